@@ -0,0 +1,22 @@
+# -*- cmake -*-
+
+include_guard()
+
+add_library( ll::mimalloc INTERFACE IMPORTED )
+
+# Replace the platform malloc with mimalloc, which gives each thread its own
+# heap. Linking the shared library overrides malloc/free for the whole
+# process (on Windows mimalloc-redirect.dll must sit next to the executable),
+# so memory may still be freed with plain free() wherever it was allocated.
+# The library is built from source in indra/deps and staged for packaging.
+option(USE_MIMALLOC "Replace the system allocator with mimalloc" OFF)
+
+if (USE_MIMALLOC)
+  if (USE_ASAN OR USE_LEAKSAN OR USE_THDSAN)
+    message(FATAL_ERROR "USE_MIMALLOC is incompatible with the sanitizers, which need their own allocator")
+  endif ()
+
+  # the mimalloc target comes from FetchContent in indra/deps
+  target_link_libraries( ll::mimalloc INTERFACE mimalloc )
+  target_compile_definitions( ll::mimalloc INTERFACE LL_USE_MIMALLOC=1 )
+endif (USE_MIMALLOC)
@@ -39,18 +39,9 @@
 // external library headers
 #include <boost/bind.hpp>
 #include <boost/fiber/fiber.hpp>
-#ifndef BOOST_DISABLE_ASSERTS
-#define UNDO_BOOST_DISABLE_ASSERTS
-// with Boost 1.65.1, needed for Mac with this specific header
-#define BOOST_DISABLE_ASSERTS
-#endif
-#include <boost/fiber/protected_fixedsize_stack.hpp>
-#ifdef UNDO_BOOST_DISABLE_ASSERTS
-#undef UNDO_BOOST_DISABLE_ASSERTS
-#undef BOOST_DISABLE_ASSERTS
-#endif
 // other Linden headers
 #include "llapp.h"
+#include "llcorostackpool.h"
 #include "lltimer.h"
 #include "llevents.h"
 #include "llerror.h"
@@ -124,6 +115,9 @@ LLCoros::LLCoros():
     // boost::context::guarded_stack_allocator::default_stacksize();
     // empirically this is insufficient.
     mStackSize(1024*1024),
+    // Enough to keep a few dozen default-size stacks around for the
+    // short-lived coroutines (HTTP requests, coprocedures) we churn through.
+    mStackPool(LLCoroStackPool::create(16*1024*1024)),
     // mCurrent does NOT own the current CoroData instance -- it simply
     // points to it. So initialize it with a no-op deleter.
     mCurrent{ [](CoroData*){} }
@@ -155,6 +149,8 @@ void LLCoros::cleanupSingleton()
         boost::this_fiber::yield();
     }
     printActiveCoroutines("after pumping");
+    // Coroutines still running keep the pool alive; just drop what's cached.
+    mStackPool->clear();
 }
 
 std::string LLCoros::generateDistinctName(const std::string& prefix) const
@@ -229,6 +225,11 @@ void LLCoros::setStackSize(S32 stacksize)
     mStackSize = stacksize;
 }
 
+void LLCoros::setStackPoolLimit(size_t max_cached_bytes)
+{
+    mStackPool->setMaxCachedBytes(max_cached_bytes);
+}
+
 void LLCoros::printActiveCoroutines(const std::string& when)
 {
     LL_INFOS("LLCoros") << "Number of active coroutines " << when
@@ -246,24 +247,35 @@ void LLCoros::printActiveCoroutines(const std::string& when)
         LL_CONT << LL_ENDL;
         LL_INFOS("LLCoros") << "-----------------------------------------------------" << LL_ENDL;
     }
+    LLCoroStackPool::Stats stats(mStackPool->getStats());
+    LL_INFOS("LLCoros") << "Coroutine stacks: " << stats.mLiveStacks << " live, "
+                        << stats.mCachedStacks << " cached (" << stats.mCachedBytes << " bytes), "
+                        << stats.mAllocated << " allocated, " << stats.mReused << " reused, "
+                        << stats.mReleased << " released" << LL_ENDL;
 }
 
 std::string LLCoros::launch(const std::string& prefix, const callable_t& callable)
+{
+    return launch(prefix, callable, mStackSize);
+}
+
+std::string LLCoros::launch(const std::string& prefix, const callable_t& callable, S32 stacksize)
 {
     std::string name(generateDistinctName(prefix));
     // 'dispatch' means: enter the new fiber immediately, returning here only
     // when the fiber yields for whatever reason.
     // std::allocator_arg is a flag to indicate that the following argument is
     // a StackAllocator.
-    // protected_fixedsize_stack sets a guard page past the end of the new
-    // stack so that stack underflow will result in an access violation
-    // instead of weird, subtle, possibly undiagnosed memory stomps.
+    // The pool hands out protected_fixedsize_stack stacks, which set a guard
+    // page past the end of the new stack so that stack underflow will result
+    // in an access violation instead of weird, subtle, possibly undiagnosed
+    // memory stomps. It recycles them when the coroutine exits.
 
     try
     {
         boost::fibers::fiber newCoro(boost::fibers::launch::dispatch,
             std::allocator_arg,
-            boost::fibers::protected_fixedsize_stack(mStackSize),
+            mStackPool->allocator(stacksize),
             [this, &name, &callable]() { toplevel(name, callable); });
 
         // You have two choices with a fiber instance: you can join() it or you
@@ -37,6 +37,7 @@
 #include "llsingleton.h"
 #include "llinstancetracker.h"
 #include <boost/function.hpp>
+#include <memory>
 #include <string>
 #include <exception>
 #include <queue>
@@ -45,6 +46,8 @@
 #define LLCOROS_MUTEX_HEADER   <boost/fiber/mutex.hpp>
 #define LLCOROS_CONDVAR_HEADER <boost/fiber/condition_variable.hpp>
 
+class LLCoroStackPool;
+
 namespace boost {
     namespace fibers {
         class mutex;
@@ -142,6 +145,14 @@ public:
      */
     std::string launch(const std::string& prefix, const callable_t& callable);
 
+    /**
+     * As above, but with an explicit stack size instead of the one set by
+     * setStackSize(). Coroutines known to run shallow call chains can ask
+     * for a smaller stack (down to LLCoroStackPool::MIN_STACK_SIZE), which
+     * is recycled separately from default-size stacks.
+     */
+    std::string launch(const std::string& prefix, const callable_t& callable, S32 stacksize);
+
     /**
      * Abort a running coroutine by name. Normally, when a coroutine either
      * runs to completion or terminates with an exception, LLCoros quietly
@@ -186,6 +197,12 @@ public:
      */
     void setStackSize(S32 stacksize);
 
+    /**
+     * Stacks of terminated coroutines are kept for reuse up to this many
+     * bytes in total (address space, guard pages included).
+     */
+    void setStackPoolLimit(size_t max_cached_bytes);
+
     /// diagnostic
     void printActiveCoroutines(const std::string& when=std::string());
 
@@ -326,6 +343,7 @@ private:
     std::queue<ExceptionData> mExceptionQueue;
 
     S32 mStackSize;
+    std::shared_ptr<LLCoroStackPool> mStackPool;
 
     // coroutine-local storage, as it were: one per coro we track
     struct CoroData: public LLInstanceTracker<CoroData, std::string>
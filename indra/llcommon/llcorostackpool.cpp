@@ -0,0 +1,194 @@
+/**
+ * @file   llcorostackpool.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llcorostackpool.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llcorostackpool.h"
+// STL headers
+// std headers
+// external library headers
+#ifndef BOOST_DISABLE_ASSERTS
+#define UNDO_BOOST_DISABLE_ASSERTS
+// with Boost 1.65.1, needed for Mac with this specific header
+#define BOOST_DISABLE_ASSERTS
+#endif
+#include <boost/context/protected_fixedsize_stack.hpp>
+#ifdef UNDO_BOOST_DISABLE_ASSERTS
+#undef UNDO_BOOST_DISABLE_ASSERTS
+#undef BOOST_DISABLE_ASSERTS
+#endif
+// other Linden headers
+#include "llerror.h"
+
+namespace
+{
+    void release_stacks(std::vector<boost::context::stack_context>& stacks)
+    {
+        for (auto& sctx : stacks)
+        {
+            // protected_fixedsize_stack::deallocate() relies only on the
+            // stack_context, so the size passed to the constructor is moot.
+            boost::context::protected_fixedsize_stack(sctx.size).deallocate(sctx);
+        }
+        stacks.clear();
+    }
+}
+
+//static
+LLCoroStackPool::ptr_t LLCoroStackPool::create(size_t max_cached_bytes)
+{
+    // private constructor: can't use std::make_shared()
+    return ptr_t(new LLCoroStackPool(max_cached_bytes));
+}
+
+LLCoroStackPool::LLCoroStackPool(size_t max_cached_bytes):
+    mMaxCachedBytes(max_cached_bytes)
+{
+}
+
+LLCoroStackPool::~LLCoroStackPool()
+{
+    // No StackAllocator can still reference us, so every stack we ever
+    // handed out has come back.
+    clear();
+}
+
+//static
+size_t LLCoroStackPool::sizeClass(size_t size)
+{
+    size_t size_class = MIN_STACK_SIZE;
+    while (size_class < size)
+    {
+        size_class <<= 1;
+    }
+    return size_class;
+}
+
+LLCoroStackPool::StackAllocator LLCoroStackPool::allocator(size_t size)
+{
+    return StackAllocator(shared_from_this(), sizeClass(size));
+}
+
+boost::context::stack_context LLCoroStackPool::StackAllocator::allocate()
+{
+    return mPool->obtain(mSizeClass);
+}
+
+void LLCoroStackPool::StackAllocator::deallocate(boost::context::stack_context& sctx)
+{
+    mPool->recycle(mSizeClass, sctx);
+}
+
+boost::context::stack_context LLCoroStackPool::obtain(size_t size_class)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mStats.mLiveStacks;
+        auto found = mFree.find(size_class);
+        if (found != mFree.end() && ! found->second.empty())
+        {
+            boost::context::stack_context sctx = found->second.back();
+            found->second.pop_back();
+            --mStats.mCachedStacks;
+            mStats.mCachedBytes -= sctx.size;
+            ++mStats.mReused;
+            return sctx;
+        }
+        ++mStats.mAllocated;
+    }
+
+    // Map outside the lock. This throws std::bad_alloc on failure, which
+    // LLCoros::launch() already handles.
+    try
+    {
+        return boost::context::protected_fixedsize_stack(size_class).allocate();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        --mStats.mLiveStacks;
+        throw;
+    }
+}
+
+void LLCoroStackPool::recycle(size_t size_class, boost::context::stack_context& sctx)
+{
+    std::vector<boost::context::stack_context> released;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        --mStats.mLiveStacks;
+        if (mStats.mCachedBytes + sctx.size <= mMaxCachedBytes)
+        {
+            mFree[size_class].push_back(sctx);
+            ++mStats.mCachedStacks;
+            mStats.mCachedBytes += sctx.size;
+        }
+        else
+        {
+            ++mStats.mReleased;
+            released.push_back(sctx);
+        }
+    }
+    release_stacks(released);
+}
+
+void LLCoroStackPool::setMaxCachedBytes(size_t max_cached_bytes)
+{
+    std::vector<boost::context::stack_context> released;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMaxCachedBytes = max_cached_bytes;
+        trim(released);
+    }
+    LL_DEBUGS("LLCoros") << "Coroutine stack pool limit " << max_cached_bytes
+                         << " bytes, released " << released.size() << " stacks" << LL_ENDL;
+    release_stacks(released);
+}
+
+void LLCoroStackPool::clear()
+{
+    std::vector<boost::context::stack_context> released;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& pair : mFree)
+        {
+            released.insert(released.end(), pair.second.begin(), pair.second.end());
+        }
+        mFree.clear();
+        mStats.mCachedStacks = 0;
+        mStats.mCachedBytes = 0;
+    }
+    release_stacks(released);
+}
+
+// Called with mMutex locked: moves stacks past the cap into 'released',
+// largest size classes first since those pin the most address space.
+void LLCoroStackPool::trim(std::vector<boost::context::stack_context>& released)
+{
+    for (auto it = mFree.rbegin(); it != mFree.rend() && mStats.mCachedBytes > mMaxCachedBytes; ++it)
+    {
+        auto& stacks = it->second;
+        while (! stacks.empty() && mStats.mCachedBytes > mMaxCachedBytes)
+        {
+            released.push_back(stacks.back());
+            stacks.pop_back();
+            --mStats.mCachedStacks;
+            mStats.mCachedBytes -= released.back().size;
+            ++mStats.mReleased;
+        }
+    }
+}
+
+LLCoroStackPool::Stats LLCoroStackPool::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
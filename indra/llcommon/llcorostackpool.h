@@ -0,0 +1,107 @@
+/**
+ * @file   llcorostackpool.h
+ * @date   2026-10-18
+ * @brief  LLCoroStackPool recycles guarded coroutine stacks so that
+ *         launching a short-lived coroutine doesn't cost an mmap/munmap
+ *         pair.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLCOROSTACKPOOL_H)
+#define LL_LLCOROSTACKPOOL_H
+
+#include "stdtypes.h"
+#include <boost/context/stack_context.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * LLCoroStackPool hands out stacks allocated by
+ * boost::context::protected_fixedsize_stack, each with its guard page, and
+ * keeps them on a free list when their coroutine exits instead of unmapping
+ * them. Requested sizes are rounded up to a power-of-two size class so that
+ * stacks can be shared between callers asking for slightly different sizes.
+ * Cached stacks are capped by total size; past the cap, released stacks are
+ * unmapped as before.
+ *
+ * The pool is thread-safe: coroutines may be launched on any thread.
+ * Because a detached fiber can outlive whoever launched it, the pool is
+ * always owned through a shared_ptr and each StackAllocator holds a
+ * reference to it.
+ */
+class LL_COMMON_API LLCoroStackPool: public std::enable_shared_from_this<LLCoroStackPool>
+{
+public:
+    typedef std::shared_ptr<LLCoroStackPool> ptr_t;
+
+    /// smallest size class handed out
+    static constexpr size_t MIN_STACK_SIZE = 64 * 1024;
+
+    static ptr_t create(size_t max_cached_bytes);
+    ~LLCoroStackPool();
+
+    /**
+     * StackAllocator concept model for boost::fibers::fiber, e.g.:
+     * @code
+     * boost::fibers::fiber(std::allocator_arg, pool->allocator(size), fn);
+     * @endcode
+     */
+    class StackAllocator
+    {
+    public:
+        boost::context::stack_context allocate();
+        void deallocate(boost::context::stack_context& sctx);
+
+    private:
+        friend class LLCoroStackPool;
+        StackAllocator(const ptr_t& pool, size_t size_class):
+            mPool(pool),
+            mSizeClass(size_class)
+        {}
+
+        ptr_t mPool;
+        size_t mSizeClass;
+    };
+
+    StackAllocator allocator(size_t size);
+
+    /// round a requested stack size up to its size class
+    static size_t sizeClass(size_t size);
+
+    /// Change the cap on cached stacks. Excess stacks are released now.
+    void setMaxCachedBytes(size_t max_cached_bytes);
+    /// release every cached stack
+    void clear();
+
+    struct Stats
+    {
+        U64 mAllocated = 0;     // stacks freshly mapped
+        U64 mReused = 0;        // stacks handed out from the cache
+        U64 mReleased = 0;      // stacks unmapped because the cache was full
+        U32 mCachedStacks = 0;  // stacks currently on the free lists
+        size_t mCachedBytes = 0;
+        U32 mLiveStacks = 0;    // stacks currently in use by coroutines
+    };
+    Stats getStats() const;
+
+private:
+    LLCoroStackPool(size_t max_cached_bytes);
+
+    boost::context::stack_context obtain(size_t size_class);
+    void recycle(size_t size_class, boost::context::stack_context& sctx);
+    void trim(std::vector<boost::context::stack_context>& released);
+
+    // free lists keyed by size class
+    typedef std::map<size_t, std::vector<boost::context::stack_context>> free_map_t;
+    free_map_t mFree;
+    size_t mMaxCachedBytes;
+    Stats mStats;
+    mutable std::mutex mMutex;
+};
+
+#endif /* ! defined(LL_LLCOROSTACKPOOL_H) */
@@ -0,0 +1,237 @@
+/**
+ * @file   llepoch.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llepoch.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llepoch.h"
+// STL headers
+#include <vector>
+// std headers
+#include <atomic>
+#include <mutex>
+// external library headers
+// other Linden headers
+
+/*
+ * The global epoch only ever moves forward, and only one step past the
+ * epoch pinned by the oldest active Guard. So while a Guard pinned at
+ * epoch e exists, the global epoch is at most e+1. Anything that Guard can
+ * reach was unlinked no earlier than e, so it was retired at e or later;
+ * freeing only what was retired at least two epochs ago is therefore safe.
+ */
+namespace
+{
+    const U32 COLLECT_INTERVAL = 64;
+
+    struct Retired
+    {
+        void* mPtr;
+        void (*mDeleter)(void*);
+        U64 mEpoch;
+    };
+
+    struct ThreadRecord
+    {
+        std::atomic<U64> mEpoch{ 0 };       // pinned epoch, 0 outside any Guard
+        std::atomic<bool> mInUse{ true };
+        ThreadRecord* mNext = nullptr;      // fixed once the record is published
+        // used only by the thread that owns the record
+        U32 mDepth = 0;
+        U32 mSinceCollect = 0;
+        std::vector<Retired> mRetired;
+    };
+
+    // Epochs start at 1 so that 0 can mean "not pinned". Atomics are
+    // constant-initialized, so these are usable during static init.
+    std::atomic<U64> sGlobalEpoch{ 1 };
+    std::atomic<ThreadRecord*> sRecords{ nullptr };
+    std::atomic<size_t> sPending{ 0 };
+
+    struct Orphans
+    {
+        std::mutex mMutex;
+        std::vector<Retired> mRetired;
+    };
+
+    Orphans& orphans()
+    {
+        // never destroyed: threads may exit after static destruction
+        static Orphans* sOrphans = new Orphans;
+        return *sOrphans;
+    }
+
+    ThreadRecord* acquire_record()
+    {
+        // Records are never freed, only recycled once their thread exits,
+        // so walking the list needs no lock.
+        for (ThreadRecord* record = sRecords.load(std::memory_order_acquire); record; record = record->mNext)
+        {
+            bool in_use = false;
+            if (!record->mInUse.load(std::memory_order_relaxed) &&
+                record->mInUse.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+            {
+                return record;
+            }
+        }
+
+        ThreadRecord* record = new ThreadRecord;
+        record->mNext = sRecords.load(std::memory_order_relaxed);
+        while (!sRecords.compare_exchange_weak(record->mNext, record,
+                                               std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return record;
+    }
+
+    struct ThreadHandle
+    {
+        ThreadHandle():
+            mRecord(acquire_record())
+        {}
+
+        ~ThreadHandle()
+        {
+            if (!mRecord->mRetired.empty())
+            {
+                Orphans& left = orphans();
+                std::lock_guard<std::mutex> lock(left.mMutex);
+                left.mRetired.insert(left.mRetired.end(), mRecord->mRetired.begin(), mRecord->mRetired.end());
+                mRecord->mRetired.clear();
+            }
+            mRecord->mDepth = 0;
+            mRecord->mSinceCollect = 0;
+            mRecord->mInUse.store(false, std::memory_order_release);
+        }
+
+        ThreadRecord* mRecord;
+    };
+
+    ThreadRecord& this_thread_record()
+    {
+        thread_local ThreadHandle sHandle;
+        return *sHandle.mRecord;
+    }
+
+    void try_advance()
+    {
+        U64 global = sGlobalEpoch.load();
+        for (ThreadRecord* record = sRecords.load(std::memory_order_acquire); record; record = record->mNext)
+        {
+            U64 pinned = record->mEpoch.load();
+            if (pinned && pinned != global)
+            {
+                // someone is still in the previous epoch
+                return;
+            }
+        }
+        sGlobalEpoch.compare_exchange_strong(global, global + 1);
+    }
+
+    // destroy everything in retired that is at least two epochs old
+    void destroy_expired(std::vector<Retired>& retired, U64 global)
+    {
+        std::vector<Retired> expired;
+        auto keep = retired.begin();
+        for (auto it = retired.begin(); it != retired.end(); ++it)
+        {
+            if (it->mEpoch + 2 <= global)
+            {
+                expired.push_back(*it);
+            }
+            else
+            {
+                *keep++ = *it;
+            }
+        }
+        retired.erase(keep, retired.end());
+
+        // after updating the list, in case a deleter retires something else
+        for (const Retired& item : expired)
+        {
+            item.mDeleter(item.mPtr);
+        }
+        sPending.fetch_sub(expired.size(), std::memory_order_relaxed);
+    }
+}
+
+LLEpoch::Guard::Guard()
+{
+    ThreadRecord& record = this_thread_record();
+    if (record.mDepth++ == 0)
+    {
+        // Pin, then make sure the epoch didn't move before the pin became
+        // visible; if it did, an advancing thread may have missed us.
+        U64 epoch = sGlobalEpoch.load();
+        for (;;)
+        {
+            record.mEpoch.store(epoch);
+            U64 now = sGlobalEpoch.load();
+            if (now == epoch)
+            {
+                break;
+            }
+            epoch = now;
+        }
+    }
+}
+
+LLEpoch::Guard::~Guard()
+{
+    ThreadRecord& record = this_thread_record();
+    if (--record.mDepth == 0)
+    {
+        record.mEpoch.store(0, std::memory_order_release);
+    }
+}
+
+//static
+void LLEpoch::retire(void* ptr, void (*deleter)(void*))
+{
+    ThreadRecord& record = this_thread_record();
+    record.mRetired.push_back({ ptr, deleter, sGlobalEpoch.load() });
+    sPending.fetch_add(1, std::memory_order_relaxed);
+    if (++record.mSinceCollect >= COLLECT_INTERVAL)
+    {
+        collect();
+    }
+}
+
+//static
+void LLEpoch::collect()
+{
+    ThreadRecord& record = this_thread_record();
+    record.mSinceCollect = 0;
+
+    try_advance();
+    U64 global = sGlobalEpoch.load();
+    destroy_expired(record.mRetired, global);
+
+    Orphans& left = orphans();
+    std::unique_lock<std::mutex> lock(left.mMutex, std::try_to_lock);
+    if (lock.owns_lock() && !left.mRetired.empty())
+    {
+        std::vector<Retired> retired;
+        retired.swap(left.mRetired);
+        lock.unlock();
+        destroy_expired(retired, global);
+        if (!retired.empty())
+        {
+            lock.lock();
+            left.mRetired.insert(left.mRetired.end(), retired.begin(), retired.end());
+        }
+    }
+}
+
+//static
+size_t LLEpoch::getPending()
+{
+    return sPending.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file   llepoch.h
+ * @date   2026-10-18
+ * @brief  LLEpoch defers destroying shared read-mostly data until no thread
+ *         can still be reading it (epoch-based reclamation).
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLEPOCH_H)
+#define LL_LLEPOCH_H
+
+#include "llpreprocessor.h"
+#include "stdtypes.h"
+
+/**
+ * LLEpoch lets readers follow an atomic pointer to shared data without
+ * taking a lock, while writers replace that data with a new copy.
+ *
+ * A reader holds an LLEpoch::Guard for as long as it uses anything it
+ * loaded through such a pointer. A writer that has swapped in a new copy
+ * passes the old one to LLEpoch::retire() rather than deleting it. The old
+ * copy is destroyed later, once every Guard that existed at the time it was
+ * retired has been released.
+ *
+ * Guards are cheap: two stores to a per-thread slot and a fence. They nest.
+ * Keep them short, though: while any thread holds one, retired data cannot
+ * be destroyed.
+ *
+ * Retired objects are destroyed by the thread that retired them, the next
+ * time it calls retire() or collect(). Anything a thread still holds when
+ * it exits is handed to whichever thread calls collect() next.
+ */
+class LL_COMMON_API LLEpoch
+{
+public:
+    class LL_COMMON_API Guard
+    {
+    public:
+        Guard();
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    /// destroy ptr with delete once no Guard can still be using it
+    template <typename T>
+    static void retire(T* ptr)
+    {
+        retire(ptr, [](void* p){ delete static_cast<T*>(p); });
+    }
+    static void retire(void* ptr, void (*deleter)(void*));
+
+    /// Advance the epoch if possible and destroy whatever is now safe.
+    /// retire() calls this every so often.
+    static void collect();
+
+    /// retired objects not yet destroyed, across all threads
+    static size_t getPending();
+};
+
+#endif /* ! defined(LL_LLEPOCH_H) */
@@ -0,0 +1,180 @@
+/**
+ * @file   llframescheduler.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llframescheduler.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llframescheduler.h"
+// STL headers
+#include <algorithm>
+// std headers
+// external library headers
+// other Linden headers
+
+namespace
+{
+    // part of the target frame time kept free for noise
+    const F64 HEADROOM = 0.1;
+    // using this much of a budget counts as having had more to do
+    const F64 SATURATED = 0.9;
+    // how fast a saturated task's request grows
+    const F64 GROWTH = 1.5;
+    // weight of the newest frame in the running averages
+    const F64 SMOOTHING = 0.25;
+}
+
+LLFrameScheduler::LLFrameScheduler():
+    mWaitTime(0.0),
+    mOtherTime(0.0),
+    mFirstFrame(true)
+{
+}
+
+LLFrameScheduler::task_id_t LLFrameScheduler::addTask(const std::string& name, U32 priority, F64 min_time, F64 max_time,
+                                                      const LLTrace::BlockTimerStatHandle* timer)
+{
+    Task task;
+    task.mName = name;
+    task.mPriority = priority;
+    task.mMaxTime = llmax(max_time, 0.0);
+    task.mMinTime = llclamp(min_time, 0.0, task.mMaxTime);
+    task.mTimer = timer;
+    task.mBudget = task.mMinTime;
+    task.mUsed = 0.0;
+    task.mLastBudget = task.mBudget;
+    task.mLastUsed = 0.0;
+    task.mRequest = task.mMinTime;
+
+    task_id_t id = (task_id_t)mTasks.size();
+    mTasks.push_back(task);
+
+    mOrder.push_back(id);
+    std::stable_sort(mOrder.begin(), mOrder.end(),
+                     [this](task_id_t a, task_id_t b) { return mTasks[a].mPriority > mTasks[b].mPriority; });
+    return id;
+}
+
+void LLFrameScheduler::setMinTime(task_id_t id, F64 min_time)
+{
+    Task& task = mTasks[id];
+    if (task.mMaxTime <= 0.0)
+    {
+        return; // only measured
+    }
+    task.mMinTime = llmax(min_time, 0.0);
+    task.mMaxTime = llmax(task.mMaxTime, task.mMinTime);
+    task.mBudget = llmax(task.mBudget, task.mMinTime);
+    task.mRequest = llmax(task.mRequest, task.mMinTime);
+}
+
+const LLFrameScheduler::Task* LLFrameScheduler::findTask(const LLTrace::BlockTimerStatHandle& timer) const
+{
+    for (const Task& task : mTasks)
+    {
+        if (task.mTimer == &timer)
+        {
+            return &task;
+        }
+    }
+    return NULL;
+}
+
+void LLFrameScheduler::beginFrame(F64 target_time)
+{
+    F64 busy_time = mFrameTimer.getElapsedTimeAndResetF64() - mWaitTime;
+    beginFrame(target_time, llmax(busy_time, 0.0));
+}
+
+void LLFrameScheduler::beginFrame(F64 target_time, F64 busy_time)
+{
+    mWaitTime = 0.0;
+
+    // settle last frame
+    F64 limited_time = 0.0;
+    for (Task& task : mTasks)
+    {
+        task.mLastBudget = task.mBudget;
+        task.mLastUsed = task.mUsed;
+        task.mUsed = 0.0;
+
+        if (task.mMaxTime <= 0.0)
+        {
+            continue;
+        }
+        limited_time += task.mLastUsed;
+
+        if (task.mLastUsed >= task.mLastBudget * SATURATED)
+        {
+            // (a task with no minimum still needs somewhere to grow from)
+            F64 base = llmax(llmax(task.mRequest, task.mLastUsed), task.mMaxTime * 0.05);
+            task.mRequest = llmin(base * GROWTH, task.mMaxTime);
+        }
+        else
+        {
+            task.mRequest = llmax(task.mRequest + (task.mLastUsed - task.mRequest) * SMOOTHING, task.mMinTime);
+        }
+    }
+
+    F64 other_time = llmax(busy_time - limited_time, 0.0);
+    if (mFirstFrame)
+    {
+        mOtherTime = other_time;
+        mFirstFrame = false;
+    }
+    else
+    {
+        mOtherTime += (other_time - mOtherTime) * SMOOTHING;
+    }
+
+    // everyone gets their minimum, whatever the frame looks like
+    F64 spare = 0.0;
+    for (Task& task : mTasks)
+    {
+        task.mBudget = task.mMinTime;
+        spare += task.mRequest - task.mMinTime;
+    }
+    if (target_time > 0.0)
+    {
+        spare = target_time * (1.0 - HEADROOM) - mOtherTime;
+        for (const Task& task : mTasks)
+        {
+            spare -= task.mMinTime;
+        }
+    }
+
+    // then the requests, by priority
+    for (task_id_t id : mOrder)
+    {
+        if (spare <= 0.0)
+        {
+            break;
+        }
+        Task& task = mTasks[id];
+        F64 extra = llclamp(task.mRequest - task.mBudget, 0.0, spare);
+        task.mBudget += extra;
+        spare -= extra;
+    }
+
+    // and whatever is left to tasks that ran out last frame
+    for (task_id_t id : mOrder)
+    {
+        if (spare <= 0.0)
+        {
+            break;
+        }
+        Task& task = mTasks[id];
+        if (task.mMaxTime > 0.0 && task.mLastUsed >= task.mLastBudget * SATURATED)
+        {
+            F64 extra = llclamp(task.mMaxTime - task.mBudget, 0.0, spare);
+            task.mBudget += extra;
+            spare -= extra;
+        }
+    }
+}
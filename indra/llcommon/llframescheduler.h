@@ -0,0 +1,134 @@
+/**
+ * @file   llframescheduler.h
+ * @date   2026-10-18
+ * @brief  LLFrameScheduler divides each frame's spare main thread time
+ *         among the tasks that can do their work a piece at a time.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLFRAMESCHEDULER_H)
+#define LL_LLFRAMESCHEDULER_H
+
+#include "lltimer.h"
+#include <string>
+#include <vector>
+
+namespace LLTrace
+{
+    class BlockTimerStatHandle;
+}
+
+/**
+ * Tasks such as creating GL textures or new objects take a time limit and
+ * leave the rest for later. LLFrameScheduler picks those limits together,
+ * once per frame, instead of each caller using its own fixed fraction.
+ *
+ * At beginFrame() the scheduler works out how much of the target frame
+ * time is left after the work it does not control (smoothed over a few
+ * frames), gives every task its minimum, then hands out the rest by
+ * priority, each task getting about what it recently used. A task that
+ * used up its whole budget is assumed to have had more to do, and its
+ * request grows until it stops doing so or reaches its maximum.
+ *
+ * A task registered with a max_time of 0 is only measured: it is never
+ * limited and its time counts as work the scheduler does not control.
+ *
+ * All methods are for the main thread only.
+ */
+class LL_COMMON_API LLFrameScheduler
+{
+public:
+    typedef S32 task_id_t;
+
+    struct Task
+    {
+        std::string mName;
+        U32 mPriority;
+        F64 mMinTime;
+        F64 mMaxTime;
+        // optional, lets timer displays find the task
+        const LLTrace::BlockTimerStatHandle* mTimer;
+
+        F64 mBudget;        // this frame
+        F64 mUsed;          // so far this frame
+        F64 mLastBudget;
+        F64 mLastUsed;
+        F64 mRequest;       // what the task is expected to want next frame
+    };
+
+    LLFrameScheduler();
+
+    // Higher priorities are served first. Times are in seconds.
+    task_id_t addTask(const std::string& name, U32 priority, F64 min_time, F64 max_time,
+                      const LLTrace::BlockTimerStatHandle* timer = NULL);
+
+    // Start a frame aiming for target_time seconds of work. The previous
+    // frame's working time is measured from the last call, less any time
+    // passed to addWaitTime(). A target_time of 0 means no target: every
+    // task gets what it asks for.
+    void beginFrame(F64 target_time);
+    // as above, with the previous frame's working time given explicitly
+    void beginFrame(F64 target_time, F64 busy_time);
+
+    // time spent blocked rather than working, e.g. in swap or sleep
+    void addWaitTime(F64 seconds) { mWaitTime += seconds; }
+
+    // Changes the minimum of a limited task, e.g. to one that follows the
+    // frame rate, raising the maximum to match if need be. Takes effect at
+    // once, so it may be called between beginFrame() and the task's run.
+    void setMinTime(task_id_t id, F64 min_time);
+
+    F64 getBudget(task_id_t id) const { return mTasks[id].mBudget; }
+    void reportUsage(task_id_t id, F64 seconds) { mTasks[id].mUsed += seconds; }
+
+    const Task& getTask(task_id_t id) const { return mTasks[id]; }
+    const Task* findTask(const LLTrace::BlockTimerStatHandle& timer) const;
+    S32 getTaskCount() const { return (S32)mTasks.size(); }
+
+    // smoothed time per frame spent on everything but the limited tasks
+    F64 getOtherTime() const { return mOtherTime; }
+
+    /**
+     * Times one run of a task and reports it when it goes out of scope:
+     *
+     *      LLFrameScheduler::Scope budget(scheduler, id);
+     *      doSomeWork(budget.getBudget());
+     */
+    class Scope
+    {
+    public:
+        Scope(LLFrameScheduler& scheduler, task_id_t id):
+            mScheduler(scheduler),
+            mID(id)
+        {}
+        ~Scope() { mScheduler.reportUsage(mID, mTimer.getElapsedTimeF64()); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        // what remains of the task's budget for this frame
+        F32 getBudget() const
+        {
+            return (F32)llmax(mScheduler.getBudget(mID) - mScheduler.getTask(mID).mUsed, 0.0);
+        }
+
+    private:
+        LLFrameScheduler& mScheduler;
+        task_id_t mID;
+        LLTimer mTimer;
+    };
+
+private:
+    std::vector<Task> mTasks;
+    // task indices, highest priority first
+    std::vector<task_id_t> mOrder;
+    LLTimer mFrameTimer;
+    F64 mWaitTime;
+    F64 mOtherTime;
+    bool mFirstFrame;
+};
+
+#endif /* ! defined(LL_LLFRAMESCHEDULER_H) */
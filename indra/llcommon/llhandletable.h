@@ -0,0 +1,189 @@
+/**
+ * @file   llhandletable.h
+ * @date   2026-10-18
+ * @brief  LLHandleTable hands out compact generational handles to live
+ *         objects, for lookups that would otherwise hash a UUID.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLHANDLETABLE_H)
+#define LL_LLHANDLETABLE_H
+
+#include "stdtypes.h"
+#include <vector>
+
+/**
+ * LLHandleTable<T> is a slot map of non-owning T pointers. add() returns a
+ * 32-bit Handle: 20 bits of slot index and 12 bits of generation. get()
+ * is an array index and a compare, and returns nullptr once the object has
+ * been removed, even if its slot has since been reused.
+ *
+ * Live pointers are also kept packed in a dense array, so iterating the
+ * table touches only live entries, in no particular order.
+ *
+ * Freed slots are reused oldest first, and only once enough of them have
+ * piled up, so a stale handle would have to outlive thousands of reuses
+ * of the same slot before its generation could match again.
+ *
+ * The table holds at most MAX_SIZE entries; past that add() returns a null
+ * Handle, and callers should fall back to whatever key they used before.
+ *
+ * Not thread safe.
+ */
+template <typename T>
+class LLHandleTable
+{
+public:
+    static const U32 INDEX_BITS = 20;
+    static const U32 MAX_SIZE = (1 << INDEX_BITS) - 1;
+
+    class Handle
+    {
+    public:
+        Handle(): mValue(0) {}
+
+        bool isNull() const { return mValue == 0; }
+        U32 asU32() const { return mValue; }
+
+        bool operator==(const Handle& other) const { return mValue == other.mValue; }
+        bool operator!=(const Handle& other) const { return mValue != other.mValue; }
+
+    private:
+        friend class LLHandleTable;
+        explicit Handle(U32 value): mValue(value) {}
+
+        U32 mValue;
+    };
+
+    typedef typename std::vector<T*>::const_iterator const_iterator;
+
+    LLHandleTable():
+        mFreeHead(NIL),
+        mFreeTail(NIL),
+        mFreeCount(0)
+    {}
+
+    Handle add(T* object)
+    {
+        U32 slot;
+        if (mFreeCount > MIN_FREE)
+        {
+            slot = mFreeHead;
+            mFreeHead = mSlots[slot].mIndex;
+            if (mFreeHead == NIL)
+            {
+                mFreeTail = NIL;
+            }
+            --mFreeCount;
+        }
+        else if (mSlots.size() < MAX_SIZE)
+        {
+            slot = (U32)mSlots.size();
+            mSlots.push_back(Slot());
+        }
+        else
+        {
+            return Handle();
+        }
+
+        mSlots[slot].mIndex = (U32)mObjects.size();
+        mObjects.push_back(object);
+        mDenseSlots.push_back(slot);
+        return Handle((mSlots[slot].mGeneration << INDEX_BITS) | slot);
+    }
+
+    /// returns false if handle was already stale
+    bool remove(Handle handle)
+    {
+        U32 slot = handle.mValue & INDEX_MASK;
+        if (handle.isNull() || slot >= mSlots.size() ||
+            mSlots[slot].mGeneration != (handle.mValue >> INDEX_BITS))
+        {
+            return false;
+        }
+
+        // move the last live entry into the hole
+        U32 index = mSlots[slot].mIndex;
+        U32 last = (U32)mObjects.size() - 1;
+        if (index != last)
+        {
+            mObjects[index] = mObjects[last];
+            mDenseSlots[index] = mDenseSlots[last];
+            mSlots[mDenseSlots[index]].mIndex = index;
+        }
+        mObjects.pop_back();
+        mDenseSlots.pop_back();
+
+        release(slot);
+        return true;
+    }
+
+    T* get(Handle handle) const
+    {
+        U32 slot = handle.mValue & INDEX_MASK;
+        // a null handle has generation 0, which no slot ever has
+        if (slot < mSlots.size() && mSlots[slot].mGeneration == (handle.mValue >> INDEX_BITS))
+        {
+            return mObjects[mSlots[slot].mIndex];
+        }
+        return nullptr;
+    }
+
+    /// Remove everything. Outstanding handles all become stale.
+    void clear()
+    {
+        for (U32 slot : mDenseSlots)
+        {
+            release(slot);
+        }
+        mObjects.clear();
+        mDenseSlots.clear();
+    }
+
+    size_t size() const { return mObjects.size(); }
+    bool empty() const { return mObjects.empty(); }
+
+    const_iterator begin() const { return mObjects.begin(); }
+    const_iterator end() const { return mObjects.end(); }
+
+private:
+    static const U32 INDEX_MASK = MAX_SIZE;
+    static const U32 MAX_GENERATION = (1 << (32 - INDEX_BITS)) - 1;
+    static const U32 MIN_FREE = 1024;
+    static const U32 NIL = ~0U;
+
+    struct Slot
+    {
+        U32 mIndex = NIL;           // into mObjects while live, else next free slot
+        U32 mGeneration = 1;        // never 0, so the null handle never matches
+    };
+
+    void release(U32 slot)
+    {
+        Slot& entry = mSlots[slot];
+        entry.mGeneration = (entry.mGeneration == MAX_GENERATION) ? 1 : entry.mGeneration + 1;
+        entry.mIndex = NIL;
+        if (mFreeTail == NIL)
+        {
+            mFreeHead = slot;
+        }
+        else
+        {
+            mSlots[mFreeTail].mIndex = slot;
+        }
+        mFreeTail = slot;
+        ++mFreeCount;
+    }
+
+    std::vector<Slot> mSlots;
+    std::vector<T*> mObjects;
+    std::vector<U32> mDenseSlots;   // slot of each entry in mObjects
+    U32 mFreeHead;
+    U32 mFreeTail;
+    U32 mFreeCount;
+};
+
+#endif /* ! defined(LL_LLHANDLETABLE_H) */
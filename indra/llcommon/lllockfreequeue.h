@@ -0,0 +1,143 @@
+/**
+ * @file   lllockfreequeue.h
+ * @date   2026-10-18
+ * @brief  LLLockFreeQueue is a bounded queue that producers and a consumer
+ *         on different threads can use without taking a mutex.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLLOCKFREEQUEUE_H)
+#define LL_LLLOCKFREEQUEUE_H
+
+#include "stdtypes.h"
+#include <atomic>
+#include <memory>
+
+/**
+ * LLLockFreeQueue<T> is a fixed capacity ring buffer in which each cell
+ * carries a sequence number saying whether it is ready to be written or
+ * read (the well known bounded queue of Dmitry Vyukov). Any number of
+ * threads may push and pop concurrently; a push or pop is a couple of
+ * atomic operations and never blocks or allocates.
+ *
+ * tryPush() returns false rather than waiting when the queue is full, so
+ * callers should keep a slower path for that case. T must be default
+ * constructible and copy assignable, and values are copied in and out, so
+ * keep messages small.
+ */
+template <typename T>
+class LLLockFreeQueue
+{
+public:
+    // capacity is rounded up to a power of two
+    explicit LLLockFreeQueue(size_t capacity):
+        mMask(roundUp(capacity) - 1),
+        mCells(new Cell[mMask + 1]),
+        mEnqueuePos(0),
+        mDequeuePos(0)
+    {
+        for (size_t i = 0; i <= mMask; ++i)
+        {
+            mCells[i].mSequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LLLockFreeQueue(const LLLockFreeQueue&) = delete;
+    LLLockFreeQueue& operator=(const LLLockFreeQueue&) = delete;
+
+    bool tryPush(const T& value)
+    {
+        size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &mCells[pos & mMask];
+            size_t seq = cell->mSequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // full
+            }
+            else
+            {
+                pos = mEnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->mValue = value;
+        cell->mSequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value)
+    {
+        size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &mCells[pos & mMask];
+            size_t seq = cell->mSequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0)
+            {
+                if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // empty
+            }
+            else
+            {
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->mValue;
+        cell->mSequence.store(pos + mMask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // only a hint while other threads are pushing or popping
+    bool empty() const
+    {
+        return mEnqueuePos.load(std::memory_order_relaxed) == mDequeuePos.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mMask + 1; }
+
+private:
+    static size_t roundUp(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    struct Cell
+    {
+        std::atomic<size_t> mSequence;
+        T mValue;
+    };
+
+    const size_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+    // producers and the consumer each write their own cache line
+    alignas(64) std::atomic<size_t> mEnqueuePos;
+    alignas(64) std::atomic<size_t> mDequeuePos;
+};
+
+#endif /* ! defined(LL_LLLOCKFREEQUEUE_H) */
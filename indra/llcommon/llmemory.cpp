@@ -50,6 +50,7 @@
 #include "llframetimer.h"
 #include "lltrace.h"
 #include "llerror.h"
+#include "llformat.h"
 //----------------------------------------------------------------------------
 
 //static
@@ -221,6 +222,17 @@ void LLMemory::logMemoryInfo(BOOL update)
     LL_INFOS() << "Current max usable memory(KB): " << sMaxPhysicalMemInKB << LL_ENDL ;
 }
 
+//static
+std::string LLMemory::getAllocatorName()
+{
+#if LL_USE_MIMALLOC
+    S32 version = mi_version();
+    return llformat("mimalloc %d.%d.%d", version / 100, (version / 10) % 10, version % 10);
+#else
+    return "system";
+#endif
+}
+
 //static
 U32Kilobytes LLMemory::getAvailableMemKB()
 {
@@ -27,11 +27,18 @@
 #define LLMEMORY_H
 
 #include "linden_common.h"
+#include "llmemtag.h"
 #include "llunits.h"
 #include "stdtypes.h"
 #if !LL_WINDOWS
 #include <stdint.h>
 #endif
+#if LL_USE_MIMALLOC
+// mimalloc replaces malloc/free process wide (see cmake/Mimalloc.cmake), so
+// the aligned allocators below can use it directly and stay compatible with
+// code that frees their memory with free()
+#include <mimalloc.h>
+#endif
 
 class LLMutex ;
 
@@ -127,6 +134,22 @@ public:                                     \
         ll_aligned_free_16(ptr);            \
     }
 
+// LL_ALIGN_NEW, with instances counted under an LLMemTag (see LL_MEMTAG_NEW)
+#define LL_ALIGN_NEW_TAGGED(tag)                    \
+public:                                             \
+    void* operator new(size_t size)                 \
+    {                                               \
+        void* ptr = ll_aligned_malloc_16(size);     \
+        LLMemTag::claim(tag, size);                 \
+        return ptr;                                 \
+    }                                               \
+                                                    \
+    void operator delete(void* ptr, size_t size)    \
+    {                                               \
+        LLMemTag::disclaim(tag, size);              \
+        ll_aligned_free_16(ptr);                    \
+    }
+
 
 //------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------
@@ -141,7 +164,9 @@ public:                                     \
     inline void* ll_aligned_malloc_fallback( size_t size, int align )
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
-    #if defined(LL_WINDOWS)
+    #if LL_USE_MIMALLOC
+        void* ret = mi_malloc_aligned(size, align);
+    #elif defined(LL_WINDOWS)
         void* ret = _aligned_malloc(size, align);
     #else
         char* aligned = NULL;
@@ -163,7 +188,9 @@ public:                                     \
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
         LL_PROFILE_FREE(ptr);
-    #if defined(LL_WINDOWS)
+    #if LL_USE_MIMALLOC
+        mi_free(ptr);
+    #elif defined(LL_WINDOWS)
         _aligned_free(ptr);
     #else
         if (ptr)
@@ -179,7 +206,9 @@ public:                                     \
 inline void* ll_aligned_malloc_16(size_t size) // returned hunk MUST be freed with ll_aligned_free_16().
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
-#if (ADDRESS_SIZE == 64 && (defined(LL_WINDOWS) || defined(LL_DARWIN) || defined(LL_LINUX)))
+#if LL_USE_MIMALLOC
+    void* ret = mi_malloc_aligned(size, 16);
+#elif (ADDRESS_SIZE == 64 && (defined(LL_WINDOWS) || defined(LL_DARWIN) || defined(LL_LINUX)))
     void* ret = malloc(size); // default x86_64 malloc alignment on windows, mac, and linux is 16 byte aligned
 #else
 #if defined(LL_WINDOWS)
@@ -200,7 +229,9 @@ inline void ll_aligned_free_16(void *p)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(p);
-#if (ADDRESS_SIZE == 64 && (defined(LL_WINDOWS) || defined(LL_DARWIN) || defined(LL_LINUX)))
+#if LL_USE_MIMALLOC
+    mi_free(p);
+#elif (ADDRESS_SIZE == 64 && (defined(LL_WINDOWS) || defined(LL_DARWIN) || defined(LL_LINUX)))
     free(p); // default x86_64 malloc alignment on windows, mac, and linux is 16 byte aligned
 #else
 #if defined(LL_WINDOWS)
@@ -217,7 +248,9 @@ inline void* ll_aligned_realloc_16(void* ptr, size_t size, size_t old_size) // r
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(ptr);
-#if (ADDRESS_SIZE == 64 && (defined(LL_WINDOWS) || defined(LL_DARWIN) || defined(LL_LINUX)))
+#if LL_USE_MIMALLOC
+    void* ret = mi_realloc_aligned(ptr, size, 16);
+#elif (ADDRESS_SIZE == 64 && (defined(LL_WINDOWS) || defined(LL_DARWIN) || defined(LL_LINUX)))
     void* ret = realloc(ptr, size); // default x86_64 malloc alignment on windows, mac, and linux is 16 byte aligned
 #else
 #if defined(LL_WINDOWS)
@@ -246,7 +279,9 @@ inline void* ll_aligned_realloc_16(void* ptr, size_t size, size_t old_size) // r
 inline void* ll_aligned_malloc_32(size_t size) // returned hunk MUST be freed with ll_aligned_free_32().
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
-#if defined(LL_WINDOWS)
+#if LL_USE_MIMALLOC
+    void* ret = mi_malloc_aligned(size, 32);
+#elif defined(LL_WINDOWS)
     void* ret = _aligned_malloc(size, 32);
 #else
     void *ret;
@@ -261,7 +296,9 @@ inline void ll_aligned_free_32(void *p)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(p);
-#if defined(LL_WINDOWS)
+#if LL_USE_MIMALLOC
+    mi_free(p);
+#elif defined(LL_WINDOWS)
     _aligned_free(p);
 #else
     free(p); // posix_memalign() is compatible with heap deallocator
@@ -271,7 +308,9 @@ inline void ll_aligned_free_32(void *p)
 inline void* ll_aligned_malloc_64(size_t size) // returned hunk MUST be freed with ll_aligned_free_64().
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
-#if defined(LL_WINDOWS)
+#if LL_USE_MIMALLOC
+    void* ret = mi_malloc_aligned(size, 64);
+#elif defined(LL_WINDOWS)
     void* ret = _aligned_malloc(size, 64);
 #else
     void *ret;
@@ -287,7 +326,9 @@ inline void ll_aligned_free_64(void *p)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_MEMORY;
     LL_PROFILE_FREE(p);
-#if defined(LL_WINDOWS)
+#if LL_USE_MIMALLOC
+    mi_free(p);
+#elif defined(LL_WINDOWS)
     _aligned_free(p);
 #else
     free(p); // posix_memalign() is compatible with heap deallocator
@@ -435,6 +476,8 @@ public:
     // Return the resident set size of the current process, in bytes.
     // Return value is zero if not known.
     static U64 getCurrentRSS();
+    // Name and version of the allocator behind malloc and ll_aligned_malloc.
+    static std::string getAllocatorName();
     static void* tryToAlloc(void* address, U32 size);
     static void initMaxHeapSizeGB(F32Gigabytes max_heap_size);
     static void updateMemoryInfo() ;
@@ -0,0 +1,72 @@
+/**
+ * @file   llmemtag.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llmemtag.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llmemtag.h"
+// STL headers
+// std headers
+// external library headers
+// other Linden headers
+
+LLMemTag::Counters LLMemTag::sCounters[LLMemTag::COUNT];
+
+namespace
+{
+    // COUNT means no scope is open
+    thread_local LLMemTag::ETag sScopeTag = LLMemTag::COUNT;
+}
+
+//static
+const char* LLMemTag::getName(ETag tag)
+{
+    switch (tag)
+    {
+    case IMAGE_RAW:         return "image_raw";
+    case IMAGE_FORMATTED:   return "image_formatted";
+    case VOLUME:            return "volume";
+    case MESH:              return "mesh";
+    case VERTEX_BUFFER:     return "vertex_buffer";
+    case SD:                return "llsd";
+    case OBJECT:            return "object";
+    case AVATAR:            return "avatar";
+    case DRAWABLE:          return "drawable";
+    default:                return "unknown";
+    }
+}
+
+//static
+LLMemTag::ETag LLMemTag::current(ETag fallback)
+{
+    return sScopeTag != COUNT ? sScopeTag : fallback;
+}
+
+LLMemTag::Scope::Scope(ETag tag):
+    mPrevious(sScopeTag)
+{
+    sScopeTag = tag;
+}
+
+LLMemTag::Scope::~Scope()
+{
+    sScopeTag = mPrevious;
+}
+
+//static
+LLMemTag::Stats LLMemTag::getStats(ETag tag)
+{
+    const Counters& counters = sCounters[tag];
+    Stats stats;
+    stats.mLiveBytes = counters.mLiveBytes.load(std::memory_order_relaxed);
+    stats.mAllocations = counters.mAllocations.load(std::memory_order_relaxed);
+    stats.mAllocatedBytes = counters.mAllocatedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file   llmemtag.h
+ * @date   2026-10-18
+ * @brief  LLMemTag attributes live heap memory to the viewer subsystem
+ *         that owns it.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLMEMTAG_H)
+#define LL_LLMEMTAG_H
+
+#include "llpreprocessor.h"
+#include "stdtypes.h"
+#include <atomic>
+#include <new>
+
+/**
+ * LLMemTag keeps a running total of live bytes, allocations and bytes
+ * allocated for each subsystem tag.
+ *
+ * Accounting is done by the owners of large buffers (image data, volume
+ * faces, vertex buffer shadow copies...) rather than by the allocator: an
+ * owner claims its bytes when it allocates and disclaims the same amount
+ * when it frees, so it only has to remember the tag it claimed under. By
+ * default an owner claims under its own tag, but code can open an
+ * LLMemTag::Scope to have everything allocated on that thread in the
+ * meantime attributed to another subsystem, e.g. volumes decoded by the
+ * mesh repository count as MESH rather than VOLUME.
+ *
+ * Heap objects can be counted per class with LL_MEMTAG_NEW (or
+ * LL_ALIGN_NEW_TAGGED in llmemory.h), which rely on sized deallocation to
+ * give back the size of the most derived class.
+ *
+ * The counters are relaxed atomics, one cache line per tag, cheap enough
+ * to leave enabled.
+ */
+class LL_COMMON_API LLMemTag
+{
+public:
+    enum ETag : U8
+    {
+        IMAGE_RAW = 0,      // decoded image data
+        IMAGE_FORMATTED,    // compressed image data
+        VOLUME,             // volume face geometry
+        MESH,               // geometry decoded from mesh assets
+        VERTEX_BUFFER,      // client side copies of vertex and index buffers
+        SD,                 // LLSD values
+        OBJECT,             // viewer objects
+        AVATAR,             // avatars
+        DRAWABLE,           // drawables and draw batches
+        COUNT
+    };
+
+    static const char* getName(ETag tag);
+
+    static void claim(ETag tag, size_t bytes)
+    {
+        Counters& counters = sCounters[tag];
+        counters.mLiveBytes.fetch_add((S64)bytes, std::memory_order_relaxed);
+        counters.mAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.mAllocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void disclaim(ETag tag, size_t bytes)
+    {
+        sCounters[tag].mLiveBytes.fetch_sub((S64)bytes, std::memory_order_relaxed);
+    }
+
+    /// tag of the innermost Scope open on this thread, or fallback if none
+    static ETag current(ETag fallback);
+
+    /// attribute allocations made on this thread to tag while in scope
+    class LL_COMMON_API Scope
+    {
+    public:
+        Scope(ETag tag);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ETag mPrevious;
+    };
+
+    struct Stats
+    {
+        S64 mLiveBytes = 0;
+        U64 mAllocations = 0;       // since startup
+        U64 mAllocatedBytes = 0;    // since startup
+    };
+    static Stats getStats(ETag tag);
+
+private:
+    struct alignas(64) Counters
+    {
+        std::atomic<S64> mLiveBytes{ 0 };
+        std::atomic<U64> mAllocations{ 0 };
+        std::atomic<U64> mAllocatedBytes{ 0 };
+    };
+    static Counters sCounters[COUNT];
+};
+
+/**
+ * Count heap instances of a class (and its subclasses) under tag. The
+ * class must have a virtual destructor if it is deleted through a base
+ * pointer, as for anything managed by LLPointer.
+ */
+#define LL_MEMTAG_NEW(tag)                              \
+public:                                                 \
+    void* operator new(size_t size)                     \
+    {                                                   \
+        void* ptr = ::operator new(size);               \
+        LLMemTag::claim(tag, size);                     \
+        return ptr;                                     \
+    }                                                   \
+                                                        \
+    void operator delete(void* ptr, size_t size)        \
+    {                                                   \
+        LLMemTag::disclaim(tag, size);                  \
+        ::operator delete(ptr);                         \
+    }
+
+#endif /* ! defined(LL_LLMEMTAG_H) */
@@ -26,6 +26,8 @@
 #include "linden_common.h"
 #include "llmortician.h"
 
+#include "lltimer.h"
+
 #include <list>
 
 std::list<LLMortician*> LLMortician::sGraveyard;
@@ -34,7 +36,11 @@ BOOL LLMortician::sDestroyImmediate = FALSE;
 
 LLMortician::~LLMortician()
 {
-    sGraveyard.remove(this);
+    // deleted directly after dying
+    if (mBuried)
+    {
+        sGraveyard.erase(mGraveyardIter);
+    }
 }
 
 size_t LLMortician::logClass(std::stringstream &str)
@@ -73,12 +79,21 @@ size_t LLMortician::logClass(std::stringstream &str)
     return size;
 }
 
-void LLMortician::updateClass()
+void LLMortician::updateClass(F32 max_time)
 {
+    LLTimer timer;
     while (!sGraveyard.empty())
     {
+        // taken off first, the destructor can kill or delete others
         LLMortician* dead = sGraveyard.front();
+        sGraveyard.pop_front();
+        dead->mBuried = false;
         delete dead;
+
+        if (max_time >= 0.f && timer.getElapsedTimeF32() > max_time)
+        {
+            break;
+        }
     }
 }
 
@@ -95,7 +110,8 @@ void LLMortician::die()
     else if (!mIsDead)
     {
         mIsDead = TRUE;
-        sGraveyard.push_back(this);
+        mBuried = true;
+        mGraveyardIter = sGraveyard.insert(sGraveyard.end(), this);
     }
 }
 
@@ -33,10 +33,13 @@
 class LL_COMMON_API LLMortician
 {
 public:
-    LLMortician() { mIsDead = FALSE; }
+    LLMortician() { mIsDead = FALSE; mBuried = false; }
     static auto graveyardCount() { return sGraveyard.size(); };
     static size_t logClass(std::stringstream &str);
-    static void updateClass();
+    // Deletes what died, oldest first, until max_time seconds have passed.
+    // At least one is deleted per call, even with a spent budget of 0; a
+    // negative max_time deletes them all.
+    static void updateClass(F32 max_time = -1.f);
     virtual ~LLMortician();
     void die();
     BOOL isDead() { return mIsDead; }
@@ -48,6 +51,9 @@ private:
     static BOOL sDestroyImmediate;
 
     BOOL mIsDead;
+    // in sGraveyard at mGraveyardIter
+    bool mBuried;
+    std::list<LLMortician*>::iterator mGraveyardIter;
 
     static std::list<LLMortician*> sGraveyard;
 };
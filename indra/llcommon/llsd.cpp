@@ -32,6 +32,7 @@
 
 #include "llerror.h"
 #include "llformat.h"
+#include "llmemtag.h"
 #include "llsdserialize.h"
 #include "stringize.h"
 
@@ -85,6 +86,7 @@ class LLSD::Impl
 
     */
 {
+    LL_MEMTAG_NEW(LLMemTag::SD);
 protected:
     Impl();
 
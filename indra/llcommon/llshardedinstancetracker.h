@@ -0,0 +1,502 @@
+/**
+ * @file   llshardedinstancetracker.h
+ * @date   2026-10-18
+ * @brief  LLShardedInstanceTracker is a drop-in alternative to
+ *         LLInstanceTracker for classes looked up from many threads.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLSHARDEDINSTANCETRACKER_H)
+#define LL_LLSHARDEDINSTANCETRACKER_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+
+#include "llepoch.h"
+#include "llinstancetracker.h"      // EInstanceTrackerAllowKeyCollisions, logerrs()
+#include "stringize.h"
+
+/*****************************************************************************
+*   ShardedMap
+*****************************************************************************/
+namespace LLInstanceTrackerPrivate
+{
+    /**
+     * Read-mostly map from KEY to std::weak_ptr<T>, split into shards by
+     * key hash. Each shard publishes an immutable table, a vector sorted by
+     * key, through an atomic pointer: lookups and snapshots read it under an
+     * LLEpoch::Guard without locking, while insertions and removals copy the
+     * shard's table under the shard's mutex, publish the copy and retire the
+     * old table. With 64 shards, tables stay small enough that a copy is
+     * one allocation plus a handful of entries.
+     *
+     * Retired tables may be read for a while after an entry is removed,
+     * which is why they hold weak_ptrs: the strong reference belongs to the
+     * instance itself, so its entries expire everywhere when it's destroyed.
+     */
+    template <typename KEY, typename T, typename HASH = std::hash<KEY>>
+    class ShardedMap
+    {
+    public:
+        using ptr_t   = std::shared_ptr<T>;
+        using weak_t  = std::weak_ptr<T>;
+        using entry_t = std::pair<KEY, weak_t>;
+        using table_t = std::vector<entry_t>;
+
+        static constexpr size_t SHARDS = 64;
+
+        ptr_t find(const KEY& key) const
+        {
+            LLEpoch::Guard guard;
+            const table_t* table = shardFor(key).mTable.load(std::memory_order_acquire);
+            if (!table)
+            {
+                return {};
+            }
+            auto found = lowerBound(*table, key);
+            return (found == table->end() || found->first != key) ? ptr_t() : found->second.lock();
+        }
+
+        size_t size() const
+        {
+            return mSize.load(std::memory_order_relaxed);
+        }
+
+        /// call fn(key, weak) for every entry, shard by shard
+        template <typename FUNC>
+        void forEach(FUNC&& fn) const
+        {
+            LLEpoch::Guard guard;
+            for (const Shard& shard : mShards)
+            {
+                if (const table_t* table = shard.mTable.load(std::memory_order_acquire))
+                {
+                    for (const entry_t& entry : *table)
+                    {
+                        fn(entry.first, entry.second);
+                    }
+                }
+            }
+        }
+
+        /// Add key. If it's already present, replace it when replace is
+        /// true; return false without changing anything when it's not.
+        bool insert(const KEY& key, const weak_t& ptr, bool replace)
+        {
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const table_t* old_table = shard.mTable.load(std::memory_order_relaxed);
+            table_t* new_table = new table_t;
+            new_table->reserve((old_table ? old_table->size() : 0) + 1);
+            if (old_table)
+            {
+                *new_table = *old_table;
+            }
+            auto found = lowerBound(*new_table, key);
+            if (found != new_table->end() && found->first == key)
+            {
+                if (!replace)
+                {
+                    delete new_table;
+                    return false;
+                }
+                found->second = ptr;
+            }
+            else
+            {
+                new_table->emplace(found, key, ptr);
+                mSize.fetch_add(1, std::memory_order_relaxed);
+            }
+            publish(shard, old_table, new_table);
+            return true;
+        }
+
+        /// remove key if it still maps to ptr
+        void erase(const KEY& key, const weak_t& ptr)
+        {
+            Shard& shard = shardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const table_t* old_table = shard.mTable.load(std::memory_order_relaxed);
+            if (!old_table)
+            {
+                return;
+            }
+            auto found = lowerBound(*old_table, key);
+            // with LLInstanceTrackerReplaceOnCollision, key may by now
+            // belong to another instance
+            if (found == old_table->end() || found->first != key ||
+                found->second.owner_before(ptr) || ptr.owner_before(found->second))
+            {
+                return;
+            }
+            table_t* new_table = new table_t;
+            new_table->reserve(old_table->size() - 1);
+            new_table->insert(new_table->end(), old_table->begin(), found);
+            new_table->insert(new_table->end(), found + 1, old_table->end());
+            mSize.fetch_sub(1, std::memory_order_relaxed);
+            publish(shard, old_table, new_table);
+        }
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::mutex mMutex;
+            std::atomic<const table_t*> mTable{ nullptr };
+        };
+
+        template <typename TABLE>
+        static auto lowerBound(TABLE& table, const KEY& key)
+        {
+            return std::lower_bound(table.begin(), table.end(), key,
+                                    [](const entry_t& entry, const KEY& k) { return entry.first < k; });
+        }
+
+        Shard& shardFor(const KEY& key)
+        {
+            return mShards[HASH()(key) % SHARDS];
+        }
+        const Shard& shardFor(const KEY& key) const
+        {
+            return mShards[HASH()(key) % SHARDS];
+        }
+
+        static void publish(Shard& shard, const table_t* old_table, table_t* new_table)
+        {
+            shard.mTable.store(new_table, std::memory_order_release);
+            if (old_table)
+            {
+                LLEpoch::retire(const_cast<table_t*>(old_table));
+            }
+        }
+
+        Shard mShards[SHARDS];
+        std::atomic<size_t> mSize{ 0 };
+    };
+
+    template <typename STATIC>
+    STATIC& getShardedStatic()
+    {
+        // Never destroyed: as with LockStatic, instances may register
+        // before and unregister after this module's static lifetime.
+        static STATIC* sData = new STATIC;
+        return *sData;
+    }
+} // namespace LLInstanceTrackerPrivate
+
+/*****************************************************************************
+*   LLShardedInstanceTracker with key
+*****************************************************************************/
+/**
+ * LLShardedInstanceTracker has the same interface as LLInstanceTracker:
+ * derive a class from one or the other to choose how its instances are
+ * tracked. LLInstanceTracker guards a single map with a mutex, so every
+ * lookup, snapshot, construction and destruction of that class contends
+ * for one lock. Here, getInstance() and snapshots take no lock at all, and
+ * construction and destruction only lock one of 64 shards -- but they copy
+ * that shard's table, so pick this for classes that are looked up far more
+ * often than they are created.
+ *
+ * Unlike LLInstanceTracker, snapshots are not ordered by key.
+ */
+template<typename T, typename KEY = void,
+         EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR = LLInstanceTrackerErrorOnCollision>
+class LLShardedInstanceTracker
+{
+    typedef LLInstanceTrackerPrivate::ShardedMap<KEY, T> InstanceMap;
+
+    static InstanceMap& getMap()
+    {
+        return LLInstanceTrackerPrivate::getShardedStatic<InstanceMap>();
+    }
+
+public:
+    using ptr_t  = std::shared_ptr<T>;
+    using weak_t = std::weak_ptr<T>;
+
+    /// see LLInstanceTracker::getWeak()
+    weak_t getWeak()
+    {
+        return mSelf;
+    }
+
+    static size_t instanceCount()
+    {
+        return getMap().size();
+    }
+
+    // snapshot of std::pair<const KEY, std::shared_ptr<SUBCLASS>> pairs, for
+    // some SUBCLASS derived from T; see LLInstanceTracker::snapshot_of
+    template <typename SUBCLASS>
+    class snapshot_of
+    {
+        typedef std::vector<std::pair<const KEY, weak_t>> VectorType;
+        typedef std::pair<const KEY, std::shared_ptr<SUBCLASS>> strong_pair;
+        static strong_pair strengthen(typename VectorType::value_type& pair)
+        {
+            return { pair.first, std::dynamic_pointer_cast<SUBCLASS>(pair.second.lock()) };
+        }
+        static bool dead_skipper(const strong_pair& pair)
+        {
+            return bool(pair.second);
+        }
+
+    public:
+        snapshot_of()
+        {
+            mData.reserve(getMap().size());
+            getMap().forEach([this](const KEY& key, const weak_t& ptr)
+                             { mData.emplace_back(key, ptr); });
+        }
+
+        typedef boost::transform_iterator<decltype(strengthen)*,
+                                          typename VectorType::iterator> strong_iterator;
+        typedef boost::filter_iterator<decltype(dead_skipper)*, strong_iterator> iterator;
+
+        iterator begin() { return make_iterator(mData.begin()); }
+        iterator end()   { return make_iterator(mData.end()); }
+
+    private:
+        iterator make_iterator(typename VectorType::iterator iter)
+        {
+            return iterator(dead_skipper,
+                            strong_iterator(iter, strengthen),
+                            strong_iterator(mData.end(), strengthen));
+        }
+
+        VectorType mData;
+    };
+    using snapshot = snapshot_of<T>;
+
+    // iterate over this for references to each SUBCLASS instance
+    template <typename SUBCLASS>
+    class instance_snapshot_of: public snapshot_of<SUBCLASS>
+    {
+    private:
+        using super = snapshot_of<SUBCLASS>;
+        static T& instance_getter(typename super::iterator::reference pair)
+        {
+            return *pair.second;
+        }
+    public:
+        typedef boost::transform_iterator<decltype(instance_getter)*,
+                                          typename super::iterator> iterator;
+        iterator begin() { return iterator(super::begin(), instance_getter); }
+        iterator end()   { return iterator(super::end(),   instance_getter); }
+
+        void deleteAll()
+        {
+            for (auto it(super::begin()), end(super::end()); it != end; ++it)
+            {
+                delete it->second.get();
+            }
+        }
+    };
+    using instance_snapshot = instance_snapshot_of<T>;
+
+    // iterate over this for each key
+    template <typename SUBCLASS>
+    class key_snapshot_of: public snapshot_of<SUBCLASS>
+    {
+    private:
+        using super = snapshot_of<SUBCLASS>;
+        static KEY key_getter(typename super::iterator::reference pair)
+        {
+            return pair.first;
+        }
+    public:
+        typedef boost::transform_iterator<decltype(key_getter)*,
+                                          typename super::iterator> iterator;
+        iterator begin() { return iterator(super::begin(), key_getter); }
+        iterator end()   { return iterator(super::end(),   key_getter); }
+    };
+    using key_snapshot = key_snapshot_of<T>;
+
+    static ptr_t getInstance(const KEY& k)
+    {
+        return getMap().find(k);
+    }
+
+protected:
+    LLShardedInstanceTracker(const KEY& key):
+        // no-op deleter, as in LLInstanceTracker
+        mSelf(static_cast<T*>(this), [](T*){})
+    {
+        add_(key);
+    }
+public:
+    virtual ~LLShardedInstanceTracker()
+    {
+        // mSelf goes away after this, expiring every weak_ptr to us
+        remove_();
+    }
+protected:
+    virtual void setKey(KEY key)
+    {
+        remove_();
+        add_(key);
+    }
+public:
+    virtual const KEY& getKey() const { return mInstanceKey; }
+
+private:
+    LLShardedInstanceTracker( const LLShardedInstanceTracker& ) = delete;
+    LLShardedInstanceTracker& operator=( const LLShardedInstanceTracker& ) = delete;
+
+    // for logging
+    template <typename K>
+    static std::string report(K key) { return stringize(key); }
+    static std::string report(const std::string& key) { return "'" + key + "'"; }
+    static std::string report(const char* key) { return report(std::string(key)); }
+
+    void add_(const KEY& key)
+    {
+        mInstanceKey = key;
+        bool replace = (KEY_COLLISION_BEHAVIOR == LLInstanceTrackerReplaceOnCollision);
+        if (! getMap().insert(key, mSelf, replace))
+        {
+            LLInstanceTrackerPrivate::logerrs(typeid(*this).name(), " instance with key ",
+                                              report(key), " already exists!");
+        }
+    }
+    void remove_()
+    {
+        getMap().erase(mInstanceKey, mSelf);
+    }
+
+private:
+    // Unlike LLInstanceTracker, the only strong reference to ourselves is
+    // our own; the map holds weak_ptrs. See ShardedMap.
+    ptr_t mSelf;
+    KEY mInstanceKey;
+};
+
+/*****************************************************************************
+*   LLShardedInstanceTracker without key
+*****************************************************************************/
+/// explicit specialization for default case where KEY is void: instances
+/// are keyed internally by address
+template<typename T, EInstanceTrackerAllowKeyCollisions KEY_COLLISION_BEHAVIOR>
+class LLShardedInstanceTracker<T, void, KEY_COLLISION_BEHAVIOR>
+{
+    typedef LLInstanceTrackerPrivate::ShardedMap<const T*, T> InstanceMap;
+
+    static InstanceMap& getMap()
+    {
+        return LLInstanceTrackerPrivate::getShardedStatic<InstanceMap>();
+    }
+
+public:
+    using ptr_t  = std::shared_ptr<T>;
+    using weak_t = std::weak_ptr<T>;
+
+    /// see LLInstanceTracker::getWeak()
+    weak_t getWeak()
+    {
+        return mSelf;
+    }
+
+    static size_t instanceCount()
+    {
+        return getMap().size();
+    }
+
+    // snapshot of std::shared_ptr<SUBCLASS> pointers
+    template <typename SUBCLASS>
+    class snapshot_of
+    {
+        typedef std::vector<weak_t> VectorType;
+        typedef std::shared_ptr<SUBCLASS> strong_ptr;
+        static strong_ptr strengthen(typename VectorType::value_type& ptr)
+        {
+            return std::dynamic_pointer_cast<SUBCLASS>(ptr.lock());
+        }
+        static bool dead_skipper(const strong_ptr& ptr)
+        {
+            return bool(ptr);
+        }
+
+    public:
+        snapshot_of()
+        {
+            mData.reserve(getMap().size());
+            getMap().forEach([this](const T*, const weak_t& ptr)
+                             { mData.emplace_back(ptr); });
+        }
+
+        typedef boost::transform_iterator<decltype(strengthen)*,
+                                          typename VectorType::iterator> strong_iterator;
+        typedef boost::filter_iterator<decltype(dead_skipper)*, strong_iterator> iterator;
+
+        iterator begin() { return make_iterator(mData.begin()); }
+        iterator end()   { return make_iterator(mData.end()); }
+
+    private:
+        iterator make_iterator(typename VectorType::iterator iter)
+        {
+            return iterator(dead_skipper,
+                            strong_iterator(iter, strengthen),
+                            strong_iterator(mData.end(), strengthen));
+        }
+
+        VectorType mData;
+    };
+    using snapshot = snapshot_of<T>;
+
+    // iterate over this for references to each instance
+    template <typename SUBCLASS>
+    class instance_snapshot_of: public snapshot_of<SUBCLASS>
+    {
+    private:
+        using super = snapshot_of<SUBCLASS>;
+
+    public:
+        typedef boost::indirect_iterator<typename super::iterator> iterator;
+        iterator begin() { return iterator(super::begin()); }
+        iterator end()   { return iterator(super::end()); }
+
+        void deleteAll()
+        {
+            for (auto it(super::begin()), end(super::end()); it != end; ++it)
+            {
+                delete it->get();
+            }
+        }
+    };
+    using instance_snapshot = instance_snapshot_of<T>;
+    template <typename SUBCLASS>
+    using key_snapshot_of = instance_snapshot_of<SUBCLASS>;
+
+protected:
+    LLShardedInstanceTracker():
+        mSelf(static_cast<T*>(this), [](T*){})
+    {
+        getMap().insert(mSelf.get(), mSelf, false);
+    }
+public:
+    virtual ~LLShardedInstanceTracker()
+    {
+        getMap().erase(mSelf.get(), mSelf);
+    }
+protected:
+    LLShardedInstanceTracker(const LLShardedInstanceTracker& other):
+        LLShardedInstanceTracker()
+    {}
+
+private:
+    // the only strong reference to ourselves, see ShardedMap
+    ptr_t mSelf;
+};
+
+#endif /* ! defined(LL_LLSHARDEDINSTANCETRACKER_H) */
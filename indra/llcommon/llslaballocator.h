@@ -0,0 +1,303 @@
+/**
+ * @file   llslaballocator.h
+ * @date   2026-10-18
+ * @brief  LLSlabAllocator hands out fixed-size blocks for one class from
+ *         large slabs, with a per-thread cache of free blocks.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLSLABALLOCATOR_H)
+#define LL_LLSLABALLOCATOR_H
+
+#include "llmemory.h"
+#include "llmemtag.h"
+#include "stdtypes.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/**
+ * LLSlabAllocator<T> serves allocations of exactly sizeof(T) bytes, for
+ * render objects that are created and destroyed by the thousand every time
+ * the camera moves (draw infos, faces, drawables, spatial groups).
+ *
+ * Blocks are carved out of slabs of roughly 64KB. A freed block goes on the
+ * freeing thread's cache, and the next allocation on that thread takes it
+ * back, still warm. A thread whose cache runs dry takes a batch of blocks
+ * from the shared free list (or carves a new slab); a thread whose cache
+ * grows too big gives a batch back, so objects created on one thread and
+ * destroyed on another don't pile up. The shared list is the only place a
+ * lock is taken, once per batch.
+ *
+ * Once more than KEEP_FREE_SLABS slabs' worth of blocks sit on the shared
+ * list, it is swept and slabs whose blocks are all on it go back to the
+ * heap, so a spike (a teleport into a dense region) doesn't pin its high
+ * water mark for the rest of the session.
+ *
+ * Requests for any other size, e.g. from a subclass of T, fall through to
+ * ll_aligned_malloc.
+ *
+ * Use LL_SLAB_NEW in the class body to route new and delete here.
+ */
+template<typename T, size_t ALIGNMENT = 16>
+class LLSlabAllocator
+{
+public:
+    static constexpr size_t BLOCK_SIZE = (sizeof(T) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    static constexpr U32 BLOCKS_PER_SLAB = BLOCK_SIZE < 4096 ? U32(65536 / BLOCK_SIZE) : 16;
+    /// blocks moved between a thread cache and the shared list at a time
+    static constexpr U32 BATCH_SIZE = 32;
+    /// free blocks the shared list keeps, in slabs, before it is swept
+    static constexpr U32 KEEP_FREE_SLABS = 4;
+
+    static void* allocate(size_t size)
+    {
+        if (size != sizeof(T))
+        {
+            return ll_aligned_malloc<ALIGNMENT>(size);
+        }
+
+        Shared& shared = getShared();
+        shared.mAllocations.fetch_add(1, std::memory_order_relaxed);
+
+        ThreadCache& cache = getCache();
+        if (!cache.mFree)
+        {
+            shared.refill(cache);
+        }
+        Block* block = cache.mFree;
+        cache.mFree = block->mNext;
+        --cache.mCount;
+        return block;
+    }
+
+    static void deallocate(void* ptr, size_t size)
+    {
+        if (size != sizeof(T))
+        {
+            ll_aligned_free<ALIGNMENT>(ptr);
+            return;
+        }
+
+        ThreadCache& cache = getCache();
+        Block* block = (Block*)ptr;
+        block->mNext = cache.mFree;
+        cache.mFree = block;
+        if (++cache.mCount >= BATCH_SIZE * 2)
+        {
+            getShared().drain(cache, BATCH_SIZE);
+        }
+    }
+
+    struct Stats
+    {
+        U64 mAllocations = 0;   // since startup
+        U64 mSlabsFreed = 0;    // since startup
+        U32 mSlabs = 0;
+        U32 mSharedFree = 0;    // blocks on the shared list, not counting thread caches
+        U64 mRetainedBytes = 0; // held in slabs, whether in use or not
+    };
+
+    static Stats getStats()
+    {
+        Shared& shared = getShared();
+        Stats stats;
+        stats.mAllocations = shared.mAllocations.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(shared.mMutex);
+        stats.mSlabsFreed = shared.mSlabsFreed;
+        stats.mSlabs = (U32)shared.mSlabs.size();
+        stats.mSharedFree = shared.mFreeCount;
+        stats.mRetainedBytes = (U64)stats.mSlabs * BLOCK_SIZE * BLOCKS_PER_SLAB;
+        return stats;
+    }
+
+private:
+    static_assert(BLOCK_SIZE >= sizeof(void*), "block too small for the free list link");
+
+    struct Block
+    {
+        Block* mNext;
+    };
+
+    struct ThreadCache;
+
+    struct Shared
+    {
+        // move up to BATCH_SIZE blocks to cache, carving a new slab if need be
+        void refill(ThreadCache& cache)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mFree)
+            {
+                U8* slab = (U8*)ll_aligned_malloc<ALIGNMENT>(BLOCK_SIZE * BLOCKS_PER_SLAB);
+                mSlabs.push_back(slab);
+                for (U32 i = BLOCKS_PER_SLAB; i-- > 0; )
+                {
+                    Block* block = (Block*)(slab + i * BLOCK_SIZE);
+                    block->mNext = mFree;
+                    mFree = block;
+                }
+                mFreeCount += BLOCKS_PER_SLAB;
+            }
+            for (U32 i = 0; i < BATCH_SIZE && mFree; ++i)
+            {
+                Block* block = mFree;
+                mFree = block->mNext;
+                --mFreeCount;
+                block->mNext = cache.mFree;
+                cache.mFree = block;
+                ++cache.mCount;
+            }
+            // only sweep again after another KEEP_FREE_SLABS slabs' worth
+            // comes back, so a list that hovers around the limit with
+            // nothing to free isn't swept on every drain
+            mSweepAt = llmin(mSweepAt, mFreeCount + KEEP_BLOCKS);
+        }
+
+        // move count blocks (or all of them) from cache to the shared list
+        void drain(ThreadCache& cache, U32 count)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (U32 i = 0; i < count && cache.mFree; ++i)
+            {
+                Block* block = cache.mFree;
+                cache.mFree = block->mNext;
+                --cache.mCount;
+                block->mNext = mFree;
+                mFree = block;
+                ++mFreeCount;
+            }
+            if (mFreeCount > mSweepAt)
+            {
+                sweep();
+                mSweepAt = mFreeCount + KEEP_BLOCKS;
+            }
+        }
+
+        // free slabs whose blocks are all on the shared list, keeping
+        // KEEP_FREE_SLABS slabs' worth of free blocks
+        void sweep()
+        {
+            std::sort(mSlabs.begin(), mSlabs.end());
+            std::vector<U32> free_blocks(mSlabs.size(), 0);
+            for (Block* block = mFree; block; block = block->mNext)
+            {
+                ++free_blocks[slabIndex(block)];
+            }
+
+            U32 freeing = 0;
+            for (size_t i = 0; i < mSlabs.size() && mFreeCount - freeing * BLOCKS_PER_SLAB >= KEEP_BLOCKS + BLOCKS_PER_SLAB; ++i)
+            {
+                if (free_blocks[i] == BLOCKS_PER_SLAB)
+                {
+                    // marks the slab for freeing below
+                    free_blocks[i] = BLOCKS_PER_SLAB + 1;
+                    ++freeing;
+                }
+            }
+            if (!freeing)
+            {
+                return;
+            }
+
+            Block** link = &mFree;
+            while (*link)
+            {
+                if (free_blocks[slabIndex(*link)] > BLOCKS_PER_SLAB)
+                {
+                    *link = (*link)->mNext;
+                    --mFreeCount;
+                }
+                else
+                {
+                    link = &(*link)->mNext;
+                }
+            }
+
+            size_t kept = 0;
+            for (size_t i = 0; i < mSlabs.size(); ++i)
+            {
+                if (free_blocks[i] > BLOCKS_PER_SLAB)
+                {
+                    ll_aligned_free<ALIGNMENT>(mSlabs[i]);
+                }
+                else
+                {
+                    mSlabs[kept++] = mSlabs[i];
+                }
+            }
+            mSlabs.resize(kept);
+            mSlabsFreed += freeing;
+        }
+
+        // index in the sorted mSlabs of the slab holding block
+        size_t slabIndex(const Block* block) const
+        {
+            auto it = std::upper_bound(mSlabs.begin(), mSlabs.end(), (const U8*)block,
+                                       [](const U8* ptr, const U8* slab) { return ptr < slab; });
+            return (it - mSlabs.begin()) - 1;
+        }
+
+        static constexpr U32 KEEP_BLOCKS = KEEP_FREE_SLABS * BLOCKS_PER_SLAB;
+
+        std::mutex mMutex;
+        Block* mFree = nullptr;
+        U32 mFreeCount = 0;
+        U32 mSweepAt = KEEP_BLOCKS;
+        U64 mSlabsFreed = 0;
+        std::vector<U8*> mSlabs;
+        std::atomic<U64> mAllocations{ 0 };
+    };
+
+    struct ThreadCache
+    {
+        ~ThreadCache()
+        {
+            // hand everything back when the thread exits
+            getShared().drain(*this, mCount);
+        }
+
+        Block* mFree = nullptr;
+        U32 mCount = 0;
+    };
+
+    static Shared& getShared()
+    {
+        // Never destroyed: blocks may still be in use, or sitting in the
+        // cache of a thread that exits after static destruction.
+        static Shared* sShared = new Shared;
+        return *sShared;
+    }
+
+    static ThreadCache& getCache()
+    {
+        static thread_local ThreadCache sCache;
+        return sCache;
+    }
+};
+
+/**
+ * Allocate instances of class T from LLSlabAllocator<T>, counting them
+ * under an LLMemTag as LL_ALIGN_NEW_TAGGED does. As with LL_MEMTAG_NEW,
+ * a class deleted through a base pointer needs a virtual destructor.
+ */
+#define LL_SLAB_NEW(T, tag, alignment)                              \
+public:                                                             \
+    void* operator new(size_t size)                                 \
+    {                                                               \
+        void* ptr = LLSlabAllocator<T, alignment>::allocate(size);  \
+        LLMemTag::claim(tag, size);                                 \
+        return ptr;                                                 \
+    }                                                               \
+                                                                    \
+    void operator delete(void* ptr, size_t size)                    \
+    {                                                               \
+        LLMemTag::disclaim(tag, size);                              \
+        LLSlabAllocator<T, alignment>::deallocate(ptr, size);       \
+    }
+
+#endif /* ! defined(LL_LLSLABALLOCATOR_H) */
@@ -0,0 +1,164 @@
+/**
+ * @file   llcorostackpool_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llcorostackpool.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llcorostackpool.h"
+// STL headers
+// external library headers
+#include <boost/fiber/fiber.hpp>
+// other Linden headers
+#include "../test/lltut.h"
+
+namespace
+{
+    // Launch and join 'count' trivial fibers, each touching a little stack
+    template <typename ALLOC_FACTORY>
+    void launch_fibers(int count, ALLOC_FACTORY make_alloc)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            boost::fibers::fiber fiber(boost::fibers::launch::dispatch,
+                                       std::allocator_arg,
+                                       make_alloc(),
+                                       []()
+                                       {
+                                           volatile char scratch[4096];
+                                           scratch[0] = scratch[sizeof(scratch) - 1] = 0;
+                                       });
+            fiber.join();
+        }
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llcorostackpool_data
+    {
+        static constexpr size_t STACK_SIZE = 256 * 1024;
+    };
+    typedef test_group<llcorostackpool_data> llcorostackpool_group;
+    typedef llcorostackpool_group::object object;
+    llcorostackpool_group llcorostackpoolgrp("llcorostackpool");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("size classes");
+        ensure_equals(LLCoroStackPool::sizeClass(1), LLCoroStackPool::MIN_STACK_SIZE);
+        ensure_equals(LLCoroStackPool::sizeClass(LLCoroStackPool::MIN_STACK_SIZE), LLCoroStackPool::MIN_STACK_SIZE);
+        ensure_equals(LLCoroStackPool::sizeClass(LLCoroStackPool::MIN_STACK_SIZE + 1), 2 * LLCoroStackPool::MIN_STACK_SIZE);
+        ensure_equals(LLCoroStackPool::sizeClass(STACK_SIZE), STACK_SIZE);
+        ensure_equals(LLCoroStackPool::sizeClass(STACK_SIZE + 4096), 2 * STACK_SIZE);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("recycling");
+        LLCoroStackPool::ptr_t pool(LLCoroStackPool::create(16 * STACK_SIZE));
+        LLCoroStackPool::StackAllocator alloc(pool->allocator(STACK_SIZE));
+
+        boost::context::stack_context first = alloc.allocate();
+        ensure("stack mapped", first.sp != nullptr);
+        ensure("guard page included", first.size > STACK_SIZE);
+        void* first_sp = first.sp;
+        alloc.deallocate(first);
+
+        LLCoroStackPool::Stats stats(pool->getStats());
+        ensure_equals("cached after release", stats.mCachedStacks, 1U);
+        ensure_equals("none live", stats.mLiveStacks, 0U);
+
+        boost::context::stack_context second = alloc.allocate();
+        ensure("same stack handed back", second.sp == first_sp);
+        stats = pool->getStats();
+        ensure_equals("one fresh allocation", stats.mAllocated, 1ULL);
+        ensure_equals("one reuse", stats.mReused, 1ULL);
+
+        // a different size class doesn't share the free list
+        LLCoroStackPool::StackAllocator small(pool->allocator(LLCoroStackPool::MIN_STACK_SIZE));
+        boost::context::stack_context tiny = small.allocate();
+        ensure("distinct stack for other size class", tiny.sp != second.sp);
+        small.deallocate(tiny);
+        alloc.deallocate(second);
+        ensure_equals("both cached", pool->getStats().mCachedStacks, 2U);
+
+        pool->clear();
+        stats = pool->getStats();
+        ensure_equals("nothing cached after clear", stats.mCachedStacks, 0U);
+        ensure_equals("no bytes cached after clear", stats.mCachedBytes, size_t(0));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("cache cap");
+        LLCoroStackPool::ptr_t pool(LLCoroStackPool::create(0));
+        LLCoroStackPool::StackAllocator alloc(pool->allocator(STACK_SIZE));
+        boost::context::stack_context sctx = alloc.allocate();
+        alloc.deallocate(sctx);
+        LLCoroStackPool::Stats stats(pool->getStats());
+        ensure_equals("nothing cached with zero cap", stats.mCachedStacks, 0U);
+        ensure_equals("stack released", stats.mReleased, 1ULL);
+
+        pool->setMaxCachedBytes(4 * STACK_SIZE);
+        std::vector<boost::context::stack_context> stacks;
+        for (int i = 0; i < 8; ++i)
+        {
+            stacks.push_back(alloc.allocate());
+        }
+        for (auto& stack : stacks)
+        {
+            alloc.deallocate(stack);
+        }
+        stats = pool->getStats();
+        ensure("cached bytes within cap", stats.mCachedBytes <= 4 * STACK_SIZE);
+        ensure("some stacks cached", stats.mCachedStacks > 0);
+
+        pool->setMaxCachedBytes(0);
+        ensure_equals("trimmed to new cap", pool->getStats().mCachedStacks, 0U);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("fibers on pooled stacks outlive the caller's reference");
+        LLCoroStackPool::ptr_t pool(LLCoroStackPool::create(16 * STACK_SIZE));
+        std::weak_ptr<LLCoroStackPool> weak(pool);
+        int ran = 0;
+        boost::fibers::fiber fiber(boost::fibers::launch::post,
+                                   std::allocator_arg,
+                                   pool->allocator(STACK_SIZE),
+                                   [&ran]() { ++ran; });
+        pool.reset();
+        ensure("allocator keeps pool alive", ! weak.expired());
+        fiber.join();
+        ensure_equals("fiber ran", ran, 1);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("launch/exit reuses stacks");
+        const int COUNT = 1000;
+        LLCoroStackPool::ptr_t pool(LLCoroStackPool::create(16 * STACK_SIZE));
+        launch_fibers(COUNT, [&pool]() { return pool->allocator(STACK_SIZE); });
+
+        LLCoroStackPool::Stats stats(pool->getStats());
+        ensure_equals("every launch got a stack", stats.mAllocated + stats.mReused, U64(COUNT));
+        // Terminated fibers are reclaimed lazily by the scheduler, so a few
+        // stacks may be in flight at once, but most launches must reuse one.
+        ensure("most launches reused a stack", stats.mReused > stats.mAllocated);
+    }
+} // namespace tut
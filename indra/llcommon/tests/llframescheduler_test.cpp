@@ -0,0 +1,168 @@
+/**
+ * @file   llframescheduler_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llframescheduler.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llframescheduler.h"
+// STL headers
+// std headers
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+
+namespace
+{
+    const F64 MS = 0.001;
+    const F64 FRAME_60HZ = 1.0 / 60.0;
+
+    // run a frame in which each task uses min(budget, wants[i])
+    void run_frame(LLFrameScheduler& scheduler, F64 target, F64 other, const F64* wants)
+    {
+        F64 busy = other;
+        for (S32 id = 0; id < scheduler.getTaskCount(); ++id)
+        {
+            busy += scheduler.getTask(id).mLastUsed;
+        }
+        scheduler.beginFrame(target, busy);
+        for (S32 id = 0; id < scheduler.getTaskCount(); ++id)
+        {
+            scheduler.reportUsage(id, llmin(scheduler.getBudget(id), wants[id]));
+        }
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llframescheduler_data
+    {
+    };
+    typedef test_group<llframescheduler_data> llframescheduler_group;
+    typedef llframescheduler_group::object object;
+    llframescheduler_group llframeschedulergrp("llframescheduler");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("busy frames get minimums only");
+        LLFrameScheduler scheduler;
+        LLFrameScheduler::task_id_t low = scheduler.addTask("low", 1, 1 * MS, 8 * MS);
+        LLFrameScheduler::task_id_t high = scheduler.addTask("high", 3, 2 * MS, 8 * MS);
+
+        // the rest of the frame already takes longer than the target
+        const F64 wants[] = { 8 * MS, 8 * MS };
+        for (S32 i = 0; i < 20; ++i)
+        {
+            run_frame(scheduler, FRAME_60HZ, 20 * MS, wants);
+        }
+        ensure_equals("low keeps its minimum", scheduler.getBudget(low), 1 * MS);
+        ensure_equals("high keeps its minimum", scheduler.getBudget(high), 2 * MS);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("spare time goes by priority");
+        LLFrameScheduler scheduler;
+        LLFrameScheduler::task_id_t low = scheduler.addTask("low", 1, 1 * MS, 10 * MS);
+        LLFrameScheduler::task_id_t high = scheduler.addTask("high", 3, 1 * MS, 10 * MS);
+
+        // about 15ms of the 16.7ms frame is free, both tasks want 10ms
+        const F64 wants[] = { 10 * MS, 10 * MS };
+        for (S32 i = 0; i < 40; ++i)
+        {
+            run_frame(scheduler, FRAME_60HZ, 0.0, wants);
+        }
+        ensure("high reaches what it wants", scheduler.getBudget(high) >= 9.9 * MS);
+        ensure("low gets the rest", scheduler.getBudget(low) < 6 * MS && scheduler.getBudget(low) >= 1 * MS);
+        ensure("frame not overcommitted",
+               scheduler.getBudget(low) + scheduler.getBudget(high) <= FRAME_60HZ * 0.9 + 0.0001);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("budgets follow the work");
+        LLFrameScheduler scheduler;
+        LLFrameScheduler::task_id_t task = scheduler.addTask("task", 1, 1 * MS, 10 * MS);
+
+        const F64 busy[] = { 10 * MS };
+        for (S32 i = 0; i < 20; ++i)
+        {
+            run_frame(scheduler, FRAME_60HZ, 2 * MS, busy);
+        }
+        ensure("grows while saturated", scheduler.getBudget(task) >= 9.9 * MS);
+
+        const F64 idle[] = { 0.5 * MS };
+        for (S32 i = 0; i < 40; ++i)
+        {
+            run_frame(scheduler, FRAME_60HZ, 2 * MS, idle);
+        }
+        ensure("shrinks back when idle", scheduler.getTask(task).mRequest < 1.1 * MS);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("measured only tasks");
+        LLFrameScheduler scheduler;
+        LLFrameScheduler::task_id_t limited = scheduler.addTask("limited", 1, 1 * MS, 10 * MS);
+        LLFrameScheduler::task_id_t measured = scheduler.addTask("measured", 5, 0.0, 0.0);
+
+        // a measured task's time counts against the frame like any other work
+        const F64 wants[] = { 10 * MS, 12 * MS };
+        for (S32 i = 0; i < 40; ++i)
+        {
+            scheduler.beginFrame(FRAME_60HZ, 12 * MS + scheduler.getTask(limited).mLastUsed + 2 * MS);
+            scheduler.reportUsage(limited, llmin(scheduler.getBudget(limited), wants[0]));
+            scheduler.reportUsage(measured, wants[1]);
+        }
+        ensure_equals("never limited", scheduler.getBudget(measured), 0.0);
+        ensure("limited squeezed by the measured work", scheduler.getBudget(limited) < 2 * MS);
+
+        // no target: everyone gets what they ask for
+        for (S32 i = 0; i < 20; ++i)
+        {
+            run_frame(scheduler, 0.0, 50 * MS, wants);
+        }
+        ensure("unlimited frame", scheduler.getBudget(limited) >= 9.9 * MS);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("minimum set per frame");
+        LLFrameScheduler scheduler;
+        LLFrameScheduler::task_id_t task = scheduler.addTask("task", 1, 0.0, 8 * MS);
+        LLFrameScheduler::task_id_t measured = scheduler.addTask("measured", 1, 0.0, 0.0);
+
+        // other work already over the target: only the minimum is left
+        const F64 wants[] = { 20 * MS, 0.0 };
+        for (S32 i = 0; i < 10; ++i)
+        {
+            run_frame(scheduler, FRAME_60HZ, 30 * MS, wants);
+        }
+        ensure_equals("nothing without a minimum", scheduler.getBudget(task), 0.0);
+
+        scheduler.setMinTime(task, 0.05 / 15.0);
+        ensure_equals("raised at once", scheduler.getBudget(task), 0.05 / 15.0);
+        run_frame(scheduler, FRAME_60HZ, 30 * MS, wants);
+        ensure_equals("kept on busy frames", scheduler.getBudget(task), 0.05 / 15.0);
+
+        scheduler.setMinTime(task, 10 * MS);
+        ensure_equals("maximum raised to match", scheduler.getTask(task).mMaxTime, 10 * MS);
+
+        scheduler.setMinTime(measured, 1 * MS);
+        ensure_equals("measured tasks stay unlimited", scheduler.getTask(measured).mMaxTime, 0.0);
+    }
+} // namespace tut
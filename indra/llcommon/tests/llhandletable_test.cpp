@@ -0,0 +1,162 @@
+/**
+ * @file   llhandletable_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llhandletable.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llhandletable.h"
+// STL headers
+#include <set>
+#include <vector>
+// std headers
+// external library headers
+#include <boost/unordered/unordered_flat_map.hpp>
+// other Linden headers
+#include "../test/lltut.h"
+#include "lluuid.h"
+
+namespace
+{
+    struct Object
+    {
+        LLUUID mID;
+        U32 mValue = 0;
+    };
+
+    typedef LLHandleTable<Object> table_t;
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llhandletable_data
+    {
+    };
+    typedef test_group<llhandletable_data> llhandletable_group;
+    typedef llhandletable_group::object object;
+    llhandletable_group llhandletablegrp("llhandletable");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("add, get, remove");
+        table_t table;
+        Object a, b, c;
+        table_t::Handle ha = table.add(&a);
+        table_t::Handle hb = table.add(&b);
+        table_t::Handle hc = table.add(&c);
+        ensure("not null", !ha.isNull() && !hb.isNull() && !hc.isNull());
+        ensure("distinct", ha != hb && hb != hc && ha != hc);
+        ensure_equals(table.size(), 3);
+        ensure("get a", table.get(ha) == &a);
+        ensure("get b", table.get(hb) == &b);
+        ensure("get c", table.get(hc) == &c);
+        ensure("null handle", table.get(table_t::Handle()) == nullptr);
+
+        ensure("removed", table.remove(ha));
+        ensure("stale", table.get(ha) == nullptr);
+        ensure("already removed", !table.remove(ha));
+        ensure("others unaffected", table.get(hb) == &b && table.get(hc) == &c);
+
+        std::set<Object*> live(table.begin(), table.end());
+        ensure("iterate live only", live.size() == 2 && live.count(&b) && live.count(&c));
+
+        table.clear();
+        ensure("empty", table.empty());
+        ensure("cleared handles stale", table.get(hb) == nullptr && table.get(hc) == nullptr);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("stale handles survive slot reuse");
+        table_t table;
+        Object obj;
+        std::vector<table_t::Handle> stale;
+        // churn enough that slots are reused many times over
+        for (U32 i = 0; i < 100000; ++i)
+        {
+            table_t::Handle handle = table.add(&obj);
+            if (i % 97 == 0)
+            {
+                stale.push_back(handle);
+            }
+            table.remove(handle);
+        }
+        Object other;
+        std::vector<table_t::Handle> live;
+        for (U32 i = 0; i < 2000; ++i)
+        {
+            live.push_back(table.add(&other));
+        }
+        for (const table_t::Handle& handle : stale)
+        {
+            ensure("stale handle resolves to nothing", table.get(handle) == nullptr);
+        }
+        for (const table_t::Handle& handle : live)
+        {
+            ensure("live handle resolves", table.get(handle) == &other);
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("100k objects");
+        const U32 COUNT = 100000;
+
+        std::vector<Object> objects(COUNT);
+        table_t table;
+        boost::unordered_flat_map<LLUUID, Object*> by_id;
+        std::vector<table_t::Handle> handles;
+        std::vector<LLUUID> ids;
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            objects[i].mID.generate();
+            objects[i].mValue = i;
+            by_id[objects[i].mID] = &objects[i];
+            handles.push_back(table.add(&objects[i]));
+            ids.push_back(objects[i].mID);
+        }
+        // look up in an order unrelated to insertion, as picking or
+        // selection would
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            U32 j = (i * 7919) % COUNT;
+            std::swap(handles[i], handles[j]);
+            std::swap(ids[i], ids[j]);
+        }
+
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            auto found = by_id.find(ids[i]);
+            ensure("id found", found != by_id.end());
+            Object* obj = table.get(handles[i]);
+            ensure("handle resolves", obj != NULL);
+            ensure("handle and id agree", obj == found->second);
+        }
+
+        U64 sum_map = 0, sum_table = 0;
+        for (const auto& entry : by_id)
+        {
+            sum_map += entry.second->mValue;
+        }
+        U32 visited = 0;
+        for (Object* obj : table)
+        {
+            sum_table += obj->mValue;
+            ++visited;
+        }
+        ensure_equals("every object visited", visited, COUNT);
+        ensure_equals("same iteration", sum_table, sum_map);
+    }
+} // namespace tut
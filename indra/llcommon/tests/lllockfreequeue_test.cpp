@@ -0,0 +1,191 @@
+/**
+ * @file   lllockfreequeue_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for lllockfreequeue.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "lllockfreequeue.h"
+// STL headers
+#include <vector>
+// std headers
+#include <atomic>
+#include <thread>
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "lluuid.h"
+
+namespace
+{
+    // shaped like a texture fetch priority update
+    struct Update
+    {
+        LLUUID mID;
+        F32 mPriority = 0.f;
+        U32 mProducer = 0;
+        U32 mSerial = 0;
+    };
+
+    typedef LLLockFreeQueue<Update> queue_t;
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct lllockfreequeue_data
+    {
+    };
+    typedef test_group<lllockfreequeue_data> lllockfreequeue_group;
+    typedef lllockfreequeue_group::object object;
+    lllockfreequeue_group lllockfreequeuegrp("lllockfreequeue");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("fifo, full and empty");
+        queue_t queue(5);
+        ensure_equals("rounded up", queue.capacity(), (size_t)8);
+        ensure("starts empty", queue.empty());
+
+        Update update;
+        ensure("pop from empty", !queue.tryPop(update));
+        for (U32 i = 0; i < 8; ++i)
+        {
+            update.mSerial = i;
+            ensure("push", queue.tryPush(update));
+        }
+        ensure("push to full", !queue.tryPush(update));
+
+        // wrap around several times
+        for (U32 i = 0; i < 100; ++i)
+        {
+            ensure("pop", queue.tryPop(update));
+            ensure_equals("in order", update.mSerial, i);
+            update.mSerial = i + 8;
+            ensure("push after pop", queue.tryPush(update));
+        }
+        for (U32 i = 100; i < 108; ++i)
+        {
+            ensure("drain", queue.tryPop(update));
+            ensure_equals("drain in order", update.mSerial, i);
+        }
+        ensure("empty again", queue.empty());
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("several producers, one consumer");
+        const U32 PRODUCERS = 4;
+        const U32 PER_PRODUCER = 200000;
+        queue_t queue(1024);
+
+        std::vector<std::thread> producers;
+        for (U32 p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&queue, p]()
+                {
+                    Update update;
+                    update.mProducer = p;
+                    for (U32 i = 0; i < PER_PRODUCER; ++i)
+                    {
+                        update.mSerial = i;
+                        while (!queue.tryPush(update))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+
+        // every producer's messages must arrive exactly once and in order
+        std::vector<U32> next(PRODUCERS, 0);
+        U32 received = 0;
+        bool in_order = true;
+        Update update;
+        while (received < PRODUCERS * PER_PRODUCER)
+        {
+            if (queue.tryPop(update))
+            {
+                in_order = in_order && (update.mSerial == next[update.mProducer]);
+                next[update.mProducer] = update.mSerial + 1;
+                ++received;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+        ensure("per producer order", in_order);
+        ensure("nothing left", !queue.tryPop(update));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("20k requests");
+        // The texture fetcher's main thread sends a priority update for
+        // every active request every frame while the fetch thread drains them.
+        const U32 REQUESTS = 20000;
+        const U32 FRAMES = 5;
+
+        std::vector<LLUUID> ids(REQUESTS);
+        for (LLUUID& id : ids)
+        {
+            id.generate();
+        }
+
+        queue_t queue(32768);
+        std::atomic<bool> done(false);
+        std::atomic<U32> applied(0);
+        std::atomic<U32> last_frame(0);
+        std::thread consumer([&queue, &done, &applied, &last_frame]()
+            {
+                Update update;
+                while (!done || !queue.empty())
+                {
+                    while (queue.tryPop(update))
+                    {
+                        applied.fetch_add(1, std::memory_order_relaxed);
+                        last_frame.store((U32)update.mPriority, std::memory_order_relaxed);
+                    }
+                    std::this_thread::yield();
+                }
+            });
+
+        Update update;
+        U32 sent = 0;
+        for (U32 frame = 0; frame < FRAMES; ++frame)
+        {
+            update.mPriority = (F32)frame;
+            for (const LLUUID& id : ids)
+            {
+                update.mID = id;
+                // the fetcher falls back to posting when the queue is full;
+                // here just retry so the counts match
+                while (!queue.tryPush(update))
+                {
+                    std::this_thread::yield();
+                }
+                ++sent;
+            }
+        }
+        done = true;
+        consumer.join();
+        ensure_equals("all delivered", applied.load(), sent);
+        ensure_equals("last frame delivered last", last_frame.load(), FRAMES - 1);
+    }
+} // namespace tut
@@ -0,0 +1,168 @@
+/**
+ * @file   llmemory_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for the aligned allocators in llmemory.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llmemory.h"
+// STL headers
+#include <vector>
+// std headers
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <thread>
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "llformat.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+
+namespace
+{
+    bool is_aligned(const void* ptr, size_t alignment)
+    {
+        return (uintptr_t(ptr) & (alignment - 1)) == 0;
+    }
+
+    // Roughly what a region load does on each worker thread: LLSD messages
+    // built, serialized and parsed, and mesh sized geometry buffers churned.
+    // Returns whether every message and buffer came through intact.
+    bool allocation_workload(U32 seed, U32 rounds)
+    {
+        bool intact = true;
+        std::vector<void*> buffers(64, nullptr);
+        for (U32 round = 0; round < rounds; ++round)
+        {
+            LLSD message;
+            for (S32 i = 0; i < 32; ++i)
+            {
+                LLSD entry;
+                entry["id"] = (S32)(seed * 1000 + i);
+                entry["name"] = llformat("object %d", i);
+                entry["scale"] = LLSD::emptyArray();
+                entry["scale"].append(1.0);
+                entry["scale"].append(2.0);
+                message["objects"].append(entry);
+            }
+            std::ostringstream out;
+            LLSDSerialize::toBinary(message, out);
+            std::istringstream in(out.str());
+            LLSD parsed;
+            LLSDSerialize::fromBinary(parsed, in, out.str().size());
+            intact = intact && parsed["objects"].size() == 32
+                && parsed["objects"][31]["id"].asInteger() == (S32)(seed * 1000 + 31);
+
+            for (size_t i = 0; i < buffers.size(); ++i)
+            {
+                size_t slot = (i * 7 + round + seed) % buffers.size();
+                ll_aligned_free_16(buffers[slot]);
+                buffers[slot] = ll_aligned_malloc_16(64 + ((round * 131 + i * 17) % 64) * 1024);
+                intact = intact && is_aligned(buffers[slot], 16);
+            }
+        }
+        for (void* buffer : buffers)
+        {
+            ll_aligned_free_16(buffer);
+        }
+        return intact;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llmemory_data
+    {
+    };
+    typedef test_group<llmemory_data> llmemory_group;
+    typedef llmemory_group::object object;
+    llmemory_group llmemorygrp("llmemory");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("alignment");
+        for (size_t size : { 1, 15, 16, 100, 4096, 100000 })
+        {
+            void* p16 = ll_aligned_malloc_16(size);
+            void* p32 = ll_aligned_malloc_32(size);
+            void* p64 = ll_aligned_malloc_64(size);
+            void* p128 = ll_aligned_malloc<128>(size);
+            ensure("16 byte aligned", is_aligned(p16, 16));
+            ensure("32 byte aligned", is_aligned(p32, 32));
+            ensure("64 byte aligned", is_aligned(p64, 64));
+            ensure("128 byte aligned", is_aligned(p128, 128));
+            ll_aligned_free_16(p16);
+            ll_aligned_free_32(p32);
+            ll_aligned_free_64(p64);
+            ll_aligned_free<128>(p128);
+        }
+        ensure("allocator named", !LLMemory::getAllocatorName().empty());
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("realloc keeps contents");
+        U8* data = (U8*)ll_aligned_malloc_16(100);
+        for (U8 i = 0; i < 100; ++i)
+        {
+            data[i] = i;
+        }
+        data = (U8*)ll_aligned_realloc_16(data, 100000, 100);
+        ensure("grown and aligned", is_aligned(data, 16));
+        bool same = true;
+        for (U8 i = 0; i < 100; ++i)
+        {
+            same = same && data[i] == i;
+        }
+        ensure("contents kept when grown", same);
+
+        data = (U8*)ll_aligned_realloc_16(data, 50, 100000);
+        ensure("shrunk and aligned", is_aligned(data, 16));
+        same = true;
+        for (U8 i = 0; i < 50; ++i)
+        {
+            same = same && data[i] == i;
+        }
+        ensure("contents kept when shrunk", same);
+        ll_aligned_free_16(data);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("multithreaded allocation workload");
+        const U32 THREADS = 8;
+        const U32 ROUNDS = 100;
+
+        std::atomic<U32> intact(0);
+        std::vector<std::thread> threads;
+        for (U32 i = 0; i < THREADS; ++i)
+        {
+            threads.emplace_back([i, &intact]()
+                {
+                    if (allocation_workload(i, ROUNDS))
+                    {
+                        ++intact;
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        ensure_equals("every thread intact", intact.load(), THREADS);
+    }
+} // namespace tut
@@ -0,0 +1,171 @@
+/**
+ * @file   llmemtag_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llmemtag.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llmemtag.h"
+// STL headers
+#include <vector>
+// std headers
+#include <thread>
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "llformat.h"
+#include "llmemory.h"
+#include "llsd.h"
+
+namespace
+{
+    class TaggedBase
+    {
+        LL_MEMTAG_NEW(LLMemTag::OBJECT);
+    public:
+        virtual ~TaggedBase() = default;
+        char mData[64];
+    };
+
+    class TaggedDerived: public TaggedBase
+    {
+    public:
+        char mMore[1000];
+    };
+
+    class AlignedTagged
+    {
+        LL_ALIGN_NEW_TAGGED(LLMemTag::DRAWABLE);
+    public:
+        F32 mData[4];
+    };
+
+    S64 live(LLMemTag::ETag tag)
+    {
+        return LLMemTag::getStats(tag).mLiveBytes;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llmemtag_data
+    {
+    };
+    typedef test_group<llmemtag_data> llmemtag_group;
+    typedef llmemtag_group::object object;
+    llmemtag_group llmemtaggrp("llmemtag");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("scopes");
+        ensure_equals("fallback without scope", LLMemTag::current(LLMemTag::VOLUME), LLMemTag::VOLUME);
+        {
+            LLMemTag::Scope outer(LLMemTag::MESH);
+            ensure_equals("outer scope", LLMemTag::current(LLMemTag::VOLUME), LLMemTag::MESH);
+            {
+                LLMemTag::Scope inner(LLMemTag::AVATAR);
+                ensure_equals("inner scope", LLMemTag::current(LLMemTag::VOLUME), LLMemTag::AVATAR);
+            }
+            ensure_equals("outer scope restored", LLMemTag::current(LLMemTag::VOLUME), LLMemTag::MESH);
+
+            LLMemTag::ETag other_thread = LLMemTag::IMAGE_RAW;
+            std::thread([&other_thread]() { other_thread = LLMemTag::current(LLMemTag::VOLUME); }).join();
+            ensure_equals("scopes are per thread", other_thread, LLMemTag::VOLUME);
+        }
+        ensure_equals("no scope after exit", LLMemTag::current(LLMemTag::VOLUME), LLMemTag::VOLUME);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("claim and disclaim");
+        LLMemTag::Stats before(LLMemTag::getStats(LLMemTag::MESH));
+        LLMemTag::claim(LLMemTag::MESH, 1000);
+        LLMemTag::claim(LLMemTag::MESH, 24);
+        LLMemTag::Stats during(LLMemTag::getStats(LLMemTag::MESH));
+        ensure_equals("live bytes", during.mLiveBytes - before.mLiveBytes, 1024LL);
+        ensure_equals("allocations", during.mAllocations - before.mAllocations, 2ULL);
+
+        LLMemTag::disclaim(LLMemTag::MESH, 1024);
+        LLMemTag::Stats after(LLMemTag::getStats(LLMemTag::MESH));
+        ensure_equals("live bytes released", after.mLiveBytes, before.mLiveBytes);
+        ensure_equals("allocated bytes kept", after.mAllocatedBytes - before.mAllocatedBytes, 1024ULL);
+
+        ensure("every tag has a name", std::string(LLMemTag::getName(LLMemTag::DRAWABLE)) != "unknown");
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("tagged classes");
+        S64 before = live(LLMemTag::OBJECT);
+        TaggedBase* base = new TaggedDerived;
+        ensure_equals("derived size claimed", live(LLMemTag::OBJECT) - before, (S64)sizeof(TaggedDerived));
+        delete base;
+        ensure_equals("derived size disclaimed through base", live(LLMemTag::OBJECT), before);
+
+        before = live(LLMemTag::DRAWABLE);
+        AlignedTagged* aligned = new AlignedTagged;
+        ensure("aligned", (uintptr_t(aligned) & 0xF) == 0);
+        ensure_equals("aligned class claimed", live(LLMemTag::DRAWABLE) - before, (S64)sizeof(AlignedTagged));
+        delete aligned;
+        ensure_equals("aligned class disclaimed", live(LLMemTag::DRAWABLE), before);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("LLSD values");
+        S64 before = live(LLMemTag::SD);
+        {
+            LLSD map;
+            for (S32 i = 0; i < 100; ++i)
+            {
+                map[llformat("key%d", i)] = i;
+            }
+            ensure("LLSD counted", live(LLMemTag::SD) > before);
+        }
+        ensure_equals("LLSD released", live(LLMemTag::SD), before);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("claims from several threads");
+        const U32 THREADS = 4;
+        const U32 COUNT = 100000;
+        LLMemTag::Stats before(LLMemTag::getStats(LLMemTag::MESH));
+
+        std::vector<std::thread> threads;
+        for (U32 t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([]()
+                {
+                    for (U32 i = 0; i < COUNT; ++i)
+                    {
+                        LLMemTag::claim(LLMemTag::MESH, 256);
+                        LLMemTag::disclaim(LLMemTag::MESH, 256);
+                    }
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        LLMemTag::Stats after(LLMemTag::getStats(LLMemTag::MESH));
+        ensure_equals("live bytes balanced", after.mLiveBytes, before.mLiveBytes);
+        ensure_equals("every allocation counted", after.mAllocations - before.mAllocations, (U64)THREADS * COUNT);
+        ensure_equals("allocated bytes counted", after.mAllocatedBytes - before.mAllocatedBytes, (U64)THREADS * COUNT * 256);
+    }
+} // namespace tut
@@ -0,0 +1,143 @@
+/**
+ * @file   llmortician_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llmortician.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llmortician.h"
+// STL headers
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+
+namespace
+{
+    S32 sDeleted = 0;
+
+    // about what a small view frees
+    class Corpse : public LLMortician
+    {
+    public:
+        Corpse(Corpse* take_with = NULL):
+            mTakeWith(take_with),
+            mData(64, 1)
+        {}
+
+        ~Corpse()
+        {
+            ++sDeleted;
+            if (mTakeWith)
+            {
+                mTakeWith->die();
+            }
+        }
+
+    private:
+        Corpse* mTakeWith;
+        std::vector<S32> mData;
+    };
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llmortician_data
+    {
+        llmortician_data()
+        {
+            sDeleted = 0;
+        }
+        ~llmortician_data()
+        {
+            LLMortician::updateClass();
+        }
+    };
+    typedef test_group<llmortician_data> llmortician_group;
+    typedef llmortician_group::object object;
+    llmortician_group llmorticiangrp("llmortician");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("deleted directly after dying");
+        Corpse* first = new Corpse;
+        Corpse* second = new Corpse;
+        Corpse* third = new Corpse;
+        first->die();
+        second->die();
+        third->die();
+        second->die();
+        ensure_equals("dying twice buries once", LLMortician::graveyardCount(), (size_t)3);
+
+        delete second;
+        ensure_equals("out of the graveyard", LLMortician::graveyardCount(), (size_t)2);
+
+        LLMortician::updateClass();
+        ensure_equals("graveyard empty", LLMortician::graveyardCount(), (size_t)0);
+        ensure_equals("all deleted", sDeleted, 3);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("deaths during deletion");
+        Corpse* follower = new Corpse;
+        Corpse* leader = new Corpse(follower);
+        leader->die();
+
+        // a long max_time still stops once the graveyard is empty
+        LLMortician::updateClass(10.f);
+        ensure_equals("both deleted", sDeleted, 2);
+        ensure_equals("graveyard empty", LLMortician::graveyardCount(), (size_t)0);
+
+        // a frame budget that is already spent is 0, not unlimited
+        (new Corpse)->die();
+        (new Corpse)->die();
+        (new Corpse)->die();
+        LLMortician::updateClass(0.f);
+        ensure_equals("one deleted on a spent budget", LLMortician::graveyardCount(), (size_t)2);
+        LLMortician::updateClass(-1.f);
+        ensure_equals("negative deletes the rest", LLMortician::graveyardCount(), (size_t)0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("50000 at once");
+        const S32 COUNT = 50000;
+        const F32 BUDGET = 0.0002f;
+
+        for (S32 i = 0; i < COUNT; ++i)
+        {
+            (new Corpse)->die();
+        }
+        LLMortician::updateClass();
+        ensure_equals("all deleted", sDeleted, COUNT);
+
+        sDeleted = 0;
+        for (S32 i = 0; i < COUNT; ++i)
+        {
+            (new Corpse)->die();
+        }
+        LLMortician::updateClass(0.f);
+        ensure("a spent budget still deletes one", sDeleted >= 1);
+        ensure("a spent budget stops early", sDeleted < COUNT);
+
+        while (LLMortician::graveyardCount() > 0)
+        {
+            LLMortician::updateClass(BUDGET);
+        }
+        ensure_equals("all deleted over frames", sDeleted, COUNT);
+    }
+} // namespace tut
@@ -0,0 +1,202 @@
+/**
+ * @file   llshardedinstancetracker_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llshardedinstancetracker and llepoch.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llshardedinstancetracker.h"
+// STL headers
+#include <set>
+#include <string>
+#include <vector>
+// std headers
+#include <atomic>
+#include <thread>
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "llformat.h"
+
+namespace
+{
+    struct Sharded: public LLShardedInstanceTracker<Sharded, std::string>
+    {
+        Sharded(const std::string& name):
+            LLShardedInstanceTracker<Sharded, std::string>(name)
+        {}
+    };
+
+    struct ShardedUnkeyed: public LLShardedInstanceTracker<ShardedUnkeyed>
+    {
+    };
+
+    struct Replacing: public LLShardedInstanceTracker<Replacing, std::string, LLInstanceTrackerReplaceOnCollision>
+    {
+        Replacing(const std::string& name):
+            LLShardedInstanceTracker<Replacing, std::string, LLInstanceTrackerReplaceOnCollision>(name)
+        {}
+    };
+
+    struct Counted
+    {
+        Counted(std::atomic<S32>& live): mLive(live) { ++mLive; }
+        ~Counted() { --mLive; }
+        std::atomic<S32>& mLive;
+    };
+
+    const U32 THREADS = 8;
+    const U32 KEYS = 200;
+
+    // Each thread looks up the fixed instances, and every sixteenth
+    // iteration also creates and destroys an instance of its own.
+    void contend(U32 iterations)
+    {
+        std::vector<std::unique_ptr<Sharded>> fixed;
+        for (U32 i = 0; i < KEYS; ++i)
+        {
+            fixed.emplace_back(new Sharded(llformat("fixed%u", i)));
+        }
+
+        std::atomic<U32> found{ 0 };
+        std::vector<std::thread> threads;
+        for (U32 t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([t, iterations, &found]()
+            {
+                U32 hits = 0;
+                for (U32 i = 0; i < iterations; ++i)
+                {
+                    hits += Sharded::getInstance(llformat("fixed%u", (i * 7 + t) % KEYS)) ? 1 : 0;
+                    if (i % 16 == 0)
+                    {
+                        Sharded temp(llformat("temp%u_%u", t, i));
+                    }
+                }
+                found += hits;
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        tut::ensure_equals("lookups all found", found.load(), THREADS * iterations);
+        tut::ensure("temporaries removed", !Sharded::getInstance(llformat("temp%u_%u", THREADS - 1, 0)));
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llshardedinstancetracker_data
+    {
+    };
+    typedef test_group<llshardedinstancetracker_data> llshardedinstancetracker_group;
+    typedef llshardedinstancetracker_group::object object;
+    llshardedinstancetracker_group llshardedinstancetrackergrp("llshardedinstancetracker");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("keyed lookup and snapshots");
+        ensure_equals(Sharded::instanceCount(), 0);
+        {
+            Sharded one("one");
+            Sharded two("two");
+            ensure_equals(Sharded::instanceCount(), 2);
+            ensure("found one", Sharded::getInstance("one").get() == &one);
+            ensure("found two", Sharded::getInstance("two").get() == &two);
+            ensure("no three", !Sharded::getInstance("three"));
+            ensure_equals(one.getKey(), "one");
+
+            std::set<std::string> keys;
+            for (const auto& key : Sharded::key_snapshot())
+            {
+                keys.insert(key);
+            }
+            ensure_equals(keys.size(), 2);
+            ensure("keys", keys.count("one") && keys.count("two"));
+
+            // instances deleted after a snapshot is taken are skipped
+            std::unique_ptr<Sharded> three(new Sharded("three"));
+            Sharded::instance_snapshot snapshot;
+            three.reset();
+            size_t visited = 0;
+            for (auto& instance : snapshot)
+            {
+                ensure("live instance", &instance == &one || &instance == &two);
+                ++visited;
+            }
+            ensure_equals("deleted instance not visited", visited, 2);
+        }
+        ensure_equals(Sharded::instanceCount(), 0);
+        ensure("gone", !Sharded::getInstance("one"));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("unkeyed and collisions");
+        {
+            ShardedUnkeyed a, b;
+            ensure_equals(ShardedUnkeyed::instanceCount(), 2);
+            std::set<ShardedUnkeyed*> seen;
+            for (auto& instance : ShardedUnkeyed::instance_snapshot())
+            {
+                seen.insert(&instance);
+            }
+            ensure("both seen", seen.size() == 2 && seen.count(&a) && seen.count(&b));
+        }
+        ensure_equals(ShardedUnkeyed::instanceCount(), 0);
+
+        Replacing first("same");
+        {
+            Replacing second("same");
+            ensure("replaced", Replacing::getInstance("same").get() == &second);
+        }
+        ensure("replacement removed", !Replacing::getInstance("same"));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("epoch reclamation");
+        std::atomic<S32> live{ 0 };
+        Counted* counted = new Counted(live);
+        {
+            LLEpoch::Guard guard;
+            LLEpoch::retire(counted);
+            for (U32 i = 0; i < 4; ++i)
+            {
+                LLEpoch::collect();
+            }
+            ensure_equals("not destroyed while guarded", live.load(), 1);
+        }
+        for (U32 i = 0; i < 4; ++i)
+        {
+            LLEpoch::collect();
+        }
+        ensure_equals("destroyed once unguarded", live.load(), 0);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("contention");
+        contend(20000);
+        for (U32 i = 0; i < 4; ++i)
+        {
+            LLEpoch::collect();
+        }
+        ensure_equals("retired maps reclaimed", LLEpoch::getPending(), (size_t)0);
+    }
+} // namespace tut
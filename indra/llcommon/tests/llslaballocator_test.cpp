@@ -0,0 +1,215 @@
+/**
+ * @file   llslaballocator_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llslaballocator.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llslaballocator.h"
+// STL headers
+#include <set>
+#include <vector>
+// std headers
+#include <thread>
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+
+namespace
+{
+    class Slabbed
+    {
+        LL_SLAB_NEW(Slabbed, LLMemTag::DRAWABLE, 16);
+    public:
+        virtual ~Slabbed() = default;
+        F32 mData[24];
+    };
+
+    class SlabbedChild: public Slabbed
+    {
+    public:
+        char mMore[100];
+    };
+
+    class Aligned64
+    {
+        LL_SLAB_NEW(Aligned64, LLMemTag::DRAWABLE, 64);
+    public:
+        char mData[40];
+    };
+
+    template<typename T>
+    void churn(U32 count)
+    {
+        std::vector<T*> objects(512);
+        for (U32 i = 0; i < count; i += (U32)objects.size())
+        {
+            for (auto& object : objects)
+            {
+                object = new T;
+            }
+            // free in a different order than allocated, as a rebuild does
+            for (size_t j = 0; j < objects.size(); j += 2)
+            {
+                delete objects[j];
+            }
+            for (size_t j = 1; j < objects.size(); j += 2)
+            {
+                delete objects[j];
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llslaballocator_data
+    {
+    };
+    typedef test_group<llslaballocator_data> llslaballocator_group;
+    typedef llslaballocator_group::object object;
+    llslaballocator_group llslaballocatorgrp("llslaballocator");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("distinct aligned blocks, reused once freed");
+        std::vector<Slabbed*> objects;
+        std::set<Slabbed*> seen;
+        for (U32 i = 0; i < 1000; ++i)
+        {
+            objects.push_back(new Slabbed);
+            ensure("aligned", (uintptr_t(objects.back()) & 0xF) == 0);
+            ensure("distinct", seen.insert(objects.back()).second);
+        }
+
+        Slabbed* last = objects.back();
+        delete last;
+        objects.pop_back();
+        Slabbed* again = new Slabbed;
+        ensure("freed block handed out next", again == last);
+        objects.push_back(again);
+
+        for (Slabbed* object : objects)
+        {
+            delete object;
+        }
+
+        Aligned64* wide = new Aligned64;
+        ensure("64 byte aligned", (uintptr_t(wide) & 0x3F) == 0);
+        delete wide;
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("subclasses go to the heap");
+        U64 before = LLSlabAllocator<Slabbed, 16>::getStats().mAllocations;
+        S64 live = LLMemTag::getStats(LLMemTag::DRAWABLE).mLiveBytes;
+
+        Slabbed* child = new SlabbedChild;
+        ensure_equals("not counted as a slab allocation", LLSlabAllocator<Slabbed, 16>::getStats().mAllocations, before);
+        ensure_equals("claimed at full size", LLMemTag::getStats(LLMemTag::DRAWABLE).mLiveBytes - live, (S64)sizeof(SlabbedChild));
+        delete child;
+        ensure_equals("disclaimed through base", LLMemTag::getStats(LLMemTag::DRAWABLE).mLiveBytes, live);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("blocks freed on another thread");
+        std::vector<Slabbed*> objects;
+        for (U32 i = 0; i < 5000; ++i)
+        {
+            objects.push_back(new Slabbed);
+        }
+        U32 slabs = LLSlabAllocator<Slabbed, 16>::getStats().mSlabs;
+
+        std::thread([&objects]()
+                    {
+                        for (Slabbed* object : objects)
+                        {
+                            delete object;
+                        }
+                    }).join();
+
+        // the other thread's cache went back to the shared list when it
+        // exited, so allocating as many again needs no new slab
+        for (Slabbed*& object : objects)
+        {
+            object = new Slabbed;
+        }
+        ensure_equals("no new slabs", LLSlabAllocator<Slabbed, 16>::getStats().mSlabs, slabs);
+        for (Slabbed* object : objects)
+        {
+            delete object;
+        }
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("slabs go back to the heap after a spike");
+        typedef LLSlabAllocator<Slabbed, 16> allocator_t;
+        std::vector<Slabbed*> objects;
+        for (U32 i = 0; i < allocator_t::BLOCKS_PER_SLAB * 40; ++i)
+        {
+            objects.push_back(new Slabbed);
+        }
+        allocator_t::Stats peak = allocator_t::getStats();
+        ensure("at least 40 slabs", peak.mSlabs >= 40);
+        ensure_equals("retained bytes", peak.mRetainedBytes,
+                      (U64)peak.mSlabs * allocator_t::BLOCK_SIZE * allocator_t::BLOCKS_PER_SLAB);
+
+        for (Slabbed* object : objects)
+        {
+            delete object;
+        }
+        allocator_t::Stats after = allocator_t::getStats();
+        // what's left: the free blocks the shared list keeps, plus slabs
+        // with a block still on this thread's cache
+        ensure("slabs freed", after.mSlabsFreed > peak.mSlabsFreed);
+        ensure("back near the floor", after.mSlabs <= allocator_t::KEEP_FREE_SLABS + 4);
+        ensure("retained bytes dropped", after.mRetainedBytes < peak.mRetainedBytes / 4);
+
+        // and the survivors still allocate
+        for (Slabbed*& object : objects)
+        {
+            object = new Slabbed;
+        }
+        std::set<Slabbed*> seen(objects.begin(), objects.end());
+        ensure_equals("distinct after freeing slabs", seen.size(), objects.size());
+        for (Slabbed* object : objects)
+        {
+            delete object;
+        }
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("churn reuses blocks");
+        typedef LLSlabAllocator<Slabbed, 16> allocator_t;
+        const U32 COUNT = 512 * 200;
+
+        churn<Slabbed>(512);
+        allocator_t::Stats before = allocator_t::getStats();
+        churn<Slabbed>(COUNT);
+        allocator_t::Stats after = allocator_t::getStats();
+
+        ensure_equals("every allocation from a slab", after.mAllocations - before.mAllocations, (U64)COUNT);
+        // 512 live at a time fit in the slabs already there
+        ensure_equals("no new slabs", after.mSlabs, before.mSlabs);
+        ensure_equals("none freed either", after.mSlabsFreed, before.mSlabsFreed);
+        ensure_equals("retained bytes unchanged", after.mRetainedBytes, before.mRetainedBytes);
+    }
+} // namespace tut
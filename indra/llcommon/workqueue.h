@@ -14,8 +14,8 @@
 
 #include "llcoros.h"
 #include "llexception.h"
-#include "llinstancetracker.h"
 #include "llinstancetrackersubclass.h"
+#include "llshardedinstancetracker.h"
 #include "threadsafeschedule.h"
 #include <chrono>
 #include <exception>                // std::current_exception
@@ -30,11 +30,13 @@ namespace LL
 *****************************************************************************/
     /**
      * A typical WorkQueue has a string name that can be used to find it.
+     * Queues are looked up by name from every thread that posts work, so
+     * they're tracked with LLShardedInstanceTracker.
      */
-    class WorkQueueBase: public LLInstanceTracker<WorkQueueBase, std::string>
+    class WorkQueueBase: public LLShardedInstanceTracker<WorkQueueBase, std::string>
     {
     private:
-        using super = LLInstanceTracker<WorkQueueBase, std::string>;
+        using super = LLShardedInstanceTracker<WorkQueueBase, std::string>;
 
     public:
         using Work = std::function<void()>;
@@ -249,6 +249,14 @@ void HttpOpRequest::stageFromActive(HttpService * service)
     mCurlTemp = NULL;
     mCurlTempLen = 0;
 
+    // Give the handler a chance to process the body while we're
+    // still on the worker thread.  The reply queue's lock orders
+    // anything written here before the notifier runs.
+    if (mUserHandler)
+    {
+        mUserHandler->onReplyReady(getHandle(), mStatus, mReplyBody, mReplyConType);
+    }
+
     addAsReply();
 }
 
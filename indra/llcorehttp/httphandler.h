@@ -35,6 +35,7 @@ namespace LLCore
 {
 
 class HttpResponse;
+class BufferArray;
 
 
 /// HttpHandler defines an interface used by the library to
@@ -83,6 +84,28 @@ public:
     ///
     virtual void onCompleted(HttpHandle handle, HttpResponse * response) = 0;
 
+    /// Optional method invoked on the HTTP worker thread once a
+    /// request has finished (including any retries) and before its
+    /// reply is queued for delivery to @see onCompleted().  Handlers
+    /// may override it to do expensive body processing, such as
+    /// deserialization, away from the thread calling @see update().
+    /// Handlers that are shared by several requests must synchronize
+    /// any state written here themselves.  The default does nothing.
+    ///
+    /// @param  handle          Identifier of the completed request.
+    /// @param  status          Final status of the request.
+    /// @param  body            Response body, may be NULL.  The
+    ///                         body must not be modified or
+    ///                         retained beyond this call.
+    /// @param  content_type    Content-Type of the response, may
+    ///                         be empty.
+    ///
+    virtual void onReplyReady(HttpHandle handle,
+                              const HttpStatus & status,
+                              const BufferArray * body,
+                              const std::string & content_type)
+        {}
+
 };  // end class HttpHandler
 
 
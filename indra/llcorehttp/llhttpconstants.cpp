@@ -106,6 +106,7 @@ const std::string HTTP_IN_HEADER_USER_AGENT("user-agent");
 const std::string HTTP_IN_HEADER_X_FORWARDED_FOR("x-forwarded-for");
 
 const std::string HTTP_CONTENT_LLSD_XML("application/llsd+xml");
+const std::string HTTP_CONTENT_LLSD_BINARY("application/llsd+binary");
 const std::string HTTP_CONTENT_OCTET_STREAM("application/octet-stream");
 const std::string HTTP_CONTENT_OGG_STREAM("application/ogg");
 const std::string HTTP_CONTENT_VND_LL_MESH("application/vnd.ll.mesh");
@@ -35,9 +35,12 @@
 #include "_httpservice.h"
 #include "_httprequestqueue.h"
 
+#include "llcorehttputil.h"
+
 #include <curl/curl.h>
 #include <boost/regex.hpp>
 #include <sstream>
+#include <thread>
 
 #include "llcorehttp_test.h"
 
@@ -185,6 +188,33 @@ public:
     regex_container_t mHeadersDisallowed;
 };
 
+// Records what onReplyReady() saw on the worker thread.
+class TestReplyReadyHandler : public TestHandler2
+{
+public:
+    TestReplyReadyHandler(HttpRequestTestData * state,
+                          const std::string & name)
+        : TestHandler2(state, name),
+          mReplyReadyCalls(0),
+          mParsed(false)
+        {}
+
+    virtual void onReplyReady(HttpHandle handle, const HttpStatus & status,
+                              const BufferArray * body, const std::string & content_type)
+        {
+            ++mReplyReadyCalls;
+            mReplyThread = std::this_thread::get_id();
+            mContentType = content_type;
+            mParsed = LLCoreHttpUtil::bodyToLLSD(body, content_type, false, mBody);
+        }
+
+    int mReplyReadyCalls;
+    std::thread::id mReplyThread;
+    std::string mContentType;
+    bool mParsed;
+    LLSD mBody;
+};
+
 typedef test_group<HttpRequestTestData> HttpRequestTestGroupType;
 typedef HttpRequestTestGroupType::object HttpRequestTestObjectType;
 HttpRequestTestGroupType HttpRequestTestGroup("HttpRequest Tests");
@@ -3012,6 +3042,118 @@ void HttpRequestTestObjectType::test<23>()
 }
 
 
+template <> template <>
+void HttpRequestTestObjectType::test<24>()
+{
+    ScopedCurlInit ready;
+
+    set_test_name("HttpRequest GET with binary LLSD negotiation parsed on worker thread");
+
+    // Handler can be stack-allocated *if* there are no dangling
+    // references to it after completion of this method.
+    TestReplyReadyHandler handler(this, "handler");
+    LLCore::HttpHandler::ptr_t handlerp(&handler, NoOpDeletor);
+    const std::thread::id main_thread(std::this_thread::get_id());
+    mHandlerCalls = 0;
+
+    HttpRequest * req = NULL;
+
+    try
+    {
+        // Get singletons created
+        HttpRequest::createService();
+
+        // Start threading early so that thread memory is invariant
+        // over the test.
+        HttpRequest::startThread();
+
+        // create a new ref counted object with an implicit reference
+        req = new HttpRequest();
+
+        const std::string accepts[] = { HTTP_CONTENT_LLSD_BINARY + ", " + HTTP_CONTENT_LLSD_XML + ";q=0.5",
+                                        HTTP_CONTENT_LLSD_XML };
+        const std::string expected[] = { HTTP_CONTENT_LLSD_BINARY, HTTP_CONTENT_LLSD_XML };
+        for (int i(0); i < 2; ++i)
+        {
+            HttpHeaders::ptr_t headers(new HttpHeaders);
+            headers->append(HTTP_OUT_HEADER_ACCEPT, accepts[i]);
+
+            handler.mReplyReadyCalls = 0;
+            handler.mParsed = false;
+            handler.mBody.clear();
+            handler.mCheckContentType = expected[i];
+
+            // Issue a GET that succeeds
+            mStatus = HttpStatus(200);
+            mHandlerCalls = 0;
+            HttpHandle handle = req->requestGet(HttpRequest::DEFAULT_POLICY_ID,
+                                                get_base_url(),
+                                                HttpOptions::ptr_t(),
+                                                headers,
+                                                handlerp);
+            ensure("Valid handle returned for request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+            // Run the notification pump.
+            int count(0);
+            int limit(LOOP_COUNT_SHORT);
+            while (count++ < limit && mHandlerCalls < 1)
+            {
+                req->update(1000000);
+                usleep(LOOP_SLEEP_INTERVAL);
+            }
+            ensure("Request executed in reasonable time", count < limit);
+            ensure("One handler invocation for request", mHandlerCalls == 1);
+            ensure("One reply-ready invocation for request", handler.mReplyReadyCalls == 1);
+            ensure("Reply-ready invoked off the caller's thread", handler.mReplyThread != main_thread);
+            ensure_equals("Negotiated content type", handler.mContentType, expected[i]);
+            ensure("Body parsed on worker thread", handler.mParsed);
+            ensure_equals("Parsed body content", handler.mBody["reply"].asString(), std::string("success"));
+        }
+        handler.mCheckContentType.clear();
+
+        // Okay, request a shutdown of the servicing thread
+        mStatus = HttpStatus();
+        mHandlerCalls = 0;
+        HttpHandle handle = req->requestStopThread(handlerp);
+        ensure("Valid handle returned for second request", handle != LLCORE_HTTP_HANDLE_INVALID);
+
+        // Run the notification pump again
+        int count = 0;
+        int limit = LOOP_COUNT_LONG;
+        while (count++ < limit && mHandlerCalls < 1)
+        {
+            req->update(1000000);
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Second request executed in reasonable time", count < limit);
+        ensure("Second handler invocation", mHandlerCalls == 1);
+
+        // See that we actually shutdown the thread
+        count = 0;
+        limit = LOOP_COUNT_SHORT;
+        while (count++ < limit && ! HttpService::isStopped())
+        {
+            usleep(LOOP_SLEEP_INTERVAL);
+        }
+        ensure("Thread actually stopped running", HttpService::isStopped());
+
+        // release the request object
+        delete req;
+        req = NULL;
+
+        // Shut down service
+        HttpRequest::destroyService();
+    }
+    catch (...)
+    {
+        stop_thread(req);
+        delete req;
+        HttpRequest::destroyService();
+        throw;
+    }
+}
+
+
 }  // end namespace tut
 
 namespace
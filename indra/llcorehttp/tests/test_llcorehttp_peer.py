@@ -77,6 +77,9 @@ class TestHTTPRequestHandler(BaseHTTPRequestHandler):
     -- '/503/5/'            "Retry-After: aklsjflajfaklsfaklfasfklasdfklasdgahsdhgasdiogaioshdgo"
     -- '/503/6/'            "Retry-After: 1 2 3 4 5 6 7 8 9 10"
 
+    Successful replies are LLSD XML unless the request's Accept
+    header asks for application/llsd+binary.
+
     Some combinations make no sense, there's no effort to protect
     you from that.
     """
@@ -223,12 +226,19 @@ class TestHTTPRequestHandler(BaseHTTPRequestHandler):
             data = data.copy()          # we're going to modify
             # Ensure there's a "reply" key in data, even if there wasn't before
             data["reply"] = data.get("reply", llsd.LLSD("success"))
-            response = llsd.format_xml(data)
+            # Honor binary LLSD content negotiation the way capability
+            # servers do, falling back to XML.
+            if "application/llsd+binary" in self.headers.get("Accept", ""):
+                response = llsd.format_binary(data)
+                content_type = "application/llsd+binary"
+            else:
+                response = llsd.format_xml(data)
+                content_type = "application/llsd+xml"
             debug("success: %s", response)
             self.send_response(200)
             if "/reflect/" in self.path:
                 self.reflect_headers()
-            self.send_header("Content-type", "application/llsd+xml")
+            self.send_header("Content-type", content_type)
             self.send_header("Content-Length", str(len(response)))
             self.send_header("X-LL-Special", "Mememememe")
             self.end_headers()
@@ -0,0 +1,424 @@
+/**
+ * @file llcachecompressor.cpp
+ * @brief Transparent zstd compression of disk cache assets.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llcachecompressor.h"
+
+#include "lldir.h"
+#include "llfile.h"
+
+#include <zstd.h>
+#include <zdict.h>
+
+namespace
+{
+    const U32 COMPRESSED_MAGIC = 0x435a4c4c;            // "LLZC"
+    const S32 DEFAULT_COMPRESSION_LEVEL = 3;
+
+    // assets smaller than this aren't worth the header
+    const size_t MIN_COMPRESS_SIZE = 64;
+    // refuse to inflate anything claiming to be larger than this (corrupt header)
+    const size_t MAX_UNCOMPRESSED_SIZE = 64 * 1024 * 1024;
+
+    // dictionary training parameters
+    const size_t DICTIONARY_CAPACITY = 32 * 1024;
+    const size_t MAX_SAMPLE_SIZE = 32 * 1024;           // only the start of larger assets is sampled
+    const size_t MIN_SAMPLES = 128;
+    const size_t MAX_SAMPLES = 2048;
+    const size_t MAX_SAMPLE_BYTES = 4 * 1024 * 1024;
+
+    struct CCtxDeleter
+    {
+        void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+    };
+
+    struct DCtxDeleter
+    {
+        void operator()(ZSTD_DCtx* ctx) const { ZSTD_freeDCtx(ctx); }
+    };
+
+    // one context per thread, reused across calls
+    ZSTD_CCtx* get_cctx()
+    {
+        thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx(ZSTD_createCCtx());
+        return ctx.get();
+    }
+
+    ZSTD_DCtx* get_dctx()
+    {
+        thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx(ZSTD_createDCtx());
+        return ctx.get();
+    }
+
+    U32 read_u32(const U8* src)
+    {
+        U32 value;
+        memcpy(&value, src, sizeof(value));
+        return value;
+    }
+
+    void write_u32(U8* dst, U32 value)
+    {
+        memcpy(dst, &value, sizeof(value));
+    }
+
+    bool valid_type(LLAssetType::EType at)
+    {
+        return at >= 0 && at < LLAssetType::AT_COUNT;
+    }
+}
+
+struct LLCacheCompressor::Dictionary
+{
+    Dictionary(const std::vector<U8>& data, S32 level):
+        mID(ZDICT_getDictID(data.data(), data.size())),
+        mCDict(ZSTD_createCDict(data.data(), data.size(), level)),
+        mDDict(ZSTD_createDDict(data.data(), data.size()))
+    {
+    }
+
+    ~Dictionary()
+    {
+        ZSTD_freeCDict(mCDict);
+        ZSTD_freeDDict(mDDict);
+    }
+
+    bool isValid() const { return mID != 0 && mCDict && mDDict; }
+
+    U32 mID;
+    ZSTD_CDict* mCDict;
+    ZSTD_DDict* mDDict;
+};
+
+LLCacheCompressor::LLCacheCompressor():
+    mEnabled(false),
+    mLevel(DEFAULT_COMPRESSION_LEVEL)
+{
+}
+
+LLCacheCompressor::~LLCacheCompressor()
+{
+}
+
+void LLCacheCompressor::init(const std::string& dict_dir)
+{
+    reset();
+    mDictDir = dict_dir;
+
+    for (S32 i = 0; i < LLAssetType::AT_COUNT; ++i)
+    {
+        LLAssetType::EType at = (LLAssetType::EType)i;
+        if (isCompressibleType(at))
+        {
+            std::string filename = dictionaryFilename(at);
+            if (LLFile::isfile(filename))
+            {
+                loadDictionary(at, filename);
+            }
+        }
+    }
+}
+
+//static
+bool LLCacheCompressor::isCompressibleType(LLAssetType::EType at)
+{
+    switch (at)
+    {
+    case LLAssetType::AT_NOTECARD:
+    case LLAssetType::AT_LSL_TEXT:
+    case LLAssetType::AT_ANIMATION:
+    case LLAssetType::AT_GESTURE:
+    case LLAssetType::AT_CLOTHING:
+    case LLAssetType::AT_BODYPART:
+    case LLAssetType::AT_LANDMARK:
+    case LLAssetType::AT_SETTINGS:
+    case LLAssetType::AT_MATERIAL:
+        return true;
+    default:
+        // textures, sounds and meshes are already compressed
+        return false;
+    }
+}
+
+//static
+bool LLCacheCompressor::isCompressed(const U8* data, size_t size)
+{
+    return size >= HEADER_SIZE && read_u32(data) == COMPRESSED_MAGIC;
+}
+
+//static
+size_t LLCacheCompressor::getUncompressedSize(const U8* header)
+{
+    return read_u32(header + 4);
+}
+
+bool LLCacheCompressor::compress(LLAssetType::EType at, const U8* src, size_t size, std::vector<U8>& out)
+{
+    if (!mEnabled || !isCompressibleType(at) || size < MIN_COMPRESS_SIZE || size > MAX_UNCOMPRESSED_SIZE)
+    {
+        return false;
+    }
+
+    dict_ptr_t dict = getDictionary(at);
+
+    std::vector<U8> buffer(HEADER_SIZE + ZSTD_compressBound(size));
+    size_t compressed_size;
+    if (dict)
+    {
+        compressed_size = ZSTD_compress_usingCDict(get_cctx(), buffer.data() + HEADER_SIZE, buffer.size() - HEADER_SIZE,
+                                                   src, size, dict->mCDict);
+    }
+    else
+    {
+        compressed_size = ZSTD_compressCCtx(get_cctx(), buffer.data() + HEADER_SIZE, buffer.size() - HEADER_SIZE,
+                                            src, size, mLevel);
+    }
+
+    if (ZSTD_isError(compressed_size))
+    {
+        LL_WARNS("DiskCache") << "Failed to compress " << LLAssetType::lookup(at) << " asset: "
+                              << ZSTD_getErrorName(compressed_size) << LL_ENDL;
+        return false;
+    }
+
+    if (HEADER_SIZE + compressed_size >= size)
+    {
+        // not worth it, keep the asset as is
+        return false;
+    }
+
+    write_u32(buffer.data(), COMPRESSED_MAGIC);
+    write_u32(buffer.data() + 4, (U32)size);
+    write_u32(buffer.data() + 8, dict ? dict->mID : 0);
+    buffer.resize(HEADER_SIZE + compressed_size);
+    out.swap(buffer);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mStats.mFilesCompressed;
+    mStats.mBytesIn += size;
+    mStats.mBytesOut += out.size();
+    return true;
+}
+
+bool LLCacheCompressor::decompress(LLAssetType::EType at, const U8* src, size_t size, std::vector<U8>& out)
+{
+    bool success = false;
+    if (isCompressed(src, size))
+    {
+        size_t uncompressed_size = getUncompressedSize(src);
+        U32 dict_id = read_u32(src + 8);
+
+        dict_ptr_t dict;
+        if (dict_id != 0)
+        {
+            dict = getDictionary(at);
+        }
+
+        if (uncompressed_size <= MAX_UNCOMPRESSED_SIZE && (dict_id == 0 || (dict && dict->mID == dict_id)))
+        {
+            out.resize(uncompressed_size);
+            size_t result;
+            if (dict)
+            {
+                result = ZSTD_decompress_usingDDict(get_dctx(), out.data(), out.size(),
+                                                    src + HEADER_SIZE, size - HEADER_SIZE, dict->mDDict);
+            }
+            else
+            {
+                result = ZSTD_decompressDCtx(get_dctx(), out.data(), out.size(), src + HEADER_SIZE, size - HEADER_SIZE);
+            }
+            success = !ZSTD_isError(result) && result == uncompressed_size;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (success)
+    {
+        ++mStats.mFilesDecompressed;
+    }
+    else
+    {
+        ++mStats.mDecompressFailures;
+        out.clear();
+    }
+    return success;
+}
+
+void LLCacheCompressor::addSample(LLAssetType::EType at, const U8* data, size_t size)
+{
+    if (!mEnabled || !isCompressibleType(at) || size < MIN_COMPRESS_SIZE)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    SampleSet& samples = mSamples[at];
+    if (mDictionaries[at] || samples.mSizes.size() >= MAX_SAMPLES || samples.mData.size() >= MAX_SAMPLE_BYTES)
+    {
+        return;
+    }
+
+    size_t sample_size = llmin(size, MAX_SAMPLE_SIZE);
+    samples.mData.insert(samples.mData.end(), data, data + sample_size);
+    samples.mSizes.push_back(sample_size);
+}
+
+void LLCacheCompressor::trainDictionaries()
+{
+    if (mDictDir.empty())
+    {
+        return;
+    }
+
+    for (S32 i = 0; i < LLAssetType::AT_COUNT; ++i)
+    {
+        LLAssetType::EType at = (LLAssetType::EType)i;
+        SampleSet samples;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mDictionaries[i] || mSamples[i].mSizes.size() < MIN_SAMPLES)
+            {
+                continue;
+            }
+            // train without holding the lock; a failed training starts over with fresh samples
+            samples.mData.swap(mSamples[i].mData);
+            samples.mSizes.swap(mSamples[i].mSizes);
+        }
+
+        std::vector<U8> dict_data(DICTIONARY_CAPACITY);
+        size_t dict_size = ZDICT_trainFromBuffer(dict_data.data(), dict_data.size(), samples.mData.data(),
+                                                 samples.mSizes.data(), (unsigned)samples.mSizes.size());
+        if (ZDICT_isError(dict_size))
+        {
+            LL_WARNS("DiskCache") << "Failed to train compression dictionary for " << LLAssetType::lookup(at)
+                                  << " from " << samples.mSizes.size() << " samples: " << ZDICT_getErrorName(dict_size) << LL_ENDL;
+            continue;
+        }
+        dict_data.resize(dict_size);
+
+        // Only use a dictionary once it is safely on disk, otherwise files
+        // compressed with it could not be read back after a restart.
+        std::string filename = dictionaryFilename(at);
+        LLFILE* file = LLFile::fopen(filename, "wb");
+        if (!file)
+        {
+            LL_WARNS("DiskCache") << "Failed to save compression dictionary " << filename << LL_ENDL;
+            continue;
+        }
+        size_t written = fwrite(dict_data.data(), 1, dict_data.size(), file);
+        fclose(file);
+        if (written != dict_data.size())
+        {
+            LL_WARNS("DiskCache") << "Failed to save compression dictionary " << filename << LL_ENDL;
+            LLFile::remove(filename);
+            continue;
+        }
+
+        auto dict = std::make_shared<Dictionary>(dict_data, mLevel);
+        if (dict->isValid())
+        {
+            LL_INFOS("DiskCache") << "Trained " << dict_size << " byte compression dictionary for "
+                                  << LLAssetType::lookup(at) << " from " << samples.mSizes.size() << " samples" << LL_ENDL;
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDictionaries[i] = dict;
+            ++mStats.mDictionaries;
+        }
+    }
+}
+
+void LLCacheCompressor::reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& dict : mDictionaries)
+    {
+        dict.reset();
+    }
+    for (auto& samples : mSamples)
+    {
+        samples = SampleSet();
+    }
+    mStats.mDictionaries = 0;
+}
+
+LLCacheCompressor::Stats LLCacheCompressor::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+}
+
+LLCacheCompressor::dict_ptr_t LLCacheCompressor::getDictionary(LLAssetType::EType at) const
+{
+    if (!valid_type(at))
+    {
+        return dict_ptr_t();
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDictionaries[at];
+}
+
+bool LLCacheCompressor::loadDictionary(LLAssetType::EType at, const std::string& filename)
+{
+    std::vector<U8> data;
+    LLFILE* file = LLFile::fopen(filename, "rb");
+    if (file)
+    {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0 && (size_t)size <= DICTIONARY_CAPACITY)
+        {
+            data.resize(size);
+            if (fread(data.data(), 1, data.size(), file) != data.size())
+            {
+                data.clear();
+            }
+        }
+        fclose(file);
+    }
+
+    if (!data.empty())
+    {
+        auto dict = std::make_shared<Dictionary>(data, mLevel);
+        if (dict->isValid())
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDictionaries[at] = dict;
+            ++mStats.mDictionaries;
+            return true;
+        }
+    }
+
+    // Files compressed with it will read as cache misses and be fetched again
+    LL_WARNS("DiskCache") << "Discarding unreadable compression dictionary " << filename << LL_ENDL;
+    LLFile::remove(filename);
+    return false;
+}
+
+std::string LLCacheCompressor::dictionaryFilename(LLAssetType::EType at) const
+{
+    return mDictDir + gDirUtilp->getDirDelimiter() + "dict_" + LLAssetType::lookup(at) + ".zdict";
+}
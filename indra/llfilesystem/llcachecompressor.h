@@ -0,0 +1,151 @@
+/**
+ * @file llcachecompressor.h
+ * @brief Transparent zstd compression of disk cache assets, with a
+ *        trained dictionary per asset type.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLCACHECOMPRESSOR_H
+#define LL_LLCACHECOMPRESSOR_H
+
+#include "llassettype.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * LLCacheCompressor compresses the small, highly redundant assets kept in
+ * the disk cache (animations, notecards, scripts and the various LLSD based
+ * assets). Assets which are already compressed (textures, sounds, meshes)
+ * are left alone.
+ *
+ * Compressed cache files start with a small header carrying the
+ * uncompressed size and the id of the dictionary the payload was compressed
+ * with, so LLFileSystem can tell them apart from raw files and report the
+ * logical size without decompressing.
+ *
+ * Small assets compress poorly on their own, so the first assets of each
+ * type written to the cache are also kept as samples; once enough have been
+ * gathered, trainDictionaries() builds a zstd dictionary for that type and
+ * saves it alongside the cache files. Later writes of that type use the
+ * dictionary. A file compressed with a dictionary that is no longer present
+ * fails to decompress and reads as a cache miss.
+ *
+ * compress() and decompress() may be called from any thread.
+ */
+class LLCacheCompressor
+{
+public:
+    LLCacheCompressor();
+    ~LLCacheCompressor();
+
+    /**
+     * Set the directory holding the trained dictionaries and load any
+     * dictionaries found there.
+     */
+    void init(const std::string& dict_dir);
+
+    void setEnabled(bool enabled) { mEnabled = enabled; }
+    bool isEnabled() const { return mEnabled; }
+
+    void setCompressionLevel(S32 level) { mLevel = level; }
+
+    /// true for asset types worth compressing
+    static bool isCompressibleType(LLAssetType::EType at);
+
+    static constexpr size_t HEADER_SIZE = 12;
+
+    /// true if data (at least HEADER_SIZE bytes) starts with a compressed file header
+    static bool isCompressed(const U8* data, size_t size);
+    /// uncompressed size from a compressed file header
+    static size_t getUncompressedSize(const U8* header);
+
+    /**
+     * Compress size bytes of asset type at into out (header included).
+     * Returns false, leaving out unchanged, if compression is disabled, the
+     * type isn't compressible or the result would not be smaller.
+     */
+    bool compress(LLAssetType::EType at, const U8* src, size_t size, std::vector<U8>& out);
+
+    /**
+     * Decompress a compressed cache file into out. Returns false if the
+     * data is corrupt or was compressed with a dictionary we don't have.
+     */
+    bool decompress(LLAssetType::EType at, const U8* src, size_t size, std::vector<U8>& out);
+
+    /**
+     * Offer an asset as a training sample for its type. Ignored once the
+     * type has a dictionary or enough samples.
+     */
+    void addSample(LLAssetType::EType at, const U8* data, size_t size);
+
+    /**
+     * Train and save dictionaries for types with enough samples. Training
+     * takes a while, so call this from a background thread.
+     */
+    void trainDictionaries();
+
+    /// discard all dictionaries and samples (their files are removed with the cache)
+    void reset();
+
+    struct Stats
+    {
+        U64 mFilesCompressed = 0;
+        U64 mBytesIn = 0;           // uncompressed bytes handed to compress()
+        U64 mBytesOut = 0;          // bytes written for them, headers included
+        U64 mFilesDecompressed = 0;
+        U64 mDecompressFailures = 0;
+        U32 mDictionaries = 0;
+    };
+    Stats getStats() const;
+
+private:
+    struct Dictionary;
+    typedef std::shared_ptr<const Dictionary> dict_ptr_t;
+
+    dict_ptr_t getDictionary(LLAssetType::EType at) const;
+    bool loadDictionary(LLAssetType::EType at, const std::string& filename);
+    std::string dictionaryFilename(LLAssetType::EType at) const;
+
+    struct SampleSet
+    {
+        std::vector<U8> mData;
+        std::vector<size_t> mSizes;
+    };
+
+    std::string mDictDir;
+    std::atomic<bool> mEnabled;
+    std::atomic<S32> mLevel;
+
+    // indexed by LLAssetType::EType
+    std::array<dict_ptr_t, LLAssetType::AT_COUNT> mDictionaries;
+    std::array<SampleSet, LLAssetType::AT_COUNT> mSamples;
+    Stats mStats;
+    mutable std::mutex mMutex;
+};
+
+#endif // LL_LLCACHECOMPRESSOR_H
@@ -58,6 +58,9 @@ void LLDiskCache::init(ELLPath location, const uintmax_t max_size_bytes, const b
     }
 
     createCache();
+
+    // dictionaries live alongside the cache files so they're removed with them
+    mCompressor.init(mCacheDir);
 }
 
 
@@ -342,7 +345,14 @@ const std::string LLDiskCache::getCacheInfo()
     uintmax_t max_in_mb = mMaxSizeBytes / (1024U * 1024U);
     F64 percent_used = ((F64)cache_used_mb / (F64)max_in_mb) * 100.0;
 
-    return llformat("%juMB / %juMB (%.1f%% used)", cache_used_mb, max_in_mb, percent_used);
+    std::string info = llformat("%juMB / %juMB (%.1f%% used)", cache_used_mb, max_in_mb, percent_used);
+
+    LLCacheCompressor::Stats stats = mCompressor.getStats();
+    if (stats.mBytesOut > 0)
+    {
+        info += llformat(", %llu assets compressed %.1f:1", stats.mFilesCompressed, (F64)stats.mBytesIn / (F64)stats.mBytesOut);
+    }
+    return info;
 }
 
 void LLDiskCache::clearCache(ELLPath location, bool recreate_cache)
@@ -367,6 +377,8 @@ void LLDiskCache::clearCache(ELLPath location, bool recreate_cache)
 #endif
         }
         gDirUtilp->deleteFilesInDir(disk_cache_dir, mask);
+        // the compression dictionaries were just deleted along with everything else
+        mCompressor.reset();
         if (recreate_cache)
         {
             createCache();
@@ -374,6 +386,13 @@ void LLDiskCache::clearCache(ELLPath location, bool recreate_cache)
     }
 }
 
+void LLDiskCache::trainCompressionDictionaries()
+{
+    if (mReadOnly || !mCompressor.isEnabled()) return;
+
+    mCompressor.trainDictionaries();
+}
+
 void LLDiskCache::removeOldVFSFiles()
 {
     //VFS files won't be created, so consider removing this code later
@@ -467,5 +486,6 @@ void LLPurgeDiskCacheThread::run()
     while (LLApp::instance()->sleep(CHECK_INTERVAL))
     {
         LLDiskCache::instance().purge();
+        LLDiskCache::instance().trainCompressionDictionaries();
     }
 }
@@ -65,6 +65,7 @@
 #include "llsingleton.h"
 #include "lluuid.h"
 #include "lldir.h"
+#include "llcachecompressor.h"
 
 #include "boost/unordered/unordered_flat_set.hpp"
 
@@ -149,6 +150,20 @@ public:
 
         void setReadonly(bool read_only) { mReadOnly = read_only; }
 
+        /**
+         * Transparent compression of compressible asset types, used by
+         * LLFileSystem. Off until enabled; LLAppViewer::initCache() turns it
+         * on from the DiskCacheCompression setting, which defaults to on.
+         */
+        LLCacheCompressor& getCompressor() { return mCompressor; }
+
+        /**
+         * Train compression dictionaries for asset types that have gathered
+         * enough samples. Called by LLPurgeDiskCacheThread since training
+         * is too slow for the main thread.
+         */
+        void trainCompressionDictionaries();
+
     private:
         /**
          * Utility function to gather the total size the files in a given
@@ -202,6 +217,8 @@ public:
         bool mEnableCacheDebugInfo = false;
 
         bool mReadOnly = false;
+
+        LLCacheCompressor mCompressor;
 };
 
 class LLPurgeDiskCacheThread : public LLThread
@@ -39,6 +39,75 @@ const S32 LLFileSystem::WRITE       = 0x00000002;
 const S32 LLFileSystem::READ_WRITE  = 0x00000003;  // LLFileSystem::READ & LLFileSystem::WRITE
 const S32 LLFileSystem::APPEND      = 0x00000006;  // 0x00000004 & LLFileSystem::WRITE
 
+namespace
+{
+    bool compression_enabled(LLAssetType::EType file_type)
+    {
+        return LLCacheCompressor::isCompressibleType(file_type) && LLDiskCache::getInstance()->getCompressor().isEnabled();
+    }
+
+    // read the compressed file header, if there is one
+    bool read_compressed_header(const boost::filesystem::path& file_path, U8* header)
+    {
+        bool compressed = false;
+        LLFILE* file = LLFile::fopen(file_path, TEXT("rb"));
+        if (file)
+        {
+            compressed = fread(header, 1, LLCacheCompressor::HEADER_SIZE, file) == LLCacheCompressor::HEADER_SIZE
+                && LLCacheCompressor::isCompressed(header, LLCacheCompressor::HEADER_SIZE);
+            fclose(file);
+        }
+        return compressed;
+    }
+
+    bool is_compressed_file(const boost::filesystem::path& file_path)
+    {
+        U8 header[LLCacheCompressor::HEADER_SIZE];
+        return read_compressed_header(file_path, header);
+    }
+
+    bool read_whole_file(const boost::filesystem::path& file_path, std::vector<U8>& data)
+    {
+        boost::system::error_code ec;
+        uintmax_t file_size = boost::filesystem::file_size(file_path, ec);
+        if (ec.failed())
+        {
+            return false;
+        }
+
+        bool success = false;
+        LLFILE* file = LLFile::fopen(file_path, TEXT("rb"));
+        if (file)
+        {
+            data.resize((size_t)file_size);
+            success = fread(data.data(), 1, data.size(), file) == data.size();
+            fclose(file);
+        }
+        return success;
+    }
+
+    // size of the asset stored at file_path, as seen by readers
+    S32 logical_file_size(const boost::filesystem::path& file_path, LLAssetType::EType file_type)
+    {
+        if (LLCacheCompressor::isCompressibleType(file_type))
+        {
+            U8 header[LLCacheCompressor::HEADER_SIZE];
+            if (read_compressed_header(file_path, header))
+            {
+                return (S32)LLCacheCompressor::getUncompressedSize(header);
+            }
+        }
+
+        boost::system::error_code ec;
+        S32 file_size = boost::filesystem::file_size(file_path, ec);
+        if (ec.failed())
+        {
+            return 0;
+        }
+        return file_size;
+    }
+}
+
 LLFileSystem::LLFileSystem(const LLUUID& file_id, const LLAssetType::EType file_type, S32 mode)
 {
     // build the filename (TODO: we do this in a few places - perhaps we should factor into a single function)
@@ -65,10 +134,109 @@ LLFileSystem::LLFileSystem(const LLUUID& file_id, const LLAssetType::EType file_
             LLDiskCache::updateFileAccessTime(mFilePath);
         }
     }
+    else if (compression_enabled(file_type))
+    {
+        boost::system::error_code ec;
+        bool exists = boost::filesystem::exists(mFilePath, ec) && !ec.failed();
+        if (mode == LLFileSystem::WRITE || !exists)
+        {
+            // The whole asset is written through this object: compress it
+            // in one go when we're done with it.
+            mBuffered = true;
+            mCompressOnFlush = true;
+        }
+        else if (is_compressed_file(mFilePath))
+        {
+            // Changing a compressed file in place keeps it compressed.
+            // Appends tend to come in a series (xfers, uploads) though, so
+            // after one the file is left uncompressed and the next ones
+            // append to it as is; it is compressed again when renamed to
+            // its final id.
+            mCompressOnFlush = (mode != LLFileSystem::APPEND);
+            if (!loadBuffer())
+            {
+                // unreadable: start over
+                mBuffer.clear();
+                mBuffered = true;
+            }
+        }
+        // else: extending an uncompressed file, append to it as is
+    }
 }
 
 LLFileSystem::~LLFileSystem()
 {
+    flushBuffer();
+}
+
+// Load the uncompressed contents of the file into mBuffer.
+bool LLFileSystem::loadBuffer()
+{
+    std::vector<U8> data;
+    if (!read_whole_file(mFilePath, data))
+    {
+        return false;
+    }
+
+    if (LLCacheCompressor::isCompressed(data.data(), data.size()))
+    {
+        if (!LLDiskCache::getInstance()->getCompressor().decompress(mFileType, data.data(), data.size(), mBuffer))
+        {
+            // e.g. the dictionary it was compressed with is gone; treat it
+            // as a cache miss so the asset gets fetched again
+            LL_WARNS() << "Failed to decompress cached " << LLAssetType::lookup(mFileType) << " " << mFileID << ", removing it" << LL_ENDL;
+            LLFile::remove(mFilePath);
+            return false;
+        }
+    }
+    else
+    {
+        mBuffer.swap(data);
+    }
+
+    mBuffered = true;
+    return true;
+}
+
+// Save mBuffer if it has been written to, compressed if worthwhile.
+void LLFileSystem::flushBuffer()
+{
+    if (!mDirty)
+    {
+        return;
+    }
+    mDirty = false;
+
+    const U8* data = mBuffer.data();
+    size_t size = mBuffer.size();
+
+    std::vector<U8> compressed;
+    if (mCompressOnFlush)
+    {
+        LLCacheCompressor& compressor = LLDiskCache::getInstance()->getCompressor();
+        compressor.addSample(mFileType, data, size);
+        if (compressor.compress(mFileType, data, size, compressed))
+        {
+            data = compressed.data();
+            size = compressed.size();
+        }
+    }
+
+    LLFILE* ofs = LLFile::fopen(mFilePath, TEXT("wb"));
+    if (ofs)
+    {
+        size_t bytes_written = fwrite(data, 1, size, ofs);
+        fclose(ofs);
+        if (bytes_written != size)
+        {
+            LL_WARNS() << "Failed to write cached " << LLAssetType::lookup(mFileType) << " " << mFileID << LL_ENDL;
+            LLFile::remove(mFilePath);
+        }
+    }
+    else
+    {
+        LL_WARNS() << "Failed to open cached " << LLAssetType::lookup(mFileType) << " " << mFileID << " for writing" << LL_ENDL;
+    }
 }
 
 // static
@@ -101,17 +269,32 @@ bool LLFileSystem::renameFile(const LLUUID& old_file_id, const LLAssetType::ETyp
 S32 LLFileSystem::getFileSize(const LLUUID& file_id, const LLAssetType::EType file_type)
 {
     const boost::filesystem::path filename = LLDiskCache::getInstance()->metaDataToFilepath(file_id, file_type);
-    boost::system::error_code ec;
-    S32 file_size = boost::filesystem::file_size(filename, ec);
-    if(ec.failed())
-    {
-        return 0;
-    }
-    return file_size;
+    return logical_file_size(filename, file_type);
 }
 
 BOOL LLFileSystem::read(U8* buffer, S32 bytes)
 {
+    if (!mBuffered && !mFormatChecked && LLCacheCompressor::isCompressibleType(mFileType))
+    {
+        mFormatChecked = true;
+        if (is_compressed_file(mFilePath) && !loadBuffer())
+        {
+            mBytesRead = 0;
+            return FALSE;
+        }
+    }
+
+    if (mBuffered)
+    {
+        mBytesRead = llclamp((S32)mBuffer.size() - mPosition, 0, bytes);
+        if (mBytesRead)
+        {
+            memcpy(buffer, mBuffer.data() + mPosition, mBytesRead);
+        }
+        mPosition += mBytesRead;
+        return mBytesRead ? TRUE : FALSE;
+    }
+
     BOOL success = FALSE;
 
     LLFILE* file = LLFile::fopen(mFilePath, TEXT("rb"));
@@ -150,7 +333,32 @@ BOOL LLFileSystem::write(const U8* buffer, S32 bytes)
 {
     BOOL success = FALSE;
 
-    if (mMode == APPEND)
+    if (mBuffered)
+    {
+        // same semantics as the unbuffered modes below, saved by flushBuffer()
+        if (mMode == APPEND)
+        {
+            mBuffer.insert(mBuffer.end(), buffer, buffer + bytes);
+            mPosition = (S32)mBuffer.size();
+        }
+        else if (mMode == READ_WRITE)
+        {
+            if (mPosition + bytes > (S32)mBuffer.size())
+            {
+                mBuffer.resize(mPosition + bytes);
+            }
+            memcpy(mBuffer.data() + mPosition, buffer, bytes);
+            mPosition += bytes;
+        }
+        else
+        {
+            mBuffer.assign(buffer, buffer + bytes);
+            mPosition = bytes;
+        }
+        mDirty = true;
+        success = TRUE;
+    }
+    else if (mMode == APPEND)
     {
         LLFILE* ofs = LLFile::fopen(mFilePath, TEXT("a+b"));
         if (ofs)
@@ -239,13 +447,11 @@ S32 LLFileSystem::tell() const
 
 S32 LLFileSystem::getSize()
 {
-    boost::system::error_code ec;
-    S32 file_size = boost::filesystem::file_size(mFilePath, ec);
-    if(ec.failed())
+    if (mBuffered)
     {
-        return 0;
+        return (S32)mBuffer.size();
     }
-    return file_size;
+    return logical_file_size(mFilePath, mFileType);
 }
 
 S32 LLFileSystem::getMaxSize()
@@ -256,6 +462,12 @@ S32 LLFileSystem::getMaxSize()
 
 BOOL LLFileSystem::rename(const LLUUID& new_id, const LLAssetType::EType new_type)
 {
+    flushBuffer();
+
+    // A compressed file may depend on its type's dictionary, so changing
+    // type means recompressing it.
+    bool repack = new_type != mFileType && is_compressed_file(mFilePath) && loadBuffer();
+
     const boost::filesystem::path new_filename = LLDiskCache::getInstance()->metaDataToFilepath(new_id, new_type);
 
     // Rename needs the new file to not exist.
@@ -281,11 +493,21 @@ BOOL LLFileSystem::rename(const LLUUID& new_id, const LLAssetType::EType new_typ
     mFileType = new_type;
     mFilePath = new_filename;
 
+    // Assets assembled under a temporary id by a series of appends are
+    // compressed once they're complete.
+    if (repack || (compression_enabled(new_type) && !is_compressed_file(mFilePath) && loadBuffer()))
+    {
+        mDirty = true;
+        mCompressOnFlush = compression_enabled(new_type);
+        flushBuffer();
+    }
+
     return TRUE;
 }
 
 BOOL LLFileSystem::remove()
 {
+    mDirty = false;
     boost::system::error_code ec;
     boost::filesystem::remove(mFilePath, ec);
     return TRUE;
@@ -60,6 +60,10 @@ class LLFileSystem
         static S32 getFileSize(const LLUUID& file_id, const LLAssetType::EType file_type);
 
     public:
+        // Compressible asset types (see LLCacheCompressor) are stored
+        // compressed when written with WRITE, or with any mode if the file
+        // is new, and stay compressed through READ_WRITE. APPEND to a
+        // compressed file leaves it uncompressed until it is renamed.
         static const S32 READ;
         static const S32 WRITE;
         static const S32 READ_WRITE;
@@ -72,6 +76,17 @@ class LLFileSystem
         S32     mPosition;
         S32     mMode;
         S32     mBytesRead;
+
+        // Compressible asset types (see LLCacheCompressor) are read and
+        // written through an in-memory copy of their uncompressed contents
+        bool loadBuffer();
+        void flushBuffer();
+
+        std::vector<U8> mBuffer;
+        bool    mBuffered = false;          // mBuffer holds the file's contents
+        bool    mDirty = false;             // mBuffer has writes not yet saved
+        bool    mCompressOnFlush = false;
+        bool    mFormatChecked = false;     // file is known to be stored uncompressed
 //private:
 //    static const std::string idToFilepath(const std::string id, LLAssetType::EType at);
 };
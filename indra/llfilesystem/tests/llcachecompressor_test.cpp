@@ -0,0 +1,284 @@
+/**
+ * @file llcachecompressor_test.cpp
+ * @date 2026-10
+ * @brief LLCacheCompressor test cases
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llcachecompressor.h"
+#include "../lldir.h"
+
+#include "../test/lltut.h"
+#include "llfile.h"
+#include "llrand.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+#include "lluuid.h"
+
+#include <sstream>
+
+namespace
+{
+    // Something shaped like a settings asset: the same keys every time with
+    // varying values, as an LLSD XML document.
+    std::string make_settings_asset(S32 seed)
+    {
+        LLSD settings;
+        settings["type"] = "sky";
+        settings["name"] = llformat("Sky preset %d", seed);
+        settings["haze_density"] = 0.5 + (seed % 17) * 0.01;
+        settings["haze_horizon"] = 0.1 + (seed % 13) * 0.02;
+        settings["density_multiplier"] = 0.0001 * (1 + seed % 7);
+        settings["distance_multiplier"] = 0.8 + (seed % 5) * 0.1;
+        settings["max_y"] = 1600 + seed % 400;
+        settings["gamma"] = 1.0 + (seed % 3) * 0.1;
+        for (S32 i = 0; i < 8; ++i)
+        {
+            LLSD layer;
+            layer["width"] = 1000 + (seed * 31 + i) % 500;
+            layer["exp_term"] = 1.0;
+            layer["linear_term"] = -0.0001 * i;
+            layer["constant_term"] = 0.0;
+            settings["rayleigh_config"].append(layer);
+        }
+        settings["cloud_id"] = LLUUID::generateNewID();
+
+        std::ostringstream str;
+        LLSDSerialize::toPrettyXML(settings, str);
+        return str.str();
+    }
+
+    std::string temp_dir()
+    {
+        std::string dir = std::string(LLFile::tmpdir()) + "llcachecompressor_test_" + LLUUID::generateNewID().asString();
+        LLFile::mkdir(dir);
+        return dir;
+    }
+
+    void remove_dir(const std::string& dir)
+    {
+        gDirUtilp->deleteFilesInDir(dir, "*");
+        LLFile::rmdir(dir);
+    }
+
+    bool write_file(const std::string& filename, const std::vector<U8>& data)
+    {
+        LLFILE* file = LLFile::fopen(filename, "wb");
+        if (!file)
+        {
+            return false;
+        }
+        bool success = fwrite(data.data(), 1, data.size(), file) == data.size();
+        fclose(file);
+        return success;
+    }
+
+    bool read_file(const std::string& filename, std::vector<U8>& data)
+    {
+        LLFILE* file = LLFile::fopen(filename, "rb");
+        if (!file)
+        {
+            return false;
+        }
+        fseek(file, 0, SEEK_END);
+        data.resize(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        bool success = fread(data.data(), 1, data.size(), file) == data.size();
+        fclose(file);
+        return success;
+    }
+
+    std::vector<U8> to_bytes(const std::string& str)
+    {
+        return std::vector<U8>(str.begin(), str.end());
+    }
+}
+
+namespace tut
+{
+    struct llcachecompressor_data
+    {
+        llcachecompressor_data()
+        {
+            mCompressor.setEnabled(true);
+        }
+
+        void gatherSamples(LLCacheCompressor& compressor, S32 count)
+        {
+            for (S32 i = 0; i < count; ++i)
+            {
+                std::string asset = make_settings_asset(i);
+                compressor.addSample(LLAssetType::AT_SETTINGS, (const U8*)asset.data(), asset.size());
+            }
+        }
+
+        LLCacheCompressor mCompressor;
+    };
+    typedef test_group<llcachecompressor_data> llcachecompressor_group;
+    typedef llcachecompressor_group::object object;
+    llcachecompressor_group llcachecompressorgrp("LLCacheCompressor");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("round trip without a dictionary");
+        std::vector<U8> asset(to_bytes(make_settings_asset(1)));
+
+        std::vector<U8> compressed;
+        ensure("compressed", mCompressor.compress(LLAssetType::AT_SETTINGS, asset.data(), asset.size(), compressed));
+        ensure("smaller", compressed.size() < asset.size());
+        ensure("has header", LLCacheCompressor::isCompressed(compressed.data(), compressed.size()));
+        ensure_equals("header size", LLCacheCompressor::getUncompressedSize(compressed.data()), asset.size());
+
+        std::vector<U8> decompressed;
+        ensure("decompressed", mCompressor.decompress(LLAssetType::AT_SETTINGS, compressed.data(), compressed.size(), decompressed));
+        ensure("contents match", decompressed == asset);
+
+        ensure("raw data isn't mistaken for compressed", !LLCacheCompressor::isCompressed(asset.data(), asset.size()));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("assets left alone");
+        std::vector<U8> asset(to_bytes(make_settings_asset(2)));
+        std::vector<U8> out;
+
+        ensure("textures aren't compressed", !mCompressor.compress(LLAssetType::AT_TEXTURE, asset.data(), asset.size(), out));
+        ensure("meshes aren't compressed", !mCompressor.compress(LLAssetType::AT_MESH, asset.data(), asset.size(), out));
+
+        std::vector<U8> noise(4096);
+        for (size_t i = 0; i < noise.size(); ++i)
+        {
+            noise[i] = (U8)ll_rand(256);
+        }
+        ensure("incompressible data is kept as is", !mCompressor.compress(LLAssetType::AT_NOTECARD, noise.data(), noise.size(), out));
+        ensure("output untouched", out.empty());
+
+        mCompressor.setEnabled(false);
+        ensure("nothing compressed when disabled", !mCompressor.compress(LLAssetType::AT_SETTINGS, asset.data(), asset.size(), out));
+
+        std::vector<U8> garbage(to_bytes("LLZC but not really a compressed asset"));
+        ensure("corrupt data fails to decompress", !mCompressor.decompress(LLAssetType::AT_SETTINGS, garbage.data(), garbage.size(), out));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("dictionary training");
+        std::string dir = temp_dir();
+        mCompressor.init(dir);
+
+        std::vector<U8> asset(to_bytes(make_settings_asset(100000)));
+        std::vector<U8> plain;
+        ensure("compressed without dictionary", mCompressor.compress(LLAssetType::AT_SETTINGS, asset.data(), asset.size(), plain));
+
+        mCompressor.trainDictionaries();
+        ensure_equals("no dictionary without samples", mCompressor.getStats().mDictionaries, 0U);
+
+        gatherSamples(mCompressor, 1000);
+        mCompressor.trainDictionaries();
+        ensure_equals("dictionary trained", mCompressor.getStats().mDictionaries, 1U);
+
+        std::vector<U8> with_dict;
+        ensure("compressed with dictionary", mCompressor.compress(LLAssetType::AT_SETTINGS, asset.data(), asset.size(), with_dict));
+        ensure("dictionary helps", with_dict.size() < plain.size());
+
+        std::vector<U8> decompressed;
+        ensure("old files still readable", mCompressor.decompress(LLAssetType::AT_SETTINGS, plain.data(), plain.size(), decompressed));
+        ensure("old contents match", decompressed == asset);
+
+        // a fresh compressor picks the dictionary up from the cache dir
+        LLCacheCompressor reloaded;
+        reloaded.init(dir);
+        ensure_equals("dictionary reloaded", reloaded.getStats().mDictionaries, 1U);
+        ensure("decompressed with reloaded dictionary", reloaded.decompress(LLAssetType::AT_SETTINGS, with_dict.data(), with_dict.size(), decompressed));
+        ensure("contents match", decompressed == asset);
+
+        // without it, the file reads as a miss
+        LLCacheCompressor no_dict;
+        ensure("fails without dictionary", !no_dict.decompress(LLAssetType::AT_SETTINGS, with_dict.data(), with_dict.size(), decompressed));
+        ensure_equals("failure counted", no_dict.getStats().mDecompressFailures, 1ULL);
+
+        remove_dir(dir);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("compression ratio");
+        const S32 COUNT = 2000;
+        std::string raw_dir = temp_dir();
+        std::string packed_dir = temp_dir();
+        std::string delim = gDirUtilp->getDirDelimiter();
+
+        mCompressor.init(packed_dir);
+        gatherSamples(mCompressor, 1000);
+        mCompressor.trainDictionaries();
+
+        std::vector<std::vector<U8>> assets;
+        U64 raw_bytes = 0;
+        U64 packed_bytes = 0;
+        for (S32 i = 0; i < COUNT; ++i)
+        {
+            assets.push_back(to_bytes(make_settings_asset(5000 + i)));
+            const std::vector<U8>& asset = assets.back();
+            std::string name = llformat("%d.sl_cache", i);
+
+            ensure("raw write", write_file(raw_dir + delim + name, asset));
+            raw_bytes += asset.size();
+
+            std::vector<U8> packed;
+            if (!mCompressor.compress(LLAssetType::AT_SETTINGS, asset.data(), asset.size(), packed))
+            {
+                packed = asset;
+            }
+            ensure("packed write", write_file(packed_dir + delim + name, packed));
+            packed_bytes += packed.size();
+        }
+
+        std::vector<U8> data;
+        std::vector<U8> decompressed;
+
+        for (S32 i = 0; i < COUNT; ++i)
+        {
+            ensure("raw read", read_file(raw_dir + delim + llformat("%d.sl_cache", i), data));
+            ensure("raw round trip", data == assets[i]);
+
+            ensure("packed read", read_file(packed_dir + delim + llformat("%d.sl_cache", i), data));
+            if (LLCacheCompressor::isCompressed(data.data(), data.size()))
+            {
+                ensure("decompressed", mCompressor.decompress(LLAssetType::AT_SETTINGS, data.data(), data.size(), decompressed));
+                data.swap(decompressed);
+            }
+            ensure("round trip", data == assets[i]);
+        }
+
+        ensure("cache holds more", packed_bytes * 2 < raw_bytes);
+
+        remove_dir(raw_dir);
+        remove_dir(packed_dir);
+    }
+}
@@ -0,0 +1,268 @@
+/**
+ * @file llfilesystem_test.cpp
+ * @date 2026-10
+ * @brief LLFileSystem test cases: reads, writes, appends, in place writes
+ *        and renames of compressed and uncompressed cache entries.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llfilesystem.h"
+#include "../lldiskcache.h"
+#include "../lldir.h"
+
+#include "../test/lltut.h"
+#include "llfile.h"
+#include "lluuid.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Notecard text: compresses well, as the real thing does
+    std::vector<U8> make_notecard(S32 seed, S32 lines)
+    {
+        std::string text = "Linden text version 2\n{\nLLEmbeddedItems version 1\n{\ncount 0\n}\nText length 0\n";
+        for (S32 i = 0; i < lines; ++i)
+        {
+            text += llformat("Line %d of notecard %d: the quick brown fox jumps over the lazy dog.\n", i, seed);
+        }
+        text += "}\n";
+        return std::vector<U8>(text.begin(), text.end());
+    }
+
+    std::vector<U8> make_bytes(S32 seed, S32 size)
+    {
+        std::vector<U8> data(size);
+        for (S32 i = 0; i < size; ++i)
+        {
+            data[i] = (U8)((seed * 131 + i * 7) & 0xff);
+        }
+        return data;
+    }
+
+    bool write_asset(const LLUUID& id, LLAssetType::EType type, const std::vector<U8>& data, S32 mode)
+    {
+        LLFileSystem file(id, type, mode);
+        return file.write(data.data(), (S32)data.size());
+    }
+
+    // read back in small pieces, as the asset code does
+    std::vector<U8> read_asset(const LLUUID& id, LLAssetType::EType type)
+    {
+        LLFileSystem file(id, type, LLFileSystem::READ);
+        std::vector<U8> data;
+        U8 chunk[100];
+        while (file.read(chunk, sizeof(chunk)))
+        {
+            data.insert(data.end(), chunk, chunk + file.getLastBytesRead());
+        }
+        return data;
+    }
+
+    // whether the entry for id is stored compressed
+    bool stored_compressed(const LLUUID& id, LLAssetType::EType type)
+    {
+        std::string filename = LLDiskCache::getInstance()->metaDataToFilepath(id, type).string();
+        LLFILE* file = LLFile::fopen(filename, "rb");
+        if (!file)
+        {
+            return false;
+        }
+        U8 header[LLCacheCompressor::HEADER_SIZE];
+        bool compressed = fread(header, 1, sizeof(header), file) == sizeof(header)
+            && LLCacheCompressor::isCompressed(header, sizeof(header));
+        fclose(file);
+        return compressed;
+    }
+
+    std::vector<U8> join(const std::vector<U8>& a, const std::vector<U8>& b)
+    {
+        std::vector<U8> joined(a);
+        joined.insert(joined.end(), b.begin(), b.end());
+        return joined;
+    }
+}
+
+namespace tut
+{
+    struct llfilesystem_data
+    {
+        llfilesystem_data()
+        {
+            mDir = std::string(LLFile::tmpdir()) + "llfilesystem_test_" + LLUUID::generateNewID().asString();
+            gDirUtilp->setCacheDir(mDir);
+
+            LLDiskCache::createInstance();
+            LLDiskCache::getInstance()->init(LL_PATH_CACHE, 64 * 1024 * 1024, false, false);
+            LLDiskCache::getInstance()->getCompressor().setEnabled(true);
+        }
+
+        ~llfilesystem_data()
+        {
+            LLDiskCache::getInstance()->clearCache(LL_PATH_CACHE, false);
+            LLDiskCache::deleteSingleton();
+            gDirUtilp->deleteDirAndContents(mDir);
+            gDirUtilp->setCacheDir("");
+        }
+
+        void setCompression(bool enabled)
+        {
+            LLDiskCache::getInstance()->getCompressor().setEnabled(enabled);
+        }
+
+        std::string mDir;
+    };
+    typedef test_group<llfilesystem_data> llfilesystem_group;
+    typedef llfilesystem_group::object object;
+    llfilesystem_group llfilesystemgrp("LLFileSystem");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("uncompressed entries");
+        // textures are never compressed
+        const LLAssetType::EType type = LLAssetType::AT_TEXTURE;
+        LLUUID id = LLUUID::generateNewID();
+        std::vector<U8> first = make_bytes(1, 1500);
+        std::vector<U8> second = make_bytes(2, 700);
+
+        ensure("write", write_asset(id, type, first, LLFileSystem::WRITE));
+        ensure("stored as is", !stored_compressed(id, type));
+        ensure_equals("size", LLFileSystem::getFileSize(id, type), (S32)first.size());
+        ensure("read back", read_asset(id, type) == first);
+
+        ensure("append", write_asset(id, type, second, LLFileSystem::APPEND));
+        std::vector<U8> expected = join(first, second);
+        ensure("appended", read_asset(id, type) == expected);
+
+        {
+            LLFileSystem file(id, type, LLFileSystem::READ_WRITE);
+            ensure("seek", file.seek(100, 0));
+            ensure("write in place", file.write(second.data(), 50));
+        }
+        std::copy(second.begin(), second.begin() + 50, expected.begin() + 100);
+        ensure("written in place", read_asset(id, type) == expected);
+
+        LLUUID new_id = LLUUID::generateNewID();
+        ensure("renamed", LLFileSystem::renameFile(id, type, new_id, type));
+        ensure("old id gone", !LLFileSystem::getExists(id, type));
+        ensure("new id read back", read_asset(new_id, type) == expected);
+        ensure("still as is", !stored_compressed(new_id, type));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("compressed entries");
+        const LLAssetType::EType type = LLAssetType::AT_NOTECARD;
+        LLUUID id = LLUUID::generateNewID();
+        std::vector<U8> first = make_notecard(1, 80);
+        std::vector<U8> second = make_notecard(2, 20);
+
+        ensure("write", write_asset(id, type, first, LLFileSystem::WRITE));
+        ensure("stored compressed", stored_compressed(id, type));
+        ensure_equals("uncompressed size reported", LLFileSystem::getFileSize(id, type), (S32)first.size());
+        ensure("read back", read_asset(id, type) == first);
+
+        {
+            LLFileSystem file(id, type, LLFileSystem::READ);
+            ensure("seek", file.seek(200, 0));
+            U8 chunk[16];
+            ensure("read after seek", file.read(chunk, sizeof(chunk)));
+            ensure("from the uncompressed offset", std::equal(chunk, chunk + sizeof(chunk), first.begin() + 200));
+        }
+
+        {
+            LLFileSystem file(id, type, LLFileSystem::READ_WRITE);
+            ensure("seek", file.seek(10, 0));
+            ensure("write in place", file.write(second.data(), 30));
+        }
+        std::vector<U8> expected = first;
+        std::copy(second.begin(), second.begin() + 30, expected.begin() + 10);
+        ensure("still compressed after writing in place", stored_compressed(id, type));
+        ensure("written in place", read_asset(id, type) == expected);
+
+        ensure("append", write_asset(id, type, second, LLFileSystem::APPEND));
+        expected = join(expected, second);
+        ensure("left uncompressed by the append", !stored_compressed(id, type));
+        ensure("appended", read_asset(id, type) == expected);
+        ensure("append again", write_asset(id, type, first, LLFileSystem::APPEND));
+        expected = join(expected, first);
+        ensure("appended again", read_asset(id, type) == expected);
+
+        LLUUID new_id = LLUUID::generateNewID();
+        ensure("renamed", LLFileSystem::renameFile(id, type, new_id, type));
+        ensure("old id gone", !LLFileSystem::getExists(id, type));
+        ensure("compressed again on rename", stored_compressed(new_id, type));
+        ensure("new id read back", read_asset(new_id, type) == expected);
+
+        LLUUID script_id = LLUUID::generateNewID();
+        ensure("renamed to another type", LLFileSystem::renameFile(new_id, type, script_id, LLAssetType::AT_LSL_TEXT));
+        ensure("recompressed for the new type", stored_compressed(script_id, LLAssetType::AT_LSL_TEXT));
+        ensure("read as the new type", read_asset(script_id, LLAssetType::AT_LSL_TEXT) == expected);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("entries of compressible types stored as is");
+        const LLAssetType::EType type = LLAssetType::AT_NOTECARD;
+        LLUUID id = LLUUID::generateNewID();
+        std::vector<U8> first = make_notecard(3, 60);
+        std::vector<U8> second = make_notecard(4, 10);
+
+        setCompression(false);
+        ensure("write", write_asset(id, type, first, LLFileSystem::WRITE));
+        ensure("not compressed while disabled", !stored_compressed(id, type));
+        ensure("read back", read_asset(id, type) == first);
+
+        setCompression(true);
+        ensure("read back once enabled", read_asset(id, type) == first);
+        ensure("append", write_asset(id, type, second, LLFileSystem::APPEND));
+        ensure("appended to as is", !stored_compressed(id, type));
+        std::vector<U8> expected = join(first, second);
+        ensure("appended", read_asset(id, type) == expected);
+
+        {
+            LLFileSystem file(id, type, LLFileSystem::READ_WRITE);
+            ensure("seek", file.seek(5, 0));
+            ensure("write in place", file.write(second.data(), 20));
+        }
+        std::copy(second.begin(), second.begin() + 20, expected.begin() + 5);
+        ensure("written in place", read_asset(id, type) == expected);
+
+        LLUUID new_id = LLUUID::generateNewID();
+        ensure("renamed", LLFileSystem::renameFile(id, type, new_id, type));
+        ensure("compressed on rename", stored_compressed(new_id, type));
+        ensure("new id read back", read_asset(new_id, type) == expected);
+
+        // appends to a new entry: the first creates it, compressed
+        LLUUID xfer_id = LLUUID::generateNewID();
+        ensure("first append", write_asset(xfer_id, type, first, LLFileSystem::APPEND));
+        ensure("new entry compressed", stored_compressed(xfer_id, type));
+        ensure("second append", write_asset(xfer_id, type, second, LLFileSystem::APPEND));
+        ensure("xfer read back", read_asset(xfer_id, type) == join(first, second));
+    }
+}
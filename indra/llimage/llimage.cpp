@@ -621,14 +621,15 @@ void LLImage::setLastError(const std::string& message)
 // LLImageBase
 //---------------------------------------------------------------------------
 
-LLImageBase::LLImageBase()
+LLImageBase::LLImageBase(LLMemTag::ETag default_tag)
 :   mData(NULL),
     mDataSize(0),
     mWidth(0),
     mHeight(0),
     mComponents(0),
     mBadBufferAllocation(false),
-    mAllowOverSize(false)
+    mAllowOverSize(false),
+    mMemTag(LLMemTag::current(default_tag))
 {}
 
 // virtual
@@ -670,6 +671,10 @@ void LLImageBase::sanityCheck()
 // virtual
 void LLImageBase::deleteData()
 {
+    if (mData)
+    {
+        LLMemTag::disclaim(mMemTag, mDataSize);
+    }
     ll_aligned_free_16(mData);
     mDataSize = 0;
     mData = NULL;
@@ -715,6 +720,10 @@ U8* LLImageBase::allocateData(S32 size)
             LL_WARNS() << "Failed to allocate image data size [" << size << "]" << LL_ENDL;
             mBadBufferAllocation = true;
         }
+        else
+        {
+            LLMemTag::claim(mMemTag, size);
+        }
     }
 
     if (mBadBufferAllocation)
@@ -746,7 +755,9 @@ U8* LLImageBase::reallocateData(S32 size)
         S32 bytes = llmin(mDataSize, size);
         memcpy(new_datap, mData, bytes);    /* Flawfinder: ignore */
         ll_aligned_free_16(mData) ;
+        LLMemTag::disclaim(mMemTag, mDataSize);
     }
+    LLMemTag::claim(mMemTag, size);
     mData = new_datap;
     mDataSize = size;
     mBadBufferAllocation = false;
@@ -2123,7 +2134,7 @@ bool LLImageRaw::createFromFile(const std::string &filename, bool j2c_lowest_mip
 S64 LLImageFormatted::sGlobalFormattedMemory = 0;
 
 LLImageFormatted::LLImageFormatted(S8 codec)
-    : LLImageBase(),
+    : LLImageBase(LLMemTag::IMAGE_FORMATTED),
       mCodec(codec),
       mDecoding(0),
       mDecoded(0),
@@ -2453,6 +2464,15 @@ static void avg4_colors2(const U8* a, const U8* b, const U8* c, const U8* d, U8*
 void LLImageBase::setDataAndSize(U8 *data, S32 size)
 {
     ll_assert_aligned(data, 16);
+    // ownership of the old buffer, if any, has been passed on
+    if (mData)
+    {
+        LLMemTag::disclaim(mMemTag, mDataSize);
+    }
+    if (data)
+    {
+        LLMemTag::claim(mMemTag, size);
+    }
     mData = data;
     mDataSize = size;
 }
@@ -31,6 +31,7 @@
 #include "llstring.h"
 #include "llpointer.h"
 #include "lltrace.h"
+#include "llmemtag.h"
 
 const S32 MIN_IMAGE_MIP =  2; // 4x4, only used for expand/contract power of 2
 const S32 MAX_IMAGE_MIP = 12; // 4096x4096
@@ -119,7 +120,9 @@ protected:
     virtual ~LLImageBase();
 
 public:
-    LLImageBase();
+    // default_tag is the LLMemTag image data is counted under when no
+    // LLMemTag::Scope is open on the constructing thread
+    LLImageBase(LLMemTag::ETag default_tag = LLMemTag::IMAGE_RAW);
 
     enum
     {
@@ -172,6 +175,8 @@ private:
 
     bool mBadBufferAllocation ;
     bool mAllowOverSize ;
+
+    const LLMemTag::ETag mMemTag;
 };
 
 // Raw representation of an image (used for textures, and other uncompressed formats
@@ -199,6 +199,22 @@ bool LLCamera::isChanged()
     return changed;
 }
 
+bool LLCamera::sameAgentFrustum(const LLCamera& other) const
+{
+    // exact compares, a result computed for one camera is reused for the other
+    if (mPlaneCount != other.mPlaneCount ||
+        mFrustumCornerDist != other.mFrustumCornerDist ||
+        getOrigin() != other.getOrigin())
+    {
+        return false;
+    }
+
+    // planes past mPlaneCount are not used
+    U32 plane_count = llmin(mPlaneCount, (U32) AGENT_PLANE_USER_CLIP_NUM);
+    return !memcmp(mPlaneMask, other.mPlaneMask, plane_count * sizeof(mPlaneMask[0])) &&
+           !memcmp(mAgentPlanes, other.mAgentPlanes, plane_count * sizeof(mAgentPlanes[0]));
+}
+
 S32 LLCamera::AABBInFrustum(const LLVector4a &center, const LLVector4a& radius, const LLPlane* planes)
 {
     if(!planes)
@@ -291,6 +307,94 @@ S32 LLCamera::AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVec
     return AABBInFrustumNoFarClip(center, radius, mRegionPlanes);
 }
 
+void LLCamera::AABBsInFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes) const
+{
+    AABBsInPlanes(centers, radii, count, results, planes ? planes : mAgentPlanes, AGENT_PLANE_USER_CLIP_NUM);
+}
+
+void LLCamera::AABBsInRegionFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results) const
+{
+    AABBsInPlanes(centers, radii, count, results, mRegionPlanes, AGENT_PLANE_USER_CLIP_NUM);
+}
+
+void LLCamera::AABBsInFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes) const
+{
+    AABBsInPlanes(centers, radii, count, results, planes ? planes : mAgentPlanes, AGENT_PLANE_FAR);
+}
+
+void LLCamera::AABBsInRegionFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results) const
+{
+    AABBsInPlanes(centers, radii, count, results, mRegionPlanes, AGENT_PLANE_FAR);
+}
+
+// Four boxes go in the four lanes of a register, transposed so that x, y and z
+// each have a register of their own, and each plane is splatted likewise. The
+// sums are done in the same order as LLVector4a::dot3() so that boxes right on
+// a plane land on the same side as they do in AABBInFrustum().
+void LLCamera::AABBsInPlanes(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results,
+                             const LLPlane* planes, U32 skip_plane) const
+{
+    LLVector4a normal[AGENT_PLANE_USER_CLIP_NUM][3];
+    LLVector4a scaler[AGENT_PLANE_USER_CLIP_NUM][3];
+    LLVector4a neg_d[AGENT_PLANE_USER_CLIP_NUM];
+    U32 plane_count = 0;
+    U32 max_planes = llmin(mPlaneCount, (U32) AGENT_PLANE_USER_CLIP_NUM);       // mAgentPlanes[] size is 7
+    for (U32 i = 0; i < max_planes; i++)
+    {
+        U8 mask = mPlaneMask[i];
+        if (i != skip_plane && mask < PLANE_MASK_NUM)
+        {
+            const LLPlane& p(planes[i]);
+            for (U32 j = 0; j < 3; j++)
+            {
+                normal[plane_count][j].splat(p[j]);
+                scaler[plane_count][j].splat(sFrustumScaler[mask][j]);
+            }
+            neg_d[plane_count].splat(-p[3]);
+            ++plane_count;
+        }
+    }
+
+    for (U32 first = 0; first < count; first += 4)
+    {
+        // a short last batch repeats its last box
+        U32 last = llmin(count - first, (U32) 4) - 1;
+        LLQuad c0 = centers[first], c1 = centers[first + llmin((U32) 1, last)],
+               c2 = centers[first + llmin((U32) 2, last)], c3 = centers[first + last];
+        LLQuad r0 = radii[first], r1 = radii[first + llmin((U32) 1, last)],
+               r2 = radii[first + llmin((U32) 2, last)], r3 = radii[first + last];
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        const LLQuad c[3] = { c0, c1, c2 };
+        const LLQuad r[3] = { r0, r1, r2 };
+
+        LLQuad outside = _mm_setzero_ps();
+        LLQuad partial = _mm_setzero_ps();
+        for (U32 i = 0; i < plane_count; i++)
+        {
+            LLQuad min_dot = _mm_setzero_ps();
+            LLQuad max_dot = _mm_setzero_ps();
+            for (U32 j = 0; j < 3; j++)
+            {
+                LLQuad rscale = _mm_mul_ps(r[j], scaler[i][j]);
+                LLQuad min_prod = _mm_mul_ps(normal[i][j], _mm_sub_ps(c[j], rscale));
+                LLQuad max_prod = _mm_mul_ps(normal[i][j], _mm_add_ps(c[j], rscale));
+                min_dot = j ? _mm_add_ps(min_dot, min_prod) : min_prod;
+                max_dot = j ? _mm_add_ps(max_dot, max_prod) : max_prod;
+            }
+            outside = _mm_or_ps(outside, _mm_cmpgt_ps(min_dot, neg_d[i]));
+            partial = _mm_or_ps(partial, _mm_cmpgt_ps(max_dot, neg_d[i]));
+        }
+
+        S32 outside_bits = _mm_movemask_ps(outside);
+        S32 partial_bits = _mm_movemask_ps(partial);
+        for (U32 k = 0; k <= last; k++)
+        {
+            results[first + k] = (outside_bits & (1 << k)) ? 0 : ((partial_bits & (1 << k)) ? 1 : 2);
+        }
+    }
+}
+
 int LLCamera::sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius)
 {
     LLVector3 dist = sphere_center-mFrustCenter;
@@ -148,6 +148,7 @@ public:
     virtual ~LLCamera() = default;
 
     bool isChanged(); //check if mAgentPlanes changed since last frame.
+    bool sameAgentFrustum(const LLCamera& other) const; //check if agent space frustum tests give exactly the same results for other.
 
     LLPlane getUserClipPlane();
     void setUserClipPlane(const LLPlane& plane);
@@ -202,6 +203,14 @@ public:
     S32 AABBInFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius, const LLPlane* planes = NULL);
     S32 AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius);
 
+    // Same tests for count boxes at once, writing 0, 1 or 2 for each to results.
+    // Boxes are tested four at a time with SIMD and the results always match
+    // the single box versions above.
+    void AABBsInFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes = NULL) const;
+    void AABBsInRegionFrustum(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results) const;
+    void AABBsInFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results, const LLPlane* planes = NULL) const;
+    void AABBsInRegionFrustumNoFarClip(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results) const;
+
     //does a quick 'n dirty sphere-sphere check
     S32 sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius);
 
@@ -215,6 +224,8 @@ public:
     friend std::ostream& operator<<(std::ostream &s, const LLCamera &C);
 
 protected:
+    void AABBsInPlanes(const LLVector4a* centers, const LLVector4a* radii, U32 count, S32* results,
+                       const LLPlane* planes, U32 skip_plane) const;
     void calculateFrustumPlanes();
     void calculateFrustumPlanes(F32 left, F32 right, F32 top, F32 bottom);
     void calculateFrustumPlanesFromWindow(F32 x1, F32 y1, F32 x2, F32 y2);
@@ -0,0 +1,165 @@
+/**
+ * @file   lllightclusters.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for lllightclusters.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lllightclusters.h"
+#include "llmath.h"
+
+#include <algorithm>
+#include <cmath>
+
+LLLightClusters::LLLightClusters()
+:   mTanX(1.f),
+    mTanY(1.f),
+    mNear(0.1f),
+    mFar(512.f),
+    mSliceScale(1.f),
+    mLightCount(0)
+{
+    mGrid.resize(CLUSTER_COUNT * 2, 0);
+}
+
+void LLLightClusters::setup(F32 tan_x, F32 tan_y, F32 near_dist, F32 far_dist)
+{
+    mTanX = llmax(tan_x, F_APPROXIMATELY_ZERO);
+    mTanY = llmax(tan_y, F_APPROXIMATELY_ZERO);
+    mNear = llmax(near_dist, F_APPROXIMATELY_ZERO);
+    mFar = llmax(far_dist, mNear * 2.f);
+    mSliceScale = SLICES / logf(mFar / mNear);
+    mLightCount = 0;
+    mSpans.clear();
+}
+
+U32 LLLightClusters::getSlice(F32 depth) const
+{
+    if (depth <= mNear)
+    {
+        return 0;
+    }
+    S32 slice = (S32)floorf(logf(depth / mNear) * mSliceScale);
+    return (U32)llclamp(slice, 0, (S32)SLICES - 1);
+}
+
+F32 LLLightClusters::sliceNear(U32 slice) const
+{
+    return mNear * expf(slice / mSliceScale);
+}
+
+void LLLightClusters::tileRange(F32 lo, F32 hi, F32 d0, F32 d1, F32 tan, U32 tiles, U8& first, U8& last) const
+{
+    // x / depth is monotonic in each, so the extremes are at the corners
+    F32 ndc_min = llmin(lo / (d0 * tan), lo / (d1 * tan));
+    F32 ndc_max = llmax(hi / (d0 * tan), hi / (d1 * tan));
+
+    if (ndc_max < -1.f || ndc_min > 1.f)
+    {
+        first = 1;
+        last = 0;
+        return;
+    }
+
+    S32 t0 = (S32)floorf((ndc_min + 1.f) * 0.5f * tiles);
+    S32 t1 = (S32)floorf((ndc_max + 1.f) * 0.5f * tiles);
+    first = (U8)llclamp(t0, 0, (S32)tiles - 1);
+    last = (U8)llclamp(t1, 0, (S32)tiles - 1);
+}
+
+bool LLLightClusters::addLight(const LLVector3& center, F32 radius, U16 light_index)
+{
+    F32 depth = -center.mV[VZ];
+    // nothing nearer than the near plane is ever shaded
+    F32 d_min = llmax(depth - radius, mNear);
+    F32 d_max = depth + radius;
+    if (d_max < mNear || d_min > mFar || radius <= 0.f)
+    {
+        return false;
+    }
+
+    U32 s0 = getSlice(d_min);
+    U32 s1 = getSlice(d_max);
+
+    bool added = false;
+    for (U32 slice = s0; slice <= s1; ++slice)
+    {
+        F32 a = llmax(d_min, sliceNear(slice));
+        F32 b = (slice == SLICES - 1) ? d_max : llmin(d_max, sliceNear(slice + 1));
+        if (a > b)
+        {
+            continue;
+        }
+
+        // widest cross section of the sphere within [a, b]
+        F32 dz = (depth < a) ? a - depth : ((depth > b) ? depth - b : 0.f);
+        F32 r = sqrtf(llmax(radius * radius - dz * dz, 0.f));
+
+        Span span;
+        tileRange(center.mV[VX] - r, center.mV[VX] + r, a, b, mTanX, TILES_X, span.mX0, span.mX1);
+        if (span.mX0 > span.mX1)
+        {
+            continue;
+        }
+        tileRange(center.mV[VY] - r, center.mV[VY] + r, a, b, mTanY, TILES_Y, span.mY0, span.mY1);
+        if (span.mY0 > span.mY1)
+        {
+            continue;
+        }
+
+        span.mLight = light_index;
+        span.mSlice = (U8)slice;
+        mSpans.push_back(span);
+        added = true;
+    }
+
+    if (added)
+    {
+        ++mLightCount;
+    }
+    return added;
+}
+
+void LLLightClusters::build()
+{
+    // count, prefix sum, then fill: two passes over the spans
+    std::fill(mGrid.begin(), mGrid.end(), 0);
+    for (const Span& span : mSpans)
+    {
+        for (U32 y = span.mY0; y <= span.mY1; ++y)
+        {
+            U32 row = (span.mSlice * TILES_Y + y) * TILES_X;
+            for (U32 x = span.mX0; x <= span.mX1; ++x)
+            {
+                ++mGrid[(row + x) * 2 + 1];
+            }
+        }
+    }
+
+    U32 offset = 0;
+    for (U32 i = 0; i < CLUSTER_COUNT; ++i)
+    {
+        mGrid[i * 2] = offset;
+        offset += mGrid[i * 2 + 1];
+        mGrid[i * 2 + 1] = 0;
+    }
+
+    mIndices.resize(offset);
+    for (const Span& span : mSpans)
+    {
+        for (U32 y = span.mY0; y <= span.mY1; ++y)
+        {
+            U32 row = (span.mSlice * TILES_Y + y) * TILES_X;
+            for (U32 x = span.mX0; x <= span.mX1; ++x)
+            {
+                U32 cluster = (row + x) * 2;
+                mIndices[mGrid[cluster] + mGrid[cluster + 1]++] = span.mLight;
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file   lllightclusters.h
+ * @date   2026-10-18
+ * @brief  LLLightClusters bins point lights into a view-space froxel grid
+ *         for clustered deferred lighting.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLLIGHTCLUSTERS_H
+#define LL_LLLIGHTCLUSTERS_H
+
+#include "stdtypes.h"
+#include "v3math.h"
+#include <vector>
+
+/**
+ * Divides the view frustum into TILES_X x TILES_Y tiles on screen and
+ * SLICES depth slices, spaced exponentially between the near and far
+ * distances, and lists for each resulting cluster the lights whose sphere
+ * may reach into it.
+ *
+ * Everything is in GL view space: the camera looks down -Z, and a point
+ * (x, y, z) lands in tile column floor((x / (-z * tan_x) + 1) / 2 * TILES_X),
+ * using the tangents passed to setup(). A shader that finds its cluster the
+ * same way, from the view-space position of the pixel, agrees with the
+ * binning whatever projection was actually used to draw.
+ *
+ * Usage per frame: setup(), addLight() for each light, then build() and
+ * upload getGrid() and getIndices().
+ */
+class LLLightClusters
+{
+public:
+    static const U32 TILES_X = 16;
+    static const U32 TILES_Y = 9;
+    static const U32 SLICES = 24;
+    static const U32 CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+
+    LLLightClusters();
+
+    // tan_x and tan_y are the tangents of the half field of view
+    void setup(F32 tan_x, F32 tan_y, F32 near_dist, F32 far_dist);
+
+    // center is in view space; returns false if the light misses every cluster
+    bool addLight(const LLVector3& center, F32 radius, U16 light_index);
+
+    // fill the grid and index list from the lights added since setup()
+    void build();
+
+    // Two entries per cluster, in the order x + y * TILES_X +
+    // slice * TILES_X * TILES_Y: offset into getIndices(), then count.
+    const std::vector<U32>& getGrid() const { return mGrid; }
+    const std::vector<U16>& getIndices() const { return mIndices; }
+
+    U32 getLightCount() const { return mLightCount; }
+
+    // multiplier such that slice = floor(log(depth / near) * getSliceScale())
+    F32 getSliceScale() const { return mSliceScale; }
+    F32 getNear() const { return mNear; }
+    F32 getTanX() const { return mTanX; }
+    F32 getTanY() const { return mTanY; }
+
+    // slice holding a point at the given distance in front of the camera
+    U32 getSlice(F32 depth) const;
+
+private:
+    // the clusters one light covers within one slice
+    struct Span
+    {
+        U16 mLight;
+        U8 mSlice;
+        U8 mX0, mX1, mY0, mY1;
+    };
+
+    // tile range covered by the box [lo, hi] between two depths
+    void tileRange(F32 lo, F32 hi, F32 d0, F32 d1, F32 tan, U32 tiles, U8& first, U8& last) const;
+    F32 sliceNear(U32 slice) const;
+
+    F32 mTanX;
+    F32 mTanY;
+    F32 mNear;
+    F32 mFar;
+    F32 mSliceScale;
+    U32 mLightCount;
+
+    std::vector<Span> mSpans;
+    std::vector<U32> mGrid;
+    std::vector<U16> mIndices;
+};
+
+#endif // LL_LLLIGHTCLUSTERS_H
@@ -30,6 +30,7 @@
 #include "lltreenode.h"
 #include "v3math.h"
 #include "llvector4a.h"
+#include "llmemory.h"
 #include <vector>
 #include "fix_macros.h"
 #include <boost/pool/pool.hpp>
@@ -59,6 +60,52 @@ extern float gOctreeMinSize;
 // the tree.
 template <class T, typename T_PTR> class LLOctreeNode;
 
+// Fixed size, 16 byte aligned blocks for the branches of one octree.
+// Branches come and go constantly as elements move, and taking them from
+// their own tree's pool keeps them together in memory and off the general
+// heap. Freed blocks are reused by the same tree and only go back to the
+// system when the tree is destroyed. Like the tree itself, not thread safe.
+// Most trees are small (a volume face or GLTF primitive gets one each), so
+// the first block is sized from the number of elements the tree expects and
+// each block after it is twice the size of the last.
+class LLOctreeNodePool
+{
+public:
+    LLOctreeNodePool(size_t node_size, U32 expected_elements)
+    :   mBlocks(node_size, firstBlockNodes(expected_elements))
+    {
+    }
+
+    void* allocateNode()            { return mBlocks.malloc(); }
+    void freeNode(void* node)       { mBlocks.free(node); }
+
+private:
+    enum
+    {
+        MIN_FIRST_BLOCK_NODES = 4,
+        MAX_FIRST_BLOCK_NODES = 64
+    };
+
+    // about two branches per full leaf, for the branches above the leaves
+    // and those left part full
+    static U32 firstBlockNodes(U32 expected_elements)
+    {
+        U32 leaves = expected_elements / llmax(gOctreeMaxCapacity, 1U);
+        return llclamp(leaves * 2, (U32)MIN_FIRST_BLOCK_NODES, (U32)MAX_FIRST_BLOCK_NODES);
+    }
+
+    struct AlignedAllocator
+    {
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        static char* malloc(const size_type bytes)  { return (char*)ll_aligned_malloc_16(bytes); }
+        static void free(char* const block)         { ll_aligned_free_16(block); }
+    };
+
+    boost::pool<AlignedAllocator> mBlocks;
+};
+
 template <class T, typename T_PTR>
 class LLOctreeListener: public LLTreeListener<T>
 {
@@ -94,10 +141,9 @@ public:
 
     typedef LLOctreeTraveler<T, T_PTR>                          oct_traveler;
     typedef LLTreeTraveler<T>                                   tree_traveler;
-    typedef std::vector<T_PTR>                                  element_list;
+    typedef LLTreeNodeList<T_PTR, 4>                            element_list;
     typedef typename element_list::iterator                     element_iter;
     typedef typename element_list::const_iterator               const_element_iter;
-    typedef typename std::vector<LLTreeListener<T>*>::iterator  tree_listener_iter;
     typedef LLOctreeNode<T, T_PTR>**                            child_list;
     typedef LLOctreeNode<T, T_PTR>**                            child_iter;
 
@@ -107,7 +153,7 @@ public:
 
     enum
     {
-        NO_CHILD_NODES = 255 // Note: This is an U8 to match the max value in mChildMap[]
+        NO_CHILD_NODES = 255 // Note: This is an U8 to match the max value of an octant
     };
 
     LLOctreeNode(   const LLVector4a& center,
@@ -115,6 +161,7 @@ public:
                     BaseType* parent,
                     U8 octant = NO_CHILD_NODES)
     :   mParent((oct_node*)parent),
+        mPool(parent ? ((oct_node*)parent)->mPool : NULL),
         mOctant(octant)
     {
         llassert(size[0] >= gOctreeMinSize*0.5f);
@@ -146,7 +193,32 @@ public:
 
         for (U32 i = 0; i < getChildCount(); i++)
         {
-            delete getChild(i);
+            deleteNode(getChild(i));
+        }
+    }
+
+    // Branches live in their tree's pool, if it has one. The root is owned
+    // by whoever created the tree and is never passed here.
+    oct_node* createNode(const LLVector4a& center, const LLVector4a& size)
+    {
+        if (mPool)
+        {   // class operator new hides placement new
+            return ::new (mPool->allocateNode()) oct_node(center, size, this);
+        }
+        return new oct_node(center, size, this);
+    }
+
+    static void deleteNode(oct_node* node)
+    {
+        LLOctreeNodePool* pool = node->mPool;
+        if (pool)
+        {
+            node->~oct_node();
+            pool->freeNode(node);
+        }
+        else
+        {
+            delete node;
         }
     }
 
@@ -252,17 +324,27 @@ public:
     U32 getChildCount() const                       { return mChildCount; }
     oct_node* getChild(U32 index)                   { return mChild[index]; }
     const oct_node* getChild(U32 index) const       { return mChild[index]; }
-    child_list& getChildren()                       { return mChild; }
-    const child_list& getChildren() const           { return mChild; }
+    child_list getChildren()                        { return mChild; }
+    const oct_node* const* getChildren() const      { return mChild; }
+
+    // index into getChildren() of the child in octant, or NO_CHILD_NODES
+    U8 getChildIndex(U8 octant) const
+    {
+        if (!(mChildMask & (1 << octant)))
+        {
+            return NO_CHILD_NODES;
+        }
+        return countBits(mChildMask & ((1 << octant) - 1));
+    }
 
     void accept(tree_traveler* visitor) const       { visitor->visit(this); }
     void accept(oct_traveler* visitor) const        { visitor->visit(this); }
 
     void validateChildMap()
     {
-        for (U32 i = 0; i < 8; i++)
+        for (U8 i = 0; i < 8; i++)
         {
-            U8 idx = mChildMap[i];
+            U8 idx = getChildIndex(i);
             if (idx != NO_CHILD_NODES)
             {
                 oct_node* child = mChild[idx];
@@ -294,13 +376,13 @@ public:
             //at the appropriate octant or is smaller than the object.
             //by definition, that node is the smallest node that contains
             // the data
-            U8 next_node = node->mChildMap[octant];
+            U8 next_node = node->getChildIndex(octant);
 
             while (next_node != NO_CHILD_NODES && node->getSize()[0] >= rad)
             {
                 node = node->getChild(next_node);
                 octant = node->getOctant(pos);
-                next_node = node->mChildMap[octant];
+                next_node = node->getChildIndex(octant);
             }
         }
         else if (!node->contains(rad) && node->getParent())
@@ -392,7 +474,7 @@ public:
 
                 llassert(size[0] >= gOctreeMinSize*0.5f);
                 //make the new kid
-                child = new oct_node(center, size, this);
+                child = createNode(center, size);
                 addChild(child);
 
                 child->insert(data);
@@ -498,7 +580,7 @@ public:
     void clearChildren()
     {
         mChildCount = 0;
-        memset(mChildMap, NO_CHILD_NODES, sizeof(mChildMap));
+        mChildMask = 0;
     }
 
     void validate()
@@ -525,7 +607,7 @@ public:
         for (U32 i = 0; i < getChildCount(); i++)
         {
             mChild[i]->destroy();
-            delete mChild[i];
+            deleteNode(mChild[i]);
         }
     }
 
@@ -550,15 +632,21 @@ public:
             }
         }
 
-        if (mChild.size() >= 8)
+        if (mChildCount >= 8)
         {
             OCT_ERRS <<"Octree node has too many children... why?" << LL_ENDL;
         }
 #endif
 
-        mChildMap[child->getOctant()] = mChildCount;
-
-        mChild[mChildCount] = child;
+        // children are kept in octant order so the mask can index them
+        U8 octant = child->getOctant();
+        U32 index = countBits(mChildMask & ((1 << octant) - 1));
+        for (U32 i = mChildCount; i > index; --i)
+        {
+            mChild[i] = mChild[i - 1];
+        }
+        mChild[index] = child;
+        mChildMask |= (1 << octant);
         ++mChildCount;
         child->setParent(this);
 
@@ -580,22 +668,19 @@ public:
             listener->handleChildRemoval(this, getChild(index));
         }
 
+        mChildMask &= ~(1 << mChild[index]->getOctant());
+
         if (destroy)
         {
             mChild[index]->destroy();
-            delete mChild[index];
+            deleteNode(mChild[index]);
         }
 
         --mChildCount;
 
-        mChild[index] = mChild[mChildCount];
-
-        //rebuild child map
-        memset(mChildMap, NO_CHILD_NODES, sizeof(mChildMap));
-
-        for (U32 i = 0; i < mChildCount; ++i)
+        for (U32 i = index; i < mChildCount; ++i)
         {
-            mChildMap[mChild[i]->getOctant()] = i;
+            mChild[i] = mChild[i + 1];
         }
 
         checkAlive();
@@ -628,6 +713,13 @@ public:
     }
 
 protected:
+    static U8 countBits(U32 mask)
+    {
+        mask = mask - ((mask >> 1) & 0x55);
+        mask = (mask & 0x33) + ((mask >> 2) & 0x33);
+        return (U8)((mask + (mask >> 4)) & 0x0F);
+    }
+
     typedef enum
     {
         CENTER = 0,
@@ -642,28 +734,37 @@ protected:
     LLVector4a mMin;
 
     oct_node* mParent;
+    LLOctreeNodePool* mPool;
     U8 mOctant;
 
+    // bit n is set when there is a child in octant n
+    U8 mChildMask;
+    U8 mChildCount;
+    // the first mChildCount entries are used, in octant order
     oct_node* mChild[8];
-    U8 mChildMap[8];
-    U32 mChildCount;
 
     element_list mData;
 };
 
 //just like a regular node, except it might expand on insert and compress on balance
+//owns the pool its branches are allocated from; the pool is a base listed
+//ahead of the node so that it outlives the branches the node destroys
 template <class T, typename T_PTR>
-class LLOctreeRoot : public LLOctreeNode<T, T_PTR>
+class LLOctreeRoot : private LLOctreeNodePool, public LLOctreeNode<T, T_PTR>
 {
 public:
     typedef LLOctreeNode<T, T_PTR> BaseType;
     typedef LLOctreeNode<T, T_PTR> oct_node;
 
+    // expected_elements only sizes the first block of the branch pool
     LLOctreeRoot(const LLVector4a& center,
                  const LLVector4a& size,
-                 BaseType* parent)
-    :   BaseType(center, size, parent)
+                 BaseType* parent,
+                 U32 expected_elements = 0)
+    :   LLOctreeNodePool(sizeof(oct_node), expected_elements),
+        BaseType(center, size, parent)
     {
+        this->mPool = this;
     }
 
     bool balance() override
@@ -693,7 +794,7 @@ public:
 
             //destroy child
             child->clearChildren();
-            delete child;
+            oct_node::deleteNode(child);
 
             return false;
         }
@@ -786,7 +887,7 @@ public:
                 llassert(size[0] >= gOctreeMinSize);
 
                 //copy our children to a new branch
-                oct_node* newnode = new oct_node(center, size, this);
+                oct_node* newnode = this->createNode(center, size);
 
                 for (U32 i = 0; i < this->getChildCount(); i++)
                 {
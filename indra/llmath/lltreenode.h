@@ -31,12 +31,101 @@
 #include "llpointer.h"
 #include "llrefcount.h"
 
+#include <utility>
 #include <vector>
 
 template <class T> class LLTreeNode;
 template <class T> class LLTreeTraveler;
 template <class T> class LLTreeListener;
 
+// Array of pointers that keeps its first N entries inside the owning object
+// and only goes to the heap when it outgrows them. Tree nodes mostly have one
+// listener and a handful of elements, so this saves an allocation (and a
+// cache miss on every traversal) per list. Erasing is left to the caller,
+// which swaps the last entry into the gap and pops it.
+template <typename T_PTR, U32 N>
+class LLTreeNodeList
+{
+public:
+    typedef T_PTR*          iterator;
+    typedef const T_PTR*    const_iterator;
+
+    LLTreeNodeList()
+    :   mData(mInline),
+        mSize(0),
+        mCapacity(N)
+    {
+    }
+
+    ~LLTreeNodeList()
+    {
+        clear();
+        if (mData != mInline)
+        {
+            delete [] mData;
+        }
+    }
+
+    LLTreeNodeList(const LLTreeNodeList&) = delete;
+    LLTreeNodeList& operator=(const LLTreeNodeList&) = delete;
+
+    U32 size() const                        { return mSize; }
+    bool empty() const                      { return mSize == 0; }
+    T_PTR& operator[](U32 index)            { return mData[index]; }
+    const T_PTR& operator[](U32 index) const { return mData[index]; }
+    iterator begin()                        { return mData; }
+    iterator end()                          { return mData + mSize; }
+    const_iterator begin() const            { return mData; }
+    const_iterator end() const              { return mData + mSize; }
+    const_iterator cbegin() const           { return mData; }
+    const_iterator cend() const             { return mData + mSize; }
+
+    void push_back(const T_PTR& value)
+    {
+        if (mSize == mCapacity)
+        {
+            grow();
+        }
+        mData[mSize++] = value;
+    }
+
+    void pop_back()
+    {
+        mData[--mSize] = T_PTR();
+    }
+
+    void clear()
+    {
+        while (mSize > 0)
+        {
+            pop_back();
+        }
+    }
+
+private:
+    void grow()
+    {
+        U32 capacity = llmax(mCapacity * 2, (U32)8);
+        T_PTR* data = new T_PTR[capacity];
+        for (U32 i = 0; i < mSize; ++i)
+        {
+            data[i] = std::move(mData[i]);
+            mData[i] = T_PTR();
+        }
+        if (mData != mInline)
+        {
+            delete [] mData;
+        }
+        mData = data;
+        mCapacity = capacity;
+    }
+
+    T_PTR* mData;
+    U32 mSize;
+    U32 mCapacity;
+    T_PTR mInline[N];
+};
+
 template <class T>
 class LLTreeListener: public LLRefCount
 {
@@ -78,7 +167,8 @@ protected:
     }
 
 public:
-    std::vector<LLPointer<LLTreeListener<T> > > mListeners;
+    // nearly every node has exactly one listener
+    LLTreeNodeList<LLPointer<LLTreeListener<T> >, 1> mListeners;
 };
 
 template <class T>
@@ -4733,6 +4733,7 @@ LLVolumeFace::LLVolumeFace() :
     mExtents[0].splat(-0.5f);
     mExtents[1].splat(0.5f);
     mCenter = mExtents+2;
+    updateMemClaim();
 }
 
 LLVolumeFace::LLVolumeFace(const LLVolumeFace& src)
@@ -4860,6 +4861,8 @@ LLVolumeFace& LLVolumeFace::operator=(const LLVolumeFace& src)
     mOptimized = src.mOptimized;
     mNormalizedScale = src.mNormalizedScale;
 
+    updateMemClaim();
+
     //delete
     return *this;
 }
@@ -4897,6 +4900,42 @@ void LLVolumeFace::freeData()
 #endif
 
     destroyOctree();
+    updateMemClaim();
+}
+
+void LLVolumeFace::updateMemClaim()
+{
+    U32 bytes = 0;
+    if (mExtents)
+    {
+        bytes += sizeof(LLVector4a) * 3;
+    }
+    if (mPositions)
+    {
+        bytes += sizeof(LLVector4a) * 2 * mNumAllocatedVertices + ((mNumAllocatedVertices * sizeof(LLVector2) + 0xF) & ~0xF);
+    }
+    if (mTangents)
+    {
+        bytes += sizeof(LLVector4a) * mNumVertices;
+    }
+    if (mWeights)
+    {
+        bytes += sizeof(LLVector4a) * mNumVertices;
+    }
+    if (mIndices)
+    {
+        bytes += (mNumIndices * sizeof(U16) + 0xF) & ~0xF;
+    }
+
+    if (bytes > mClaimedBytes)
+    {
+        LLMemTag::claim(mMemTag, bytes - mClaimedBytes);
+    }
+    else if (bytes < mClaimedBytes)
+    {
+        LLMemTag::disclaim(mMemTag, mClaimedBytes - bytes);
+    }
+    mClaimedBytes = bytes;
 }
 
 BOOL LLVolumeFace::create(LLVolume* volume, BOOL partial_build)
@@ -5012,6 +5051,8 @@ void LLVolumeFace::remap()
     mTexCoords = remap_tex_coords;
     mNumVertices = remap_vertices_count;
     mNumAllocatedVertices = remap_vertices_count;
+
+    updateMemClaim();
 }
 
 void LLVolumeFace::optimize(F32 angle_cutoff)
@@ -5595,8 +5636,8 @@ void LLVolumeFace::createOctree(F32 scaler, const LLVector4a& center, const LLVe
 
     llassert(mNumIndices % 3 == 0);
 
-    mOctree = new LLVolumeOctree(center, size);
     const U32 num_triangles = mNumIndices / 3;
+    mOctree = new LLVolumeOctree(center, size, num_triangles);
     // Initialize all the triangles we need
     mOctreeTriangles = new LLVolumeTriangle[num_triangles];
 
@@ -5683,6 +5724,9 @@ void LLVolumeFace::swapData(LLVolumeFace& rhs)
     llswap(rhs.mIndices,mIndices);
     llswap(rhs.mNumVertices, mNumVertices);
     llswap(rhs.mNumIndices, mNumIndices);
+
+    updateMemClaim();
+    rhs.updateMemClaim();
 }
 
 void    LerpPlanarVertex(LLVolumeFace::VertexData& v0,
@@ -6454,6 +6498,8 @@ void LLVolumeFace::resizeVertices(S32 num_verts)
 
     // Force update
     mJointRiggingInfoTab.clear();
+
+    updateMemClaim();
 }
 
 void LLVolumeFace::pushVertex(const LLVolumeFace::VertexData& cv)
@@ -6502,6 +6548,7 @@ void LLVolumeFace::pushVertex(const LLVector4a& pos, const LLVector4a& norm, con
 
         mNumAllocatedVertices = new_verts;
 
+        updateMemClaim();
     }
 
     mPositions[mNumVertices] = pos;
@@ -6515,13 +6562,14 @@ void LLVolumeFace::allocateTangents(S32 num_verts)
 {
     ll_aligned_free_16(mTangents);
     mTangents = (LLVector4a*) ll_aligned_malloc_16(sizeof(LLVector4a)*num_verts);
+    updateMemClaim();
 }
 
 void LLVolumeFace::allocateWeights(S32 num_verts)
 {
     ll_aligned_free_16(mWeights);
     mWeights = (LLVector4a*)ll_aligned_malloc_16(sizeof(LLVector4a)*num_verts);
-
+    updateMemClaim();
 }
 
 void LLVolumeFace::allocateJointIndices(S32 num_verts)
@@ -6561,6 +6609,8 @@ void LLVolumeFace::resizeIndices(S32 num_indices)
         // Either num_indices is zero or allocation failure
         mNumIndices = 0;
     }
+
+    updateMemClaim();
 }
 
 void LLVolumeFace::pushIndex(const U16& idx)
@@ -6576,6 +6626,11 @@ void LLVolumeFace::pushIndex(const U16& idx)
     }
 
     mIndices[mNumIndices++] = idx;
+
+    if (new_size != old_size)
+    {
+        updateMemClaim();
+    }
 }
 
 void LLVolumeFace::fillFromLegacyData(std::vector<LLVolumeFace::VertexData>& v, std::vector<U16>& idx)
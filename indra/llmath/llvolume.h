@@ -58,6 +58,7 @@ class LLVolumeOctree;
 #include "llrefcount.h"
 #include "llpointer.h"
 #include "llfile.h"
+#include "llmemtag.h"
 #include "llalignedarray.h"
 #include "llrigginginfo.h"
 
@@ -989,6 +990,12 @@ private:
     LLVolumeOctree* mOctree;
     LLVolumeTriangle* mOctreeTriangles;
 
+    // bring the LLMemTag accounting for this face in line with its buffers
+    void updateMemClaim();
+
+    LLMemTag::ETag mMemTag = LLMemTag::current(LLMemTag::VOLUME);
+    U32 mClaimedBytes = 0;
+
     BOOL createUnCutCubeCap(LLVolume* volume, BOOL partial_build = FALSE);
     BOOL createCap(LLVolume* volume, BOOL partial_build = FALSE);
     BOOL createSide(LLVolume* volume, BOOL partial_build = FALSE);
@@ -220,16 +220,16 @@ public:
 class LLVolumeOctree : public LLOctreeRoot<LLVolumeTriangle, LLVolumeTriangle*>, public LLRefCount
 {
 public:
-    LLVolumeOctree(const LLVector4a& center, const LLVector4a& size)
+    LLVolumeOctree(const LLVector4a& center, const LLVector4a& size, U32 num_triangles = 0)
         :
-        LLOctreeRoot<LLVolumeTriangle, LLVolumeTriangle*>(center, size, nullptr),
+        LLOctreeRoot<LLVolumeTriangle, LLVolumeTriangle*>(center, size, nullptr, num_triangles),
         LLRefCount()
     {
         new LLVolumeOctreeListener(this);
     }
 
-    LLVolumeOctree()
-        : LLOctreeRoot<LLVolumeTriangle, LLVolumeTriangle*>(LLVector4a::getZero(), LLVector4a(1.f,1.f,1.f), nullptr),
+    explicit LLVolumeOctree(U32 num_triangles = 0)
+        : LLOctreeRoot<LLVolumeTriangle, LLVolumeTriangle*>(LLVector4a::getZero(), LLVector4a(1.f,1.f,1.f), nullptr, num_triangles),
         LLRefCount()
     {
         new LLVolumeOctreeListener(this);
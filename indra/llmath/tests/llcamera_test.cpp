@@ -0,0 +1,174 @@
+/**
+ * @file   llcamera_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llcamera.cpp.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+#include "../llcamera.h"
+
+#include <random>
+
+namespace
+{
+    // a camera at origin looking down -z with its agent frustum planes set up
+    void setup_camera(LLCamera& camera, const LLVector3& origin)
+    {
+        camera.setOrigin(origin);
+        LLVector3 frust[LLCamera::AGENT_FRUSTRUM_NUM] =
+        {
+            LLVector3(-1.f, -1.f, -1.f), LLVector3(1.f, -1.f, -1.f),
+            LLVector3(1.f, 1.f, -1.f), LLVector3(-1.f, 1.f, -1.f),
+            LLVector3(-64.f, -64.f, -64.f), LLVector3(64.f, -64.f, -64.f),
+            LLVector3(64.f, 64.f, -64.f), LLVector3(-64.f, 64.f, -64.f)
+        };
+        for (LLVector3& corner : frust)
+        {
+            corner += origin;
+        }
+        camera.calcAgentFrustumPlanes(frust);
+    }
+
+    // boxes around the camera, many of them crossing a plane
+    void make_boxes(std::vector<LLVector4a>& centers, std::vector<LLVector4a>& radii, U32 count, const LLVector3& origin)
+    {
+        std::mt19937 rand(3);
+        std::uniform_real_distribution<F32> pos(-80.f, 80.f);
+        std::uniform_real_distribution<F32> size(0.1f, 10.f);
+        centers.resize(count);
+        radii.resize(count);
+        for (U32 i = 0; i < count; ++i)
+        {
+            centers[i].set(origin.mV[0] + pos(rand), origin.mV[1] + pos(rand), origin.mV[2] + pos(rand));
+            radii[i].set(size(rand), size(rand), size(rand));
+        }
+    }
+}
+
+namespace tut
+{
+    struct LLCameraData
+    {
+    };
+
+    typedef test_group<LLCameraData> factory;
+    typedef factory::object object;
+}
+
+namespace
+{
+    tut::factory llcamera_test_factory("LLCamera");
+}
+
+namespace tut
+{
+    template<> template<>
+    void object::test<1>()
+    {
+        LLCamera camera;
+        setup_camera(camera, LLVector3(10.f, 20.f, 30.f));
+
+        LLCamera copy(camera);
+        ensure("copy has the same frustum", camera.sameAgentFrustum(copy));
+
+        LLCamera rebuilt;
+        setup_camera(rebuilt, LLVector3(10.f, 20.f, 30.f));
+        ensure("same inputs give the same frustum", camera.sameAgentFrustum(rebuilt));
+
+        LLCamera moved;
+        setup_camera(moved, LLVector3(10.f, 20.f, 30.001f));
+        ensure("moved camera", !camera.sameAgentFrustum(moved));
+
+        LLCamera clipped(camera);
+        clipped.setUserClipPlane(LLPlane(LLVector3(0.f, 0.f, 20.f), LLVector3(0.f, 0.f, 1.f)));
+        ensure("user clip plane", !camera.sameAgentFrustum(clipped));
+        clipped.disableUserClipPlane();
+        ensure("user clip plane disabled", camera.sameAgentFrustum(clipped));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("batched box tests match single box tests");
+        const LLVector3 origin(10.f, 20.f, 30.f);
+        LLCamera camera;
+        setup_camera(camera, origin);
+        camera.calcRegionFrustumPlanes(LLVector3(5.f, 5.f, 0.f), 64.f);
+
+        // odd count so the last batch is short
+        const U32 COUNT = 1001;
+        std::vector<LLVector4a> centers, radii;
+        make_boxes(centers, radii, COUNT, origin);
+        std::vector<S32> results(COUNT);
+        U32 seen[3] = { 0, 0, 0 };
+
+        for (S32 pass = 0; pass < 2; ++pass)
+        {
+            if (pass)
+            {
+                camera.setUserClipPlane(LLPlane(origin + LLVector3(0.f, 0.f, -10.f), LLVector3(0.f, 0.f, 1.f)));
+            }
+
+            camera.AABBsInFrustum(&centers[0], &radii[0], COUNT, &results[0]);
+            for (U32 i = 0; i < COUNT; ++i)
+            {
+                ensure_equals("frustum", results[i], camera.AABBInFrustum(centers[i], radii[i]));
+                ++seen[results[i]];
+            }
+
+            camera.AABBsInFrustumNoFarClip(&centers[0], &radii[0], COUNT, &results[0]);
+            for (U32 i = 0; i < COUNT; ++i)
+            {
+                ensure_equals("no far clip", results[i], camera.AABBInFrustumNoFarClip(centers[i], radii[i]));
+            }
+
+            camera.AABBsInRegionFrustum(&centers[0], &radii[0], COUNT, &results[0]);
+            for (U32 i = 0; i < COUNT; ++i)
+            {
+                ensure_equals("region", results[i], camera.AABBInRegionFrustum(centers[i], radii[i]));
+            }
+
+            camera.AABBsInRegionFrustumNoFarClip(&centers[0], &radii[0], COUNT, &results[0]);
+            for (U32 i = 0; i < COUNT; ++i)
+            {
+                ensure_equals("region no far clip", results[i], camera.AABBInRegionFrustumNoFarClip(centers[i], radii[i]));
+            }
+        }
+
+        ensure("some boxes outside", seen[0] > 0);
+        ensure("some boxes partly in", seen[1] > 0);
+        ensure("some boxes fully in", seen[2] > 0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("batches of octree children match one batch");
+        const LLVector3 origin(10.f, 20.f, 30.f);
+        LLCamera camera;
+        setup_camera(camera, origin);
+
+        const U32 COUNT = 10000;
+        std::vector<LLVector4a> centers, radii;
+        make_boxes(centers, radii, COUNT, origin);
+        std::vector<S32> flat(COUNT);
+        std::vector<S32> children(COUNT);
+
+        camera.AABBsInFrustumNoFarClip(&centers[0], &radii[0], COUNT, &flat[0]);
+        // the size of the batches an octree node's children make, and the
+        // odd sizes of nodes with fewer children
+        for (U32 i = 0, batch = 1; i < COUNT; i += batch, batch = batch % 8 + 1)
+        {
+            camera.AABBsInFrustumNoFarClip(&centers[i], &radii[i], llmin(COUNT - i, batch), &children[i]);
+        }
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            ensure_equals("same result in small batches", children[i], flat[i]);
+        }
+    }
+}
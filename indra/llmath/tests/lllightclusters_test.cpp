@@ -0,0 +1,135 @@
+/**
+ * @file   lllightclusters_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for lllightclusters.cpp.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+#include "../lllightclusters.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    const F32 TAN_X = 1.f;
+    const F32 TAN_Y = 0.5625f;
+
+    // the cluster a shader would pick for a view space position
+    U32 cluster_of(const LLLightClusters& clusters, const LLVector3& pos)
+    {
+        F32 depth = -pos.mV[VZ];
+        S32 x = (S32)floorf((pos.mV[VX] / (depth * TAN_X) + 1.f) * 0.5f * LLLightClusters::TILES_X);
+        S32 y = (S32)floorf((pos.mV[VY] / (depth * TAN_Y) + 1.f) * 0.5f * LLLightClusters::TILES_Y);
+        x = llclamp(x, 0, (S32)LLLightClusters::TILES_X - 1);
+        y = llclamp(y, 0, (S32)LLLightClusters::TILES_Y - 1);
+        U32 slice = clusters.getSlice(depth);
+        return (slice * LLLightClusters::TILES_Y + y) * LLLightClusters::TILES_X + x;
+    }
+
+    bool cluster_has(const LLLightClusters& clusters, U32 cluster, U16 light)
+    {
+        U32 offset = clusters.getGrid()[cluster * 2];
+        U32 count = clusters.getGrid()[cluster * 2 + 1];
+        for (U32 i = 0; i < count; ++i)
+        {
+            if (clusters.getIndices()[offset + i] == light)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    F32 frand(F32 lo, F32 hi)
+    {
+        return lo + (hi - lo) * (F32)rand() / (F32)RAND_MAX;
+    }
+}
+
+namespace tut
+{
+    struct LLLightClustersData
+    {
+    };
+
+    typedef test_group<LLLightClustersData> factory;
+    typedef factory::object object;
+}
+
+namespace
+{
+    tut::factory lllightclusters_test_factory("LLLightClusters");
+}
+
+namespace tut
+{
+    template<> template<>
+    void object::test<1>()
+    {
+        LLLightClusters clusters;
+        clusters.setup(TAN_X, TAN_Y, 0.5f, 256.f);
+        ensure_equals("near slice", clusters.getSlice(0.1f), 0U);
+        ensure_equals("far slice", clusters.getSlice(1000.f), LLLightClusters::SLICES - 1);
+        ensure("slices increase with depth", clusters.getSlice(10.f) < clusters.getSlice(100.f));
+
+        ensure("light in view", clusters.addLight(LLVector3(0.f, 0.f, -20.f), 2.f, 0));
+        ensure("light behind camera", !clusters.addLight(LLVector3(0.f, 0.f, 20.f), 2.f, 1));
+        ensure("light beyond far", !clusters.addLight(LLVector3(0.f, 0.f, -400.f), 2.f, 2));
+        ensure("light off screen", !clusters.addLight(LLVector3(100.f, 0.f, -20.f), 2.f, 3));
+        clusters.build();
+        ensure_equals(clusters.getLightCount(), 1U);
+
+        ensure("center cluster", cluster_has(clusters, cluster_of(clusters, LLVector3(0.f, 0.f, -20.f)), 0));
+        ensure("corner cluster", !cluster_has(clusters, cluster_of(clusters, LLVector3(-18.f, 10.f, -20.f)), 0));
+        ensure("deeper cluster", !cluster_has(clusters, cluster_of(clusters, LLVector3(0.f, 0.f, -60.f)), 0));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        // every point inside a light's sphere must find that light in its cluster
+        srand(1);
+        LLLightClusters clusters;
+        clusters.setup(TAN_X, TAN_Y, 0.5f, 256.f);
+
+        const U32 LIGHTS = 300;
+        std::vector<LLVector3> centers;
+        std::vector<F32> radii;
+        for (U32 i = 0; i < LIGHTS; ++i)
+        {
+            centers.push_back(LLVector3(frand(-40.f, 40.f), frand(-25.f, 25.f), frand(-80.f, 2.f)));
+            radii.push_back(frand(0.5f, 12.f));
+            clusters.addLight(centers.back(), radii.back(), (U16)i);
+        }
+        clusters.build();
+
+        U32 checked = 0;
+        for (U32 i = 0; i < LIGHTS; ++i)
+        {
+            for (U32 j = 0; j < 50; ++j)
+            {
+                LLVector3 offset(frand(-1.f, 1.f), frand(-1.f, 1.f), frand(-1.f, 1.f));
+                if (offset.lengthSquared() > 1.f)
+                {
+                    continue;
+                }
+                LLVector3 pos = centers[i] + offset * (radii[i] * 0.999f);
+                F32 depth = -pos.mV[VZ];
+                if (depth < 0.5f || fabsf(pos.mV[VX]) > depth * TAN_X || fabsf(pos.mV[VY]) > depth * TAN_Y)
+                {
+                    continue; // not on screen
+                }
+                ensure("light listed where it reaches", cluster_has(clusters, cluster_of(clusters, pos), (U16)i));
+                ++checked;
+            }
+        }
+        ensure("checked enough points", checked > 1000);
+        ensure("indices are sparse", clusters.getIndices().size() < LIGHTS * LLLightClusters::CLUSTER_COUNT / 20);
+    }
+}
@@ -0,0 +1,228 @@
+/**
+ * @file   lloctree_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for lloctree.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+#include "../lloctree.h"
+
+#include <random>
+
+namespace
+{
+    // shaped like a drawable: a position, a bounding radius and a bin index
+    class TestElement
+    {
+    public:
+        TestElement(): mBinRadius(1.f), mBinIndex(-1) { mPosition.clear(); }
+
+        const LLVector4a& getPositionGroup() const  { return mPosition; }
+        F32 getBinRadius() const                    { return mBinRadius; }
+        S32 getBinIndex() const                     { return mBinIndex; }
+        void setBinIndex(S32 idx) const             { mBinIndex = idx; }
+
+        LLVector4a mPosition;
+        F32 mBinRadius;
+        mutable S32 mBinIndex;
+    };
+
+    typedef LLOctreeNode<TestElement, TestElement*> test_node;
+    typedef LLOctreeRoot<TestElement, TestElement*> test_root;
+
+    class CountElements : public LLOctreeTraveler<TestElement, TestElement*>
+    {
+    public:
+        CountElements(): mElements(0), mNodes(0), mChildrenOrdered(true) {}
+
+        void visit(const test_node* node) override
+        {
+            ++mNodes;
+            mElements += node->getElementCount();
+            for (U32 i = 0; i < node->getChildCount(); ++i)
+            {
+                const test_node* child = node->getChild(i);
+                mChildrenOrdered = mChildrenOrdered &&
+                    node->getChildIndex(child->getOctant()) == i &&
+                    (i == 0 || node->getChild(i - 1)->getOctant() < child->getOctant());
+            }
+        }
+
+        U32 mElements;
+        U32 mNodes;
+        bool mChildrenOrdered;
+    };
+
+    // a 256m region, with the spread of sizes found in a busy one
+    void place(TestElement& element, std::mt19937& rand)
+    {
+        std::uniform_real_distribution<F32> pos(0.f, 256.f);
+        std::uniform_real_distribution<F32> radius(0.1f, 8.f);
+        element.mPosition.set(pos(rand), pos(rand), pos(rand) * 0.25f);
+        element.mBinRadius = radius(rand);
+    }
+
+    test_root* make_root(U32 expected_elements = 0)
+    {
+        gOctreeMaxCapacity = 128;
+        gOctreeMinSize = 0.01f;
+        LLVector4a center(128.f, 128.f, 128.f);
+        LLVector4a size(128.f, 128.f, 128.f);
+        return new test_root(center, size, NULL, expected_elements);
+    }
+}
+
+namespace tut
+{
+    struct LLOctreeData
+    {
+        // the tests tune the octree globals; put them back for whatever
+        // runs next in this process
+        LLOctreeData():
+            mMaxCapacity(gOctreeMaxCapacity),
+            mMinSize(gOctreeMinSize)
+        {}
+
+        ~LLOctreeData()
+        {
+            gOctreeMaxCapacity = mMaxCapacity;
+            gOctreeMinSize = mMinSize;
+        }
+
+        const U32 mMaxCapacity;
+        const F32 mMinSize;
+    };
+
+    typedef test_group<LLOctreeData> factory;
+    typedef factory::object object;
+}
+
+namespace
+{
+    tut::factory lloctree_test_factory("LLOctree");
+}
+
+namespace tut
+{
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("children and elements");
+        const U32 COUNT = 5000;
+        std::mt19937 rand(1);
+        std::vector<TestElement> elements(COUNT);
+        test_root* root = make_root(COUNT);
+        for (TestElement& element : elements)
+        {
+            place(element, rand);
+            root->insert(&element);
+        }
+
+        CountElements count;
+        count.traverse(root);
+        ensure_equals("every element is in the tree", count.mElements, COUNT);
+        ensure("children kept in octant order", count.mChildrenOrdered);
+        ensure("tree has branches", count.mNodes > 1);
+
+        // remove every other element; bin indices must stay valid
+        for (U32 i = 0; i < COUNT; i += 2)
+        {
+            ensure("removed", root->remove(&elements[i]));
+            ensure_equals("bin index cleared", elements[i].getBinIndex(), -1);
+        }
+        for (U32 i = 1; i < COUNT; i += 2)
+        {
+            ensure("still binned", elements[i].getBinIndex() >= 0);
+        }
+
+        CountElements half;
+        half.traverse(root);
+        ensure_equals("half left", half.mElements, COUNT / 2);
+        ensure("still in octant order", half.mChildrenOrdered);
+
+        // empty branches free themselves
+        for (U32 i = 1; i < COUNT; i += 2)
+        {
+            root->remove(&elements[i]);
+        }
+        ensure_equals("root has no elements", root->getElementCount(), (U32)0);
+        ensure_equals("root has no children", root->getChildCount(), (U32)0);
+        delete root;
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("element lists grow past their inline space");
+        // all in one spot, so one node ends up holding them
+        const U32 COUNT = 100;
+        std::vector<TestElement> elements(COUNT);
+        test_root* root = make_root();
+        gOctreeMaxCapacity = COUNT;
+        for (TestElement& element : elements)
+        {
+            element.mPosition.set(10.f, 10.f, 10.f);
+            element.mBinRadius = 0.5f;
+            root->insert(&element);
+        }
+
+        test_node* node = root->getNodeAt(&elements[0]);
+        ensure_equals("all in one node", node->getElementCount(), COUNT);
+        for (U32 i = 0; i < COUNT; ++i)
+        {
+            ensure("bin index matches slot", *(node->getDataBegin() + elements[i].getBinIndex()) == &elements[i]);
+        }
+
+        // removing from the middle swaps the last element into the gap
+        node->remove(&elements[3]);
+        ensure_equals("moved into the gap", elements[COUNT - 1].getBinIndex(), 3);
+        ensure_equals("one fewer", node->getElementCount(), COUNT - 1);
+        delete root;
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("100k elements");
+        const U32 COUNT = 100000;
+        std::mt19937 rand(2);
+        std::vector<TestElement> elements(COUNT);
+        for (TestElement& element : elements)
+        {
+            place(element, rand);
+        }
+
+        test_root* root = make_root(COUNT);
+        for (TestElement& element : elements)
+        {
+            root->insert(&element);
+        }
+
+        // what LLSpatialPartition::move does for an object that changed bins
+        std::normal_distribution<F32> nudge(0.f, 2.f);
+        for (TestElement& element : elements)
+        {
+            root->remove(&element);
+            LLVector4a delta(nudge(rand), nudge(rand), nudge(rand));
+            element.mPosition.add(delta);
+            root->insert(&element);
+        }
+
+        CountElements count;
+        count.traverse(root);
+        ensure_equals("every element still in the tree", count.mElements, COUNT);
+        ensure("children kept in octant order", count.mChildrenOrdered);
+
+        for (TestElement& element : elements)
+        {
+            root->remove(&element);
+        }
+        ensure_equals("all removed", root->getChildCount(), (U32)0);
+        delete root;
+    }
+}
@@ -51,6 +51,7 @@ const F32 HTTP_REQUEST_EXPIRY_SECS = 60.0f;
 namespace 
 {
     const std::string   HTTP_LOGBODY_KEY("HTTPLogBodyOnError");
+    const std::string   HTTP_BINARY_LLSD_KEY("HTTPPreferBinaryLLSD");
 
     BoolSettingQuery_t  mBoolSettingGet;
     BoolSettingUpdate_t mBoolSettingPut;
@@ -59,7 +60,17 @@ namespace
     {
         if (!mBoolSettingGet || mBoolSettingGet.empty())
             return(false);
-        return mBoolSettingGet(HTTP_LOGBODY_KEY);
+        return mBoolSettingGet(keyname);
+    }
+
+    // Accept header offered by LLSD handlers when binary LLSD is enabled.
+    // Servers that don't support binary will keep answering with XML.
+    const std::string   HTTP_ACCEPT_LLSD_BINARY_OR_XML(HTTP_CONTENT_LLSD_BINARY + ", " + HTTP_CONTENT_LLSD_XML + ";q=0.5");
+
+    inline bool isBinaryLLSDContent(const std::string &content_type)
+    {
+        // Ignore any parameters following the media type.
+        return content_type.compare(0, HTTP_CONTENT_LLSD_BINARY.size(), HTTP_CONTENT_LLSD_BINARY) == 0;
     }
 
 }
@@ -72,6 +83,7 @@ void setPropertyMethods(BoolSettingQuery_t queryfn, BoolSettingUpdate_t updatefn
     if (mBoolSettingPut && !mBoolSettingPut.empty())
     {
         mBoolSettingPut(HTTP_LOGBODY_KEY, false, "Log the entire HTTP body in the case of an HTTP error.");
+        mBoolSettingPut(HTTP_BINARY_LLSD_KEY, true, "Ask capability servers for binary LLSD instead of LLSD XML.");
     }
 }
 
@@ -105,23 +117,44 @@ private:
 
 
 //=========================================================================
-// *TODO:  Currently converts only from XML content.  A mode
-// to convert using fromBinary() might be useful as well.  Mesh
-// headers could use it.
 bool responseToLLSD(HttpResponse * response, bool log, LLSD & out_llsd)
 {
-    // Convert response to LLSD
-    BufferArray * body(response->getBody());
+    return bodyToLLSD(response->getBody(), response->getContentType(), log, out_llsd);
+}
+
+
+bool bodyToLLSD(const BufferArray * body, const std::string & content_type, bool log, LLSD & out_llsd)
+{
     if (!body || !body->size())
     {
         return false;
     }
 
-    LLCore::BufferArrayStream bas(body);
+    // BufferArrayStream only reads from the array, but wants a
+    // mutable pointer.
+    LLCore::BufferArrayStream bas(const_cast<BufferArray *>(body));
     LLSD body_llsd;
-    S32 parse_status(LLSDSerialize::fromXML(body_llsd, bas, log));
-    if (LLSDParser::PARSE_FAILURE == parse_status){
-        return false;
+    if (isBinaryLLSDContent(content_type))
+    {
+        // Binary bodies may or may not carry the '<?llsd/binary?>' header.
+        if (bas.peek() == '<')
+        {
+            if (!LLSDSerialize::deserialize(body_llsd, bas, body->size()))
+            {
+                return false;
+            }
+        }
+        else if (LLSDParser::PARSE_FAILURE == LLSDSerialize::fromBinary(body_llsd, bas, body->size()))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        S32 parse_status(LLSDSerialize::fromXML(body_llsd, bas, log));
+        if (LLSDParser::PARSE_FAILURE == parse_status){
+            return false;
+        }
     }
     out_llsd = body_llsd;
     return true;
@@ -254,6 +287,11 @@ HttpCoroHandler::HttpCoroHandler(LLEventStream &reply) :
 {
 }
 
+const std::string &HttpCoroHandler::getDefaultAccept() const
+{
+    return HTTP_CONTENT_LLSD_XML;
+}
+
 void HttpCoroHandler::onCompleted(LLCore::HttpHandle handle, LLCore::HttpResponse * response)
 {
     LLSD result;
@@ -375,21 +413,66 @@ void HttpCoroHandler::writeStatusCodes(LLCore::HttpStatus status, const std::str
 ///                      +- ["url"]     - The URL used to make the call.
 ///                      +- ["headers"] - A map of name name value pairs with the HTTP headers.
 ///                      
+/// The body is deserialized on the HTTP worker thread in onReplyReady() so
+/// that large replies don't cost parse time on the thread resuming the
+/// coroutine.  Each handler serves a single request.
+///
 class HttpCoroLLSDHandler : public HttpCoroHandler
 {
 public:
     HttpCoroLLSDHandler(LLEventStream &reply);
 
+    virtual void onReplyReady(LLCore::HttpHandle handle, const LLCore::HttpStatus &status,
+        const LLCore::BufferArray *body, const std::string &content_type);
+
+    virtual const std::string &getDefaultAccept() const;
+
 protected:
     virtual LLSD handleSuccess(LLCore::HttpResponse * response, LLCore::HttpStatus &status);
     virtual LLSD parseBody(LLCore::HttpResponse *response, bool &success);
+
+private:
+    // Written on the worker thread before the reply is queued, read on
+    // the notifier thread afterwards; the reply queue orders the two.
+    LLSD mParsedBody;
+    bool mBodyParsed;
+    bool mParseSuccess;
 };
 
 //-------------------------------------------------------------------------
 HttpCoroLLSDHandler::HttpCoroLLSDHandler(LLEventStream &reply):
-    HttpCoroHandler(reply)
+    HttpCoroHandler(reply),
+    mBodyParsed(false),
+    mParseSuccess(false)
 {
 }
+
+void HttpCoroLLSDHandler::onReplyReady(LLCore::HttpHandle handle, const LLCore::HttpStatus &status,
+    const LLCore::BufferArray *body, const std::string &content_type)
+{
+    // Only the bodies that onCompleted() will look at: successes and 4xx errors.
+    LLCore::HttpStatus::type_enum_t errType = status.getType();
+    if (!status && !((errType >= 400) && (errType < 500)))
+    {
+        return;
+    }
+
+    mParseSuccess = true;
+    if (body && body->size())
+    {
+        mParseSuccess = LLCoreHttpUtil::bodyToLLSD(body, content_type, true, mParsedBody);
+        if (!mParseSuccess)
+        {
+            mParsedBody.clear();
+        }
+    }
+    mBodyParsed = true;
+}
+
+const std::string &HttpCoroLLSDHandler::getDefaultAccept() const
+{
+    return getBoolSetting(HTTP_BINARY_LLSD_KEY) ? HTTP_ACCEPT_LLSD_BINARY_OR_XML : HTTP_CONTENT_LLSD_XML;
+}
     
 
 LLSD HttpCoroLLSDHandler::handleSuccess(LLCore::HttpResponse * response, LLCore::HttpStatus &status)
@@ -430,7 +513,7 @@ LLSD HttpCoroLLSDHandler::handleSuccess(LLCore::HttpResponse * response, LLCore:
         LLCore::HttpHeaders::ptr_t headers(response->getHeaders());
         const std::string *contentType = (headers) ? headers->find(HTTP_IN_HEADER_CONTENT_TYPE) : NULL;
 
-        if (contentType && (HTTP_CONTENT_LLSD_XML == *contentType))
+        if (contentType && ((HTTP_CONTENT_LLSD_XML == *contentType) || isBinaryLLSDContent(*contentType)))
         {
             std::string thebody = LLCoreHttpUtil::responseToString(response);
             LL_WARNS("CoreHTTP") << "Failed to deserialize . " << response->getRequestURL() << " [status:" << response->getStatus().toString() << "] "
@@ -459,6 +542,12 @@ LLSD HttpCoroLLSDHandler::handleSuccess(LLCore::HttpResponse * response, LLCore:
 
 LLSD HttpCoroLLSDHandler::parseBody(LLCore::HttpResponse *response, bool &success)
 {
+    if (mBodyParsed)
+    {   // Already done on the worker thread.
+        success = mParseSuccess;
+        return mParsedBody;
+    }
+
     success = true;
     if (response->getBodySize() == 0)
         return LLSD();
@@ -690,7 +779,7 @@ LLSD HttpCoroutineAdapter::postAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -814,7 +903,7 @@ LLSD HttpCoroutineAdapter::postAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -871,7 +960,7 @@ LLSD HttpCoroutineAdapter::putAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -898,7 +987,7 @@ LLSD HttpCoroutineAdapter::putAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -954,7 +1043,7 @@ LLSD HttpCoroutineAdapter::getAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     HttpCoroHandler::ptr_t &handler)
 {
     HttpRequestPumper pumper(request);
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -1001,7 +1090,7 @@ LLSD HttpCoroutineAdapter::deleteAndSuspend_(LLCore::HttpRequest::ptr_t &request
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
     LLCore::HttpHandle hhandle = request->requestDelete(mPolicyId,
@@ -1037,7 +1126,7 @@ LLSD HttpCoroutineAdapter::patchAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -1079,7 +1168,7 @@ LLSD HttpCoroutineAdapter::copyAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -1121,7 +1210,7 @@ LLSD HttpCoroutineAdapter::moveAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 {
     HttpRequestPumper pumper(request);
 
-    checkDefaultHeaders(headers);
+    checkDefaultHeaders(headers, handler);
 
     // The HTTPCoroHandler does not self delete, so retrieval of a the contained 
     // pointer from the smart pointer is safe in this case.
@@ -1142,13 +1231,13 @@ LLSD HttpCoroutineAdapter::moveAndSuspend_(LLCore::HttpRequest::ptr_t &request,
 }
 
 
-void HttpCoroutineAdapter::checkDefaultHeaders(LLCore::HttpHeaders::ptr_t &headers)
+void HttpCoroutineAdapter::checkDefaultHeaders(LLCore::HttpHeaders::ptr_t &headers, const HttpCoroHandler::ptr_t &handler)
 {
     if (!headers)
         headers = std::make_shared<LLCore::HttpHeaders>();
     if (!headers->find(HTTP_OUT_HEADER_ACCEPT))
     {
-        headers->append(HTTP_OUT_HEADER_ACCEPT, HTTP_CONTENT_LLSD_XML);
+        headers->append(HTTP_OUT_HEADER_ACCEPT, handler ? handler->getDefaultAccept() : HTTP_CONTENT_LLSD_XML);
     }
     if (!headers->find(HTTP_OUT_HEADER_CONTENT_TYPE))
     {
@@ -69,6 +69,9 @@ void setPropertyMethods(BoolSettingQuery_t queryfn, BoolSettingUpdate_t updatefn
 extern const F32 HTTP_REQUEST_EXPIRY_SECS;
 
 /// Attempt to convert a response object's contents to LLSD.
+/// The body is parsed as binary LLSD when the response's
+/// Content-Type is application/llsd+binary and as LLSD XML
+/// otherwise.
 /// It is expected that the response body will be of non-zero
 /// length on input but basic checks will be performed and
 /// and error (false status) returned if there is no data.
@@ -92,6 +95,14 @@ bool responseToLLSD(LLCore::HttpResponse * response,
                     bool log,
                     LLSD & out_llsd);
 
+/// As responseToLLSD() but working directly from a body and its
+/// Content-Type.  Does not touch any shared state and so may be
+/// used from the HTTP worker thread.
+bool bodyToLLSD(const LLCore::BufferArray * body,
+                const std::string & content_type,
+                bool log,
+                LLSD & out_llsd);
+
 /// Create a std::string representation of a response object
 /// suitable for logging.  Mainly intended for logging of
 /// failures and debug information.  This won't be fast,
@@ -274,6 +285,9 @@ public:
 
     virtual void onCompleted(LLCore::HttpHandle handle, LLCore::HttpResponse * response);
 
+    /// The Accept header to send when the caller has not supplied one.
+    virtual const std::string &getDefaultAccept() const;
+
     inline LLEventStream &getReplyPump()
     {
         return mReplyPump;
@@ -303,7 +317,9 @@ private:
 /// Posting through the adapter will automatically add the following headers to
 /// the request if they have not been previously specified in a supplied
 /// HttpHeaders object:
-///     "Accept=application/llsd+xml"
+///     "Accept=application/llsd+xml" (or, for LLSD requests when
+///         HTTPPreferBinaryLLSD is set, "application/llsd+binary"
+///         preferred over XML)
 ///     "X-SecondLife-UDP-Listen-Port=###"
 ///
 class HttpCoroutineAdapter
@@ -666,7 +682,7 @@ private:
     static void trivialPostCoro(std::string url, LLCore::HttpRequest::policy_t policyId, LLSD postData, completionCallback_t success, completionCallback_t failure);
     static void trivialDelCoro(std::string url, LLCore::HttpRequest::policy_t policyId, completionCallback_t success, completionCallback_t failure);
 
-    void checkDefaultHeaders(LLCore::HttpHeaders::ptr_t &headers);
+    void checkDefaultHeaders(LLCore::HttpHeaders::ptr_t &headers, const HttpCoroHandler::ptr_t &handler);
 
     std::string                     mAdapterName;
     LLCore::HttpRequest::policy_t   mPolicyId;
@@ -924,3 +924,43 @@ void LLGLTFMaterial::updateTextureTracking()
     // setTEGLTFMaterialOverride is responsible for tracking
     // for material overrides editor will set it
 }
+
+LLGLTFMaterial* LLGLTFOverrideTable::intern(LLGLTFMaterial* override_mat)
+{
+    // local texture tracking belongs to one instance and is not hashed
+    if (!override_mat || override_mat->hasLocalTextures())
+    {
+        return override_mat;
+    }
+
+    const LLUUID hash = override_mat->getHash();
+    std::pair<override_map_t::iterator, override_map_t::iterator> range = mOverrides.equal_range(hash);
+    for (override_map_t::iterator it = range.first; it != range.second; ++it)
+    {
+        if (*it->second == *override_mat)
+        {
+            return it->second;
+        }
+    }
+
+    mOverrides.emplace(hash, override_mat);
+    return override_mat;
+}
+
+U32 LLGLTFOverrideTable::flush()
+{
+    U32 uses = 0;
+    for (override_map_t::iterator it = mOverrides.begin(); it != mOverrides.end(); )
+    {
+        if (it->second->getNumRefs() == 1)
+        {
+            it = mOverrides.erase(it);
+        }
+        else
+        {
+            uses += it->second->getNumRefs() - 1;
+            ++it;
+        }
+    }
+    return uses;
+}
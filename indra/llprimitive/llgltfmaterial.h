@@ -27,6 +27,7 @@
 #pragma once
 
 #include "llrefcount.h"
+#include "llpointer.h"
 #include "llmemory.h"
 #include "v4color.h"
 #include "v3color.h"
@@ -37,6 +38,7 @@
 #include <array>
 #include <string>
 #include <map>
+#include <unordered_map>
 
 namespace tinygltf
 {
@@ -275,3 +277,28 @@ public:
     bool mOverrideDoubleSided;
     bool mOverrideAlphaMode;
 };
+
+// Material overrides with equal data, shared so that faces carrying the
+// same override (say a tint across a whole build) hold one instance between
+// them. An interned override must not be changed in place: whoever holds one
+// copies it first if it has more than one reference (see
+// LLTextureEntry::setBaseMaterial()). Overrides tracking local textures
+// belong to the face they were made for and are never interned.
+class LLGLTFOverrideTable
+{
+public:
+    // The interned override equal to override_mat, which becomes the
+    // interned one if there is none yet
+    LLGLTFMaterial* intern(LLGLTFMaterial* override_mat);
+
+    // Drops the overrides nothing outside the table uses any more and
+    // returns how many references the rest have from outside it
+    U32 flush();
+
+    size_t size() const { return mOverrides.size(); }
+
+private:
+    // by LLGLTFMaterial::getHash()
+    typedef std::unordered_multimap<LLUUID, LLPointer<LLGLTFMaterial> > override_map_t;
+    override_map_t mOverrides;
+};
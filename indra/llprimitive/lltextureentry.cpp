@@ -122,13 +122,15 @@ LLTextureEntry &LLTextureEntry::operator=(const LLTextureEntry &rhs)
             mGLTFMaterial->addTextureEntry(this);
         }
 
-        if (rhs.mGLTFMaterialOverrides.notNull())
+        // overrides are copied on write, see setBaseMaterial(), except
+        // those tracking local textures, which belong to one face
+        if (rhs.mGLTFMaterialOverrides.notNull() && rhs.mGLTFMaterialOverrides->hasLocalTextures())
         {
             mGLTFMaterialOverrides = new LLGLTFMaterial(*rhs.mGLTFMaterialOverrides);
         }
         else
         {
-            mGLTFMaterialOverrides = nullptr;
+            mGLTFMaterialOverrides = rhs.mGLTFMaterialOverrides;
         }
     }
 
@@ -578,7 +580,17 @@ S32 LLTextureEntry::setBaseMaterial()
 
     if (mGLTFMaterialOverrides)
     {
-        if (mGLTFMaterialOverrides->setBaseMaterial())
+        if (mGLTFMaterialOverrides->getNumRefs() > 1)
+        {
+            // shared with other entries, change a copy
+            LLPointer<LLGLTFMaterial> overrides = new LLGLTFMaterial(*mGLTFMaterialOverrides);
+            if (overrides->setBaseMaterial())
+            {
+                mGLTFMaterialOverrides = overrides;
+                changed = TEM_CHANGE_TEXTURE;
+            }
+        }
+        else if (mGLTFMaterialOverrides->setBaseMaterial())
         {
             changed = TEM_CHANGE_TEXTURE;
         }
@@ -244,6 +244,7 @@ protected:
 
     // GLTF material parameter overrides -- the viewer will use this data to override material parameters
     // set by the asset and store the results in mRenderGLTFMaterial
+    // May be shared with other entries, so copy it before making changes
     LLPointer<LLGLTFMaterial> mGLTFMaterialOverrides;
 
     // GLTF material to use for rendering -- will always be an LLFetchedGLTFMaterial
@@ -27,6 +27,7 @@
 #include "lltut.h"
 
 #include "../llgltfmaterial.h"
+#include <vector>
 #include "lluuid.cpp"
 
 // Import & define single-header gltf import/export lib
@@ -376,4 +377,70 @@ namespace tut
             ensure_equals("LLGLTFMaterial: double sided override flag unset", material.mOverrideDoubleSided, false);
         }
     }
+
+    // Test interning of overrides
+    template<> template<>
+    void llgltfmaterial_object_t::test<12>()
+    {
+        LLGLTFOverrideTable table;
+        LLPointer<LLGLTFMaterial> first = new LLGLTFMaterial();
+        first->setBaseColorFactor(LLColor4(1.f, 0.5f, 0.25f, 1.f), true);
+        LLPointer<LLGLTFMaterial> second = new LLGLTFMaterial(*first);
+        LLPointer<LLGLTFMaterial> other = new LLGLTFMaterial(*first);
+        other->setRoughnessFactor(0.5f, true);
+
+        ensure("LLGLTFOverrideTable: first override is interned as is", table.intern(first) == first.get());
+        ensure("LLGLTFOverrideTable: equal override shares the first", table.intern(second) == first.get());
+        ensure("LLGLTFOverrideTable: different override is its own", table.intern(other) == other.get());
+        ensure_equals("LLGLTFOverrideTable: two interned", table.size(), (size_t)2);
+
+        LLPointer<LLGLTFMaterial> local = new LLGLTFMaterial(*first);
+        local->addLocalTextureTracking(LLUUID::generateNewID(), LLUUID::generateNewID());
+        ensure("LLGLTFOverrideTable: override tracking local textures is not interned", table.intern(local) == local.get());
+        ensure_equals("LLGLTFOverrideTable: still two interned", table.size(), (size_t)2);
+
+        second = nullptr;
+        other = nullptr;
+        ensure_equals("LLGLTFOverrideTable: one outside use left", table.flush(), (U32)1);
+        ensure_equals("LLGLTFOverrideTable: unused override dropped", table.size(), (size_t)1);
+    }
+
+    // Overrides across a dense build of 15000 prims with 8 faces each. Most
+    // faces use one of a few hundred tint and repeat combinations, one in
+    // ten has its own, so interning keeps far fewer than one per face.
+    template<> template<>
+    void llgltfmaterial_object_t::test<13>()
+    {
+        const U32 FACES = 15000 * 8;
+        const U32 TINTS = 64;
+        const U32 REPEATS = 4;
+
+        LLGLTFOverrideTable table;
+        std::vector<LLPointer<LLGLTFMaterial> > faces;
+        faces.reserve(FACES);
+        U32 seed = 1;
+        U32 unique = 0;
+        for (U32 i = 0; i < FACES; ++i)
+        {
+            seed = seed * 1664525 + 1013904223;
+            LLPointer<LLGLTFMaterial> override_mat = new LLGLTFMaterial();
+            if (seed % 10 == 0)
+            {
+                override_mat->setBaseColorFactor(LLColor4((F32)i / FACES, 0.5f, 0.5f, 1.f), true);
+                ++unique;
+            }
+            else
+            {
+                F32 tint = (F32)((seed >> 8) % TINTS) / TINTS;
+                F32 repeat = (F32)(1 + (seed >> 16) % REPEATS);
+                override_mat->setBaseColorFactor(LLColor4(tint, tint, 1.f, 1.f), true);
+                override_mat->setTextureScale(LLGLTFMaterial::GLTF_TEXTURE_INFO_BASE_COLOR, LLVector2(repeat, repeat));
+            }
+            faces.push_back(table.intern(override_mat));
+        }
+
+        ensure("LLGLTFOverrideTable: shared tints interned once", table.size() <= unique + TINTS * REPEATS);
+        ensure("LLGLTFOverrideTable: far fewer overrides than faces", table.size() * 5 < FACES);
+        ensure_equals("LLGLTFOverrideTable: every face uses its override", table.flush(), FACES);
+    }
 }
@@ -63,6 +63,10 @@ U64 LLGLSLShader::sTotalTimeElapsed = 0;
 U32 LLGLSLShader::sTotalTrianglesDrawn = 0;
 U64 LLGLSLShader::sTotalSamplesDrawn = 0;
 U32 LLGLSLShader::sTotalBinds = 0;
+U32 LLGLSLShader::sUniformUpdates = 0;
+
+// last buffer bound to each uniform block binding point via bindUniformBlock
+static GLuint sBoundUniformBlocks[LLGLSLShader::UB_COUNT] = { 0 };
 
 //UI shader -- declared here so llui_libtest will link properly
 LLGLSLShader    gUIProgram;
@@ -92,6 +96,25 @@ BOOL shouldChange(const LLVector4& v1, const LLVector4& v2)
 // LLGLSL Shader implementation
 //===============================
 
+//static
+void LLGLSLShader::bindUniformBlock(eUniformBlock block, GLuint buffer)
+{
+    if (sBoundUniformBlocks[block] != buffer)
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, block, buffer);
+        sBoundUniformBlocks[block] = buffer;
+    }
+}
+
+//static
+void LLGLSLShader::resetUniformBlockBindings()
+{
+    for (U32 i = 0; i < UB_COUNT; ++i)
+    {
+        sBoundUniformBlocks[i] = 0;
+    }
+}
+
 //static
 void LLGLSLShader::initProfile()
 {
@@ -799,11 +822,13 @@ GLint LLGLSLShader::mapUniformTextureChannel(GLint location, GLenum type, GLint
 
     if ((type >= GL_SAMPLER_1D && type <= GL_SAMPLER_2D_RECT_SHADOW) ||
         type == GL_SAMPLER_2D_MULTISAMPLE ||
-        type == GL_SAMPLER_CUBE_MAP_ARRAY)
+        type == GL_SAMPLER_CUBE_MAP_ARRAY ||
+        type == GL_UNSIGNED_INT_SAMPLER_2D)
     {   //this here is a texture
         GLint ret = mActiveTextureChannels;
         if (size == 1)
         {
+            sUniformUpdates++;
             glUniform1i(location, mActiveTextureChannels);
             LL_DEBUGS("ShaderUniform") << "Assigned to texture channel " << mActiveTextureChannels << LL_ENDL;
             mActiveTextureChannels++;
@@ -818,6 +843,7 @@ GLint LLGLSLShader::mapUniformTextureChannel(GLint location, GLenum type, GLint
             {
                 channel[i] = mActiveTextureChannels++;
             }
+            sUniformUpdates++;
             glUniform1iv(location, size, channel);
             LL_DEBUGS("ShaderUniform") << "Assigned to texture channel " <<
                 (mActiveTextureChannels - size) << " through " << (mActiveTextureChannels - 1) << LL_ENDL;
@@ -984,13 +1010,28 @@ BOOL LLGLSLShader::mapUniforms(const vector<LLStaticHashedString>* uniforms)
 
     if (mFeatures.hasReflectionProbes) // Set up block binding, in a way supported by Apple (rather than binding = 1 in .glsl).
     {   // See slide 35 and more of https://docs.huihoo.com/apple/wwdc/2011/session_420__advances_in_opengl_for_mac_os_x_lion.pdf
-        static const GLuint BLOCKBINDING = 1; //picked by us
         //Get the index, similar to a uniform location
         GLuint UBOBlockIndex = glGetUniformBlockIndex(mProgramObject, "ReflectionProbes");
         if (UBOBlockIndex != GL_INVALID_INDEX)
         {
             //Set this index to a binding index
-            glUniformBlockBinding(mProgramObject, UBOBlockIndex, BLOCKBINDING);
+            glUniformBlockBinding(mProgramObject, UBOBlockIndex, UB_REFLECTION_PROBES);
+        }
+    }
+
+    { // atmospheric settings shared by sky, cloud and atmospherics shaders, filled once per frame by LLEnvironment
+        GLuint UBOBlockIndex = glGetUniformBlockIndex(mProgramObject, "AtmosphereData");
+        if (UBOBlockIndex != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(mProgramObject, UBOBlockIndex, UB_ATMOSPHERE);
+        }
+    }
+
+    { // local light positions and colors for clustered deferred lighting
+        GLuint UBOBlockIndex = glGetUniformBlockIndex(mProgramObject, "ClusteredLights");
+        if (UBOBlockIndex != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(mProgramObject, UBOBlockIndex, UB_CLUSTERED_LIGHTS);
         }
     }
     unbind();
@@ -1245,6 +1286,7 @@ void LLGLSLShader::uniform1i(U32 index, GLint x)
             const auto& iter = mValue.find(mUniform[index]);
             if (iter == mValue.end() || iter->second.mV[0] != x)
             {
+                sUniformUpdates++;
                 glUniform1i(mUniform[index], x);
                 mValue[mUniform[index]] = LLVector4(x, 0.f, 0.f, 0.f);
             }
@@ -1270,6 +1312,7 @@ void LLGLSLShader::uniform1f(U32 index, GLfloat x)
             const auto& iter = mValue.find(mUniform[index]);
             if (iter == mValue.end() || iter->second.mV[0] != x)
             {
+                sUniformUpdates++;
                 glUniform1f(mUniform[index], x);
                 mValue[mUniform[index]] = LLVector4(x, 0.f, 0.f, 0.f);
             }
@@ -1284,6 +1327,7 @@ void LLGLSLShader::fastUniform1f(U32 index, GLfloat x)
     llassert(mProgramObject);
     llassert(mUniform.size() <= index);
     llassert(mUniform[index] >= 0);
+    sUniformUpdates++;
     glUniform1f(mUniform[index], x);
 }
 
@@ -1306,6 +1350,7 @@ void LLGLSLShader::uniform2f(U32 index, GLfloat x, GLfloat y)
             LLVector4 vec(x, y, 0.f, 0.f);
             if (iter == mValue.end() || shouldChange(iter->second, vec))
             {
+                sUniformUpdates++;
                 glUniform2f(mUniform[index], x, y);
                 mValue[mUniform[index]] = vec;
             }
@@ -1332,6 +1377,7 @@ void LLGLSLShader::uniform3f(U32 index, GLfloat x, GLfloat y, GLfloat z)
             LLVector4 vec(x, y, z, 0.f);
             if (iter == mValue.end() || shouldChange(iter->second, vec))
             {
+                sUniformUpdates++;
                 glUniform3f(mUniform[index], x, y, z);
                 mValue[mUniform[index]] = vec;
             }
@@ -1358,6 +1404,7 @@ void LLGLSLShader::uniform4f(U32 index, GLfloat x, GLfloat y, GLfloat z, GLfloat
             LLVector4 vec(x, y, z, w);
             if (iter == mValue.end() || shouldChange(iter->second, vec))
             {
+                sUniformUpdates++;
                 glUniform4f(mUniform[index], x, y, z, w);
                 mValue[mUniform[index]] = vec;
             }
@@ -1384,6 +1431,7 @@ void LLGLSLShader::uniform1iv(U32 index, U32 count, const GLint* v)
             LLVector4 vec(v[0], 0.f, 0.f, 0.f);
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
+                sUniformUpdates++;
                 glUniform1iv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1410,6 +1458,7 @@ void LLGLSLShader::uniform4iv(U32 index, U32 count, const GLint* v)
             LLVector4 vec(v[0], v[1], v[2], v[3]);
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
+                sUniformUpdates++;
                 glUniform1iv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1436,6 +1485,7 @@ void LLGLSLShader::uniform4uiv(U32 index, U32 count, const GLuint* v)
             LLVector4 vec(v[0], v[1], v[2], v[3]);
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
+                sUniformUpdates++;
                 glUniform1uiv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1462,6 +1512,7 @@ void LLGLSLShader::uniform1fv(U32 index, U32 count, const GLfloat* v)
             LLVector4 vec(v[0], 0.f, 0.f, 0.f);
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
+                sUniformUpdates++;
                 glUniform1fv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1488,6 +1539,7 @@ void LLGLSLShader::uniform2fv(U32 index, U32 count, const GLfloat* v)
             LLVector4 vec(v[0], v[1], 0.f, 0.f);
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
+                sUniformUpdates++;
                 glUniform2fv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1514,6 +1566,7 @@ void LLGLSLShader::uniform3fv(U32 index, U32 count, const GLfloat* v)
             LLVector4 vec(v[0], v[1], v[2], 0.f);
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
+                sUniformUpdates++;
                 glUniform3fv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1541,6 +1594,7 @@ void LLGLSLShader::uniform4fv(U32 index, U32 count, const GLfloat* v)
             if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
             {
                 LL_PROFILE_ZONE_SCOPED_CATEGORY_SHADER;
+                sUniformUpdates++;
                 glUniform4fv(mUniform[index], count, v);
                 mValue[mUniform[index]] = vec;
             }
@@ -1563,6 +1617,7 @@ void LLGLSLShader::uniformMatrix2fv(U32 index, U32 count, GLboolean transpose, c
 
         if (mUniform[index] >= 0)
         {
+            sUniformUpdates++;
             glUniformMatrix2fv(mUniform[index], count, transpose, v);
         }
     }
@@ -1583,6 +1638,7 @@ void LLGLSLShader::uniformMatrix3fv(U32 index, U32 count, GLboolean transpose, c
 
         if (mUniform[index] >= 0)
         {
+            sUniformUpdates++;
             glUniformMatrix3fv(mUniform[index], count, transpose, v);
         }
     }
@@ -1603,6 +1659,7 @@ void LLGLSLShader::uniformMatrix3x4fv(U32 index, U32 count, GLboolean transpose,
 
         if (mUniform[index] >= 0)
         {
+            sUniformUpdates++;
             glUniformMatrix3x4fv(mUniform[index], count, transpose, v);
         }
     }
@@ -1623,6 +1680,7 @@ void LLGLSLShader::uniformMatrix4fv(U32 index, U32 count, GLboolean transpose, c
 
         if (mUniform[index] >= 0)
         {
+            sUniformUpdates++;
             glUniformMatrix4fv(mUniform[index], count, transpose, v);
         }
     }
@@ -1697,6 +1755,7 @@ void LLGLSLShader::uniform1i(const LLStaticHashedString& uniform, GLint v)
         LLVector4 vec(v, 0.f, 0.f, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec))
         {
+            sUniformUpdates++;
             glUniform1i(location, v);
             mValue[location] = vec;
         }
@@ -1715,6 +1774,7 @@ void LLGLSLShader::uniform1iv(const LLStaticHashedString& uniform, U32 count, co
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_SHADER;
+            sUniformUpdates++;
             glUniform1iv(location, count, v);
             mValue[location] = vec;
         }
@@ -1733,6 +1793,7 @@ void LLGLSLShader::uniform4iv(const LLStaticHashedString& uniform, U32 count, co
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_SHADER;
+            sUniformUpdates++;
             glUniform4iv(location, count, v);
             mValue[location] = vec;
         }
@@ -1751,6 +1812,7 @@ void LLGLSLShader::uniform4uiv(const LLStaticHashedString& uniform, U32 count, c
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_SHADER;
+            sUniformUpdates++;
             glUniform4uiv(location, count, v);
             mValue[location] = vec;
         }
@@ -1768,6 +1830,7 @@ void LLGLSLShader::uniform2i(const LLStaticHashedString& uniform, GLint i, GLint
         LLVector4 vec(i, j, 0.f, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec))
         {
+            sUniformUpdates++;
             glUniform2i(location, i, j);
             mValue[location] = vec;
         }
@@ -1786,6 +1849,7 @@ void LLGLSLShader::uniform1f(const LLStaticHashedString& uniform, GLfloat v)
         LLVector4 vec(v, 0.f, 0.f, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec))
         {
+            sUniformUpdates++;
             glUniform1f(location, v);
             mValue[location] = vec;
         }
@@ -1803,6 +1867,7 @@ void LLGLSLShader::uniform2f(const LLStaticHashedString& uniform, GLfloat x, GLf
         LLVector4 vec(x, y, 0.f, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec))
         {
+            sUniformUpdates++;
             glUniform2f(location, x, y);
             mValue[location] = vec;
         }
@@ -1821,6 +1886,7 @@ void LLGLSLShader::uniform3f(const LLStaticHashedString& uniform, GLfloat x, GLf
         LLVector4 vec(x, y, z, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec))
         {
+            sUniformUpdates++;
             glUniform3f(location, x, y, z);
             mValue[location] = vec;
         }
@@ -1838,6 +1904,7 @@ void LLGLSLShader::uniform1fv(const LLStaticHashedString& uniform, U32 count, co
         LLVector4 vec(v[0], 0.f, 0.f, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
+            sUniformUpdates++;
             glUniform1fv(location, count, v);
             mValue[location] = vec;
         }
@@ -1855,6 +1922,7 @@ void LLGLSLShader::uniform2fv(const LLStaticHashedString& uniform, U32 count, co
         LLVector4 vec(v[0], v[1], 0.f, 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
+            sUniformUpdates++;
             glUniform2fv(location, count, v);
             mValue[location] = vec;
         }
@@ -1872,6 +1940,7 @@ void LLGLSLShader::uniform3fv(const LLStaticHashedString& uniform, U32 count, co
         LLVector4 vec(v[0], v[1], v[2], 0.f);
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
+            sUniformUpdates++;
             glUniform3fv(location, count, v);
             mValue[location] = vec;
         }
@@ -1890,6 +1959,7 @@ void LLGLSLShader::uniform4fv(const LLStaticHashedString& uniform, U32 count, co
         if (iter == mValue.end() || shouldChange(iter->second, vec) || count != 1)
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_SHADER;
+            sUniformUpdates++;
             glUniform4fv(location, count, v);
             mValue[location] = vec;
         }
@@ -1904,6 +1974,7 @@ void LLGLSLShader::uniformMatrix4fv(const LLStaticHashedString& uniform, U32 cou
     if (location >= 0)
     {
         stop_glerror();
+        sUniformUpdates++;
         glUniformMatrix4fv(location, count, transpose, v);
         stop_glerror();
     }
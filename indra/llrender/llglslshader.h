@@ -145,9 +145,28 @@ public:
         SG_COUNT
     } eGroup;
 
+    // uniform buffer binding points shared by every program
+    // (set with glUniformBlockBinding in mapUniforms rather than binding = N in .glsl)
+    enum eUniformBlock
+    {
+        UB_REFLECTION_PROBES = 1,   // "ReflectionProbes", see LLReflectionMapManager
+        UB_ATMOSPHERE = 2,          // "AtmosphereData", see LLEnvironment
+        UB_CLUSTERED_LIGHTS = 3,    // "ClusteredLights", see LLPipeline::renderClusteredLights
+        UB_COUNT
+    };
+
     static std::set<LLGLSLShader*> sInstances;
     static bool sProfileEnabled;
 
+    // bind buffer to the given uniform block binding point, skipping the call if it's already bound there
+    static void bindUniformBlock(eUniformBlock block, GLuint buffer);
+    // forget cached uniform block bindings (call when GL state may have been lost)
+    static void resetUniformBlockBindings();
+
+    // number of glUniform* calls made since the last resetUniformUpdates (see LLViewerStats)
+    static U32 sUniformUpdates;
+    static void resetUniformUpdates() { sUniformUpdates = 0; }
+
     LLGLSLShader();
     ~LLGLSLShader();
 
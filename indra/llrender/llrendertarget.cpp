@@ -30,8 +30,11 @@
 #include "llrender.h"
 #include "llgl.h"
 
+#include <algorithm>
+
 LLRenderTarget* LLRenderTarget::sBoundTarget = NULL;
 U32 LLRenderTarget::sBytesAllocated = 0;
+LLRenderTargetPool LLRenderTarget::sPool(256 * 1024 * 1024, [](U32 name) { LLImageGL::deleteTextures(1, &name); });
 
 void check_framebuffer_status()
 {
@@ -65,6 +68,8 @@ LLRenderTarget::LLRenderTarget() :
     mFBO(0),
     mDepth(0),
     mUseDepth(false),
+    mGenerateMipMaps(LLTexUnit::TMG_NONE),
+    mMipLevels(0),
     mUsage(LLTexUnit::TT_TEXTURE)
 {
 }
@@ -222,16 +227,12 @@ bool LLRenderTarget::addColorAttachment(U32 color_fmt)
         return false;
     }
 
-    U32 tex;
-    LLImageGL::generateTextures(1, &tex);
-    gGL.getTexUnit(0)->bindManual(mUsage, tex);
-
     stop_glerror();
 
-
+    U32 tex;
     {
         clear_glerror();
-        LLImageGL::setManualImage(LLTexUnit::getInternalType(mUsage), 0, color_fmt, mResX, mResY, GL_RGBA, GL_UNSIGNED_BYTE, NULL, false);
+        tex = acquireTexture(color_fmt, GL_RGBA, GL_UNSIGNED_BYTE);
         if (glGetError() != GL_NO_ERROR)
         {
             LL_WARNS() << "Could not allocate color buffer for render target." << LL_ENDL;
@@ -294,13 +295,9 @@ bool LLRenderTarget::addColorAttachment(U32 color_fmt)
 bool LLRenderTarget::allocateDepth()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_DISPLAY;
-    LLImageGL::generateTextures(1, &mDepth);
-    gGL.getTexUnit(0)->bindManual(mUsage, mDepth);
-
-    U32 internal_type = LLTexUnit::getInternalType(mUsage);
     stop_glerror();
     clear_glerror();
-    LLImageGL::setManualImage(internal_type, 0, GL_DEPTH_COMPONENT24, mResX, mResY, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL, false);
+    mDepth = acquireTexture(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT);
     gGL.getTexUnit(0)->setTextureFilteringOption(LLTexUnit::TFO_POINT);
 
     sBytesAllocated += mResX*mResY*4;
@@ -344,9 +341,25 @@ void LLRenderTarget::shareDepthBuffer(LLRenderTarget& target)
         glBindFramebuffer(GL_FRAMEBUFFER, sCurFBO);
 
         target.mUseDepth = true;
+        target.mDepthOwner = this;
+        mDepthSharers.push_back(&target);
     }
 }
 
+void LLRenderTarget::detachSharedDepth()
+{
+    llassert(mUseDepth && mDepthOwner);
+
+    if (mFBO)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, LLTexUnit::getInternalType(mUsage), 0, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, sCurFBO);
+    }
+    mUseDepth = false;
+    mDepthOwner = nullptr;
+}
+
 void LLRenderTarget::release()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_DISPLAY;
@@ -354,23 +367,24 @@ void LLRenderTarget::release()
 
     if (mDepth)
     {
-        LLImageGL::deleteTextures(1, &mDepth);
+        // the next target to take it from the pool must be its only user
+        for (LLRenderTarget* sharer : mDepthSharers)
+        {
+            sharer->detachSharedDepth();
+        }
+        mDepthSharers.clear();
+
+        releaseTexture(mDepth, GL_DEPTH_COMPONENT24);
 
         mDepth = 0;
 
         sBytesAllocated -= mResX*mResY*4;
     }
-    else if (mFBO)
-    {
-        glBindFramebuffer(GL_FRAMEBUFFER, mFBO);
-
-        if (mUseDepth)
-        { //detach shared depth buffer
-            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, LLTexUnit::getInternalType(mUsage), 0, 0);
-            mUseDepth = false;
-        }
-
-        glBindFramebuffer(GL_FRAMEBUFFER, sCurFBO);
+    else if (mDepthOwner)
+    { //detach shared depth buffer
+        std::vector<LLRenderTarget*>& sharers = mDepthOwner->mDepthSharers;
+        sharers.erase(std::remove(sharers.begin(), sharers.end(), this), sharers.end());
+        detachSharedDepth();
     }
 
     // Detach any extra color buffers (e.g. SRGB spec buffers)
@@ -383,7 +397,7 @@ void LLRenderTarget::release()
         {
             sBytesAllocated -= mResX*mResY*4;
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0+z, LLTexUnit::getInternalType(mUsage), 0, 0);
-            LLImageGL::deleteTextures(1, &mTex[z]);
+            releaseTexture(mTex[z], mInternalFormat[z]);
         }
         glBindFramebuffer(GL_FRAMEBUFFER, sCurFBO);
     }
@@ -403,7 +417,14 @@ void LLRenderTarget::release()
     if (mTex.size() > 0)
     {
         sBytesAllocated -= mResX*mResY*4;
-        LLImageGL::deleteTextures(1, &mTex[0]);
+        if (mInternalFormat.empty())
+        { // attached with setColorAttachment and never released
+            LLImageGL::deleteTextures(1, &mTex[0]);
+        }
+        else
+        {
+            releaseTexture(mTex[0], mInternalFormat[0]);
+        }
     }
 
     mTex.clear();
@@ -412,6 +433,48 @@ void LLRenderTarget::release()
     mResX = mResY = 0;
 }
 
+LLRenderTargetPool::Key LLRenderTarget::getPoolKey(U32 internal_format) const
+{
+    return { internal_format, mResX, mResY, (U32)mUsage, mGenerateMipMaps != LLTexUnit::TMG_NONE };
+}
+
+U32 LLRenderTarget::acquireTexture(U32 internal_format, U32 pix_format, U32 pix_type)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_DISPLAY;
+    U32 internal_type = LLTexUnit::getInternalType(mUsage);
+
+    U32 tex = sPool.take(getPoolKey(internal_format));
+    if (tex)
+    {
+        gGL.getTexUnit(0)->bindManual(mUsage, tex);
+        // shadow maps turn on depth compare after allocating
+        glTexParameteri(internal_type, GL_TEXTURE_COMPARE_MODE, GL_NONE);
+        return tex;
+    }
+
+    LLImageGL::generateTextures(1, &tex);
+    gGL.getTexUnit(0)->bindManual(mUsage, tex);
+    LLImageGL::setManualImage(internal_type, 0, internal_format, mResX, mResY, pix_format, pix_type, NULL, false);
+    return tex;
+}
+
+void LLRenderTarget::releaseTexture(U32 tex, U32 internal_format)
+{
+    sPool.put(tex, getPoolKey(internal_format));
+}
+
+// static
+void LLRenderTarget::updatePool(U32 frame, U32 max_age)
+{
+    sPool.update(frame, max_age);
+}
+
+// static
+void LLRenderTarget::clearPool()
+{
+    sPool.clear();
+}
+
 void LLRenderTarget::bindTarget()
 {
     LL_PROFILE_GPU_ZONE("bindTarget");
@@ -31,6 +31,7 @@
 
 #include "llgl.h"
 #include "llrender.h"
+#include "llrendertargetpool.h"
 
 /*
  Wrapper around OpenGL framebuffer objects for use in render-to-texture
@@ -68,6 +69,20 @@ public:
     static U32 sCurResX;
     static U32 sCurResY;
 
+    // Released color and depth textures wait in a pool, keyed by size,
+    // format and usage, for the next allocation that matches. That is the
+    // only aliasing done: the pipeline's targets live for the session, and
+    // those used within a frame (the post chain, shadow maps) are all live
+    // at once, so only targets released and allocated again (resizes,
+    // settings changes, snapshots, probes) share memory.
+    static const LLRenderTargetPool& getPool() { return sPool; }
+
+    // delete pooled textures that have not been reused for max_age frames
+    // call once per frame
+    static void updatePool(U32 frame, U32 max_age = 60);
+
+    // delete all pooled textures, before the GL context goes away
+    static void clearPool();
 
     LLRenderTarget();
     ~LLRenderTarget();
@@ -173,6 +188,16 @@ public:
     void swapFBORefs(LLRenderTarget& other);
 
 protected:
+    // a texture of internal_format at this target's size and usage, bound to
+    // texture unit 0, from the pool if there is one
+    U32 acquireTexture(U32 internal_format, U32 pix_format, U32 pix_type);
+    // hand a texture this target created back to the pool
+    void releaseTexture(U32 tex, U32 internal_format);
+    // the pool key for a texture of internal_format at this target's size and usage
+    LLRenderTargetPool::Key getPoolKey(U32 internal_format) const;
+    // detach the depth buffer shared from mDepthOwner
+    void detachSharedDepth();
+
     U32 mResX;
     U32 mResY;
     std::vector<U32> mTex;
@@ -182,12 +207,19 @@ protected:
 
     U32 mDepth;
     bool mUseDepth;
+    // targets this one's depth buffer is shared with, and the target whose
+    // depth buffer this one uses; a pooled depth buffer must be attached
+    // to no framebuffer but its new owner's
+    std::vector<LLRenderTarget*> mDepthSharers;
+    LLRenderTarget* mDepthOwner = nullptr;
     LLTexUnit::eTextureMipGeneration mGenerateMipMaps;
     U32 mMipLevels;
 
     LLTexUnit::eTextureType mUsage;
 
     static LLRenderTarget* sBoundTarget;
+
+    static LLRenderTargetPool sPool;
 };
 
 #endif
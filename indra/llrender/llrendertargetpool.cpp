@@ -0,0 +1,83 @@
+/**
+ * @file   llrendertargetpool.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llrendertargetpool.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llrendertargetpool.h"
+
+LLRenderTargetPool::LLRenderTargetPool(U32 budget, const delete_func_t& delete_texture) :
+    mDeleteTexture(delete_texture),
+    mBudget(budget),
+    mBytes(0),
+    mFrame(0),
+    mHits(0),
+    mMisses(0)
+{
+}
+
+U32 LLRenderTargetPool::take(const Key& key)
+{
+    for (auto iter = mEntries.rbegin(); iter != mEntries.rend(); ++iter)
+    {
+        if (iter->mKey == key)
+        {
+            U32 name = iter->mName;
+            mEntries.erase(std::next(iter).base());
+            mBytes -= key.getBytes();
+            ++mHits;
+            return name;
+        }
+    }
+
+    ++mMisses;
+    return 0;
+}
+
+void LLRenderTargetPool::put(U32 name, const Key& key)
+{
+    mEntries.push_back({ name, key, mFrame });
+    mBytes += key.getBytes();
+
+    size_t count = 0;
+    U32 bytes = mBytes;
+    while (bytes > mBudget && count < mEntries.size())
+    {
+        bytes -= mEntries[count].mKey.getBytes();
+        ++count;
+    }
+    dropOldest(count);
+}
+
+void LLRenderTargetPool::update(U32 frame, U32 max_age)
+{
+    mFrame = frame;
+
+    size_t count = 0;
+    while (count < mEntries.size() && frame - mEntries[count].mFrame > max_age)
+    {
+        ++count;
+    }
+    dropOldest(count);
+}
+
+void LLRenderTargetPool::clear()
+{
+    dropOldest(mEntries.size());
+}
+
+void LLRenderTargetPool::dropOldest(size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        mBytes -= mEntries[i].mKey.getBytes();
+        mDeleteTexture(mEntries[i].mName);
+    }
+    mEntries.erase(mEntries.begin(), mEntries.begin() + count);
+}
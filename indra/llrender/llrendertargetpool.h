@@ -0,0 +1,91 @@
+/**
+ * @file   llrendertargetpool.h
+ * @date   2026-10-18
+ * @brief  LLRenderTargetPool keeps released render target textures for the
+ *         next allocation of the same size, format and usage.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLRENDERTARGETPOOL_H
+#define LL_LLRENDERTARGETPOOL_H
+
+#include "stdtypes.h"
+#include <functional>
+#include <vector>
+
+/**
+ * The bookkeeping behind LLRenderTarget's texture pool, with no GL calls of
+ * its own: textures are GL names, and the pool asks its delete function to
+ * get rid of the ones it drops.
+ *
+ * Textures are handed out most recently released first, so a target
+ * released and allocated again in the same frame gets its own textures
+ * back. They are dropped least recently released first, once the pooled
+ * bytes pass the budget or a texture has waited more than max_age frames.
+ */
+class LLRenderTargetPool
+{
+public:
+    struct Key
+    {
+        U32 mInternalFormat;
+        U32 mResX;
+        U32 mResY;
+        U32 mUsage;         // LLTexUnit::eTextureType
+        bool mMipmapped;
+
+        bool operator==(const Key& other) const
+        {
+            return mInternalFormat == other.mInternalFormat && mResX == other.mResX && mResY == other.mResY &&
+                   mUsage == other.mUsage && mMipmapped == other.mMipmapped;
+        }
+
+        // what LLRenderTarget accounts for a texture of this size
+        U32 getBytes() const { return mResX * mResY * 4; }
+    };
+
+    typedef std::function<void(U32 name)> delete_func_t;
+
+    LLRenderTargetPool(U32 budget, const delete_func_t& delete_texture);
+
+    // A pooled texture for key, or 0 if there is none (a miss)
+    U32 take(const Key& key);
+    // Pools a texture, then drops the least recently released past the budget
+    void put(U32 name, const Key& key);
+    // Sets the current frame and drops textures pooled for more than max_age frames
+    void update(U32 frame, U32 max_age);
+    // Drops every pooled texture
+    void clear();
+
+    U32 getBudget() const           { return mBudget; }
+    void setBudget(U32 budget)      { mBudget = budget; }
+    U32 getBytes() const            { return mBytes; }
+    size_t getCount() const         { return mEntries.size(); }
+    // textures taken from the pool and textures that had to be created
+    U32 getHits() const             { return mHits; }
+    U32 getMisses() const           { return mMisses; }
+
+private:
+    void dropOldest(size_t count);
+
+    struct Entry
+    {
+        U32 mName;
+        Key mKey;
+        U32 mFrame;
+    };
+
+    // least recently released first
+    std::vector<Entry> mEntries;
+    delete_func_t mDeleteTexture;
+    U32 mBudget;
+    U32 mBytes;
+    U32 mFrame;
+    U32 mHits;
+    U32 mMisses;
+};
+
+#endif // LL_LLRENDERTARGETPOOL_H
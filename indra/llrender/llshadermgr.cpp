@@ -1474,6 +1474,9 @@ void LLShaderMgr::initAttribsAndUniforms()
     mReservedUniforms.push_back("colorgrade_lut");
     mReservedUniforms.push_back("colorgrade_lut_size");
 
+    mReservedUniforms.push_back("clusterGrid");
+    mReservedUniforms.push_back("clusterIndices");
+
     llassert(mReservedUniforms.size() == END_RESERVED_UNIFORMS);
 
     std::set<std::string> dupe_check;
@@ -329,6 +329,9 @@ public:
         COLORGRADE_LUT,                     //  "colorgrade_lut"
         COLORGRADE_LUT_SIZE,                //  "colorgrade_lut_size"
 
+        CLUSTER_GRID,                       //  "clusterGrid"
+        CLUSTER_INDICES,                    //  "clusterIndices"
+
         END_RESERVED_UNIFORMS
     } eGLSLReservedUniforms;
     // clang-format on
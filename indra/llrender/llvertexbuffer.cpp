@@ -375,6 +375,7 @@ public:
             }
 
             data = (U8*)ll_aligned_malloc_16(size);
+            LLMemTag::claim(LLMemTag::VERTEX_BUFFER, size);
         }
         else
         {
@@ -461,6 +462,7 @@ public:
                     LL_PROFILE_ZONE_NAMED_CATEGORY_VERTEX("vbo cache timeout");
                     auto& entry = entries.back();
                     ll_aligned_free_16(entry.mData);
+                    LLMemTag::disclaim(LLMemTag::VERTEX_BUFFER, iter->first);
                     names_to_free.push_back(entry.mGLName);
                     llassert(mReserved >= iter->first);
                     mReserved -= iter->first;
@@ -499,6 +501,7 @@ public:
             for (auto& entry : entries.second)
             {
                 ll_aligned_free_16(entry.mData);
+                LLMemTag::disclaim(LLMemTag::VERTEX_BUFFER, entries.first);
                 names_to_free.push_back(entry.mGLName);
             }
         }
@@ -508,6 +511,7 @@ public:
             for (auto& entry : entries.second)
             {
                 ll_aligned_free_16(entry.mData);
+                LLMemTag::disclaim(LLMemTag::VERTEX_BUFFER, entries.first);
                 names_to_free.push_back(entry.mGLName);
             }
         }
@@ -0,0 +1,123 @@
+/**
+ * @file   llrendertargetpool_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llrendertargetpool.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+#include "../llrendertargetpool.h"
+
+#include <vector>
+
+namespace
+{
+    const U32 RGBA8 = 0x8058;       // GL_RGBA8
+    const U32 DEPTH24 = 0x81A6;     // GL_DEPTH_COMPONENT24
+    const U32 TEXTURE = 0;          // LLTexUnit::TT_TEXTURE
+
+    LLRenderTargetPool::Key make_key(U32 format, U32 width, U32 height, bool mipmapped = false)
+    {
+        return { format, width, height, TEXTURE, mipmapped };
+    }
+}
+
+namespace tut
+{
+    struct llrendertargetpool_data
+    {
+        llrendertargetpool_data() :
+            mPool(64 * 1024 * 1024, [this](U32 name) { mDeleted.push_back(name); })
+        {}
+
+        std::vector<U32> mDeleted;
+        LLRenderTargetPool mPool;
+    };
+    typedef test_group<llrendertargetpool_data> llrendertargetpool_group;
+    typedef llrendertargetpool_group::object object;
+    llrendertargetpool_group llrendertargetpoolgrp("llrendertargetpool");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("take and put");
+        const LLRenderTargetPool::Key screen = make_key(RGBA8, 1920, 1080);
+
+        ensure_equals("empty pool misses", mPool.take(screen), (U32)0);
+        ensure_equals("one miss", mPool.getMisses(), (U32)1);
+
+        mPool.put(1, screen);
+        mPool.put(2, screen);
+        mPool.put(3, make_key(DEPTH24, 1920, 1080));
+        ensure_equals("three pooled", mPool.getCount(), (size_t)3);
+        ensure_equals("bytes pooled", mPool.getBytes(), 3 * screen.getBytes());
+
+        ensure_equals("most recently released first", mPool.take(screen), (U32)2);
+        ensure_equals("then the older one", mPool.take(screen), (U32)1);
+        ensure_equals("no more of that key", mPool.take(screen), (U32)0);
+        ensure_equals("other format kept", mPool.take(make_key(DEPTH24, 1920, 1080)), (U32)3);
+
+        mPool.put(4, screen);
+        ensure_equals("size must match", mPool.take(make_key(RGBA8, 1920, 1079)), (U32)0);
+        ensure_equals("mipmapping must match", mPool.take(make_key(RGBA8, 1920, 1080, true)), (U32)0);
+
+        ensure_equals("hits", mPool.getHits(), (U32)3);
+        ensure_equals("misses", mPool.getMisses(), (U32)4);
+        ensure("nothing deleted", mDeleted.empty());
+        ensure_equals("bytes follow", mPool.getBytes(), screen.getBytes());
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("budget eviction");
+        const LLRenderTargetPool::Key screen = make_key(RGBA8, 1024, 1024);
+        mPool.setBudget(2 * screen.getBytes());
+
+        mPool.put(1, screen);
+        mPool.put(2, screen);
+        ensure("within budget", mDeleted.empty());
+
+        mPool.put(3, screen);
+        ensure_equals("least recently released deleted", mDeleted.size(), (size_t)1);
+        ensure_equals("that was the first", mDeleted[0], (U32)1);
+        ensure_equals("at the budget", mPool.getBytes(), mPool.getBudget());
+
+        // one bigger than the whole budget goes straight back out
+        const LLRenderTargetPool::Key huge = make_key(RGBA8, 4096, 4096);
+        mPool.put(4, huge);
+        ensure_equals("everything deleted", mDeleted.size(), (size_t)4);
+        ensure_equals("empty", mPool.getCount(), (size_t)0);
+        ensure_equals("no bytes", mPool.getBytes(), (U32)0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("age eviction");
+        const LLRenderTargetPool::Key probe = make_key(RGBA8, 256, 256);
+
+        mPool.update(100, 60);
+        mPool.put(1, probe);
+        mPool.update(110, 60);
+        mPool.put(2, probe);
+
+        mPool.update(160, 60);
+        ensure("60 frames is not too old", mDeleted.empty());
+
+        mPool.update(161, 60);
+        ensure_equals("first one aged out", mDeleted.size(), (size_t)1);
+        ensure_equals("that was the first", mDeleted[0], (U32)1);
+        ensure_equals("second still pooled", mPool.take(probe), (U32)2);
+
+        mPool.put(2, probe);
+        mPool.put(3, probe);
+        mPool.clear();
+        ensure_equals("clear deletes the rest", mDeleted.size(), (size_t)3);
+        ensure_equals("no bytes left", mPool.getBytes(), (U32)0);
+    }
+} // namespace tut
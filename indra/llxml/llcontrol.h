@@ -33,6 +33,7 @@
 #include "llrect.h"
 #include "llrefcount.h"
 #include "llinstancetracker.h"
+#include "llshardedinstancetracker.h"
 
 #include <boost/unordered/unordered_flat_map.hpp>
 
@@ -307,8 +308,10 @@ public:
 //! Use an LLCachedControl instance to connect to a LLControlVariable
 //! without have to manually create and bind a listener to a local
 //! object.
+// LLCachedControl looks these up by name on construction, which for
+// non-static LLCachedControls means every call, on any thread.
 template <class T>
-class LLControlCache final : public LLRefCount, public LLInstanceTracker<LLControlCache<T>, std::string>
+class LLControlCache final : public LLRefCount, public LLShardedInstanceTracker<LLControlCache<T>, std::string>
 {
 public:
     // This constructor will declare a control if it doesn't exist in the contol group
@@ -316,7 +319,7 @@ public:
                     const std::string& name,
                     const T& default_value,
                     const std::string& comment)
-    :   LLInstanceTracker<LLControlCache<T>, std::string >(name)
+    :   LLShardedInstanceTracker<LLControlCache<T>, std::string >(name)
     {
         if(!group.controlExists(name))
         {
@@ -331,7 +334,7 @@ public:
 
     LLControlCache(LLControlGroup& group,
                     const std::string& name)
-    :   LLInstanceTracker<LLControlCache<T>, std::string >(name)
+    :   LLShardedInstanceTracker<LLControlCache<T>, std::string >(name)
     {
         if(!group.controlExists(name))
         {
@@ -50,18 +50,29 @@ uniform vec3 lightnorm;
 uniform vec3 sunlight_color;
 uniform vec3 moonlight_color;
 uniform int sun_up_factor;
-uniform vec3 ambient_color;
-uniform vec3 blue_horizon;
-uniform vec3 blue_density;
-uniform float haze_horizon;
-uniform float haze_density;
-
-uniform float cloud_shadow;
-uniform float density_multiplier;
-uniform float max_y;
-
-uniform vec3 glow;
-uniform float sun_moon_glow_factor;
+
+// atmospheric settings, filled once per frame by LLEnvironment (see LLEnvironment::AtmosphereData)
+// NOTE: Keep these in sync!
+//       indra\newview\app_settings\shaders\class1\windlight\atmosphericsFuncs.glsl
+//       indra\newview\app_settings\shaders\class1\deferred\skyV.glsl
+//       indra\newview\app_settings\shaders\class1\deferred\cloudsV.glsl
+//       indra\newview\llenvironment.h
+layout (std140) uniform AtmosphereData
+{
+    vec3  ambient_color;
+    float haze_horizon;
+    vec3  blue_horizon;
+    float haze_density;
+    vec3  blue_density;
+    float cloud_shadow;
+    vec3  glow;
+    float density_multiplier;
+    float distance_multiplier;
+    float max_y;
+    float sun_moon_glow_factor;
+    float sky_sunlight_scale;
+    float sky_ambient_scale;
+};
 
 uniform vec3 cloud_color;
 
@@ -0,0 +1,198 @@
+/**
+ * @file class3\deferred\clusteredLightF.glsl
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+/*[EXTRA_CODE_HERE]*/
+
+// Shades every local point light in one fullscreen pass. The C++ side
+// (LLPipeline::renderClusteredLights, LLLightClusters) bins the lights into
+// a CLUSTER_TILES_X x CLUSTER_TILES_Y x CLUSTER_SLICES view space grid;
+// each pixel only visits the lights listed for its cluster.
+
+out vec4 frag_color;
+
+uniform sampler2D diffuseRect;
+uniform sampler2D specularRect;
+uniform sampler2D emissiveRect; // PBR linear packed Occlusion, Roughness, Metal. See: pbropaqueF.glsl
+uniform sampler2D     lightFunc;
+
+uniform usampler2D clusterGrid;    // x = offset into clusterIndices, y = light count
+uniform usampler2D clusterIndices; // CLUSTER_INDEX_WIDTH light indices per row
+
+uniform vec2  cluster_tan;         // tangents of the half field of view used for binning
+uniform float cluster_near;
+uniform float cluster_slice_scale; // slice = log(depth / cluster_near) * cluster_slice_scale
+uniform float far_z;               // no light reaches past this view space depth
+
+// NOTE: Keep in sync with LLPipeline::ClusteredLightData
+layout (std140) uniform ClusteredLights
+{
+    vec4 cl_light[MAX_CLUSTERED_LIGHTS];     // view space center, .w = size
+    vec4 cl_light_col[MAX_CLUSTERED_LIGHTS]; // linear color, .a = falloff
+};
+
+in vec4 vary_fragcoord;
+
+void calcHalfVectors(vec3 lv, vec3 n, vec3 v, out vec3 h, out vec3 l, out float nh, out float nl, out float nv, out float vh, out float lightDist);
+float calcLegacyDistanceAttenuation(float distance, float falloff);
+vec4 getPosition(vec2 pos_screen);
+vec4 getNorm(vec2 screenpos);
+vec2 getScreenCoord(vec4 clip);
+vec3 srgb_to_linear(vec3 c);
+
+vec3 pbrPunctual(vec3 diffuseColor, vec3 specularColor,
+                    float perceptualRoughness,
+                    float metallic,
+                    vec3 n, // normal
+                    vec3 v, // surface point to camera
+                    vec3 l); //surface point to light
+
+ivec2 clusterLights(vec3 pos)
+{
+    float depth = max(-pos.z, cluster_near);
+    vec2 ndc = pos.xy / (depth * cluster_tan);
+    ivec2 tile = clamp(ivec2(floor((ndc * 0.5 + 0.5) * vec2(CLUSTER_TILES_X, CLUSTER_TILES_Y))),
+                       ivec2(0), ivec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+    int slice = clamp(int(floor(log(depth / cluster_near) * cluster_slice_scale)), 0, CLUSTER_SLICES - 1);
+
+    uvec2 cell = texelFetch(clusterGrid, ivec2(tile.x + tile.y * CLUSTER_TILES_X, slice), 0).xy;
+    return ivec2(cell);
+}
+
+int lightIndex(int i)
+{
+    return int(texelFetch(clusterIndices, ivec2(i % CLUSTER_INDEX_WIDTH, i / CLUSTER_INDEX_WIDTH), 0).r);
+}
+
+void main()
+{
+    vec3 final_color = vec3(0, 0, 0);
+    vec2 tc          = getScreenCoord(vary_fragcoord);
+    vec3 pos         = getPosition(tc).xyz;
+    if (pos.z < far_z)
+    {
+        discard;
+    }
+
+    ivec2 cell = clusterLights(pos);
+    if (cell.y == 0)
+    {
+        discard;
+    }
+
+    vec4 norm = getNorm(tc); // need `norm.w` for GET_GBUFFER_FLAG()
+    vec3 n = norm.xyz;
+
+    vec4 spec    = texture(specularRect, tc);
+    vec3 diffuse = texture(diffuseRect, tc).rgb;
+
+    vec3  h, l, v = -normalize(pos);
+    float nh, nv, vh, lightDist;
+
+    if (GET_GBUFFER_FLAG(GBUFFER_FLAG_HAS_PBR))
+    {
+        vec3 orm = spec.rgb;
+        float perceptualRoughness = orm.g;
+        float metallic = orm.b;
+        vec3 f0 = vec3(0.04);
+        vec3 baseColor = diffuse.rgb;
+
+        vec3 diffuseColor = baseColor.rgb*(vec3(1.0)-f0);
+        diffuseColor *= 1.0 - metallic;
+
+        vec3 specularColor = mix(f0, baseColor.rgb, metallic);
+
+        for (int i = cell.x; i < cell.x + cell.y; ++i)
+        {
+            int light_idx = lightIndex(i);
+            vec3  lightColor = cl_light_col[light_idx].rgb; // Already in linear, see pipeline.cpp: volume->getLightLinearColor();
+            float falloff    = cl_light_col[light_idx].a;
+            float lightSize  = cl_light[light_idx].w;
+            vec3  lv         = cl_light[light_idx].xyz - pos;
+
+            lightDist = length(lv);
+
+            float dist = lightDist / lightSize;
+            if (dist <= 1.0)
+            {
+                lv /= lightDist;
+
+                float dist_atten = calcLegacyDistanceAttenuation(dist, falloff);
+
+                vec3 intensity = dist_atten * lightColor * 3.25;
+
+                final_color += intensity*pbrPunctual(diffuseColor, specularColor, perceptualRoughness, metallic, n.xyz, v, lv);
+            }
+        }
+    }
+    else
+    {
+        diffuse = srgb_to_linear(diffuse);
+        spec.rgb = srgb_to_linear(spec.rgb);
+
+        for (int i = cell.x; i < cell.x + cell.y; ++i)
+        {
+            int light_idx = lightIndex(i);
+            vec3  lv   = cl_light[light_idx].xyz - pos;
+            float dist = length(lv);
+            dist /= cl_light[light_idx].w;
+            if (dist <= 1.0)
+            {
+                float nl = dot(n, lv);
+                if (nl > 0.0)
+                {
+                    float lightDist;
+                    calcHalfVectors(lv, n, v, h, l, nh, nl, nv, vh, lightDist);
+
+                    float fa         = cl_light_col[light_idx].a;
+                    float dist_atten = calcLegacyDistanceAttenuation(dist, fa);
+
+                    float lit = nl * dist_atten;
+
+                    vec3 col = cl_light_col[light_idx].rgb * lit * diffuse;
+
+                    if (spec.a > 0.0)
+                    {
+                        lit        = min(nl * 6.0, 1.0) * dist_atten;
+                        float fres = pow(1 - vh, 5) * 0.4 + 0.5;
+
+                        float gtdenom = 2 * nh;
+                        float gt      = max(0, min(gtdenom * nv / vh, gtdenom * nl / vh));
+
+                        if (nh > 0.0)
+                        {
+                            float scol = fres * texture(lightFunc, vec2(nh, spec.a)).r * gt / (nh * nl);
+                            col += lit * scol * cl_light_col[light_idx].rgb * spec.rgb;
+                        }
+                    }
+
+                    final_color += col;
+                }
+            }
+        }
+    }
+
+    frag_color.rgb = max(final_color, vec3(0));
+    frag_color.a   = 0.0;
+}
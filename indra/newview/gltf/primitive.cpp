@@ -213,8 +213,8 @@ void initOctreeTriangle(LLVolumeTriangle* tri, F32 scaler, S32 i0, S32 i1, S32 i
 
 void Primitive::createOctree()
 {
-    // create octree
-    mOctree = new LLVolumeOctree();
+    // create octree, sized for a triangle list; strips and fans have more
+    mOctree = new LLVolumeOctree((U32)(mIndexArray.size() / 3));
 
     F32 scaler = 0.25f;
 
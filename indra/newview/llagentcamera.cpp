@@ -2792,7 +2792,7 @@ void LLAgentCamera::setFocusObject(LLViewerObject* object)
 //-----------------------------------------------------------------------------
 void LLAgentCamera::setFocusGlobal(const LLPickInfo& pick)
 {
-    LLViewerObject* objectp = gObjectList.findObject(pick.mObjectID);
+    LLPointer<LLViewerObject> objectp = pick.getObject();
 
     if (objectp && pick.mGLTFNodeIndex == -1)
     {
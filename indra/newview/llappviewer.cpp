@@ -270,6 +270,12 @@ using namespace LL;
 
 #include "alstreaminfo.h"
 
+#if LL_USE_MIMALLOC
+// Replaces the global operator new/delete with mimalloc's; this header must
+// be included by exactly one source file of the executable.
+#include <mimalloc-new-delete.h>
+#endif
+
 // *FIX: These extern globals should be cleaned up.
 // The globals either represent state/config/resource-storage of either
 // this app, or another 'component' of the viewer. App globals should be
@@ -337,6 +343,7 @@ F32SecondsImplicit gFrameTimeSeconds = 0.f;
 F32SecondsImplicit gFrameIntervalSeconds = 0.f;
 F32 gFPSClamped = 10.f;                     // Pretend we start at target rate.
 F32 gFrameDTClamped = 0.f;                  // Time between adjacent checks to network for packets
+LLFrameScheduler gFrameScheduler;
 U64MicrosecondsImplicit gStartTime = 0; // gStartTime is "private", used only to calculate gFrameTimeSeconds
 
 LLTimer gRenderStartTime;
@@ -769,6 +776,7 @@ bool LLAppViewer::init()
     //set the max heap size.
     initMaxHeapSize() ;
     LLCoros::instance().setStackSize(gSavedSettings.getS32("CoroutineStackSize"));
+    LLCoros::instance().setStackPoolLimit(gSavedSettings.getU32("CoroutineStackPoolSize"));
 
 
     // Although initLoggingAndGetLastDuration() is the right place to mess with
@@ -1269,6 +1277,29 @@ void LLAppViewer::initMaxHeapSize()
 // externally visible timers
 LLTrace::BlockTimerStatHandle FTM_FRAME("Frame");
 
+// Aim gFrameScheduler at the display's refresh rate when vsync is on, or
+// at FrameBudgetTargetFPS when it is not.
+static void begin_frame_budget()
+{
+    static LLCachedControl<bool> vsync_enabled(gSavedSettings, "RenderVSyncEnable", true);
+    static LLCachedControl<U32> target_fps(gSavedSettings, "FrameBudgetTargetFPS", 60);
+
+    U32 fps = target_fps;
+    if (vsync_enabled && gViewerWindow && gViewerWindow->getWindow()->getRefreshRate() > 0)
+    {
+        fps = (U32)gViewerWindow->getWindow()->getRefreshRate();
+    }
+    gFrameScheduler.beginFrame(fps > 0 ? 1.0 / fps : 0.0);
+}
+
+// sleep, and tell gFrameScheduler the time was not spent working
+static void frame_sleep(S32 ms)
+{
+    LLTimer sleep_timer;
+    ms_sleep(ms);
+    gFrameScheduler.addWaitTime(sleep_timer.getElapsedTimeF64());
+}
+
 bool LLAppViewer::frame()
 {
     bool ret = false;
@@ -1320,6 +1351,7 @@ bool LLAppViewer::doFrame()
     }
 
     LLPerfStats::RecordSceneTime T (LLPerfStats::StatType_t::RENDER_FRAME);
+    begin_frame_budget();
     if (!LLWorld::instanceExists())
     {
         LLWorld::createInstance();
@@ -1501,14 +1533,14 @@ bool LLAppViewer::doFrame()
             {
                 LL_PROFILE_ZONE_NAMED_CATEGORY_APP("Yield");
                 LL_PROFILE_ZONE_NUM( yield_time )
-                ms_sleep(yield_time);
+                frame_sleep(yield_time);
             }
 
             if (gNonInteractive)
             {
                 S32 non_interactive_ms_sleep_time = 100;
                 LLAppViewer::getTextureCache()->pause();
-                ms_sleep(non_interactive_ms_sleep_time);
+                frame_sleep(non_interactive_ms_sleep_time);
             }
 
             // yield cooperatively when not running as foreground window
@@ -1525,7 +1557,7 @@ bool LLAppViewer::doFrame()
                 if (milliseconds_to_sleep > 0)
                 {
                     LLPerfStats::RecordSceneTime T ( LLPerfStats::StatType_t::RENDER_SLEEP );
-                    ms_sleep(milliseconds_to_sleep);
+                    frame_sleep(milliseconds_to_sleep);
                     // also pause worker threads during this wait period
                     LLAppViewer::getTextureCache()->pause();
                 }
@@ -1559,7 +1591,7 @@ bool LLAppViewer::doFrame()
 
                 if (io_pending > 1000)
                 {
-                    ms_sleep(llmin(io_pending/100,100)); // give the lfs some time to catch up
+                    frame_sleep(llmin(io_pending/100,100)); // give the lfs some time to catch up
                 }
 
                 total_work_pending += work_pending ;
@@ -3642,6 +3674,7 @@ void LLAppViewer::writeSystemInfo()
     // query some system information
     LL_INFOS("SystemInfo") << "CPU info:\n" << gSysCPU << LL_ENDL;
     LL_INFOS("SystemInfo") << "Memory info:\n" << gSysMemory << LL_ENDL;
+    LL_INFOS("SystemInfo") << "Allocator: " << LLMemory::getAllocatorName() << LL_ENDL;
     LL_INFOS("SystemInfo") << "OS: " << LLOSInfo::instance().getOSStringSimple() << LL_ENDL;
     LL_INFOS("SystemInfo") << "OS info: " << LLOSInfo::instance() << LL_ENDL;
 
@@ -4057,7 +4090,8 @@ U32 LLAppViewer::getTextureCacheVersion()
 U32 LLAppViewer::getDiskCacheVersion()
 {
     // Viewer disk cache version intorduced in Simple Cache Viewer, change if the cache format changes.
-    const U32 DISK_CACHE_VERSION = 1;
+    // 2: compressible assets may be stored zstd compressed (see LLCacheCompressor)
+    const U32 DISK_CACHE_VERSION = 2;
 
     return DISK_CACHE_VERSION ;
 }
@@ -4160,6 +4194,9 @@ bool LLAppViewer::initCache()
         const uintmax_t disk_cache_bytes = disk_cache_mb * 1024ull * 1024ull;
 
         const bool enable_cache_debug_info = gSavedSettings.getBOOL("EnableDiskCacheDebugInfo");
+        LLCacheCompressor& compressor = LLDiskCache::getInstance()->getCompressor();
+        compressor.setEnabled(gSavedSettings.getBOOL("DiskCacheCompression"));
+        compressor.setCompressionLevel(llclamp(gSavedSettings.getS32("DiskCacheCompressionLevel"), 1, 19));
         LLDiskCache::getInstance()->init(LL_PATH_CACHE, disk_cache_bytes, enable_cache_debug_info, disk_cache_mismatch);
 
         if (!read_only)
@@ -4562,6 +4599,8 @@ public:
 static LLTrace::BlockTimerStatHandle FTM_AUDIO_UPDATE("Update Audio");
 static LLTrace::BlockTimerStatHandle FTM_CLEANUP("Cleanup");
 static LLTrace::BlockTimerStatHandle FTM_CLEANUP_DRAWABLES("Drawables");
+static LLTrace::BlockTimerStatHandle FTM_CLEANUP_OBJECTS("Dead Objects");
+static LLTrace::BlockTimerStatHandle FTM_CLEANUP_VIEWS("Dead Views");
 static LLTrace::BlockTimerStatHandle FTM_IDLE_CB("Idle Callbacks");
 static LLTrace::BlockTimerStatHandle FTM_LOD_UPDATE("Update LOD");
 static LLTrace::BlockTimerStatHandle FTM_OBJECTLIST_UPDATE("Update Objectlist");
@@ -4597,7 +4636,14 @@ void LLAppViewer::idle()
     // completely redundant with LLEventTimer.
     LLNotificationsUI::LLToast::updateClass();
     LLSmoothInterpolation::updateInterpolants();
-    LLMortician::updateClass();
+    {
+        // closing a big floater can leave thousands of views to delete
+        static const LLFrameScheduler::task_id_t views_task =
+            gFrameScheduler.addTask("Dead Views", 1, 0.0005, 0.004, &FTM_CLEANUP_VIEWS);
+        LL_RECORD_BLOCK_TIME(FTM_CLEANUP_VIEWS);
+        LLFrameScheduler::Scope budget(gFrameScheduler, views_task);
+        LLMortician::updateClass(budget.getBudget());
+    }
     LLFilePickerThread::clearDead();  //calls LLFilePickerThread::notify()
     LLDirPickerThread::clearDead();
     F32 dt_raw = idle_timer.getElapsedTimeAndResetF32();
@@ -4871,12 +4917,21 @@ void LLAppViewer::idle()
     {
         LL_RECORD_BLOCK_TIME(FTM_CLEANUP);
         {
-            gObjectList.cleanDeadObjects();
+            // leaving a crowded area can kill thousands of objects at once
+            static const LLFrameScheduler::task_id_t objects_task =
+                gFrameScheduler.addTask("Dead Objects", 1, 0.001, 0.010, &FTM_CLEANUP_OBJECTS);
+            LL_RECORD_BLOCK_TIME(FTM_CLEANUP_OBJECTS);
+            LLFrameScheduler::Scope budget(gFrameScheduler, objects_task);
+            gObjectList.cleanDeadObjects(budget.getBudget());
         }
         {
             LL_RECORD_BLOCK_TIME(FTM_CLEANUP_DRAWABLES);
             LLDrawable::cleanupDeadDrawables();
         }
+
+        // what is left for later frames
+        sample(LLStatViewer::NUM_DEAD_OBJECTS, gObjectList.mNumDeadObjects);
+        sample(LLStatViewer::NUM_DEAD_VIEWS, LLMortician::graveyardCount());
     }
 
     //
@@ -4916,9 +4971,11 @@ void LLAppViewer::idle()
 
     worldInst.updateVisibilities();
     {
-        const F32 max_region_update_time = .001f; // 1ms
+        static const LLFrameScheduler::task_id_t region_task =
+            gFrameScheduler.addTask("Update Region", 1, 0.001, 0.004, &FTM_REGION_UPDATE);
         LL_RECORD_BLOCK_TIME(FTM_REGION_UPDATE);
-        worldInst.updateRegions(max_region_update_time);
+        LLFrameScheduler::Scope budget(gFrameScheduler, region_task);
+        worldInst.updateRegions(budget.getBudget());
     }
 
     /////////////////////////
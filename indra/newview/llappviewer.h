@@ -49,6 +49,7 @@
 #include "llsys.h"          // for LLOSInfo
 #include "lltimer.h"
 #include "llappcorehttp.h"
+#include "llframescheduler.h"
 #include "threadpool_fwd.h"
 
 #include <boost/signals2.hpp>
@@ -368,6 +369,9 @@ extern F32SecondsImplicit       gFrameIntervalSeconds;      // Elapsed time betw
 extern F32      gFPSClamped;                // Frames per second, smoothed, weighted toward last frame
 extern F32      gFrameDTClamped;
 
+// Hands out the time limits of the main loop's throttled work each frame
+extern LLFrameScheduler gFrameScheduler;
+
 extern LLTimer gRenderStartTime;
 extern LLFrameTimer gForegroundTime;
 extern LLFrameTimer gLoggedInTime;
@@ -0,0 +1,113 @@
+/**
+ * @file   llavatarbodyfill.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llavatarbodyfill.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llavatarbodyfill.h"
+
+#include "llmemory.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    // Shared with the helper tasks, which may still hold it after the
+    // calling thread is done, so it must own its list of fills.
+    struct FillBatch
+    {
+        std::vector<LLAvatarBodyFill::Fill> mFills;
+        std::atomic<U32> mNext{ 0 };
+        std::atomic<U32> mDone{ 0 };
+
+        void drain()
+        {
+            const U32 count = (U32)mFills.size();
+            U32 i;
+            while ((i = mNext.fetch_add(1, std::memory_order_relaxed)) < count)
+            {
+                LLAvatarBodyFill::run(mFills[i]);
+                mDone.fetch_add(1, std::memory_order_release);
+            }
+        }
+    };
+}
+
+LLAvatarBodyFill::LLAvatarBodyFill() :
+    mVertexCount(0)
+{
+}
+
+// static
+void LLAvatarBodyFill::run(const Fill& fill)
+{
+    const U32 num_verts = fill.mNumVerts;
+    U32 words = num_verts*4;
+
+    ll_memcpy_nonaliased_aligned_16((char*) fill.mVertices, (const char*) fill.mSrcCoords, words*sizeof(F32));
+    ll_memcpy_nonaliased_aligned_16((char*) fill.mNormals, (const char*) fill.mSrcNormals, words*sizeof(F32));
+
+    if (!fill.mTerse)
+    {
+        S32 tc_size = (num_verts*sizeof(F32)*2+0xF) & ~0xF;
+        ll_memcpy_nonaliased_aligned_16((char*) fill.mTexCoords, (const char*) fill.mSrcTexCoords, tc_size);
+        S32 vw_size = (num_verts*sizeof(F32)+0xF) & ~0xF;
+        ll_memcpy_nonaliased_aligned_16((char*) fill.mWeights, (const char*) fill.mSrcWeights, vw_size);
+        ll_memcpy_nonaliased_aligned_16((char*) fill.mClothingWeights, (const char*) fill.mSrcClothingWeights, num_verts*4*sizeof(F32));
+    }
+
+    U16* __restrict idx = fill.mIndices;
+    const S32* __restrict src_idx = fill.mSrcIndices;
+    const S32 offset = fill.mIndexOffset;
+
+    for (U32 i = 0; i < fill.mNumIndices; ++i)
+    {
+        *(idx++) = *(src_idx++)+offset;
+    }
+}
+
+void LLAvatarBodyFill::add(const Fill& fill)
+{
+    mFills.push_back(fill);
+    mVertexCount += fill.mNumVerts;
+}
+
+U32 LLAvatarBodyFill::flush(const post_func_t& post)
+{
+    U32 helpers = 0;
+    if (mFills.empty())
+    {
+        return helpers;
+    }
+
+    std::shared_ptr<FillBatch> batch = std::make_shared<FillBatch>();
+    batch->mFills.swap(mFills);
+    const U32 count = (U32)batch->mFills.size();
+
+    if (mVertexCount >= MIN_PARALLEL_VERTS && post)
+    {
+        const U32 wanted = llmin(mVertexCount / VERTS_PER_HELPER, MAX_HELPERS);
+        while (helpers < wanted && post([batch]() { batch->drain(); }))
+        {
+            ++helpers;
+        }
+    }
+    mVertexCount = 0;
+
+    // take fills until none are left, then wait for any still being
+    // copied by a helper
+    batch->drain();
+    while (batch->mDone.load(std::memory_order_acquire) < count)
+    {
+        std::this_thread::yield();
+    }
+    return helpers;
+}
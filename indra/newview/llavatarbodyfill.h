@@ -0,0 +1,77 @@
+/**
+ * @file   llavatarbodyfill.h
+ * @date   2026-10-18
+ * @brief  LLAvatarBodyFill copies system avatar body meshes into mapped
+ *         vertex buffers, a batch at a time, across several threads.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLAVATARBODYFILL_H
+#define LL_LLAVATARBODYFILL_H
+
+#include <functional>
+#include <vector>
+
+/**
+ * Mapping the buffers stays with the main thread (see
+ * LLViewerJointMesh::updateFaceData()); what is left for a Fill is plain
+ * memory, so it may be copied on any thread.
+ *
+ * flush() shares a large batch with helper tasks, sent through the given
+ * post function, while the calling thread takes its own share. It returns
+ * once every copy is done; helpers that start late find nothing to do.
+ */
+class LLAvatarBodyFill
+{
+public:
+    // One mesh's copy from its poly mesh into already mapped buffer memory
+    struct Fill
+    {
+        F32* mVertices;
+        F32* mNormals;
+        F32* mTexCoords;
+        F32* mWeights;
+        F32* mClothingWeights;
+        U16* mIndices;
+        const F32* mSrcCoords;
+        const F32* mSrcNormals;
+        const F32* mSrcTexCoords;
+        const F32* mSrcWeights;
+        const F32* mSrcClothingWeights;
+        const S32* mSrcIndices;
+        U32 mNumVerts;
+        U32 mNumIndices;
+        S32 mIndexOffset;
+        // positions and normals only
+        bool mTerse;
+    };
+
+    // Sends work to another thread, returning false if it could not
+    typedef std::function<bool(const std::function<void()>&)> post_func_t;
+
+    // below this many vertices a batch is copied on the calling thread
+    static const U32 MIN_PARALLEL_VERTS = 20000;
+    // rough number of vertices worth handing to one helper
+    static const U32 VERTS_PER_HELPER = 10000;
+    static const U32 MAX_HELPERS = 3;
+
+    LLAvatarBodyFill();
+
+    static void run(const Fill& fill);
+
+    void add(const Fill& fill);
+    bool empty() const { return mFills.empty(); }
+    U32 getVertexCount() const { return mVertexCount; }
+
+    // Copies every fill added so far. Returns the number of helpers posted.
+    U32 flush(const post_func_t& post);
+
+private:
+    std::vector<Fill> mFills;
+    U32 mVertexCount;
+};
+
+#endif // LL_LLAVATARBODYFILL_H
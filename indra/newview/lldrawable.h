@@ -42,6 +42,7 @@
 #include "llrect.h"
 #include "llappviewer.h" // for gFrameTimeSeconds
 #include "llvieweroctree.h"
+#include "llslaballocator.h"
 #include <unordered_set>
 
 class LLCamera;
@@ -63,7 +64,7 @@ LL_ALIGN_PREFIX(16)
 class LLDrawable
     : public LLViewerOctreeEntryData
 {
-    LL_ALIGN_NEW;
+    LL_SLAB_NEW(LLDrawable, LLMemTag::DRAWABLE, 16);
 public:
     typedef std::vector<LLFace*> face_list_t;
 
@@ -1814,6 +1814,7 @@ void LLEnvironment::updateSettingsUniforms()
     if (mCurrentEnvironment->getSky())
     {
         updateGLVariablesForSettings(mSkyUniforms, mCurrentEnvironment->getSky());
+        updateAtmosphereData();
     }
     else
     {
@@ -1821,6 +1822,94 @@ void LLEnvironment::updateSettingsUniforms()
     }
 }
 
+static_assert(sizeof(LLEnvironment::AtmosphereData) == 96, "AtmosphereData must match the std140 layout of the AtmosphereData uniform block");
+
+void LLEnvironment::updateAtmosphereData()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_SHADER;
+
+    // Members of the AtmosphereData block have no uniform location, so applying
+    // mSkyUniforms to a shader skips them; they're fed from here instead, once
+    // per update rather than once per shader.  Values are packed in the order
+    // they were pushed so that applySpecial overrides win, as they would with
+    // LLShaderUniforms::apply.
+    const LLShaderUniforms& uniforms = mSkyUniforms[LLGLSLShader::SG_ANY];
+    AtmosphereData& data = mAtmosphereData;
+
+    auto set_float = [&data](S32 uniform, F32 value)
+    {
+        switch (uniform)
+        {
+        case LLShaderMgr::HAZE_HORIZON:         data.mHazeHorizon = value; break;
+        case LLShaderMgr::HAZE_DENSITY:         data.mHazeDensity = value; break;
+        case LLShaderMgr::CLOUD_SHADOW:         data.mCloudShadow = value; break;
+        case LLShaderMgr::DENSITY_MULTIPLIER:   data.mDensityMultiplier = value; break;
+        case LLShaderMgr::DISTANCE_MULTIPLIER:  data.mDistanceMultiplier = value; break;
+        case LLShaderMgr::MAX_Y:                data.mMaxY = value; break;
+        case LLShaderMgr::SUN_MOON_GLOW_FACTOR: data.mSunMoonGlowFactor = value; break;
+        case LLShaderMgr::SKY_SUNLIGHT_SCALE:   data.mSkySunlightScale = value; break;
+        case LLShaderMgr::SKY_AMBIENT_SCALE:    data.mSkyAmbientScale = value; break;
+        default: break;
+        }
+    };
+
+    for (const auto& uniform : uniforms.mIntegers)
+    {
+        set_float(uniform.mUniform, (F32)uniform.mValue);
+    }
+
+    for (const auto& uniform : uniforms.mFloats)
+    {
+        set_float(uniform.mUniform, uniform.mValue);
+    }
+
+    for (const auto& uniform : uniforms.mVector3s)
+    {
+        switch (uniform.mUniform)
+        {
+        case LLShaderMgr::AMBIENT:      data.mAmbientColor = uniform.mValue; break;
+        case LLShaderMgr::BLUE_HORIZON: data.mBlueHorizon = uniform.mValue; break;
+        case LLShaderMgr::BLUE_DENSITY: data.mBlueDensity = uniform.mValue; break;
+        case LLShaderMgr::GLOW:         data.mGlow = uniform.mValue; break;
+        default: break;
+        }
+    }
+
+    uploadAtmosphereData(data);
+}
+
+void LLEnvironment::uploadAtmosphereData(const AtmosphereData& data)
+{
+    if (mAtmosphereUBO == 0)
+    {
+        glGenBuffers(1, &mAtmosphereUBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, mAtmosphereUBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(AtmosphereData), &data, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        mUploadedAtmosphereData = data;
+    }
+    else if (memcmp(&data, &mUploadedAtmosphereData, sizeof(AtmosphereData)) != 0)
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_SHADER("env - update atmosphere buffer");
+        glBindBuffer(GL_UNIFORM_BUFFER, mAtmosphereUBO);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(AtmosphereData), &data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        mUploadedAtmosphereData = data;
+    }
+
+    LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_ATMOSPHERE, mAtmosphereUBO);
+}
+
+void LLEnvironment::cleanupGL()
+{
+    if (mAtmosphereUBO != 0)
+    {
+        LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_ATMOSPHERE, 0);
+        glDeleteBuffers(1, &mAtmosphereUBO);
+        mAtmosphereUBO = 0;
+    }
+}
+
 void LLEnvironment::recordEnvironment(S32 parcel_id, LLEnvironment::EnvironmentInfo::ptr_t envinfo, LLSettingsBase::Seconds transition)
 {
     if (!gAgent.getRegion())
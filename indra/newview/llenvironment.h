@@ -141,6 +141,35 @@ public:
     // prepare settings to be applied to shaders (call whenever settings are updated)
     void                        updateSettingsUniforms();
 
+    // std140 mirror of the AtmosphereData uniform block
+    // NOTE: Keep in sync with AtmosphereData in
+    //       indra\newview\app_settings\shaders\class1\windlight\atmosphericsFuncs.glsl
+    struct AtmosphereData
+    {
+        LLVector3 mAmbientColor;
+        F32 mHazeHorizon = 0.f;
+        LLVector3 mBlueHorizon;
+        F32 mHazeDensity = 0.f;
+        LLVector3 mBlueDensity;
+        F32 mCloudShadow = 0.f;
+        LLVector3 mGlow;
+        F32 mDensityMultiplier = 0.f;
+        F32 mDistanceMultiplier = 0.f;
+        F32 mMaxY = 0.f;
+        F32 mSunMoonGlowFactor = 0.f;
+        F32 mSkySunlightScale = 0.f;
+        F32 mSkyAmbientScale = 0.f;
+        F32 mPad[3] = { 0.f, 0.f, 0.f };
+    };
+
+    // atmospheric settings as last packed by updateSettingsUniforms
+    const AtmosphereData&       getAtmosphereData() const { return mAtmosphereData; }
+    // upload data to the AtmosphereData uniform buffer and bind it (skipped if unchanged)
+    // use to temporarily override the sky for an offscreen render, then restore with getAtmosphereData()
+    void                        uploadAtmosphereData(const AtmosphereData& data);
+    // release the uniform buffer (recreated on next update)
+    void                        cleanupGL();
+
     void                        setSelectedEnvironment(EnvSelection_t env, LLSettingsBase::Seconds transition = TRANSITION_DEFAULT, bool forced = false);
     EnvSelection_t              getSelectedEnvironment() const                  { return mSelectedEnvironment; }
 
@@ -244,6 +273,16 @@ public:
     //cached uniform values from LLSD values
     LLShaderUniforms mWaterUniforms[LLGLSLShader::SG_COUNT];
     LLShaderUniforms mSkyUniforms[LLGLSLShader::SG_COUNT];
+
+private:
+    // pack the AtmosphereData members out of mSkyUniforms and upload them
+    void                        updateAtmosphereData();
+
+    AtmosphereData              mAtmosphereData;
+    AtmosphereData              mUploadedAtmosphereData;
+    U32                         mAtmosphereUBO = 0;
+
+public:
     // =======================================================================================
 
     class DayInstance: public std::enable_shared_from_this<DayInstance>
@@ -56,7 +56,7 @@ const U8 FACE_DO_NOT_BATCH_TEXTURES = 255;
 
 class alignas(16) LLFace
 {
-    LL_ALIGN_NEW
+    LL_SLAB_NEW(LLFace, LLMemTag::DRAWABLE, 16);
 public:
     LLFace(const LLFace& rhs) = delete;
     LLFace& operator=(const LLFace& rhs) = delete;
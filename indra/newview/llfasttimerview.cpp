@@ -336,6 +336,18 @@ static std::string get_tooltip(BlockTimerStatHandle& timer, S32 history_index, P
     {
         tooltip = fmt::format(FMT_STRING("{:s} ({:.3f} ms, {:d} calls)"), timer.getName(), F64Milliseconds(frame_recording.getPrevRecording(history_index).getSum(timer)).value(), (S32)frame_recording.getPrevRecording(history_index).getSum(timer.callCount()));
     }
+
+    // main loop work limited by gFrameScheduler also shows how much of its budget it used last frame
+    const LLFrameScheduler::Task* task = gFrameScheduler.findTask(timer);
+    if (task && task->mMaxTime > 0.0)
+    {
+        F64 used_pct = task->mLastBudget > 0.0 ? task->mLastUsed / task->mLastBudget * 100.0 : 0.0;
+        tooltip += fmt::format(FMT_STRING(" budget {:.3f} ms, {:.0f}% used"), task->mLastBudget * 1000.0, used_pct);
+    }
+    else if (task)
+    {
+        tooltip += " unbudgeted";
+    }
     return tooltip;
 }
 
@@ -33,6 +33,7 @@
 #include "llfetchedgltfmaterial.h"
 #include "llfilesystem.h"
 #include "llsdserialize.h"
+#include "lltextureentry.h"
 #include "lltinygltfhelper.h"
 #include "llviewercontrol.h"
 #include "llviewergenericmessage.h"
@@ -219,8 +220,9 @@ void LLGLTFMaterialList::applyOverrideMessage(LLMessageSystem* msg, const std::s
             U32 count = llmin(tes.size(), MAX_TES);
             for (U32 i = 0; i < count; ++i)
             {
-                LLGLTFMaterial* mat = new LLGLTFMaterial(); // setTEGLTFMaterialOverride and cache will take ownership
+                LLPointer<LLGLTFMaterial> mat = new LLGLTFMaterial(); // setTEGLTFMaterialOverride and cache will share it
                 mat->applyOverrideLLSD(od[i]);
+                mat = internOverride(mat);
 
                 S32 te = tes[i].asInteger();
 
@@ -664,12 +666,78 @@ void LLGLTFMaterialList::flushMaterials()
         mLastUpdateKey.setNull();
     }
 
+    // drop shared render materials and overrides no face uses anymore,
+    // render materials first since they hold overrides
+    const F32 SHARED_FLUSH_INTERVAL = 5.f;
+    if (mSharedFlushTimer.getElapsedTimeF32() > SHARED_FLUSH_INTERVAL)
+    {
+        mSharedFlushTimer.reset();
+        for (render_mat_map_t::iterator it = mRenderMaterials.begin(); it != mRenderMaterials.end(); )
+        {
+            if (it->second.mRender->getNumRefs() == 1)
+            {
+                it = mRenderMaterials.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        U32 override_uses = mInternedOverrides.flush();
+
+        using namespace LLStatViewer;
+        sample(NUM_MATERIAL_OVERRIDES, mInternedOverrides.size());
+        sample(NUM_MATERIAL_OVERRIDE_USES, override_uses);
+    }
+
     {
         using namespace LLStatViewer;
         sample(NUM_MATERIALS, mList.size());
     }
 }
 
+LLGLTFMaterial* LLGLTFMaterialList::internOverride(LLGLTFMaterial* override_mat)
+{
+    return mInternedOverrides.intern(override_mat);
+}
+
+LLFetchedGLTFMaterial* LLGLTFMaterialList::getRenderMaterial(LLFetchedGLTFMaterial* base_mat, LLGLTFMaterial* override_mat)
+{
+    if (override_mat->hasLocalTextures())
+    {
+        // not interned, see LLGLTFOverrideTable
+        LLFetchedGLTFMaterial* render_mat = new LLFetchedGLTFMaterial(*base_mat);
+        render_mat->applyOverride(*override_mat);
+        return render_mat;
+    }
+
+    SharedRenderMaterial& shared = mRenderMaterials[render_mat_map_t::key_type(base_mat, override_mat)];
+    if (shared.mRender.isNull())
+    {
+        shared.mBase = base_mat;
+        shared.mOverride = override_mat;
+        shared.mRender = new LLFetchedGLTFMaterial(*base_mat);
+        shared.mRender->applyOverride(*override_mat);
+    }
+    return shared.mRender;
+}
+
+void LLGLTFMaterialList::unshareMaterials(LLTextureEntry* tep)
+{
+    LLGLTFMaterial* override_mat = tep->getGLTFMaterialOverride();
+    if (override_mat && override_mat->getNumRefs() > 1)
+    {
+        tep->setGLTFMaterialOverride(new LLGLTFMaterial(*override_mat));
+    }
+
+    LLFetchedGLTFMaterial* render_mat = (LLFetchedGLTFMaterial*) tep->getGLTFRenderMaterial();
+    if (render_mat && render_mat->getNumRefs() > 1)
+    {
+        tep->setGLTFRenderMaterial(new LLFetchedGLTFMaterial(*render_mat));
+    }
+}
+
 // static
 void LLGLTFMaterialList::modifyMaterialCoro(std::string cap_url, LLSD overrides, void(*done_callback)(bool) )
 {
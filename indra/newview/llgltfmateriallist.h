@@ -29,13 +29,16 @@
 #include "llassettype.h"
 #include "llextendedstatus.h"
 #include "llfetchedgltfmaterial.h"
+#include "llframetimer.h"
 #include "llgltfmaterial.h"
 #include "llpointer.h"
 
+#include <boost/unordered_map.hpp>
 #include <unordered_map>
 
 class LLFetchedGLTFMaterial;
 class LLGLTFOverrideCacheEntry;
+class LLTextureEntry;
 
 class LLGLTFMaterialList
 {
@@ -50,6 +53,21 @@ public:
 
     void flushMaterials();
 
+    // The same override data is often applied to thousands of faces (say a
+    // tint across a whole build). Returns the one shared instance equal to
+    // override_mat, which must not be modified in place from then on;
+    // LLTextureEntry copies overrides before changing them.
+    LLGLTFMaterial* internOverride(LLGLTFMaterial* override_mat);
+
+    // base_mat with override_mat applied, shared by every face using the
+    // same pair
+    LLFetchedGLTFMaterial* getRenderMaterial(LLFetchedGLTFMaterial* base_mat, LLGLTFMaterial* override_mat);
+
+    // Gives tep its own copies of its override and render material where
+    // they are shared, so that they can be changed in place, e.g. to track
+    // local textures
+    static void unshareMaterials(LLTextureEntry* tep);
+
     // Queue an modification of a material that we want to send to the simulator.  Call "flushUpdates" to flush pending updates.
     //  id - ID of object to modify
     //  side - TexureEntry index to modify, or -1 for all sides
@@ -123,6 +141,20 @@ protected:
 
     LLUUID mLastUpdateKey;
 
+    LLGLTFOverrideTable mInternedOverrides;
+
+    struct SharedRenderMaterial
+    {
+        // the key's materials, kept alive so their addresses are not reused
+        LLPointer<LLGLTFMaterial> mBase;
+        LLPointer<LLGLTFMaterial> mOverride;
+        LLPointer<LLFetchedGLTFMaterial> mRender;
+    };
+    typedef boost::unordered_map<std::pair<const LLGLTFMaterial*, const LLGLTFMaterial*>, SharedRenderMaterial> render_mat_map_t;
+    render_mat_map_t mRenderMaterials;
+
+    LLFrameTimer mSharedFlushTimer;
+
     struct ModifyMaterialData
     {
         LLUUID object_id;
@@ -385,7 +385,11 @@ void fixup_shader_constants(LLGLSLShader& shader)
     // Sunlight intensity of 0 no matter what
     shader.uniform1i(LLShaderMgr::SUN_UP_FACTOR, 1);
     shader.uniform3fv(LLShaderMgr::SUNLIGHT_COLOR, 1, LLColor3::white.mV);
-    shader.uniform1f(LLShaderMgr::DENSITY_MULTIPLIER, 0.0f);
+
+    // No haze (density_multiplier lives in the shared atmosphere uniform buffer, restored after render)
+    LLEnvironment::AtmosphereData atmosphere = LLEnvironment::instance().getAtmosphereData();
+    atmosphere.mDensityMultiplier = 0.0f;
+    LLEnvironment::instance().uploadAtmosphereData(atmosphere);
 
     // Ignore sun shadow (if enabled)
     for (U32 i = 0; i < 6; i++)
@@ -548,6 +552,7 @@ BOOL LLGLTFPreviewTexture::render()
     gDeferredPostNoDoFProgram.unbind();
 
     // Clean up
+    LLEnvironment::instance().uploadAtmosphereData(LLEnvironment::instance().getAtmosphereData());
     gPipeline.setupHWLights();
     gPipeline.mReflectionMapManager.forceDefaultProbeAndUpdateUniforms(false);
     gSavedSettings.set<S32>("RenderLocalLightCount", old_local_light_count);
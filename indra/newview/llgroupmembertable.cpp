@@ -0,0 +1,241 @@
+/**
+ * @file   llgroupmembertable.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llgroupmembertable.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llgroupmembertable.h"
+
+#include "llsd.h"
+#include "llstring.h"
+
+namespace
+{
+    // reads 1 to max_digits digits, returns false if there are none
+    bool read_number(const char*& p, S32 max_digits, U32& value)
+    {
+        value = 0;
+        S32 digits = 0;
+        while (digits < max_digits && *p >= '0' && *p <= '9')
+        {
+            value = value * 10 + (*p - '0');
+            ++p;
+            ++digits;
+        }
+        return digits > 0;
+    }
+}
+
+LLGroupMemberTable::LLGroupMemberTable():
+    mMemberCount(0)
+{
+}
+
+bool LLGroupMemberTable::fromLLSD(const LLSD& content)
+{
+    mGroupID = content["group_id"].asUUID();
+    mMemberCount = content["member_count"].asInteger();
+    mIDs.clear();
+    mContributions.clear();
+    mPowers.clear();
+    mTitleIndices.clear();
+    mLastLogins.clear();
+    mOwners.clear();
+    mTitles.clear();
+    mRows.clear();
+
+    const LLSD& members = content["members"];
+    const LLSD& titles = content["titles"];
+    if (mMemberCount < 1 || !members.isMap())
+    {
+        return false;
+    }
+
+    // members refer to their titles by index into this list
+    const U32 title_count = llmin((U32)titles.size(), (U32)U16_MAX);
+    mTitles.reserve(title_count + 1);
+    for (U32 i = 0; i < title_count; ++i)
+    {
+        mTitles.push_back(std::make_shared<const std::string>(titles[i].asString()));
+    }
+    // for members whose title is not in the list
+    const U16 no_title = (U16)mTitles.size();
+    mTitles.push_back(std::make_shared<const std::string>());
+    const U16 default_title = title_count ? 0 : no_title;
+
+    const U64 default_powers = llstrtou64(content["defaults"]["default_powers"].asString().c_str(), NULL, 16);
+
+    const U32 count = (U32)members.size();
+    mIDs.reserve(count);
+    mContributions.reserve(count);
+    mPowers.reserve(count);
+    mTitleIndices.reserve(count);
+    mLastLogins.reserve(count);
+    mOwners.reserve(count);
+    mRows.reserve(count);
+
+    for (LLSD::map_const_iterator it = members.beginMap(), end = members.endMap(); it != end; ++it)
+    {
+        if (!it->second.isMap())
+        {
+            continue;
+        }
+
+        S32 contribution = 0;
+        U64 powers = default_powers;
+        U16 title = default_title;
+        U32 last_login = LAST_LOGIN_UNKNOWN;
+        U8 owner = 0;
+
+        // one pass over the member's few fields, rather than a lookup per field
+        for (LLSD::map_const_iterator field = it->second.beginMap(), fields_end = it->second.endMap();
+             field != fields_end; ++field)
+        {
+            const std::string& key = field->first;
+            if (key == "last_login")
+            {
+                last_login = parseLastLogin(field->second.asString());
+            }
+            else if (key == "title")
+            {
+                S32 index = field->second.asInteger();
+                title = (index >= 0 && (U32)index < title_count) ? (U16)index : no_title;
+            }
+            else if (key == "powers")
+            {
+                powers = llstrtou64(field->second.asString().c_str(), NULL, 16);
+            }
+            else if (key == "donated_square_meters")
+            {
+                contribution = field->second.asInteger();
+            }
+            else if (key == "owner")
+            {
+                owner = 1;
+            }
+        }
+
+        LLUUID id(it->first);
+        if (!mRows.emplace(id, (U32)mIDs.size()).second)
+        {
+            continue;
+        }
+        mIDs.push_back(id);
+        mContributions.push_back(contribution);
+        mPowers.push_back(powers);
+        mTitleIndices.push_back(title);
+        mLastLogins.push_back(last_login);
+        mOwners.push_back(owner);
+    }
+
+    return !mIDs.empty();
+}
+
+void LLGroupMemberTable::addMember(const LLUUID& id, S32 contribution, U64 powers, const std::string& title,
+                                   U32 last_login, bool is_owner)
+{
+    if (!mRows.emplace(id, (U32)mIDs.size()).second)
+    {
+        return;
+    }
+    mIDs.push_back(id);
+    mContributions.push_back(contribution);
+    mPowers.push_back(powers);
+    mTitleIndices.push_back(internTitle(title));
+    mLastLogins.push_back(last_login);
+    mOwners.push_back(is_owner ? 1 : 0);
+    mMemberCount = llmax(mMemberCount, (S32)mIDs.size());
+}
+
+U16 LLGroupMemberTable::internTitle(const std::string& title)
+{
+    // groups have a handful of titles
+    for (U32 i = 0; i < mTitles.size(); ++i)
+    {
+        if (*mTitles[i] == title)
+        {
+            return (U16)i;
+        }
+    }
+    mTitles.push_back(std::make_shared<const std::string>(title));
+    return (U16)(mTitles.size() - 1);
+}
+
+S32 LLGroupMemberTable::findRow(const LLUUID& id) const
+{
+    boost::unordered_map<LLUUID, U32>::const_iterator it = mRows.find(id);
+    return it != mRows.end() ? (S32)it->second : -1;
+}
+
+bool LLGroupMemberTable::sameRow(U32 row, const LLGroupMemberTable& other, U32 other_row) const
+{
+    if (mContributions[row] != other.mContributions[other_row] ||
+        mPowers[row] != other.mPowers[other_row] ||
+        mLastLogins[row] != other.mLastLogins[other_row] ||
+        mOwners[row] != other.mOwners[other_row])
+    {
+        return false;
+    }
+    const title_t& title = getTitle(row);
+    const title_t& other_title = other.getTitle(other_row);
+    return title == other_title || *title == *other_title;
+}
+
+void LLGroupMemberTable::diff(const LLGroupMemberTable* older, std::vector<U32>& changed, uuid_vec_t& removed) const
+{
+    changed.clear();
+    removed.clear();
+    for (U32 row = 0; row < size(); ++row)
+    {
+        S32 old_row = older ? older->findRow(mIDs[row]) : -1;
+        if (old_row < 0 || !sameRow(row, *older, (U32)old_row))
+        {
+            changed.push_back(row);
+        }
+    }
+    if (older)
+    {
+        for (const LLUUID& id : older->mIDs)
+        {
+            if (findRow(id) < 0)
+            {
+                removed.push_back(id);
+            }
+        }
+    }
+}
+
+// static
+U32 LLGroupMemberTable::parseLastLogin(const std::string& status)
+{
+    if (status == "Online")
+    {
+        return LAST_LOGIN_ONLINE;
+    }
+
+    const char* p = status.c_str();
+    U32 month, day, year;
+    if (read_number(p, 2, month) && *p++ == '/' &&
+        read_number(p, 2, day) && *p++ == '/' &&
+        read_number(p, 4, year) && *p == '\0' && year >= 1000)
+    {
+        return year * 10000 + month * 100 + day;
+    }
+    return LAST_LOGIN_UNKNOWN;
+}
+
+// static
+std::string LLGroupMemberTable::formatLastLogin(U32 last_login)
+{
+    if (last_login == LAST_LOGIN_UNKNOWN || last_login == LAST_LOGIN_ONLINE)
+    {
+        return std::string();
+    }
+    return llformat("%04u/%02u/%02u", last_login / 10000, (last_login / 100) % 100, last_login % 100);
+}
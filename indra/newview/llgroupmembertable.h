@@ -0,0 +1,93 @@
+/**
+ * @file   llgroupmembertable.h
+ * @date   2026-10-18
+ * @brief  LLGroupMemberTable holds a group's member list as columns, the
+ *         way the GroupMemberData capability sends it.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_LLGROUPMEMBERTABLE_H)
+#define LL_LLGROUPMEMBERTABLE_H
+
+#include "lluuid.h"
+#include <boost/unordered_map.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+class LLSD;
+
+/**
+ * One row per member. Titles are shared, one string per entry of the
+ * reply's title list, and last logins are kept as numbers rather than
+ * display strings.
+ *
+ * fromLLSD() touches nothing but its arguments and the table, so a
+ * reply can be parsed off the main thread. LLGroupMgr keeps the last
+ * table for each group and uses diff() so that a refresh only touches
+ * the members that changed.
+ */
+class LLGroupMemberTable
+{
+public:
+    typedef std::shared_ptr<const std::string> title_t;
+
+    // last logins are dates packed as YYYYMMDD, or one of these
+    static const U32 LAST_LOGIN_UNKNOWN = 0;
+    static const U32 LAST_LOGIN_ONLINE = 0xffffffff;
+
+    LLGroupMemberTable();
+
+    // Fill from a GroupMemberData capability reply, replacing anything
+    // already in the table. Returns false if the reply has no members.
+    bool fromLLSD(const LLSD& content);
+
+    // Add a row; for building tables some other way, e.g. in tests.
+    void addMember(const LLUUID& id, S32 contribution, U64 powers, const std::string& title,
+                   U32 last_login, bool is_owner);
+
+    const LLUUID& getGroupID() const            { return mGroupID; }
+    S32 getMemberCount() const                  { return mMemberCount; }
+
+    U32 size() const                            { return (U32)mIDs.size(); }
+    const LLUUID& getID(U32 row) const          { return mIDs[row]; }
+    S32 getContribution(U32 row) const          { return mContributions[row]; }
+    U64 getPowers(U32 row) const                { return mPowers[row]; }
+    const title_t& getTitle(U32 row) const      { return mTitles[mTitleIndices[row]]; }
+    U32 getLastLogin(U32 row) const             { return mLastLogins[row]; }
+    bool isOwner(U32 row) const                 { return mOwners[row] != 0; }
+
+    // row of the member, or -1 if not in the table
+    S32 findRow(const LLUUID& id) const;
+
+    // Rows of this table that are new or differ from older, and the IDs
+    // in older that are no longer here. older may be NULL.
+    void diff(const LLGroupMemberTable* older, std::vector<U32>& changed, uuid_vec_t& removed) const;
+
+    // "Online" or MM/DD/YYYY, as both member replies send it
+    static U32 parseLastLogin(const std::string& status);
+    // YYYY/MM/DD, which sorts as text; empty for the non-date values
+    static std::string formatLastLogin(U32 last_login);
+
+private:
+    bool sameRow(U32 row, const LLGroupMemberTable& other, U32 other_row) const;
+    U16 internTitle(const std::string& title);
+
+    LLUUID mGroupID;
+    S32 mMemberCount;
+
+    std::vector<LLUUID> mIDs;
+    std::vector<S32> mContributions;
+    std::vector<U64> mPowers;
+    std::vector<U16> mTitleIndices;
+    std::vector<U32> mLastLogins;
+    std::vector<U8> mOwners;
+
+    std::vector<title_t> mTitles;
+    boost::unordered_map<LLUUID, U32> mRows;
+};
+
+#endif /* ! defined(LL_LLGROUPMEMBERTABLE_H) */
@@ -51,10 +51,8 @@
 #include "lluictrlfactory.h"
 #include "lltrans.h"
 #include "llviewerregion.h"
-#include <boost/regex.hpp>
 #include "llcorehttputil.h"
-
-#include <boost/lexical_cast.hpp>
+#include "workqueue.h"
 
 const U32 MAX_CACHED_GROUPS = 20;
 
@@ -79,16 +77,56 @@ LLRoleActionSet::~LLRoleActionSet()
 LLGroupMemberData::LLGroupMemberData(const LLUUID& id,
                                         S32 contribution,
                                         U64 agent_powers,
-                                        const std::string& title,
-                                        const std::string& online_status,
+                                        const LLGroupMemberTable::title_t& title,
+                                        U32 last_login,
                                         BOOL is_owner) :
     mID(id),
     mContribution(contribution),
     mAgentPowers(agent_powers),
     mTitle(title),
-    mOnlineStatus(online_status),
+    mLastLogin(last_login),
     mIsOwner(is_owner)
 {
+    if (!mTitle)
+    {
+        static const LLGroupMemberTable::title_t no_title = std::make_shared<const std::string>();
+        mTitle = no_title;
+    }
+}
+
+const std::string& LLGroupMemberData::getOnlineStatus() const
+{
+    if (mOnlineStatus.empty())
+    {
+        if (mLastLogin == LLGroupMemberTable::LAST_LOGIN_ONLINE)
+        {
+            static const std::string localized_online(LLTrans::getString("group_member_status_online"));
+            mOnlineStatus = localized_online;
+        }
+        else if (mLastLogin == LLGroupMemberTable::LAST_LOGIN_UNKNOWN)
+        {
+            mOnlineStatus = "unknown";
+        }
+        else
+        {
+            // sorts as text, year before month before day
+            mOnlineStatus = LLGroupMemberTable::formatLastLogin(mLastLogin);
+        }
+    }
+    return mOnlineStatus;
+}
+
+void LLGroupMemberData::update(const LLGroupMemberTable& table, U32 row)
+{
+    mContribution = table.getContribution(row);
+    mAgentPowers = table.getPowers(row);
+    mTitle = table.getTitle(row);
+    if (mLastLogin != table.getLastLogin(row))
+    {
+        mLastLogin = table.getLastLogin(row);
+        mOnlineStatus.clear();
+    }
+    mIsOwner = table.isOwner(row);
 }
 
 void LLGroupMemberData::addRole(const LLUUID& role, LLGroupRoleData* rd)
@@ -410,6 +448,7 @@ void LLGroupMgrGroupData::removeData()
 void LLGroupMgrGroupData::removeMemberData()
 {
     mMembers.clear();
+    mMemberTable.reset();
     mMemberDataComplete = false;
     mMemberVersion.generate();
 }
@@ -504,6 +543,10 @@ bool LLGroupMgrGroupData::changeRoleMember(const LLUUID& role_id,
         gmd->mIsOwner = (role_id == mOwnerRole) ? FALSE : gmd->mIsOwner;
     }
 
+    // the member no longer matches the last reply, so the next refresh
+    // has to look at everyone
+    mMemberTable.reset();
+
     lluuid_pair role_member;
     role_member.first = role_id;
     role_member.second = member_id;
@@ -893,26 +936,6 @@ LLGroupMgrGroupData* LLGroupMgr::getGroupData(const LLUUID& id)
     return NULL;
 }
 
-// Helper function for LLGroupMgr::processGroupMembersReply
-// This reformats date strings from MM/DD/YYYY to YYYY/MM/DD ( e.g. 1/27/2008 -> 2008/1/27 )
-// so that the sorter can sort by year before month before day.
-static void formatDateString(std::string &date_string)
-{
-    using namespace boost;
-    cmatch result;
-    const regex expression("([0-9]{1,2})/([0-9]{1,2})/([0-9]{4})");
-    if (regex_match(date_string.c_str(), result, expression))
-    {
-        // convert matches to integers so that we can pad them with zeroes on Linux
-        S32 year    = boost::lexical_cast<S32>(result[3]);
-        S32 month   = boost::lexical_cast<S32>(result[1]);
-        S32 day     = boost::lexical_cast<S32>(result[2]);
-
-        // ISO 8601 date format
-        date_string = llformat("%04d/%02d/%02d", year, month, day);
-    }
-}
-
 // static
 void LLGroupMgr::processGroupMembersReply(LLMessageSystem* msg, void** data)
 {
@@ -942,6 +965,9 @@ void LLGroupMgr::processGroupMembersReply(LLMessageSystem* msg, void** data)
 
     msg->getS32Fast(_PREHASH_GroupData, _PREHASH_MemberCount, group_datap->mMemberCount );
 
+    // these members did not come from a GroupMemberData reply
+    group_datap->mMemberTable.reset();
+
     if (group_datap->mMemberCount > 0)
     {
         S32 contribution = 0;
@@ -949,6 +975,8 @@ void LLGroupMgr::processGroupMembersReply(LLMessageSystem* msg, void** data)
         std::string title;
         U64 agent_powers = 0;
         BOOL is_owner = FALSE;
+        // members with the same title share it
+        std::map<std::string, LLGroupMemberTable::title_t> titles;
 
         S32 num_members = msg->getNumberOfBlocksFast(_PREHASH_MemberData);
         for (S32 i = 0; i < num_members; i++)
@@ -964,22 +992,18 @@ void LLGroupMgr::processGroupMembersReply(LLMessageSystem* msg, void** data)
 
             if (member_id.notNull())
             {
-                if (online_status == "Online")
-                {
-                    static std::string localized_online(LLTrans::getString("group_member_status_online"));
-                    online_status = localized_online;
-                }
-                else
+                LLGroupMemberTable::title_t& shared_title = titles[title];
+                if (!shared_title)
                 {
-                    formatDateString(online_status); // reformat for sorting, e.g. 12/25/2008 -> 2008/12/25
+                    shared_title = std::make_shared<const std::string>(title);
                 }
 
                 //LL_INFOS() << "Member " << member_id << " has powers " << std::hex << agent_powers << std::dec << LL_ENDL;
                 auto newdata = std::make_unique<LLGroupMemberData>(member_id,
                                                                     contribution,
                                                                     agent_powers,
-                                                                    title,
-                                                                    online_status,
+                                                                    shared_title,
+                                                                    LLGroupMemberTable::parseLastLogin(online_status),
                                                                     is_owner);
 #if LL_DEBUG
                 LLGroupMgrGroupData::member_list_t::iterator mit = group_datap->mMembers.find(member_id);
@@ -2142,7 +2166,37 @@ void LLGroupMgr::groupMembersRequestCoro(std::string url, LLUUID groupId)
     }
 
     result.erase(LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS);
-    LLGroupMgr::processCapGroupMembersRequest(result);
+    if (!result.size())
+    {
+        LL_DEBUGS("GrpMgr") << "No group member data received." << LL_ENDL;
+        mMemberRequestInFlight = false;
+        return;
+    }
+
+    // Big groups send tens of thousands of members; parse them on a worker
+    // while this coroutine waits. Nothing else holds a reference to result.
+    std::shared_ptr<LLGroupMemberTable> table = std::make_shared<LLGroupMemberTable>();
+    const LLSD& content = result;
+    bool parsed = false;
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (general_queue)
+    {
+        try
+        {
+            general_queue->waitForResult([&table, &content]() { return table->fromLLSD(content); });
+            parsed = true;
+        }
+        catch (const LL::WorkQueue::Closed&)
+        {
+            // shutting down, fall through
+        }
+    }
+    if (!parsed)
+    {
+        table->fromLLSD(content);
+    }
+
+    applyMemberTable(table);
     mMemberRequestInFlight = false;
 }
 
@@ -2200,7 +2254,14 @@ void LLGroupMgr::processCapGroupMembersRequest(const LLSD& content)
         return;
     }
 
-    LLUUID group_id = content["group_id"].asUUID();
+    std::shared_ptr<LLGroupMemberTable> table = std::make_shared<LLGroupMemberTable>();
+    table->fromLLSD(content);
+    applyMemberTable(table);
+}
+
+void LLGroupMgr::applyMemberTable(const std::shared_ptr<const LLGroupMemberTable>& table)
+{
+    const LLUUID& group_id = table->getGroupID();
 
     LLGroupMgrGroupData* group_datap = getGroupData(group_id);
     if(!group_datap)
@@ -2210,8 +2271,7 @@ void LLGroupMgr::processCapGroupMembersRequest(const LLSD& content)
     }
 
     // If we have no members, there's no reason to do anything else
-    S32 num_members = content["member_count"];
-    if (num_members < 1)
+    if (table->getMemberCount() < 1)
     {
         LL_INFOS("GrpMgr") << "Received empty group members list for group id: " << group_id.asString() << LL_ENDL;
         // Set mMemberDataComplete for correct handling of empty responses. See MAINT-5237
@@ -2221,102 +2281,76 @@ void LLGroupMgr::processCapGroupMembersRequest(const LLSD& content)
         return;
     }
 
-    group_datap->mMemberCount = num_members;
-
-    LLSD    member_list = content["members"];
-    LLSD    titles      = content["titles"];
-    LLSD    defaults    = content["defaults"];
+    group_datap->mMemberCount = table->getMemberCount();
 
-    std::string online_status;
-    std::string title;
-    S32         contribution;
-    U64         member_powers;
-    // If this is changed to a bool, make sure to change the LLGroupMemberData constructor
-    BOOL        is_owner;
-
-    // Compute this once, rather than every time.
-    U64 default_powers  = llstrtou64(defaults["default_powers"].asString().c_str(), NULL, 16);
-
-    const std::string group_member_status_online = LLTrans::getString("group_member_status_online");
-    const std::string default_title = titles[0].asString();
-
-    LLSD::map_const_iterator member_iter_start  = member_list.beginMap();
-    LLSD::map_const_iterator member_iter_end    = member_list.endMap();
-    for( ; member_iter_start != member_iter_end; ++member_iter_start)
+    // Only compare against the last reply if the member list still matches it;
+    // ejects and UDP replies change the list behind its back.
+    const LLGroupMemberTable* older = group_datap->mMemberTable.get();
+    if (older && (older->size() != group_datap->mMembers.size()))
     {
-        if (!member_iter_start->second.isMap()) continue;
+        older = NULL;
+    }
 
-        const LLUUID member_id(member_iter_start->first);
-        const auto& member_info = member_iter_start->second.asMap();
-        const auto member_info_end = member_info.end();
+    std::vector<U32> changed;
+    uuid_vec_t removed;
+    table->diff(older, changed, removed);
 
-        auto it = member_info.find("last_login");
-        if(it != member_info_end)
+    for (U32 row : changed)
+    {
+        const LLUUID& member_id = table->getID(row);
+        std::unique_ptr<LLGroupMemberData>& member = group_datap->mMembers[member_id];
+        if (member)
         {
-            online_status = it->second.asString();
-            if(online_status == "Online")
-                online_status = group_member_status_online;
-            else
-                formatDateString(online_status);
+            member->update(*table, row);
         }
         else
         {
-            online_status = "unknown";
-        }
-
-        it = member_info.find("title");
-        if (it != member_info_end)
-            title = titles[it->second.asInteger()].asString();
-        else
-            title = default_title;
-
-        it = member_info.find("powers");
-        if (it != member_info_end)
-            member_powers = llstrtou64(it->second.asString().c_str(), NULL, 16);
-        else
-            member_powers = default_powers;
+            group_datap->mRoleMemberDataComplete = false;
 
-        it = member_info.find("donated_square_meters");
-        if (it != member_info_end)
-            contribution = it->second.asInteger();
-        else
-            contribution = 0;
+            member = std::make_unique<LLGroupMemberData>(member_id,
+                table->getContribution(row),
+                table->getPowers(row),
+                table->getTitle(row),
+                table->getLastLogin(row),
+                table->isOwner(row));
+        }
+    }
 
-        it = member_info.find("owner");
-        if (it != member_info_end)
-            is_owner = true;
-        else
-            is_owner = false;
+    for (const LLUUID& member_id : removed)
+    {
+        LLGroupMgrGroupData::member_list_t::iterator mit = group_datap->mMembers.find(member_id);
+        if (mit == group_datap->mMembers.end())
+        {
+            continue;
+        }
 
-        LLGroupMemberData* member_old = group_datap->mMembers[member_id].get();
-        if (member_old)
+        LLGroupMemberData* member_data = mit->second.get();
+        for (LLGroupMemberData::role_list_t::iterator rit = member_data->roleBegin();
+            rit != member_data->roleEnd(); ++rit)
         {
-            member_old->mID = member_id;
-            member_old->mContribution = contribution;
-            member_old->mAgentPowers = member_powers;
-            member_old->mTitle = std::move(title);
-            member_old->mOnlineStatus = std::move(online_status);
-            member_old->mIsOwner = is_owner;
-
-            if (!group_datap->mRoleMemberDataComplete)
+            if ((*rit).first.notNull() && (*rit).second != nullptr)
             {
-                member_old->mRolesList.clear();
+                (*rit).second->removeMember(member_id);
             }
         }
-        else
-        {
-            group_datap->mRoleMemberDataComplete = false;
+        group_datap->mMembers.erase(mit);
+    }
 
-            group_datap->mMembers[member_id] = std::make_unique<LLGroupMemberData>(member_id,
-                contribution,
-                member_powers,
-                title,
-                online_status,
-                is_owner);
+    if (!group_datap->mRoleMemberDataComplete)
+    {
+        for (const auto& member_pair : group_datap->mMembers)
+        {
+            member_pair.second->clearRoles();
         }
     }
 
-    group_datap->mMemberVersion.generate();
+    // Panels rebuild their lists when the version changes, so leave it be
+    // if the refresh brought nothing new.
+    if (!older || !changed.empty() || !removed.empty())
+    {
+        group_datap->mMemberVersion.generate();
+    }
+    group_datap->mMemberTable = table;
 
     // Technically, we have this data, but to prevent completely overhauling
     // this entire system (it would be nice, but I don't have the time),
@@ -28,6 +28,7 @@
 #define LL_LLGROUPMGR_H
 
 #include "lluuid.h"
+#include "llgroupmembertable.h"
 #include "roles_constants.h"
 #include <vector>
 #include <string>
@@ -82,8 +83,8 @@ public:
     LLGroupMemberData(const LLUUID& id,
                         S32 contribution,
                         U64 agent_powers,
-                        const std::string& title,
-                        const std::string& online_status,
+                        const LLGroupMemberTable::title_t& title,
+                        U32 last_login,
                         BOOL is_owner);
 
     ~LLGroupMemberData() = default;
@@ -92,8 +93,10 @@ public:
     S32 getContribution() const { return mContribution; }
     U64 getAgentPowers() const { return mAgentPowers; }
     BOOL isOwner() const { return mIsOwner; }
-    const std::string& getTitle() const { return mTitle; }
-    const std::string& getOnlineStatus() const { return mOnlineStatus; }
+    const std::string& getTitle() const { return *mTitle; }
+    // formatted from mLastLogin the first time it is asked for
+    const std::string& getOnlineStatus() const;
+    bool isOnline() const { return mLastLogin == LLGroupMemberTable::LAST_LOGIN_ONLINE; }
     void addRole(const LLUUID& role, LLGroupRoleData* rd);
     bool removeRole(const LLUUID& role);
     void clearRoles() { mRolesList.clear(); };
@@ -102,13 +105,19 @@ public:
 
     BOOL isInRole(const LLUUID& role_id) { return (mRolesList.find(role_id) != mRolesList.end()); }
 
+    // copy row of table over this member's data
+    void update(const LLGroupMemberTable& table, U32 row);
+
     LLUUID  mID;
     S32     mContribution;
     U64     mAgentPowers;
-    std::string mTitle;
-    std::string mOnlineStatus;
+    LLGroupMemberTable::title_t mTitle;
+    U32     mLastLogin;
     BOOL    mIsOwner;
     role_list_t mRolesList;
+
+private:
+    mutable std::string mOnlineStatus;
 };
 
 struct LLRoleData
@@ -356,6 +365,10 @@ private:
 
     // Generate a new ID every time mMembers
     LLUUID              mMemberVersion;
+
+    // the last GroupMemberData reply, which mMembers matches; the next one
+    // is diffed against it
+    std::shared_ptr<const LLGroupMemberTable> mMemberTable;
 };
 
 struct LLRoleAction
@@ -461,6 +474,7 @@ public:
 private:
     void groupMembersRequestCoro(std::string url, LLUUID groupId);
     void processCapGroupMembersRequest(const LLSD& content);
+    void applyMemberTable(const std::shared_ptr<const LLGroupMemberTable>& table);
 
     void getGroupBanRequestCoro(std::string url, LLUUID groupId);
     void postGroupBanRequestCoro(std::string url, LLUUID groupId, U32 action, uuid_vec_t banList, bool update);
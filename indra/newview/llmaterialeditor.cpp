@@ -378,8 +378,15 @@ bool LLSelectedTEUpdateOverrides::apply(LLSelectNode* nodep)
     {
 
         LLTextureEntry* tep = objectp->getTE(te_index);
-        LLGLTFMaterial* override_mat = tep->getGLTFMaterialOverride();
-        if (mEditor->updateMaterialLocalSubscription(override_mat))
+        if (!mEditor->hasMaterialLocalSubscription(tep->getGLTFMaterialOverride()))
+        {
+            continue;
+        }
+
+        // Subscribing changes the materials in place, so this face must not
+        // share them with faces the local texture isn't on
+        LLGLTFMaterialList::unshareMaterials(tep);
+        if (mEditor->updateMaterialLocalSubscription(tep->getGLTFMaterialOverride()))
         {
             LLGLTFMaterial* render_mat = tep->getGLTFRenderMaterial();
             mEditor->updateMaterialLocalSubscription(render_mat);
@@ -1005,6 +1012,28 @@ bool LLMaterialEditor::updateMaterialLocalSubscription(LLGLTFMaterial* mat)
     return res;
 }
 
+bool LLMaterialEditor::hasMaterialLocalSubscription(const LLGLTFMaterial* mat) const
+{
+    if (!mat)
+    {
+        return false;
+    }
+
+    for (const mat_connection_map_t::value_type& cn : mTextureChangesUpdates)
+    {
+        LLUUID world_id = LLLocalBitmapMgr::getInstance()->getWorldID(cn.second.mTrackingId);
+        if (world_id.notNull()
+            && (world_id == mat->mTextureId[LLGLTFMaterial::GLTF_TEXTURE_INFO_BASE_COLOR]
+                || world_id == mat->mTextureId[LLGLTFMaterial::GLTF_TEXTURE_INFO_METALLIC_ROUGHNESS]
+                || world_id == mat->mTextureId[LLGLTFMaterial::GLTF_TEXTURE_INFO_EMISSIVE]
+                || world_id == mat->mTextureId[LLGLTFMaterial::GLTF_TEXTURE_INFO_NORMAL]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void LLMaterialEditor::replaceLocalTexture(const LLUUID& old_id, const LLUUID& new_id)
 {
     // todo: might be a good idea to set mBaseColorTextureUploadId here
@@ -2949,7 +2978,9 @@ public:
 
             LLPointer<LLGLTFMaterial> material = tep->getGLTFMaterialOverride();
             // make a copy to not invalidate existing
-            // material for multiple objects
+            // material for multiple objects (overrides may be shared
+            // between faces, so local textures must only be associated
+            // with the copy)
             if (material.isNull())
             {
                 // Start with a material override which does not make any changes
@@ -232,6 +232,8 @@ class LLMaterialEditor : public LLPreview, public LLVOInventoryListener
     U32 getRevertedChangesFlags() { return mRevertedChanges; }
     LLUUID getLocalTextureTrackingIdFromFlag(U32 flag);
     bool updateMaterialLocalSubscription(LLGLTFMaterial* mat);
+    // True if updateMaterialLocalSubscription() would subscribe mat
+    bool hasMaterialLocalSubscription(const LLGLTFMaterial* mat) const;
 
     static bool capabilitiesAvailable();
 
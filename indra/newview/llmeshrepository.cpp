@@ -53,6 +53,7 @@
 #include "llviewernetwork.h"
 #include "llviewerobjectlist.h"
 #include "llviewerregion.h"
+#include "llviewerstats.h"
 #include "llviewerstatsrecorder.h"
 #include "llviewertexturelist.h"
 #include "llvolume.h"
@@ -68,6 +69,7 @@
 #include "bufferarray.h"
 #include "bufferstream.h"
 #include "llfasttimer.h"
+#include "llmemtag.h"
 #include "llcorehttputil.h"
 #include "lltrans.h"
 #include "llstatusbar.h"
@@ -1820,6 +1822,7 @@ EMeshProcessingResult LLMeshRepoThread::lodReceived(const LLVolumeParams& mesh_p
         return MESH_NO_DATA;
     }
 
+    LLMemTag::Scope mem_scope(LLMemTag::MESH);
     LLPointer<LLVolume> volume = new LLVolume(mesh_params, LLVolumeLODGroup::getVolumeScaleFromDetail(lod));
     if (volume->unpackVolumeFaces(data, data_size))
     {
@@ -3551,6 +3554,7 @@ void LLMeshRepository::unregisterMesh(LLVOVolume* vobj, const LLUUID& mesh_id)
             }
         }
     }
+    recordFirstGeometry(mesh_id, false);
 }
 
 void LLMeshRepository::unregisterSkin(LLVOVolume* vobj, const LLUUID& mesh_id)
@@ -3579,31 +3583,8 @@ S32 LLMeshRepository::loadMesh(LLVOVolume* vobj, const LLVolumeParams& mesh_para
         return detail;
     }
 
-    {
-        //add volume to list of loading meshes
-        const auto& mesh_id = mesh_params.getSculptID();
-        mesh_load_map::iterator iter = mLoadingMeshes[detail].find(mesh_id);
-        if (iter != mLoadingMeshes[detail].end())
-        { //request pending for this mesh, append volume id to list
-            auto& obj_set = iter->second;
-            auto it = obj_set.find(vobj);
-            if (it == obj_set.end()) {
-                vobj->incMeshCache();
-                obj_set.insert(vobj);
-            }
-        }
-        else
-        {
-            vobj->incMeshCache();
-            LLMutexLock lock(mMeshMutex);
-            //first request for this mesh
-            mLoadingMeshes[detail][mesh_id].insert(vobj);
-            mPendingRequests.emplace_back(mesh_params, detail);
-            LLMeshRepository::sLODPending++;
-        }
-    }
-
     //do a quick search to see if we can't display something while we wait for this mesh to load
+    S32 available_lod = -1;
     LLVolume* volume = vobj->getVolume();
 
     if (volume)
@@ -3620,33 +3601,30 @@ S32 LLMeshRepository::loadMesh(LLVOVolume* vobj, const LLVolumeParams& mesh_para
                 LLVolume* lod = group->refLOD(last_lod);
                 if (lod && lod->isMeshAssetLoaded() && lod->getNumVolumeFaces() > 0)
                 {
-                    group->derefLOD(lod);
-                    return last_lod;
+                    available_lod = last_lod;
                 }
                 group->derefLOD(lod);
             }
 
             //next, see what the next lowest LOD available might be
-            for (S32 i = detail-1; i >= 0; --i)
+            for (S32 i = detail-1; i >= 0 && available_lod < 0; --i)
             {
                 LLVolume* lod = group->refLOD(i);
                 if (lod && lod->isMeshAssetLoaded() && lod->getNumVolumeFaces() > 0)
                 {
-                    group->derefLOD(lod);
-                    return i;
+                    available_lod = i;
                 }
 
                 group->derefLOD(lod);
             }
 
             //no lower LOD is a available, is a higher lod available?
-            for (S32 i = detail+1; i < LLVolumeLODGroup::NUM_LODS; ++i)
+            for (S32 i = detail+1; i < LLVolumeLODGroup::NUM_LODS && available_lod < 0; ++i)
             {
                 LLVolume* lod = group->refLOD(i);
                 if (lod && lod->isMeshAssetLoaded() && lod->getNumVolumeFaces() > 0)
                 {
-                    group->derefLOD(lod);
-                    return i;
+                    available_lod = i;
                 }
 
                 group->derefLOD(lod);
@@ -3654,7 +3632,89 @@ S32 LLMeshRepository::loadMesh(LLVOVolume* vobj, const LLVolumeParams& mesh_para
         }
     }
 
-    return detail;
+    const LLUUID& mesh_id = mesh_params.getSculptID();
+    if (available_lod < 0)
+    {
+        if (mFirstGeometryStart.find(mesh_id) == mFirstGeometryStart.end())
+        {
+            mFirstGeometryStart[mesh_id] = LLTimer::getTotalSeconds();
+        }
+
+        // Nothing to draw yet. The lowest LOD is small and quick to fetch,
+        // so ask for it too, ahead of everything else, and draw that until
+        // the requested one arrives.
+        static LLCachedControl<bool> lowest_first(gSavedSettings, "MeshStreamLowestLODFirst", true);
+        if (lowest_first)
+        {
+            S32 lowest_lod = getActualMeshLOD(mesh_params, LLModel::LOD_IMPOSTOR);
+            if (lowest_lod >= 0 && lowest_lod < detail)
+            {
+                queueLODRequest(vobj, mesh_params, lowest_lod, true);
+            }
+        }
+    }
+
+    queueLODRequest(vobj, mesh_params, detail, false);
+
+    return available_lod < 0 ? detail : available_lod;
+}
+
+void LLMeshRepository::queueLODRequest(LLVOVolume* vobj, const LLVolumeParams& mesh_params, S32 lod, bool first_geometry)
+{
+    //add volume to list of loading meshes
+    const auto& mesh_id = mesh_params.getSculptID();
+    mesh_load_map::iterator iter = mLoadingMeshes[lod].find(mesh_id);
+    if (iter != mLoadingMeshes[lod].end())
+    { //request pending for this mesh, append volume id to list
+        auto& obj_set = iter->second;
+        auto it = obj_set.find(vobj);
+        if (it == obj_set.end()) {
+            vobj->incMeshCache();
+            obj_set.insert(vobj);
+        }
+    }
+    else
+    {
+        vobj->incMeshCache();
+        LLMutexLock lock(mMeshMutex);
+        //first request for this mesh
+        mLoadingMeshes[lod][mesh_id].insert(vobj);
+        mPendingRequests.emplace_back(mesh_params, lod);
+        mPendingRequests.back().mFirstGeometry = first_geometry;
+        LLMeshRepository::sLODPending++;
+    }
+}
+
+bool LLMeshRepository::isLoadingMesh(const LLUUID& mesh_id) const
+{
+    for (const auto& lod : mLoadingMeshes)
+    {
+        if (lod.find(mesh_id) != lod.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LLMeshRepository::recordFirstGeometry(const LLUUID& mesh_id, bool loaded)
+{
+    auto iter = mFirstGeometryStart.find(mesh_id);
+    if (iter == mFirstGeometryStart.end())
+    {
+        return;
+    }
+
+    if (loaded)
+    {
+        record(LLStatViewer::MESH_FIRST_GEOMETRY_TIME, F64Seconds(LLTimer::getTotalSeconds() - iter->second));
+        mFirstGeometryStart.erase(iter);
+    }
+    else if (!isLoadingMesh(mesh_id))
+    {
+        // every LOD we asked for failed; don't count it
+        mFirstGeometryStart.erase(iter);
+    }
 }
 
 void LLMeshRepository::notifyLoadedMeshes()
@@ -3878,7 +3938,9 @@ void LLMeshRepository::notifyLoadedMeshes()
                             }
                         }
 
-                        score_map[param.first] = max_score;
+                        // a mesh may be loading several LODs; rank by its largest on screen
+                        F32& score = score_map[param.first];
+                        score = llmax(score, max_score);
                     }
                 }
 
@@ -4027,6 +4089,7 @@ void LLMeshRepository::notifyMeshLoaded(const LLVolumeParams& mesh_params, LLVol
             LLVolume* sys_volume = LLPrimitive::getVolumeManager()->refVolume(mesh_params, detail);
             if (sys_volume)
             {
+                LLMemTag::Scope mem_scope(LLMemTag::MESH);
                 sys_volume->copyVolumeFaces(volume);
                 sys_volume->setMeshAssetLoaded(true);
                 LLPrimitive::getVolumeManager()->unrefVolume(sys_volume);
@@ -4049,6 +4112,7 @@ void LLMeshRepository::notifyMeshLoaded(const LLVolumeParams& mesh_params, LLVol
         }
 
         mLoadingMeshes[detail].erase(obj_iter);
+        recordFirstGeometry(mesh_id, volume->getNumVolumeFaces() > 0);
 
         LLViewerStatsRecorder::instance().meshLoaded();
     }
@@ -4088,6 +4152,7 @@ void LLMeshRepository::notifyMeshUnavailable(const LLVolumeParams& mesh_params,
         }
 
         mLoadingMeshes[lod].erase(obj_iter);
+        recordFirstGeometry(mesh_params.getSculptID(), false);
     }
 }
 
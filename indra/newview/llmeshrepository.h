@@ -296,9 +296,10 @@ public:
         LLVolumeParams  mMeshParams;
         S32 mLOD;
         F32 mScore;
+        bool mFirstGeometry; // lowest LOD of a mesh that has nothing to draw yet
 
         LODRequest(const LLVolumeParams&  mesh_params, S32 lod)
-            : RequestStats(), mMeshParams(mesh_params), mLOD(lod), mScore(0.f)
+            : RequestStats(), mMeshParams(mesh_params), mLOD(lod), mScore(0.f), mFirstGeometry(false)
         {
         }
     };
@@ -307,6 +308,10 @@ public:
     {
         bool operator()(const LODRequest& lhs, const LODRequest& rhs)
         {
+            if (lhs.mFirstGeometry != rhs.mFirstGeometry)
+            {
+                return lhs.mFirstGeometry; // something to draw beats a better LOD
+            }
             return lhs.mScore > rhs.mScore; // greatest = first
         }
     };
@@ -713,6 +718,9 @@ public:
     typedef boost::unordered_node_map<LLUUID, boost::unordered_flat_set<LLVOVolume*> > mesh_load_map;
     mesh_load_map mLoadingMeshes[4];
 
+    // when meshes with no LOD loaded yet were first requested, for MESH_FIRST_GEOMETRY_TIME
+    boost::unordered_flat_map<LLUUID, F64> mFirstGeometryStart;
+
     typedef boost::unordered_flat_map<LLUUID, LLPointer<LLMeshSkinInfo>> skin_map;
     skin_map mSkinMap;
 
@@ -768,6 +776,10 @@ public:
 
     std::queue<LLSD> mUploadErrorQ;
 
+    void queueLODRequest(LLVOVolume* vobj, const LLVolumeParams& mesh_params, S32 lod, bool first_geometry);
+    bool isLoadingMesh(const LLUUID& mesh_id) const;
+    void recordFirstGeometry(const LLUUID& mesh_id, bool loaded);
+
     void uploadError(LLSD& args);
     void updateInventory(inventory_data data);
     int mLegacyGetMeshVersion;      // Shadows value in LLMeshRepoThread
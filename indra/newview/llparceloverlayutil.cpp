@@ -0,0 +1,266 @@
+/**
+ * @file   llparceloverlayutil.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llparceloverlayutil.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llparceloverlayutil.h"
+
+#include "llparcel.h"
+
+#include <immintrin.h>
+
+namespace
+{
+    U8 edge_mask(const U8* ownership, S32 grids_per_edge, S32 row, S32 col)
+    {
+        const U8 overlay = ownership[row * grids_per_edge + col];
+        const U8 color = overlay & PARCEL_COLOR_MASK;
+        if (color == PARCEL_PUBLIC || color > PARCEL_AUCTION)
+        {
+            return 0;
+        }
+
+        U8 mask = 0;
+        if (overlay & PARCEL_WEST_LINE)
+        {
+            mask |= LLParcelOverlayUtil::EDGE_WEST;
+        }
+        if (col == grids_per_edge - 1 || (ownership[row * grids_per_edge + col + 1] & PARCEL_WEST_LINE))
+        {
+            mask |= LLParcelOverlayUtil::EDGE_EAST;
+        }
+        if (overlay & PARCEL_SOUTH_LINE)
+        {
+            mask |= LLParcelOverlayUtil::EDGE_SOUTH;
+        }
+        if (row == grids_per_edge - 1 || (ownership[(row + 1) * grids_per_edge + col] & PARCEL_SOUTH_LINE))
+        {
+            mask |= LLParcelOverlayUtil::EDGE_NORTH;
+        }
+        return mask;
+    }
+
+    // one bit per cell, for up to 16 cells, of the west and south line flags
+    void line_bits(const U8* cells, S32 count, U32& west_bits, U32& south_bits)
+    {
+        if (count == 16)
+        {
+            const __m128i overlay = _mm_loadu_si128((const __m128i*)cells);
+            // PARCEL_SOUTH_LINE is the sign bit; doubling moves PARCEL_WEST_LINE there
+            south_bits = (U32)_mm_movemask_epi8(overlay);
+            west_bits = (U32)_mm_movemask_epi8(_mm_add_epi8(overlay, overlay));
+            return;
+        }
+        west_bits = south_bits = 0;
+        for (S32 i = 0; i < count; ++i)
+        {
+            west_bits |= (cells[i] & PARCEL_WEST_LINE) ? (1 << i) : 0;
+            south_bits |= (cells[i] & PARCEL_SOUTH_LINE) ? (1 << i) : 0;
+        }
+    }
+
+    // the bits of mask in lanes where (value & flag) is set
+    inline __m128i flag_to_mask(__m128i value, __m128i flag, __m128i mask)
+    {
+        return _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(value, flag), flag), mask);
+    }
+}
+
+void LLParcelOverlayUtil::colorCells(const U8* ownership, S32 count, const LLColor4U* palette, U8* rgba)
+{
+    S32 i = 0;
+#if defined(__SSSE3__)
+    // one 16 entry table per channel, looked up with the color index
+    alignas(16) U8 tables[4][16];
+    for (S32 c = 0; c < 16; ++c)
+    {
+        const LLColor4U& color = palette[c & PARCEL_COLOR_MASK];
+        for (S32 channel = 0; channel < 4; ++channel)
+        {
+            tables[channel][c] = color.mV[channel];
+        }
+    }
+    const __m128i red = _mm_load_si128((const __m128i*)tables[0]);
+    const __m128i green = _mm_load_si128((const __m128i*)tables[1]);
+    const __m128i blue = _mm_load_si128((const __m128i*)tables[2]);
+    const __m128i alpha = _mm_load_si128((const __m128i*)tables[3]);
+    const __m128i color_mask = _mm_set1_epi8(PARCEL_COLOR_MASK);
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i index = _mm_and_si128(_mm_loadu_si128((const __m128i*)(ownership + i)), color_mask);
+        __m128i r = _mm_shuffle_epi8(red, index);
+        __m128i g = _mm_shuffle_epi8(green, index);
+        __m128i b = _mm_shuffle_epi8(blue, index);
+        __m128i a = _mm_shuffle_epi8(alpha, index);
+
+        // interleave the channels back into pixels
+        __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+        __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+        __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+        __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+        __m128i* out = (__m128i*)(rgba + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rg_lo, ba_lo));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rg_hi, ba_hi));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rg_hi, ba_hi));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const LLColor4U& color = palette[ownership[i] & PARCEL_COLOR_MASK];
+        U8* pixel = rgba + i * 4;
+        pixel[0] = color.mV[VRED];
+        pixel[1] = color.mV[VGREEN];
+        pixel[2] = color.mV[VBLUE];
+        pixel[3] = color.mV[VALPHA];
+    }
+}
+
+void LLParcelOverlayUtil::edgeMasks(const U8* ownership, S32 grids_per_edge, S32 first_row, S32 end_row, U8* masks)
+{
+    const S32 n = grids_per_edge;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i color_mask = _mm_set1_epi8(PARCEL_COLOR_MASK);
+    const __m128i past_auction = _mm_set1_epi8(PARCEL_AUCTION + 1);
+    const __m128i west_line = _mm_set1_epi8(PARCEL_WEST_LINE);
+    const __m128i south_line = _mm_set1_epi8(PARCEL_SOUTH_LINE);
+    const __m128i west = _mm_set1_epi8(EDGE_WEST);
+    const __m128i east = _mm_set1_epi8(EDGE_EAST);
+    const __m128i south = _mm_set1_epi8(EDGE_SOUTH);
+    const __m128i north = _mm_set1_epi8(EDGE_NORTH);
+    // the region's east edge, as if a west line were just past the last cell
+    const __m128i east_border = _mm_set_epi8((char)PARCEL_WEST_LINE, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    const S32 simd_cols = (n % 16) ? 0 : n;
+    for (S32 row = first_row; row < end_row; ++row)
+    {
+        const U8* cells = ownership + row * n;
+        const U8* above = (row < n - 1) ? cells + n : NULL;
+        U8* out = masks + row * n;
+
+        for (S32 col = 0; col < simd_cols; col += 16)
+        {
+            const __m128i overlay = _mm_loadu_si128((const __m128i*)(cells + col));
+            const __m128i next = (col + 16 < n)
+                ? _mm_loadu_si128((const __m128i*)(cells + col + 1))
+                : _mm_or_si128(_mm_srli_si128(overlay, 1), east_border);
+            const __m128i up = above ? _mm_loadu_si128((const __m128i*)(above + col)) : south_line;
+
+            const __m128i color = _mm_and_si128(overlay, color_mask);
+            const __m128i owned = _mm_and_si128(_mm_cmpgt_epi8(color, zero), _mm_cmplt_epi8(color, past_auction));
+
+            __m128i mask = flag_to_mask(overlay, west_line, west);
+            mask = _mm_or_si128(mask, flag_to_mask(next, west_line, east));
+            mask = _mm_or_si128(mask, flag_to_mask(overlay, south_line, south));
+            mask = _mm_or_si128(mask, flag_to_mask(up, south_line, north));
+            _mm_storeu_si128((__m128i*)(out + col), _mm_and_si128(mask, owned));
+        }
+        for (S32 col = simd_cols; col < n; ++col)
+        {
+            out[col] = edge_mask(ownership, n, row, col);
+        }
+    }
+}
+
+void LLParcelOverlayUtil::minimapLines(const U8* ownership, S32 grids_per_edge, F32 grid_step, std::vector<LLVector2>& lines)
+{
+    const S32 n = grids_per_edge;
+    const S32 blocks = (n + 15) / 16;
+    const F32 edge = n * grid_step;
+    lines.clear();
+
+    // Row by row, 16 cells to a block. A column's west line run opens in
+    // the row its line starts and is written out in the row it stops.
+    std::vector<U32> last_west(blocks, 0);
+    std::vector<S32> open(n, 0);
+    std::vector<LLVector2> south_lines;
+    for (S32 row = 0; row < n; ++row)
+    {
+        const U8* cells = ownership + row * n;
+        const F32 y = row * grid_step;
+        S32 run_start = -1;
+        for (S32 block = 0; block < blocks; ++block)
+        {
+            const S32 first_col = block * 16;
+            const S32 count = llmin(16, n - first_col);
+            U32 west_bits, south_bits;
+            line_bits(cells + first_col, count, west_bits, south_bits);
+
+            U32 changed = west_bits ^ last_west[block];
+            last_west[block] = west_bits;
+            for (S32 i = 0; changed; ++i, changed >>= 1)
+            {
+                if (!(changed & 1))
+                {
+                    continue;
+                }
+                const S32 col = first_col + i;
+                if (west_bits & (1 << i))
+                {
+                    open[col] = row;
+                }
+                else
+                {
+                    lines.emplace_back(col * grid_step, open[col] * grid_step);
+                    lines.emplace_back(col * grid_step, y);
+                }
+            }
+
+            // nothing starts or stops in this block
+            const U32 all = (1 << count) - 1;
+            if ((run_start < 0 && !south_bits) || (run_start >= 0 && south_bits == all))
+            {
+                continue;
+            }
+            for (S32 i = 0; i < count; ++i)
+            {
+                const bool south = (south_bits >> i) & 1;
+                if (south && run_start < 0)
+                {
+                    run_start = first_col + i;
+                }
+                else if (!south && run_start >= 0)
+                {
+                    south_lines.emplace_back(run_start * grid_step, y);
+                    south_lines.emplace_back((first_col + i) * grid_step, y);
+                    run_start = -1;
+                }
+            }
+        }
+        if (run_start >= 0)
+        {
+            south_lines.emplace_back(run_start * grid_step, y);
+            south_lines.emplace_back(edge, y);
+        }
+    }
+
+    // west lines running off the north edge
+    for (S32 block = 0; block < blocks; ++block)
+    {
+        for (S32 i = 0; i < 16; ++i)
+        {
+            if (last_west[block] & (1 << i))
+            {
+                const S32 col = block * 16 + i;
+                lines.emplace_back(col * grid_step, open[col] * grid_step);
+                lines.emplace_back(col * grid_step, edge);
+            }
+        }
+    }
+
+    lines.insert(lines.end(), south_lines.begin(), south_lines.end());
+
+    // east and north edges of the region
+    lines.emplace_back(edge, 0.f);
+    lines.emplace_back(edge, edge);
+    lines.emplace_back(0.f, edge);
+    lines.emplace_back(edge, edge);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file   llparceloverlayutil.h
+ * @date   2026-10-18
+ * @brief  Whole-grid passes over a region's parcel ownership bytes, used by
+ *         LLViewerParcelOverlay to build its texture, property lines and
+ *         minimap lines.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPARCELOVERLAYUTIL_H
+#define LL_LLPARCELOVERLAYUTIL_H
+
+#include "v2math.h"
+#include "v4coloru.h"
+#include <vector>
+
+// The grids are row major, south row first, grids_per_edge cells to a row.
+// Grids whose width is a multiple of 16 are done 16 cells at a time.
+namespace LLParcelOverlayUtil
+{
+    // Property line edges of a cell, as set by edgeMasks()
+    const U8 EDGE_WEST  = 0x01;
+    const U8 EDGE_EAST  = 0x02;
+    const U8 EDGE_SOUTH = 0x04;
+    const U8 EDGE_NORTH = 0x08;
+
+    // Write the RGBA color of each of count cells, palette[ownership & PARCEL_COLOR_MASK].
+    // palette has PARCEL_COLOR_MASK + 1 entries.
+    void colorCells(const U8* ownership, S32 count, const LLColor4U* palette, U8* rgba);
+
+    // For rows [first_row, end_row), the edges each cell draws a property
+    // line on. Only owned cells (PARCEL_OWNED to PARCEL_AUCTION) get
+    // lines. A cell's east and north edges are its neighbours' west and
+    // south lines, or the region edge.
+    void edgeMasks(const U8* ownership, S32 grids_per_edge, S32 first_row, S32 end_row, U8* masks);
+
+    // Line segments (pairs of points, region meters) for every west and south
+    // line in the grid plus the region's east and north edges, with runs
+    // of cells merged into one segment.
+    void minimapLines(const U8* ownership, S32 grids_per_edge, F32 grid_step, std::vector<LLVector2>& lines);
+}
+
+#endif // LL_LLPARCELOVERLAYUTIL_H
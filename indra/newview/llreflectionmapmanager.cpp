@@ -1239,6 +1239,9 @@ void LLReflectionMapManager::updateUniforms()
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
+    // bind once here rather than on every shader bind (see setUniforms)
+    LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_REFLECTION_PROBES, mUBO);
+
 #if 0
     if (!gCubeSnapshot)
     {
@@ -1266,7 +1269,8 @@ void LLReflectionMapManager::setUniforms()
     {
         updateUniforms();
     }
-    glBindBufferBase(GL_UNIFORM_BUFFER, 1, mUBO);
+    // no-op unless something else was bound to the reflection probe binding point since updateUniforms
+    LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_REFLECTION_PROBES, mUBO);
 }
 
 
@@ -1483,6 +1487,7 @@ void LLReflectionMapManager::cleanup()
     mDefaultProbe = nullptr;
     mUpdatingProbe = nullptr;
 
+    LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_REFLECTION_PROBES, 0);
     glDeleteBuffers(1, &mUBO);
     mUBO = 0;
 
@@ -0,0 +1,72 @@
+/**
+ * @file   llregiongrid.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for llregiongrid.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llregiongrid.h"
+
+#include "indra_constants.h"
+#include "llregionhandle.h"
+
+// static
+U64 LLRegionGrid::cellOf(U32 x, U32 y)
+{
+    return to_region_handle(x - x % REGION_WIDTH_U32, y - y % REGION_WIDTH_U32);
+}
+
+void LLRegionGrid::add(LLViewerRegion* region, U64 handle, U32 width)
+{
+    U32 origin_x, origin_y;
+    from_region_handle(handle, &origin_x, &origin_y);
+    for (U32 y = 0; y < width; y += REGION_WIDTH_U32)
+    {
+        for (U32 x = 0; x < width; x += REGION_WIDTH_U32)
+        {
+            mCells.emplace(cellOf(origin_x + x, origin_y + y), region);
+        }
+    }
+}
+
+void LLRegionGrid::remove(LLViewerRegion* region, U64 handle, U32 width)
+{
+    U32 origin_x, origin_y;
+    from_region_handle(handle, &origin_x, &origin_y);
+    for (U32 y = 0; y < width; y += REGION_WIDTH_U32)
+    {
+        for (U32 x = 0; x < width; x += REGION_WIDTH_U32)
+        {
+            auto it = mCells.find(cellOf(origin_x + x, origin_y + y));
+            if (it != mCells.end() && it->second == region)
+            {
+                mCells.erase(it);
+            }
+        }
+    }
+}
+
+LLViewerRegion* LLRegionGrid::find(U64 handle) const
+{
+    U32 x, y;
+    from_region_handle(handle, &x, &y);
+    auto it = mCells.find(cellOf(x, y));
+    return it != mCells.end() ? it->second : NULL;
+}
+
+LLViewerRegion* LLRegionGrid::find(const LLVector3d& pos_global) const
+{
+    const F64 x = pos_global.mdV[VX];
+    const F64 y = pos_global.mdV[VY];
+    if (x < 0.0 || y < 0.0 || x >= (F64)U32_MAX || y >= (F64)U32_MAX)
+    {
+        return NULL;
+    }
+    auto it = mCells.find(cellOf((U32)x, (U32)y));
+    return it != mCells.end() ? it->second : NULL;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file   llregiongrid.h
+ * @date   2026-10-18
+ * @brief  LLRegionGrid finds the connected region covering a global position
+ *         or region handle without walking the region list.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLREGIONGRID_H
+#define LL_LLREGIONGRID_H
+
+#include "v3dmath.h"
+#include <boost/unordered_map.hpp>
+
+class LLViewerRegion;
+
+/**
+ * Maps each 256m grid cell to the region covering it. A region is a square
+ * with its south west corner at its handle; variable sized regions cover
+ * several cells.
+ *
+ * Where regions overlap, a cell keeps the region added first, which is the
+ * one a walk of LLWorld's region list would have found.
+ */
+class LLRegionGrid
+{
+public:
+    // width in meters, a multiple of 256
+    void add(LLViewerRegion* region, U64 handle, U32 width);
+    // Removes the cells region holds; add any regions that overlapped it again after.
+    void remove(LLViewerRegion* region, U64 handle, U32 width);
+    void clear()                                    { mCells.clear(); }
+
+    // The region covering the point whose global x and y are packed in handle
+    LLViewerRegion* find(U64 handle) const;
+    LLViewerRegion* find(const LLVector3d& pos_global) const;
+
+    size_t getCellCount() const                     { return mCells.size(); }
+
+private:
+    static U64 cellOf(U32 x, U32 y);
+
+    boost::unordered_map<U64, LLViewerRegion*> mCells;
+};
+
+#endif // LL_LLREGIONGRID_H
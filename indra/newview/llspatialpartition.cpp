@@ -59,8 +59,14 @@ extern bool gShiftFrame;
 
 static U32 sZombieGroups = 0;
 U32 LLSpatialGroup::sNodeCount = 0;
+U32 LLSpatialGroup::sDrawInfoReused = 0;
 
 bool LLSpatialGroup::sNoDelete = false;
+U32 LLSpatialPartition::sPrecullStamp = 0;
+bool LLSpatialPartition::sPrecullValidate = false;
+U32 LLSpatialPartition::sPrecullMismatches = 0;
+U32 LLSpatialPartition::sShadowCullStamp = 0;
+U32 LLSpatialPartition::sShadowCullCamera = 0;
 
 static F32 sLastMaxTexPriority = 1.f;
 static F32 sCurMaxTexPriority = 1.f;
@@ -136,6 +142,42 @@ void LLSpatialGroup::clearDrawMap()
     mDrawMap.clear();
 }
 
+void LLSpatialGroup::recycleDrawMap()
+{
+    for (auto& pass : mDrawMap)
+    {
+        for (auto& info : pass.second)
+        {
+            if (info.notNull() && info->getNumRefs() == 1)
+            {
+                mSpareDrawInfo.push_back(info);
+            }
+        }
+    }
+    mDrawMap.clear();
+}
+
+LLPointer<LLDrawInfo> LLSpatialGroup::obtainDrawInfo(U16 start, U16 end, U32 count, U32 offset,
+                                                     LLViewerTexture* image, LLVertexBuffer* buffer,
+                                                     bool fullbright, U8 bump)
+{
+    if (mSpareDrawInfo.empty())
+    {
+        return new LLDrawInfo(start, end, count, offset, image, buffer, fullbright, bump);
+    }
+
+    LLPointer<LLDrawInfo> info = mSpareDrawInfo.back();
+    mSpareDrawInfo.pop_back();
+    info->reset(start, end, count, offset, image, buffer, fullbright, bump);
+    ++sDrawInfoReused;
+    return info;
+}
+
+void LLSpatialGroup::clearSpareDrawInfo()
+{
+    mSpareDrawInfo.clear();
+}
+
 BOOL LLSpatialGroup::isHUDGroup()
 {
     return getSpatialPartition() && getSpatialPartition()->isHUDPartition() ;
@@ -459,6 +501,8 @@ void LLSpatialGroup::shift(const LLVector4a &offset)
     mObjectBounds[0].add(offset);
     mObjectExtents[0].add(offset);
     mObjectExtents[1].add(offset);
+    mPrecullStamp = 0;
+    mShadowCullStamp = 0;
 
     if (!getSpatialPartition()->mRenderByGroup &&
         getSpatialPartition()->mPartitionType != LLViewerRegion::PARTITION_TREE &&
@@ -1074,6 +1118,20 @@ public:
         return res;
     }
 
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        AABBInFrustumNoFarClipChildBounds(branch, results);
+        for (U32 i = 0; i < branch->getChildCount(); i++)
+        {
+            if (results[i] != 0)
+            {
+                const LLViewerOctreeGroup* group = (const LLViewerOctreeGroup*) branch->getChild(i)->getListener(0);
+                results[i] = llmin(results[i], AABBSphereIntersectGroupExtents(group));
+            }
+        }
+        return true;
+    }
+
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
     {
         S32 res = AABBInFrustumNoFarClipObjectBounds(group);
@@ -1107,6 +1165,12 @@ public:
         return AABBInFrustumNoFarClipGroupBounds(group);
     }
 
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        AABBInFrustumNoFarClipChildBounds(branch, results);
+        return true;
+    }
+
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
     {
         S32 res = AABBInFrustumNoFarClipObjectBounds(group);
@@ -1125,12 +1189,317 @@ public:
         return AABBInFrustumGroupBounds(group);
     }
 
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        AABBInFrustumChildBounds(branch, results);
+        return true;
+    }
+
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
     {
         return AABBInFrustumObjectBounds(group);
     }
 };
 
+// Runs a culler's frustum tests without culling anything, stamping each
+// group with the results for LLOctreeCullPrecomputed to pick up later.
+template <class T>
+class LLOctreePrecull : public T
+{
+public:
+    LLOctreePrecull(LLCamera* camera, U32 stamp)
+        : T(camera), mStamp(stamp) { }
+
+    virtual bool earlyFail(LLViewerOctreeGroup* group)
+    {
+        // a dirty group's bounds are stale until the cull rebounds it, and
+        // occlusion is left to the cull itself
+        return group->isDirty();
+    }
+
+    virtual S32 frustumCheck(const LLViewerOctreeGroup* base_group)
+    {
+        S32 res = T::frustumCheck(base_group);
+        LLViewerOctreeGroup* group = const_cast<LLViewerOctreeGroup*>(base_group);
+        group->mPrecullStamp = mStamp;
+        group->mPrecullRes = (S8)res;
+        group->mPrecullObjectRes = -1;
+        return res;
+    }
+
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        if (!T::frustumCheckChildren(branch, results))
+        {
+            return false;
+        }
+        for (U32 i = 0; i < branch->getChildCount(); i++)
+        {
+            LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) branch->getChild(i)->getListener(0);
+            if (!group->isDirty())
+            {
+                group->mPrecullStamp = mStamp;
+                group->mPrecullRes = (S8)results[i];
+                group->mPrecullObjectRes = -1;
+            }
+        }
+        return true;
+    }
+
+    virtual bool checkObjects(const OctreeNode* branch, const LLViewerOctreeGroup* base_group)
+    {
+        // the only case in which the cull tests the object bounds
+        if (this->mRes == 1 && branch->getElementCount() > 0 && branch->getChildCount() > 0)
+        {
+            LLViewerOctreeGroup* group = const_cast<LLViewerOctreeGroup*>(base_group);
+            if (group->mPrecullStamp != mStamp)
+            {
+                group->mPrecullStamp = mStamp;
+                group->mPrecullRes = -1;
+            }
+            group->mPrecullObjectRes = (S8)T::frustumCheckObjects(group);
+        }
+        return false;
+    }
+
+private:
+    U32 mStamp;
+};
+
+// Uses the results stamped by LLOctreePrecull where they are still valid.
+template <class T>
+class LLOctreeCullPrecomputed : public T
+{
+public:
+    LLOctreeCullPrecomputed(LLCamera* camera, U32 stamp)
+        : T(camera), mStamp(stamp) { }
+
+    virtual S32 frustumCheck(const LLViewerOctreeGroup* group)
+    {
+        if (group->mPrecullStamp == mStamp && group->mPrecullRes >= 0)
+        {
+            return validate(group->mPrecullRes, group, false);
+        }
+        return T::frustumCheck(group);
+    }
+
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        // most children already have results from the precull
+        return false;
+    }
+
+    virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
+    {
+        if (group->mPrecullStamp == mStamp && group->mPrecullObjectRes >= 0)
+        {
+            return validate(group->mPrecullObjectRes, group, true);
+        }
+        return T::frustumCheckObjects(group);
+    }
+
+private:
+    S32 validate(S32 res, const LLViewerOctreeGroup* group, bool objects)
+    {
+        if (LLSpatialPartition::sPrecullValidate)
+        {
+            S32 live = objects ? T::frustumCheckObjects(group) : T::frustumCheck(group);
+            if (live != res)
+            {
+                ++LLSpatialPartition::sPrecullMismatches;
+                return live;
+            }
+        }
+        return res;
+    }
+
+    U32 mStamp;
+};
+
+// Frustum tests the groups against several shadow cameras in one walk.
+// A camera drops out of a branch once the branch is entirely inside or
+// outside its frustum, so each group is tested against just the cameras
+// whose own cull would have tested it. Branches the cull would not test
+// (SKIP_FRUSTUM_CHECK under a partial result) are not tested here either.
+// The children's bounds are gathered once for all of those cameras.
+class LLOctreeShadowPrecull
+{
+public:
+    LLOctreeShadowPrecull(LLCamera* const* cameras, U32 count, U32 stamp)
+        : mCameras(cameras), mCount(llmin(count, LLViewerOctreeGroup::MAX_SHADOW_CAMERAS)), mStamp(stamp) { }
+
+    void traverse(const OctreeNode* root)
+    {
+        LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) root->getListener(0);
+        if (earlyFail(group))
+        {
+            return;
+        }
+
+        stamp(group);
+        const LLVector4a* bounds = group->getBounds();
+        U32 partial = 0;
+        for (U32 i = 0; i < mCount; i++)
+        {
+            if (mCameras[i])
+            {
+                S32 res = mCameras[i]->AABBInFrustum(bounds[0], bounds[1]);
+                setRes(group->mShadowCullRes, i, res);
+                partial |= (res == 1) ? (1 << i) : 0;
+            }
+        }
+        visit(root, group, partial);
+    }
+
+private:
+    // Shadows are generated with occlusion culling disabled, so only dirty
+    // groups are left out: their bounds are stale until the cascade cull
+    // rebounds them, and groups not stamped here are tested live.
+    static bool earlyFail(LLViewerOctreeGroup* group)
+    {
+        return group->isDirty();
+    }
+
+    void stamp(LLViewerOctreeGroup* group)
+    {
+        group->mShadowCullStamp = mStamp;
+        group->mShadowCullRes = 0xffff;
+        group->mShadowCullObjectRes = 0xffff;
+    }
+
+    static void setRes(U16& packed, U32 camera, S32 res)
+    {
+        U32 shift = camera * 2;
+        packed = (U16) ((packed & ~(3 << shift)) | (res << shift));
+    }
+
+    // partial: the cameras whose frustum the stamped group is partly inside
+    void visit(const OctreeNode* branch, LLViewerOctreeGroup* group, U32 partial)
+    {
+        if (!partial)
+        {
+            return;
+        }
+
+        U32 child_count = branch->getChildCount();
+
+        // the only case in which the shadow cull tests the object bounds
+        if (branch->getElementCount() > 0 && child_count > 0)
+        {
+            const LLVector4a* bounds = group->getObjectBounds();
+            for (U32 i = 0; i < mCount; i++)
+            {
+                if (partial & (1 << i))
+                {
+                    setRes(group->mShadowCullObjectRes, i, mCameras[i]->AABBInFrustum(bounds[0], bounds[1]));
+                }
+            }
+        }
+
+        const OctreeNode* nodes[8];
+        LLViewerOctreeGroup* children[8];
+        U32 child_partial[8];
+        U32 count = 0;
+        // the children that get frustum tested, as indices into the above
+        U32 tested[8];
+        LLVector4a centers[8], radii[8];
+        U32 test_count = 0;
+        for (U32 c = 0; c < child_count; c++)
+        {
+            const OctreeNode* node = branch->getChild(c);
+            LLViewerOctreeGroup* child = (LLViewerOctreeGroup*) node->getListener(0);
+            if (earlyFail(child))
+            { //left for the cull
+                continue;
+            }
+            stamp(child);
+            nodes[count] = node;
+            children[count] = child;
+            if (child->hasState(LLViewerOctreeGroup::SKIP_FRUSTUM_CHECK))
+            { //the cull goes straight on down with the parent's result
+                child_partial[count] = partial;
+            }
+            else
+            {
+                child_partial[count] = 0;
+                tested[test_count] = count;
+                centers[test_count] = child->getBounds()[0];
+                radii[test_count] = child->getBounds()[1];
+                test_count++;
+            }
+            count++;
+        }
+
+        S32 results[8];
+        for (U32 i = 0; i < mCount && test_count > 0; i++)
+        {
+            if (partial & (1 << i))
+            {
+                mCameras[i]->AABBsInFrustum(centers, radii, test_count, results);
+                for (U32 t = 0; t < test_count; t++)
+                {
+                    U32 c = tested[t];
+                    setRes(children[c]->mShadowCullRes, i, results[t]);
+                    child_partial[c] |= (results[t] == 1) ? (1 << i) : 0;
+                }
+            }
+        }
+
+        for (U32 c = 0; c < count; c++)
+        {
+            visit(nodes[c], children[c], child_partial[c]);
+        }
+    }
+
+    LLCamera* const* mCameras;
+    U32 mCount;
+    U32 mStamp;
+};
+
+// Uses the results stamped by LLOctreeShadowPrecull for one of its cameras.
+class LLOctreeCullShadowPrecomputed : public LLOctreeCullShadow
+{
+public:
+    LLOctreeCullShadowPrecomputed(LLCamera* camera, U32 stamp, U32 index)
+        : LLOctreeCullShadow(camera), mStamp(stamp), mIndex(index) { }
+
+    virtual S32 frustumCheck(const LLViewerOctreeGroup* group)
+    {
+        if (group->mShadowCullStamp == mStamp)
+        {
+            S32 res = group->getShadowCullRes(group->mShadowCullRes, mIndex);
+            if (res != LLViewerOctreeGroup::SHADOW_RES_UNTESTED)
+            {
+                return res;
+            }
+        }
+        return LLOctreeCullShadow::frustumCheck(group);
+    }
+
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        // the children already have results from the walk
+        return false;
+    }
+
+    virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
+    {
+        if (group->mShadowCullStamp == mStamp)
+        {
+            S32 res = group->getShadowCullRes(group->mShadowCullObjectRes, mIndex);
+            if (res != LLViewerOctreeGroup::SHADOW_RES_UNTESTED)
+            {
+                return res;
+            }
+        }
+        return LLOctreeCullShadow::frustumCheckObjects(group);
+    }
+
+private:
+    U32 mStamp;
+    U32 mIndex;
+};
+
 class LLOctreeCullVisExtents: public LLOctreeCullShadow
 {
 public:
@@ -1446,21 +1815,68 @@ S32 LLSpatialPartition::cull(LLCamera &camera, bool do_occlusion)
 
     if (LLPipeline::sShadowRender)
     {
-        LLOctreeCullShadow culler(&camera);
-        culler.traverse(mOctree);
+        if (sShadowCullStamp)
+        {
+            LLOctreeCullShadowPrecomputed culler(&camera, sShadowCullStamp, sShadowCullCamera);
+            culler.traverse(mOctree);
+        }
+        else
+        {
+            LLOctreeCullShadow culler(&camera);
+            culler.traverse(mOctree);
+        }
     }
     else if (mInfiniteFarClip || (!LLPipeline::sUseFarClip && !gCubeSnapshot))
     {
-        LLOctreeCullNoFarClip culler(&camera);
+        if (sPrecullStamp)
+        {
+            LLOctreeCullPrecomputed<LLOctreeCullNoFarClip> culler(&camera, sPrecullStamp);
+            culler.traverse(mOctree);
+        }
+        else
+        {
+            LLOctreeCullNoFarClip culler(&camera);
+            culler.traverse(mOctree);
+        }
+    }
+    else
+    {
+        if (sPrecullStamp)
+        {
+            LLOctreeCullPrecomputed<LLOctreeCull> culler(&camera, sPrecullStamp);
+            culler.traverse(mOctree);
+        }
+        else
+        {
+            LLOctreeCull culler(&camera);
+            culler.traverse(mOctree);
+        }
+    }
+
+    return 0;
+}
+
+void LLSpatialPartition::precull(LLCamera& camera, U32 stamp)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+    // same choice as cull() makes for the world camera
+    if (mInfiniteFarClip || !LLPipeline::sUseFarClip)
+    {
+        LLOctreePrecull<LLOctreeCullNoFarClip> culler(&camera, stamp);
         culler.traverse(mOctree);
     }
     else
     {
-        LLOctreeCull culler(&camera);
+        LLOctreePrecull<LLOctreeCull> culler(&camera, stamp);
         culler.traverse(mOctree);
     }
+}
 
-    return 0;
+void LLSpatialPartition::precullShadows(LLCamera* const* cameras, U32 count, U32 stamp)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+    LLOctreeShadowPrecull culler(cameras, count, stamp);
+    culler.traverse(mOctree);
 }
 
 void pushVerts(LLDrawInfo* params)
@@ -3886,6 +4302,50 @@ LLDrawInfo::LLDrawInfo(U16 start, U16 end, U32 count, U32 offset,
     mVertexBuffer->validateRange(mStart, mEnd, mCount, mOffset);
 }
 
+void LLDrawInfo::reset(U16 start, U16 end, U32 count, U32 offset,
+                       LLViewerTexture* texture, LLVertexBuffer* buffer,
+                       bool fullbright, U8 bump)
+{
+    // keep in step with the member initializers in the class declaration
+    mVertexBuffer = buffer;
+    mStart = start;
+    mEnd = end;
+    mCount = count;
+    mOffset = offset;
+
+    mTexture = texture;
+    mSpecularMap = nullptr;
+    mNormalMap = nullptr;
+
+    mSpecularMapMatrix = nullptr;
+    mNormalMapMatrix = nullptr;
+    mTextureMatrix = nullptr;
+    mModelMatrix = nullptr;
+
+    mAvatar = nullptr;
+    mSkinInfo = nullptr;
+    mMaterial = nullptr;
+    mGLTFMaterial = nullptr;
+
+    mSpecColor = LLVector4(1.f, 1.f, 1.f, 0.5f);
+    mTextureList.clear();
+    mMaterialID.setNull();
+
+    mShaderMask = 0;
+    mEnvIntensity = 0.f;
+    mAlphaMaskCutoff = 0.5f;
+
+    mBlendFuncSrc = LLRender::BF_SOURCE_ALPHA;
+    mBlendFuncDst = LLRender::BF_ONE_MINUS_SOURCE_ALPHA;
+    mDiffuseAlphaMode = 0;
+    mBump = bump;
+    mShiny = 0;
+    mFullbright = fullbright;
+    mHasGlow = false;
+
+    mVertexBuffer->validateRange(mStart, mEnd, mCount, mOffset);
+}
+
 LLDrawInfo::~LLDrawInfo()
 {
     if (gDebugGL)
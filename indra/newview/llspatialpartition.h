@@ -66,7 +66,7 @@ void pushVerts(LLFace* face);
 */
 class LLDrawInfo final : public LLRefCount
 {
-    LL_ALIGN_NEW;
+    LL_SLAB_NEW(LLDrawInfo, LLMemTag::DRAWABLE, 16);
 protected:
     ~LLDrawInfo();
 
@@ -81,6 +81,11 @@ public:
                 LLViewerTexture* image, LLVertexBuffer* buffer,
                 bool fullbright = false, U8 bump = 0);
 
+    // reinitialize a draw info no one else references, as though it had
+    // just been constructed with these arguments
+    void reset(U16 start, U16 end, U32 count, U32 offset,
+               LLViewerTexture* image, LLVertexBuffer* buffer,
+               bool fullbright = false, U8 bump = 0);
 
     void validate();
 
@@ -196,12 +201,14 @@ class LLSpatialGroup final : public LLOcclusionCullingGroup
     using super = LLOcclusionCullingGroup;
     friend class LLSpatialPartition;
     friend class LLOctreeStateCheck;
+    LL_SLAB_NEW(LLSpatialGroup, LLMemTag::DRAWABLE, 64);
 public:
 
     LLSpatialGroup(const LLSpatialGroup& rhs) = delete;
     LLSpatialGroup& operator=(const LLSpatialGroup& rhs) = delete;
 
     static U32 sNodeCount;
+    static U32 sDrawInfoReused; // draw infos reinitialized by obtainDrawInfo since the last reset
     static bool sNoDelete; //deletion of spatial groups and draw info not allowed if TRUE
 
     typedef std::vector<LLPointer<LLSpatialGroup> > sg_vector_t;
@@ -267,6 +274,15 @@ public:
     BOOL isHUDGroup() ;
 
     void clearDrawMap();
+    // Clear the draw map, but keep the draw infos nothing else references
+    // for obtainDrawInfo to reinitialize during the rebuild that follows.
+    void recycleDrawMap();
+    // a recycled draw info reset with these arguments, or a new one
+    LLPointer<LLDrawInfo> obtainDrawInfo(U16 start, U16 end, U32 count, U32 offset,
+                                         LLViewerTexture* image, LLVertexBuffer* buffer,
+                                         bool fullbright, U8 bump);
+    // release recycled draw infos the rebuild didn't need
+    void clearSpareDrawInfo();
     void validate();
     void validateDrawMap();
 
@@ -331,6 +347,7 @@ protected:
 public:
     LLPointer<LLVertexBuffer> mVertexBuffer;
     draw_map_t mDrawMap;
+    drawmap_elem_t mSpareDrawInfo; // see recycleDrawMap()
 
     bridge_list_t mBridgeList;
     buffer_map_t mBufferMap; //used by volume buffers to attempt to reuse vertex buffers
@@ -402,6 +419,24 @@ public:
     /*virtual*/ S32 cull(LLCamera &camera, bool do_occlusion=false); // Cull on arbitrary frustum
     S32 cull(LLCamera &camera, std::vector<LLDrawable *>* results, BOOL for_select); // Cull on arbitrary frustum
 
+    // Work out the frustum tests of a later world camera cull(camera) ahead
+    // of time and stamp the groups with the results. Only reads the octree,
+    // so may run off the main thread while nothing else touches it.
+    void precull(LLCamera& camera, U32 stamp);
+
+    static U32 sPrecullStamp;       // precull results cull() may use, 0 for none
+    static bool sPrecullValidate;   // recompute precull results and count mismatches
+    static U32 sPrecullMismatches;
+
+    // Frustum test every group against all of the shadow cameras in a
+    // single walk, stamping each group with its result for every camera so
+    // that a later shadow cull(*cameras[i]) needs no tests of its own.
+    // NULL cameras are skipped. The root must already be rebounded.
+    void precullShadows(LLCamera* const* cameras, U32 count, U32 stamp);
+
+    static U32 sShadowCullStamp;    // precullShadows() results cull() may use, 0 for none
+    static U32 sShadowCullCamera;   // which of the precullShadows() cameras cull() is for
+
     BOOL isVisible(const LLVector3& v);
     bool isHUDPartition() ;
 
@@ -523,7 +523,7 @@ void LLSpeakerMgr::updateSpeakerList()
                         LLGroupMemberData* member = member_it->second.get();
                         LLUUID id = member_it->first;
                         // Add only members who are online and not already in the list
-                        if ((member && member->getOnlineStatus() == "Online") && (mSpeakers.find(id) == mSpeakers.end()))
+                        if ((member && member->isOnline()) && (mSpeakers.find(id) == mSpeakers.end()))
                         {
                             LLPointer<LLSpeaker> speakerp = setSpeaker(id, "", LLSpeaker::STATUS_VOICE_ACTIVE, LLSpeaker::SPEAKER_AGENT);
                             speakerp->mIsModerator = ((member->getAgentPowers() & GP_SESSION_MODERATOR) == GP_SESSION_MODERATOR);
@@ -157,6 +157,15 @@ const std::string sTesterName("TextureFetchTester");
 //              LLTextureFetchWorker).  One per request.
 // 7.  Mw       LLTextureFetchWorker's mutex.  One per request.
 //
+// Priority and discard changes to existing requests don't take Mw
+// on the calling thread.  createRequest() and updateRequestPriority()
+// push an update onto mRequestUpdates, a lock-free queue that Ttf
+// drains at the start of every update.  Should the queue be full, the
+// caller falls back to the old locked path.  A worker that is DONE
+// isn't busy, so createRequest() restarts it directly; otherwise the
+// worker counts the discard changes still queued for it, and
+// getRequestFinished() reports nothing until they have been applied.
+//
 //
 // Lock Ordering Rules
 //
@@ -231,6 +240,10 @@ static const S32 HTTP_PIPE_REQUESTS_LOW_WATER = 50;         // Active level at w
 static const S32 HTTP_NONPIPE_REQUESTS_HIGH_WATER = 40;
 static const S32 HTTP_NONPIPE_REQUESTS_LOW_WATER = 20;
 
+// Priority and discard updates queued for the fetch thread, which drains
+// them every frame.  Past this the sender applies the update itself.
+static const U32 REQUEST_UPDATE_QUEUE_SIZE = 32768;
+
 // BUG-3323/SH-4375
 // *NOTE:  This is a heuristic value.  Texture fetches have a habit of using a
 // value of 32MB to indicate 'get the rest of the image'.  Certain ISPs and
@@ -284,6 +297,7 @@ class LLTextureFetchWorker : public LLWorkerClass, public LLCore::HttpHandler
 
 {
     friend class LLTextureFetch;
+    friend class LLTextureFetchUpdates;
 
 private:
     class CacheReadResponder : public LLTextureCache::ReadResponder
@@ -467,6 +481,21 @@ private:
     // Locks:  Mw (ctor invokes without lock)
     void setDesiredDiscard(S32 discard, S32 size);
 
+    // Threads:  Ttf (or the sender when the update queue is full or the worker is DONE)
+    // Locks:  -Mw
+    void applyUpdate(const LLTextureFetchUpdates::Update& update);
+
+    // Discard changes queued for this worker that Ttf hasn't applied yet
+    // Threads:  T*
+    LLTextureFetchUpdates::Pending& getPendingUpdates() { return mPendingUpdates; }
+
+    // True if the worker is DONE, or DONE with a request for this size
+    // and discard, readable without Mw.
+    // Threads:  T*
+    bool isDone() const { return mDoneRequest != -1; }
+    bool isDoneWith(S32 size, S32 discard) const { return mDoneRequest == doneKey(size, discard); }
+    static S64 doneKey(S32 size, S32 discard) { return ((S64)size << 8) | (U8)discard; }
+
     // Threads:  T*
     // Locks:  Mw
     bool insertPacket(S32 index, U8* data, S32 size);
@@ -530,6 +559,8 @@ private:
 
     e_state mState;
     void setState(e_state new_state);
+    std::atomic<S64> mDoneRequest; // doneKey() of the request while DONE, -1 otherwise
+    LLTextureFetchUpdates::Pending mPendingUpdates;
     LLViewerRegion* getRegion();
 
     e_write_to_cache_state mWriteToCacheState;
@@ -580,7 +611,6 @@ private:
     BOOL mInCache;
     bool                        mCanUseHTTP;
     S32 mRetryAttempt;
-    S32 mActiveCount;
     LLCore::HttpStatus mGetStatus;
     std::string mGetReason;
     LLAdaptiveRetryPolicy mFetchRetryPolicy;
@@ -884,6 +914,7 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
     : LLWorkerClass(fetcher, "TextureFetch"),
       LLCore::HttpHandler(),
       mState(INIT),
+      mDoneRequest(-1),
       mWriteToCacheState(NOT_WRITE),
       mFetcher(fetcher),
       mFTType(f_type),
@@ -920,7 +951,6 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
       mInCache(FALSE),
       mCanUseHTTP(true),
       mRetryAttempt(0),
-      mActiveCount(0),
       mWorkMutex(),
       mFirstPacket(0),
       mLastPacket(-1),
@@ -1040,6 +1070,44 @@ void LLTextureFetchWorker::setImagePriority(F32 priority)
     mImagePriority = priority; //should map to max virtual size, abort if zero
 }
 
+// Threads:  Ttf (or the sender when the update queue is full or the worker is DONE)
+// Locks:  -Mw
+void LLTextureFetchWorker::applyUpdate(const LLTextureFetchUpdates::Update& update)
+{
+    lockWorkMutex();                                                    // +Mw
+    if (update.mPriorityOnly)
+    {
+        setImagePriority(update.mPriority);
+        unlockWorkMutex();                                              // -Mw
+        return;
+    }
+
+    if (mState == DONE && mDesiredSize == llmax(update.mDesiredSize, TEXTURE_CACHE_ENTRY_SIZE) && mDesiredDiscard == update.mDesiredDiscard)
+    {
+        unlockWorkMutex();                                              // -Mw
+        return; // similar request has failed or is in a transitional state
+    }
+
+    mNeedsAux = update.mNeedsAux;
+    setImagePriority(update.mPriority);
+    setDesiredDiscard(update.mDesiredDiscard, update.mDesiredSize);
+    setCanUseHTTP(update.mCanUseHTTP);
+
+    //MAINT-4184 url is always empty.  Do not set with it.
+
+    if (!haveWork())
+    {
+        setState(INIT);
+        unlockWorkMutex();                                              // -Mw
+
+        addWork(0);
+    }
+    else
+    {
+        unlockWorkMutex();                                              // -Mw
+    }
+}
+
 // Locks:  Mw
 void LLTextureFetchWorker::resetFormattedData()
 {
@@ -2485,6 +2553,7 @@ LLTextureFetch::LLTextureFetch(LLTextureCache* cache, bool threaded, bool qa_mod
       mHTTPTextureBits((U32Bits)0),
       mTotalHTTPRequests(0),
       mCommandsSize(0),
+      mRequestUpdates(REQUEST_UPDATE_QUEUE_SIZE),
       mQAMode(qa_mode),
       mHttpRequest(NULL),
       mHttpOptions(),
@@ -2637,30 +2706,33 @@ S32 LLTextureFetch::createRequest(FTType f_type, const std::string& url, const L
         {
             return -1; // need to wait for previous aborted request to complete
         }
-        worker->lockWorkMutex();                                        // +Mw
-        if (worker->mState == LLTextureFetchWorker::DONE && worker->mDesiredSize == llmax(desired_size, TEXTURE_CACHE_ENTRY_SIZE) && worker->mDesiredDiscard == desired_discard) {
-            worker->unlockWorkMutex();                                  // -Mw
-
+        if (worker->isDoneWith(llmax(desired_size, TEXTURE_CACHE_ENTRY_SIZE), desired_discard))
+        {
             return -1; // similar request has failed or is in a transitional state
         }
-        worker->mActiveCount++;
-        worker->mNeedsAux = needs_aux;
-        worker->setImagePriority(priority);
-        worker->setDesiredDiscard(desired_discard, desired_size);
-        worker->setCanUseHTTP(can_use_http);
-
-        //MAINT-4184 url is always empty.  Do not set with it.
 
-        if (!worker->haveWork())
+        LLTextureFetchUpdates::Update update;
+        update.mID = id;
+        update.mPriority = priority;
+        update.mDesiredDiscard = desired_discard;
+        update.mDesiredSize = desired_size;
+        update.mPriorityOnly = false;
+        update.mNeedsAux = needs_aux;
+        update.mCanUseHTTP = can_use_http;
+        if (worker->isDone() && !worker->getPendingUpdates().any())
         {
-            worker->setState(LLTextureFetchWorker::INIT);
-            worker->unlockWorkMutex();                                  // -Mw
-
-            worker->addWork(0);
+            // A DONE worker has no work in progress to wait on, and it must
+            // be back in INIT before the caller next asks whether the request
+            // is finished, so restart it here.  With older changes still
+            // queued it waits for them instead, to keep them in order.
+            worker->applyUpdate(update);
         }
-        else
+        else if (!mRequestUpdates.push(update, &worker->getPendingUpdates()))
         {
-            worker->unlockWorkMutex();                                  // -Mw
+            // Otherwise the fetch thread applies the change (and repeats the
+            // check above under the worker's lock) so we never wait on a busy
+            // worker here, unless the queue is full.
+            worker->applyUpdate(update);
         }
     }
     else
@@ -2671,7 +2743,6 @@ S32 LLTextureFetch::createRequest(FTType f_type, const std::string& url, const L
         unlockQueue();                                                  // -Mfq
 
         worker->lockWorkMutex();                                        // +Mw
-        worker->mActiveCount++;
         worker->mNeedsAux = needs_aux;
         worker->setCanUseHTTP(can_use_http) ;
         worker->unlockWorkMutex();                                      // -Mw
@@ -2838,6 +2909,11 @@ bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level,
         {
             res = true;
         }
+        else if (worker->getPendingUpdates().any())
+        {
+            // Not finished: the last createRequest() for it hasn't reached
+            // the worker yet, so whatever it has is for an older request.
+        }
         else if (!worker->haveWork())
         {
             // Should only happen if we set mDebugPause...
@@ -2923,16 +2999,21 @@ bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level,
 bool LLTextureFetch::updateRequestPriority(const LLUUID& id, F32 priority)
 {
     LL_PROFILE_ZONE_SCOPED;
-    mRequestQueue.tryPost([=]()
-        {
-            LLTextureFetchWorker* worker = getWorker(id);
-            if (worker)
+    LLTextureFetchUpdates::Update update;
+    update.mID = id;
+    update.mPriority = priority;
+    if (!mRequestUpdates.push(update))
+    {
+        // queue is full, fall back to a posted update
+        mRequestQueue.tryPost([=]()
             {
-                worker->lockWorkMutex();                                        // +Mw
-                worker->setImagePriority(priority);
-                worker->unlockWorkMutex();                                      // -Mw
-            }
-        });
+                LLTextureFetchWorker* worker = getWorker(id);
+                if (worker)
+                {
+                    worker->applyUpdate(update);
+                }
+            });
+    }
 
     return true;
 }
@@ -3008,6 +3089,9 @@ void LLTextureFetch::commonUpdate()
         mHttpLowWater = HTTP_NONPIPE_REQUESTS_LOW_WATER;
     }
 
+    // Pick up priority and discard changes before anything looks at them
+    applyRequestUpdates();
+
     // Release waiters
     releaseHttpWaiters();
 
@@ -3025,6 +3109,28 @@ void LLTextureFetch::commonUpdate()
 }
 
 
+// Threads:  Ttf
+void LLTextureFetch::applyRequestUpdates()
+{
+    LL_PROFILE_ZONE_SCOPED;
+    // resolve workers in batches so the request map lock is taken once per
+    // batch rather than once per update
+    mRequestUpdates.drain<LLTextureFetchWorker>(
+        [this](const LLTextureFetchUpdates::Update* updates, U32 count, LLTextureFetchWorker** workers)
+        {
+            lockQueue();                                                // +Mfq
+            for (U32 i = 0; i < count; ++i)
+            {
+                workers[i] = getWorkerAfterLock(updates[i].mID);
+            }
+            unlockQueue();                                              // -Mfq
+        },
+        [](LLTextureFetchWorker* worker, const LLTextureFetchUpdates::Update& update)
+        {
+            worker->applyUpdate(update);
+        });
+}
+
 // Threads:  Tmain
 
 //virtual
@@ -3180,6 +3286,7 @@ void LLTextureFetchWorker::setState(e_state new_state)
 
     mStateTimer.reset();
     mState = new_state;
+    mDoneRequest = (new_state == DONE) ? doneKey(mDesiredSize, mDesiredDiscard) : -1;
 }
 
 LLViewerRegion* LLTextureFetchWorker::getRegion()
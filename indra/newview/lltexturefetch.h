@@ -35,6 +35,7 @@
 #include "lluuid.h"
 #include "llworkerthread.h"
 #include "lltextureinfo.h"
+#include "lltexturefetchupdates.h"
 #include "llimageworker.h"
 #include "httprequest.h"
 #include "httpoptions.h"
@@ -253,6 +254,10 @@ private:
     // Threads:  Ttf
     void commonUpdate();
 
+    // Apply the request updates queued by other threads.
+    // Threads:  Ttf
+    void applyRequestUpdates();
+
     // Metrics command helpers
     /**
      * Enqueues a command request at the end of the command queue
@@ -340,6 +345,11 @@ private:
     command_queue_t mCommands;                                          // Mfq
     std::atomic<S32> mCommandsSize;
 
+    // Changes to existing requests from createRequest() and
+    // updateRequestPriority(), applied on the fetch thread so that
+    // callers never wait on a busy worker.
+    LLTextureFetchUpdates mRequestUpdates;                              // <none>
+
     // If true, modifies some behaviors that help with QA tasks.
     const bool mQAMode;
 
@@ -0,0 +1,51 @@
+/**
+ * @file   lltexturefetchupdates.cpp
+ * @date   2026-10-18
+ * @brief  Implementation for lltexturefetchupdates.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "lltexturefetchupdates.h"
+
+namespace
+{
+    // 0 marks an update that no Pending counts
+    std::atomic<U32> sNextSerial(1);
+}
+
+LLTextureFetchUpdates::Pending::Pending() :
+    mCount(0),
+    mSerial(sNextSerial.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+LLTextureFetchUpdates::LLTextureFetchUpdates(U32 capacity) :
+    mQueue(capacity)
+{
+}
+
+bool LLTextureFetchUpdates::push(const Update& update, Pending* pending)
+{
+    if (!pending)
+    {
+        Update uncounted = update;
+        uncounted.mSerial = 0;
+        return mQueue.tryPush(uncounted);
+    }
+
+    // counted before it can be applied, so the count never dips below zero
+    pending->mCount.fetch_add(1, std::memory_order_relaxed);
+    Update counted = update;
+    counted.mSerial = pending->mSerial;
+    if (!mQueue.tryPush(counted))
+    {
+        pending->mCount.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
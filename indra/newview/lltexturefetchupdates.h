@@ -0,0 +1,138 @@
+/**
+ * @file   lltexturefetchupdates.h
+ * @date   2026-10-18
+ * @brief  LLTextureFetchUpdates carries priority and discard changes for
+ *         existing texture fetch requests over to the fetch thread.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTEXTUREFETCHUPDATES_H
+#define LL_LLTEXTUREFETCHUPDATES_H
+
+#include "lllockfreequeue.h"
+#include "lluuid.h"
+#include <atomic>
+
+/**
+ * Any thread pushes an Update for a request; the fetch thread drains them
+ * all at the start of its update and applies each to the request's worker.
+ * Nothing here locks, so the sender never waits on a busy worker.
+ *
+ * A change of desired discard can be pushed with the request's Pending,
+ * which then counts it until the fetch thread has applied it. The owner of
+ * the request uses that to avoid reporting a result that predates its own
+ * latest change (see LLTextureFetch::getRequestFinished()).
+ *
+ * The requests drain() applies updates to are TARGETs, and must have a
+ * getPendingUpdates() returning their Pending.
+ */
+class LLTextureFetchUpdates
+{
+public:
+    struct Update
+    {
+        LLUUID mID;
+        F32 mPriority = 0.f;
+        S32 mDesiredDiscard = -1;
+        S32 mDesiredSize = 0;
+        bool mPriorityOnly = true;
+        bool mNeedsAux = false;
+        bool mCanUseHTTP = true;
+        // set by push(): the Pending counting this update, if any
+        U32 mSerial = 0;
+    };
+
+    // One per request: how many of its updates are waiting for the fetch thread
+    class Pending
+    {
+    public:
+        Pending();
+        Pending(const Pending&) = delete;
+        Pending& operator=(const Pending&) = delete;
+
+        bool any() const { return mCount.load(std::memory_order_acquire) > 0; }
+
+    private:
+        friend class LLTextureFetchUpdates;
+        std::atomic<S32> mCount;
+        // Tells this request's updates from those of an earlier request
+        // for the same texture, which a queued update may outlive
+        const U32 mSerial;
+    };
+
+    // Updates are applied in batches of up to this many
+    static const U32 BATCH_SIZE = 256;
+
+    explicit LLTextureFetchUpdates(U32 capacity);
+
+    // Threads:  T*
+    // Queues update, counted by pending if one is given. Returns false if the
+    // queue is full, in which case the caller applies the update itself.
+    bool push(const Update& update, Pending* pending = NULL);
+
+    // Threads:  Ttf
+    // Applies every queued update, oldest first. resolve(updates, count,
+    // targets) looks up the target of each of a batch of updates, leaving
+    // NULL for requests that are gone; apply(target, update) applies one.
+    // Returns the number of updates applied.
+    template <typename TARGET, typename RESOLVE, typename APPLY>
+    U32 drain(RESOLVE resolve, APPLY apply);
+
+private:
+    LLLockFreeQueue<Update> mQueue;
+};
+
+template <typename TARGET, typename RESOLVE, typename APPLY>
+U32 LLTextureFetchUpdates::drain(RESOLVE resolve, APPLY apply)
+{
+    Update updates[BATCH_SIZE];
+    TARGET* targets[BATCH_SIZE];
+    U32 applied = 0;
+    while (true)
+    {
+        U32 count = 0;
+        while (count < BATCH_SIZE && mQueue.tryPop(updates[count]))
+        {
+            ++count;
+        }
+        if (count == 0)
+        {
+            break;
+        }
+
+        resolve(updates, count, targets);
+
+        for (U32 i = 0; i < count; ++i)
+        {
+            TARGET* target = targets[i];
+            if (!target)
+            {
+                continue;
+            }
+
+            const Update& update = updates[i];
+            if (update.mSerial)
+            {
+                Pending& pending = target->getPendingUpdates();
+                if (pending.mSerial != update.mSerial)
+                {
+                    continue; // meant for a request that has since been deleted
+                }
+                apply(target, update);
+                // only now may the owner see the request as settled
+                pending.mCount.fetch_sub(1, std::memory_order_release);
+            }
+            else
+            {
+                apply(target, update);
+            }
+            ++applied;
+        }
+    }
+    return applied;
+}
+
+#endif // LL_LLTEXTUREFETCHUPDATES_H
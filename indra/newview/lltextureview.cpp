@@ -527,10 +527,14 @@ void LLGLTexMemBar::draw()
     U32 texFetchLatMed = U32(recording.getMean(LLTextureFetch::sTexFetchLatency).value() * 1000.0f);
     U32 texFetchLatMax = U32(recording.getMax(LLTextureFetch::sTexFetchLatency).value() * 1000.0f);
 
-    text = llformat("GL Free: %d MB Sys Free: %d MB FBO: %d MB Bias: %.2f Cache: %.1f/%.1f MB",
+    const LLRenderTargetPool& rt_pool = LLRenderTarget::getPool();
+    text = llformat("GL Free: %d MB Sys Free: %d MB FBO: %d MB Pool: %d MB (%d/%d hit) Bias: %.2f Cache: %.1f/%.1f MB",
                     gViewerWindow->getWindow()->getAvailableVRAMMegabytes(),
                     LLMemory::getAvailableMemKB()/1024,
                     LLRenderTarget::sBytesAllocated/(1024*1024),
+                    rt_pool.getBytes()/(1024*1024),
+                    rt_pool.getHits(),
+                    rt_pool.getHits() + rt_pool.getMisses(),
                     discard_bias,
                     cache_usage,
                     cache_max_usage);
@@ -406,7 +406,7 @@ BOOL LLToolPie::handleLeftClickPick()
         case CLICK_ACTION_ZOOM:
             {
                 const F32 PADDING_FACTOR = 2.f;
-                LLViewerObject* object = gObjectList.findObject(mPick.mObjectID);
+                LLViewerObject* object = mPick.getObject();
 
                 if (object)
                 {
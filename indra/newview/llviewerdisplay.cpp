@@ -108,6 +108,7 @@ BOOL gResizeShadowTexture = FALSE;
 BOOL gWindowResized = FALSE;
 BOOL gSnapshot = FALSE;
 BOOL gCubeSnapshot = FALSE;
+
 BOOL gSnapshotNoPost = FALSE;
 BOOL gShaderProfileFrame = FALSE;
 
@@ -121,6 +122,11 @@ LLFrameTimer gRecentFPSTime;
 LLFrameTimer gRecentMemoryTime;
 LLFrameTimer gAssetStorageLogTime;
 
+// main loop work limited by gFrameScheduler
+static LLTrace::BlockTimerStatHandle FTM_CREATE_OBJECTS("Create Objects");
+static LLTrace::BlockTimerStatHandle FTM_UPDATE_GEOM("Update Geom");
+static LLTrace::BlockTimerStatHandle FTM_UPDATE_IMAGE_LIST("Update Image List");
+
 // Rendering stuff
 void pre_show_depth_buffer();
 void post_show_depth_buffer();
@@ -560,6 +566,7 @@ void display(BOOL rebuild, F32 zoom_factor, int subfield, BOOL for_snapshot)
     stop_glerror();
 
     LLImageGL::updateStats(gFrameTimeSeconds);
+    LLRenderTarget::updatePool(gFrameCount);
 
     static const LLCachedControl<S32> av_name_tag_mode(gSavedSettings, "AvatarNameTagMode");
     static const LLCachedControl<bool> name_tag_show_grp_title(gSavedSettings, "NameTagShowGroupTitles");
@@ -741,10 +748,25 @@ void display(BOOL rebuild, F32 zoom_factor, int subfield, BOOL for_snapshot)
 
         {
             LL_PROFILE_ZONE_NAMED_CATEGORY_DISPLAY("Update Geom");
-            const F32 max_geom_update_time = 0.005f*10.f*gFrameIntervalSeconds.value(); // 50 ms/second update time
-            gPipeline.createObjects(max_geom_update_time);
+            static const LLFrameScheduler::task_id_t create_task =
+                gFrameScheduler.addTask("Create Objects", 3, 0.0, 0.008, &FTM_CREATE_OBJECTS);
+            static const LLFrameScheduler::task_id_t geom_task =
+                gFrameScheduler.addTask("Update Geom", 3, 0.0, 0.008, &FTM_UPDATE_GEOM);
+            // never less than the 50 ms/second update time each always had
+            const F64 min_update_time = 0.005 * 10.0 * gFrameIntervalSeconds.value();
+            gFrameScheduler.setMinTime(create_task, min_update_time);
+            gFrameScheduler.setMinTime(geom_task, min_update_time);
+            {
+                LL_RECORD_BLOCK_TIME(FTM_CREATE_OBJECTS);
+                LLFrameScheduler::Scope budget(gFrameScheduler, create_task);
+                gPipeline.createObjects(budget.getBudget());
+            }
             gPipeline.processPartitionQ();
-            gPipeline.updateGeom(max_geom_update_time);
+            {
+                LL_RECORD_BLOCK_TIME(FTM_UPDATE_GEOM);
+                LLFrameScheduler::Scope budget(gFrameScheduler, geom_task);
+                gPipeline.updateGeom(budget.getBudget());
+            }
             stop_glerror();
         }
 
@@ -847,9 +869,11 @@ void display(BOOL rebuild, F32 zoom_factor, int subfield, BOOL for_snapshot)
 
             {
                 LL_PROFILE_ZONE_NAMED_CATEGORY_DISPLAY("List");
-                F32 max_image_decode_time = 0.050f*gFrameIntervalSeconds.value(); // 50 ms/second decode time
-                max_image_decode_time = llclamp(max_image_decode_time, 0.002f, 0.005f ); // min 2ms/frame, max 5ms/frame)
-                gTextureList.updateImages(max_image_decode_time);
+                static const LLFrameScheduler::task_id_t image_task =
+                    gFrameScheduler.addTask("Update Image List", 2, 0.002, 0.010, &FTM_UPDATE_IMAGE_LIST);
+                LL_RECORD_BLOCK_TIME(FTM_UPDATE_IMAGE_LIST);
+                LLFrameScheduler::Scope budget(gFrameScheduler, image_task);
+                gTextureList.updateImages(budget.getBudget());
             }
 
             {
@@ -1470,7 +1494,13 @@ void swap()
     LL_PROFILE_GPU_ZONE("swap");
     if (gDisplaySwapBuffers)
     {
+        // the next frame's frustum tests can run while we wait here
+        gPipeline.startPrecull();
+        // mostly waiting on vsync or the GPU, not work the scheduler can trade
+        LLTimer swap_timer;
         gViewerWindow->getWindow()->swapBuffers();
+        gFrameScheduler.addWaitTime(swap_timer.getElapsedTimeF64());
+        gPipeline.finishPrecull();
     }
     gDisplaySwapBuffers = TRUE;
 }
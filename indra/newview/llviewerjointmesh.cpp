@@ -55,6 +55,10 @@
 #include "m4math.h"
 #include "llmatrix4a.h"
 #include "llperfstats.h"
+#include "llframetimer.h"
+#include "lltimer.h"
+#include "workqueue.h"
+#include "llavatarbodyfill.h"
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -68,7 +72,8 @@
 //-----------------------------------------------------------------------------
 LLViewerJointMesh::LLViewerJointMesh()
     :
-    LLAvatarJointMesh()
+    LLAvatarJointMesh(),
+    mSkinMatrixFrame(0)
 {
 }
 
@@ -89,39 +94,32 @@ const S32 NUM_AXES = 3;
 // rotation Z 0-n
 // pivot parent 0-n -- child = n+1
 
-static LLMatrix4    gJointMatUnaligned[32];
 static LLMatrix4a   gJointMatAligned[32];
-static LLMatrix3    gJointRotUnaligned[32];
 static LLVector4    gJointPivot[32];
 
 //-----------------------------------------------------------------------------
-// uploadJointMatrices()
+// updateSkinMatrices()
 //-----------------------------------------------------------------------------
-void LLViewerJointMesh::uploadJointMatrices()
+void LLViewerJointMesh::updateSkinMatrices()
 {
-    S32 joint_num;
     LLPolyMesh *reference_mesh = mMesh->getReferenceMesh();
-    LLDrawPool *poolp = mFace ? mFace->getPool() : NULL;
-    BOOL hardware_skinning = (poolp && poolp->getShaderLevel() > 0) ? TRUE : FALSE;
+    const U32 joint_count = (U32)reference_mesh->mJointRenderData.size();
+    const U32 frame = LLFrameTimer::getFrameCount();
 
-    //calculate joint matrices
-    for (joint_num = 0; joint_num < reference_mesh->mJointRenderData.size(); joint_num++)
+    // The skeleton is posed during idle, so the world matrices hold still
+    // for every pass (shadows, main view, impostors, ...) of a frame.
+    if (mSkinMatrixFrame == frame && mSkinMatrices.size() == joint_count)
     {
-        LLMatrix4a joint_mat = *reference_mesh->mJointRenderData[joint_num]->mWorldMatrix;
-
-        if (hardware_skinning)
-        {
-            joint_mat.setMul(LLDrawPoolAvatar::getModelView(),joint_mat);
-        }
-        gJointMatUnaligned[joint_num] = LLMatrix4(joint_mat.getF32ptr());
-        gJointRotUnaligned[joint_num] = gJointMatUnaligned[joint_num].getMat3();
+        return;
     }
+    mSkinMatrixFrame = frame;
+    mSkinMatrices.resize(joint_count);
 
     BOOL last_pivot_uploaded = FALSE;
-    S32 j = 0;
+    U32 j = 0;
 
-    //upload joint pivots
-    for (joint_num = 0; joint_num < reference_mesh->mJointRenderData.size(); joint_num++)
+    //gather joint pivots
+    for (U32 joint_num = 0; joint_num < joint_count; joint_num++)
     {
         LLSkinJoint *sj = reference_mesh->mJointRenderData[joint_num]->mSkinJoint;
         if (sj)
@@ -146,30 +144,53 @@ void LLViewerJointMesh::uploadJointMatrices()
         }
     }
 
-    //add pivot point into transform
-    for (S32 i = 0; i < j; i++)
+    //add pivot point into transform: world * translate(pivot), so that a
+    //pass only has to premultiply its modelview
+    for (U32 joint_num = 0; joint_num < joint_count; joint_num++)
     {
-        LLVector3 pivot;
-        pivot = LLVector3(gJointPivot[i]);
-        pivot = pivot * gJointRotUnaligned[i];
-        gJointMatUnaligned[i].translate(pivot);
+        LLMatrix4a& joint_mat = mSkinMatrices[joint_num];
+        joint_mat = *reference_mesh->mJointRenderData[joint_num]->mWorldMatrix;
+
+        if (joint_num < j)
+        {
+            LLVector4a pivot;
+            pivot.loadua(gJointPivot[joint_num].mV);
+            LLVector4a offset;
+            joint_mat.rotate(pivot, offset);
+            joint_mat.mMatrix[3].add(offset);
+        }
     }
+}
+
+//-----------------------------------------------------------------------------
+// uploadJointMatrices()
+//-----------------------------------------------------------------------------
+void LLViewerJointMesh::uploadJointMatrices()
+{
+    LLDrawPool *poolp = mFace ? mFace->getPool() : NULL;
+    BOOL hardware_skinning = (poolp && poolp->getShaderLevel() > 0) ? TRUE : FALSE;
+
+    updateSkinMatrices();
+    const U32 joint_count = (U32)mSkinMatrices.size();
 
     // upload matrices
     if (hardware_skinning)
     {
+        const LLMatrix4a& modelview = LLDrawPoolAvatar::getModelView();
+
         GLfloat mat[45*4];
         memset(mat, 0, sizeof(GLfloat)*45*4);
 
-        for (joint_num = 0; joint_num < reference_mesh->mJointRenderData.size(); joint_num++)
+        for (U32 joint_num = 0; joint_num < joint_count; joint_num++)
         {
-            gJointMatUnaligned[joint_num].transpose();
+            LLMatrix4a joint_mat;
+            joint_mat.setMul(modelview, mSkinMatrices[joint_num]);
+            joint_mat.transpose();
 
             for (S32 axis = 0; axis < NUM_AXES; axis++)
             {
-                F32* vector = gJointMatUnaligned[joint_num].mMatrix[axis];
                 U32 offset = LL_CHARACTER_MAX_JOINTS_PER_MESH*axis+joint_num;
-                memcpy(mat+offset*4, vector, sizeof(GLfloat)*4);
+                memcpy(mat+offset*4, joint_mat.mMatrix[axis].getF32ptr(), sizeof(GLfloat)*4);
             }
         }
         stop_glerror();
@@ -181,10 +202,9 @@ void LLViewerJointMesh::uploadJointMatrices()
     }
     else
     {
-        //load gJointMatUnaligned into gJointMatAligned
-        for (joint_num = 0; joint_num < reference_mesh->mJointRenderData.size(); ++joint_num)
+        for (U32 joint_num = 0; joint_num < joint_count; ++joint_num)
         {
-            gJointMatAligned[joint_num].loadu(gJointMatUnaligned[joint_num]);
+            gJointMatAligned[joint_num] = mSkinMatrices[joint_num];
         }
     }
 }
@@ -332,6 +352,69 @@ void LLViewerJointMesh::updateFaceSizes(U32 &num_vertices, U32& num_indices, F32
     }
 }
 
+//-----------------------------------------------------------------------------
+// Batched face fill
+//-----------------------------------------------------------------------------
+namespace
+{
+    LLAvatarBodyFill sPendingFills;
+    std::vector<LLPointer<LLVertexBuffer> > sPendingUnmaps;
+}
+
+bool LLViewerJointMesh::sFillBatchOpen = false;
+F64 LLViewerJointMesh::sFillTime = 0.0;
+
+// static
+void LLViewerJointMesh::beginFillBatch()
+{
+    llassert(on_main_thread());
+    llassert(!sFillBatchOpen);
+    sFillBatchOpen = true;
+}
+
+// static
+void LLViewerJointMesh::deferUnmap(LLVertexBuffer* buffer)
+{
+    llassert(sFillBatchOpen);
+    // a buffer shows up once per avatar, usually back to back
+    if (sPendingUnmaps.empty() || sPendingUnmaps.back() != buffer)
+    {
+        sPendingUnmaps.push_back(buffer);
+    }
+}
+
+// static
+void LLViewerJointMesh::flushFillBatch()
+{
+    if (!sFillBatchOpen)
+    {
+        return;
+    }
+    sFillBatchOpen = false;
+
+    if (sPendingFills.empty() && sPendingUnmaps.empty())
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+    LLTimer timer;
+
+    sPendingFills.flush([](const std::function<void()>& copy)
+        {
+            LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+            return general_queue && general_queue->tryPost(copy);
+        });
+
+    for (LLVertexBuffer* buffer : sPendingUnmaps)
+    {
+        buffer->unmapBuffer();
+    }
+    sPendingUnmaps.clear();
+
+    sFillTime += timer.getElapsedTimeF64() * 1000.0;
+}
+
 //-----------------------------------------------------------------------------
 // updateFaceData()
 //-----------------------------------------------------------------------------
@@ -372,50 +455,35 @@ void LLViewerJointMesh::updateFaceData(LLFace *face, F32 pixel_area, BOOL damp_w
 
         if (num_verts)
         {
+            // mapping stays on this thread, only the copy may move
             face->getVertexBuffer()->getIndexStrider(indicesp);
             face->getGeometryAvatar(verticesp, normalsp, tex_coordsp, vertex_weightsp, clothing_weightsp);
 
-            verticesp += mMesh->mFaceVertexOffset;
-            normalsp += mMesh->mFaceVertexOffset;
-
-            F32* v = (F32*) verticesp.get();
-            F32* n = (F32*) normalsp.get();
-
-            U32 words = num_verts*4;
-
-            LLVector4a::memcpyNonAliased16(v, (F32*) mMesh->getCoords(), words*sizeof(F32));
-            LLVector4a::memcpyNonAliased16(n, (F32*) mMesh->getNormals(), words*sizeof(F32));
-
-
-            if (!terse_update)
+            LLAvatarBodyFill::Fill fill;
+            fill.mVertices = (F32*) (verticesp + mMesh->mFaceVertexOffset).get();
+            fill.mNormals = (F32*) (normalsp + mMesh->mFaceVertexOffset).get();
+            fill.mTexCoords = (F32*) (tex_coordsp + mMesh->mFaceVertexOffset).get();
+            fill.mWeights = (F32*) (vertex_weightsp + mMesh->mFaceVertexOffset).get();
+            fill.mClothingWeights = (F32*) (clothing_weightsp + mMesh->mFaceVertexOffset).get();
+            fill.mIndices = (indicesp + mMesh->mFaceIndexOffset).get();
+            fill.mSrcCoords = (const F32*) mMesh->getCoords();
+            fill.mSrcNormals = (const F32*) mMesh->getNormals();
+            fill.mSrcTexCoords = (const F32*) mMesh->getTexCoords();
+            fill.mSrcWeights = (const F32*) mMesh->getWeights();
+            fill.mSrcClothingWeights = (const F32*) mMesh->getClothingWeights();
+            fill.mSrcIndices = (const S32*) mMesh->getFaces();
+            fill.mNumVerts = num_verts;
+            fill.mNumIndices = mMesh->getNumFaces()*3;
+            fill.mIndexOffset = (S32) mMesh->mFaceVertexOffset;
+            fill.mTerse = terse_update;
+
+            if (sFillBatchOpen)
             {
-                vertex_weightsp += mMesh->mFaceVertexOffset;
-                clothing_weightsp += mMesh->mFaceVertexOffset;
-                tex_coordsp += mMesh->mFaceVertexOffset;
-
-                F32* tc = (F32*) tex_coordsp.get();
-                F32* vw = (F32*) vertex_weightsp.get();
-                F32* cw = (F32*) clothing_weightsp.get();
-
-                S32 tc_size = (num_verts*sizeof(LLVector2)+0xF) & ~0xF;
-                LLVector4a::memcpyNonAliased16(tc, (F32*) mMesh->getTexCoords(), tc_size);
-                S32 vw_size = (num_verts*sizeof(F32)+0xF) & ~0xF;
-                LLVector4a::memcpyNonAliased16(vw, (F32*) mMesh->getWeights(), vw_size);
-                LLVector4a::memcpyNonAliased16(cw, (F32*) mMesh->getClothingWeights(), num_verts*4*sizeof(F32));
+                sPendingFills.add(fill);
             }
-
-            const U32 idx_count = mMesh->getNumFaces()*3;
-
-            indicesp += mMesh->mFaceIndexOffset;
-
-            U16* __restrict idx = indicesp.get();
-            S32* __restrict src_idx = (S32*) mMesh->getFaces();
-
-            const S32 offset = (S32) mMesh->mFaceVertexOffset;
-
-            for (S32 i = 0; i < idx_count; ++i)
+            else
             {
-                *(idx++) = *(src_idx++)+offset;
+                LLAvatarBodyFill::run(fill);
             }
         }
     }
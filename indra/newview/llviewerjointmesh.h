@@ -35,6 +35,7 @@
 
 class LLDrawable;
 class LLFace;
+class LLVertexBuffer;
 class LLCharacter;
 class LLViewerTexLayerSet;
 
@@ -68,10 +69,34 @@ public:
 
     /*virtual*/ BOOL isAnimatable() const override { return FALSE; }
 
+    // While a fill batch is open, updateFaceData() still maps the face's
+    // vertex buffer but leaves copying the poly mesh into it to the
+    // "General" thread pool. flushFillBatch() waits for the copies (helping
+    // with them) and unmaps every buffer touched. Main thread only.
+    static void beginFillBatch();
+    static void flushFillBatch();
+    static bool isFillBatchOpen() { return sFillBatchOpen; }
+    // unmap buffer at the next flushFillBatch()
+    static void deferUnmap(LLVertexBuffer* buffer);
+
+    // milliseconds the main thread spent in flushFillBatch() since the last
+    // call to resetFillTime()
+    static F64 getFillTime() { return sFillTime; }
+    static void resetFillTime() { sFillTime = 0.0; }
+
 private:
+    // world space skinning matrices with the joint pivots applied, one per
+    // entry of the reference mesh's mJointRenderData; rebuilt once per frame
+    void updateSkinMatrices();
 
     //copy mesh into given face's vertex buffer, applying current animation pose
     static void updateGeometry(LLFace* face, LLPolyMesh* mesh);
+
+    std::vector<LLMatrix4a> mSkinMatrices;
+    U32 mSkinMatrixFrame;
+
+    static bool sFillBatchOpen;
+    static F64 sFillTime;
 };
 
 #endif // LL_LLVIEWERJOINTMESH_H
@@ -86,6 +86,7 @@ void LLViewerMediaFocus::setFocusFace(LLPointer<LLViewerObject> objectp, S32 fac
         mPrevFocusedImplID = LLUUID::null;
         mFocusedImplID = media_impl->getMediaTextureID();
         mFocusedObjectID = objectp->getID();
+        mFocusedObjectHandle = objectp->getHandle();
         mFocusedObjectFace = face;
         mFocusedObjectNormal = pick_normal;
 
@@ -159,10 +160,12 @@ void LLViewerMediaFocus::setFocusFace(LLPointer<LLViewerObject> objectp, S32 fac
             // Still record the focused object...it may mean we need to load media data.
             // This will aid us in determining this object is "important enough"
             mFocusedObjectID = objectp->getID();
+            mFocusedObjectHandle = objectp->getHandle();
             mFocusedObjectFace = face;
         }
         else {
             mFocusedObjectID = LLUUID::null;
+            mFocusedObjectHandle = LLViewerObject::handle_t();
             mFocusedObjectFace = 0;
         }
     }
@@ -179,12 +182,14 @@ void LLViewerMediaFocus::setHoverFace(LLPointer<LLViewerObject> objectp, S32 fac
     {
         mHoverImplID = media_impl->getMediaTextureID();
         mHoverObjectID = objectp->getID();
+        mHoverObjectHandle = objectp->getHandle();
         mHoverObjectFace = face;
         mHoverObjectNormal = pick_normal;
     }
     else
     {
         mHoverObjectID = LLUUID::null;
+        mHoverObjectHandle = LLViewerObject::handle_t();
         mHoverObjectFace = 0;
         mHoverImplID = LLUUID::null;
     }
@@ -544,7 +549,7 @@ LLViewerMediaImpl* LLViewerMediaFocus::getFocusedMediaImpl()
 
 LLViewerObject* LLViewerMediaFocus::getFocusedObject()
 {
-    return gObjectList.findObject(mFocusedObjectID);
+    return gObjectList.findObject(mFocusedObjectHandle, mFocusedObjectID);
 }
 
 LLViewerMediaImpl* LLViewerMediaFocus::getHoverMediaImpl()
@@ -554,7 +559,7 @@ LLViewerMediaImpl* LLViewerMediaFocus::getHoverMediaImpl()
 
 LLViewerObject* LLViewerMediaFocus::getHoverObject()
 {
-    return gObjectList.findObject(mHoverObjectID);
+    return gObjectList.findObject(mHoverObjectHandle, mHoverObjectID);
 }
 
 void LLViewerMediaFocus::focusZoomOnMedia(LLUUID media_id)
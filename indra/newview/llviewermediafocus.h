@@ -105,12 +105,14 @@ private:
     LLObjectSelectionHandle mSelection;
 
     LLUUID mFocusedObjectID;
+    LLViewerObject::handle_t mFocusedObjectHandle; // looked up every frame, so by handle
     S32 mFocusedObjectFace;
     LLUUID mFocusedImplID;
     LLUUID mPrevFocusedImplID;
     LLVector3 mFocusedObjectNormal;
 
     LLUUID mHoverObjectID;
+    LLViewerObject::handle_t mHoverObjectHandle;
     S32 mHoverObjectFace;
     LLUUID mHoverImplID;
     LLVector3 mHoverObjectNormal;
@@ -5403,9 +5403,9 @@ void LLViewerObject::updateTEMaterialTextures(U8 te)
         llassert(mat == nullptr || dynamic_cast<LLFetchedGLTFMaterial*>(gGLTFMaterialList.getMaterial(mat_id)) != nullptr);
         if (mat->isFetching())
         { // material is not loaded yet, rebuild draw info when the object finishes loading
-            mat->onMaterialComplete([id=getID()]
+            mat->onMaterialComplete([handle=getHandle(), id=getID()]
                 {
-                    LLViewerObject* obj = gObjectList.findObject(id);
+                    LLViewerObject* obj = gObjectList.findObject(handle, id);
                     if (obj)
                     {
                         obj->markForUpdate();
@@ -5841,9 +5841,7 @@ S32 LLViewerObject::setTEGLTFMaterialOverride(U8 te, LLGLTFMaterial* override_ma
     {
         if (override_mat)
         {
-            LLFetchedGLTFMaterial* render_mat = new LLFetchedGLTFMaterial(*src_mat);
-            render_mat->applyOverride(*override_mat);
-            tep->setGLTFRenderMaterial(render_mat);
+            tep->setGLTFRenderMaterial(gGLTFMaterialList.getRenderMaterial(src_mat, override_mat));
             retval = TEM_CHANGE_TEXTURE;
 
             for (LLGLTFMaterial::local_tex_map_t::value_type &val : override_mat->mTrackingIdToLocalTexture)
@@ -7696,9 +7694,9 @@ void LLViewerObject::setRenderMaterialID(S32 te_in, const LLUUID& id, bool updat
             const LLGLTFMaterial* override_material = tep->getGLTFMaterialOverride();
             if (override_material)
             {
-                new_material->onMaterialComplete([obj_id = getID(), te]()
+                new_material->onMaterialComplete([handle = getHandle(), obj_id = getID(), te]()
                     {
-                        LLViewerObject* obj = gObjectList.findObject(obj_id);
+                        LLViewerObject* obj = gObjectList.findObject(handle, obj_id);
                         if (!obj) { return; }
                         LLTextureEntry* tep = obj->getTE(te);
                         if (!tep) { return; }
@@ -7722,9 +7720,9 @@ void LLViewerObject::setRenderMaterialID(S32 te_in, const LLUUID& id, bool updat
     }
     else
     {
-        new_material->onMaterialComplete([obj_id = getID()]()
+        new_material->onMaterialComplete([handle = getHandle(), obj_id = getID()]()
             {
-                LLViewerObject* obj = gObjectList.findObject(obj_id);
+                LLViewerObject* obj = gObjectList.findObject(handle, obj_id);
                 if (obj)
                 {
                     obj->rebuildMaterial();
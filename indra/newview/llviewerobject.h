@@ -31,6 +31,7 @@
 #include <unordered_map>
 
 #include "llassetstorage.h"
+#include "llhandletable.h"
 //#include "llhudicon.h"
 #include "llinventory.h"
 #include "llrefcount.h"
@@ -116,6 +117,7 @@ class LLViewerObject
     public LLRefCount,
     public LLGLUpdate
 {
+    LL_MEMTAG_NEW(LLMemTag::OBJECT);
 protected:
     virtual ~LLViewerObject(); // use unref()
 
@@ -148,6 +150,8 @@ public:
 
     typedef const child_list_t const_child_list_t;
 
+    typedef LLHandleTable<LLViewerObject>::Handle handle_t;
+
     LLViewerObject(const LLUUID &id, const LLPCode pcode, LLViewerRegion *regionp, BOOL is_global = FALSE);
 
     virtual void resetVertexBuffers() {}
@@ -266,6 +270,8 @@ public:
     virtual void setSelected(BOOL sel);
 
     const LLUUID &getID() const                     { return mID; }
+    // cheaper than getID() to look up again; see LLViewerObjectList::findObject()
+    handle_t getHandle() const                      { return mHandle; }
     U32 getLocalID() const                          { return mLocalID; }
     U32 getCRC() const                              { return mTotalCRC; }
     S32 getListIndex() const                        { return mListIndex; }
@@ -775,6 +781,9 @@ public:
     // index into LLViewerObjectList::mActiveObjects or -1 if not in list
     S32             mListIndex;
 
+    // entry in LLViewerObjectList::mObjectHandles, null once cleaned up
+    handle_t        mHandle;
+
     LLPointer<LLViewerTexture> *mTEImages;
     LLPointer<LLViewerTexture> *mTENormalMaps;
     LLPointer<LLViewerTexture> *mTESpecularMaps;
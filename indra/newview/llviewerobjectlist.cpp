@@ -129,6 +129,7 @@ void LLViewerObjectList::destroy()
     mDeadObjects.clear();
     mMapObjects.clear();
     mUUIDObjectMap.clear();
+    mObjectHandles.clear();
 }
 
 
@@ -647,7 +648,8 @@ void LLViewerObjectList::processObjectUpdate(LLMessageSystem *mesgsys,
 
             }
 #ifdef IGNORE_DEAD
-            if (mDeadObjects.find(fullid) != mDeadObjects.end())
+            if (std::any_of(mDeadObjects.begin(), mDeadObjects.end(),
+                            [&fullid](const LLViewerObject* dead) { return dead->mID == fullid; }))
             {
                 mNumDeadObjectUpdates++;
                 //LL_INFOS() << "update for a dead object:" << fullid << LL_ENDL;
@@ -1399,7 +1401,7 @@ void LLViewerObjectList::cleanupReferences(LLViewerObject *objectp)
     {
     // <FS:Beq> FIRE-30694 DeadObject Spam
     //  mDeadObjects.insert(objectp->mID);
-        mDeadObjects.insert( objectp->mID );
+        mDeadObjects.insert( objectp );
         mNumDeadObjects++;
         llassert( mNumDeadObjects == mDeadObjects.size() );
     // </FS:Beq>
@@ -1414,6 +1416,8 @@ void LLViewerObjectList::cleanupReferences(LLViewerObject *objectp)
 #endif
 
     mUUIDObjectMap.erase(objectp->mID);
+    mObjectHandles.remove(objectp->mHandle);
+    objectp->mHandle = LLViewerObject::handle_t();
 
     //if (objectp->getRegion())
     //{
@@ -1476,14 +1480,13 @@ void LLViewerObjectList::killObjects(LLViewerRegion *regionp)
     {
         objectp = *iter;
 
-        if (objectp->mRegionp == regionp)
+        if (objectp->mRegionp == regionp && killObject(objectp))
         {
-            killObject(objectp);
+            // Unlinked from every lookup now, but deleted by the idle loop
+            // under its "Dead Objects" budget, after the region is gone.
+            objectp->mRegionp = NULL;
         }
     }
-
-    // Have to clean right away because the region is becoming invalid.
-    cleanDeadObjects(FALSE);
 }
 
 void LLViewerObjectList::killAllObjects()
@@ -1499,7 +1502,7 @@ void LLViewerObjectList::killAllObjects()
         llassert((objectp == gAgentAvatarp) || objectp->isDead());
     }
 
-    cleanDeadObjects(FALSE);
+    cleanDeadObjects();
 
     if(!mObjects.empty())
     {
@@ -1520,7 +1523,7 @@ void LLViewerObjectList::killAllObjects()
     }
 }
 
-void LLViewerObjectList::cleanDeadObjects(BOOL use_timer)
+void LLViewerObjectList::cleanDeadObjects(F32 max_time)
 {
     if (!mNumDeadObjects)
     {
@@ -1534,7 +1537,6 @@ void LLViewerObjectList::cleanDeadObjects(BOOL use_timer)
     S32 num_divergent = 0;
     LLViewerObject *objectp;
 
-    static const F64 max_time = 0.01; // Let's try 10ms per frame
     LLTimer timer;
 
     vobj_list_t::reverse_iterator target = mObjects.rbegin();
@@ -1552,7 +1554,7 @@ void LLViewerObjectList::cleanDeadObjects(BOOL use_timer)
         if (objectp->isDead())
         {
             // mDeadObjects.erase(objectp->mID); // <FS:Ansariel> Use timer for cleaning up dead objects
-            auto delete_me = mDeadObjects.find(objectp->mID);
+            auto delete_me = mDeadObjects.find(objectp);
             if( delete_me != mDeadObjects.end() )
             {
                 mDeadObjects.erase( delete_me );
@@ -1568,7 +1570,7 @@ void LLViewerObjectList::cleanDeadObjects(BOOL use_timer)
             num_removed++;
 
             //if (num_removed == mNumDeadObjects || iter->isNull())
-            if (num_removed == mNumDeadObjects || iter->isNull() || (use_timer && timer.getElapsedTimeF64() > max_time))
+            if (num_removed == mNumDeadObjects || iter->isNull() || (max_time >= 0.f && timer.getElapsedTimeF32() > max_time))
             {
                 // We've cleaned up all of the dead objects or caught up to the dead tail
                 break;
@@ -2037,6 +2039,7 @@ LLViewerObject *LLViewerObjectList::createObjectViewer(const LLPCode pcode, LLVi
     }
 
     mUUIDObjectMap[fullid] = objectp;
+    objectp->mHandle = mObjectHandles.add(objectp);
 
     mObjects.push_back(objectp);
 
@@ -2063,6 +2066,7 @@ LLViewerObject *LLViewerObjectList::createObjectFromCache(const LLPCode pcode, L
 
     objectp->mLocalID = local_id;
     mUUIDObjectMap[uuid] = objectp;
+    objectp->mHandle = mObjectHandles.add(objectp);
     setUUIDAndLocal(uuid,
                     local_id,
                     regionp->getHost().getAddress(),
@@ -2104,6 +2108,7 @@ LLViewerObject *LLViewerObjectList::createObject(const LLPCode pcode, LLViewerRe
     }
 
     mUUIDObjectMap[fullid] = objectp;
+    objectp->mHandle = mObjectHandles.add(objectp);
     setUUIDAndLocal(fullid,
                     local_id,
                     gMessageSystem->getSenderIP(),
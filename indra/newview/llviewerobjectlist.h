@@ -41,6 +41,7 @@
 
 // system includes
 #include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
 #include <boost/unordered/unordered_map.hpp>
 
 class LLCamera;
@@ -71,6 +72,12 @@ public:
     inline LLViewerObject *getObject(const S32 index);
 
     inline LLViewerObject *findObject(const LLUUID &id);
+    // Prefer this for references held inside the viewer: no hashing, and
+    // NULL once the object has been cleaned up even if its UUID comes back.
+    inline LLViewerObject *findObject(LLViewerObject::handle_t handle) const;
+    // As above, but a null handle (the table was full when the object was
+    // created, or there never was one) looks up id instead.
+    inline LLViewerObject *findObject(LLViewerObject::handle_t handle, const LLUUID &id);
     LLViewerObject *createObjectViewer(const LLPCode pcode, LLViewerRegion *regionp, S32 flags = 0); // Create a viewer-side object
     LLViewerObject *createObjectFromCache(const LLPCode pcode, LLViewerRegion *regionp, const LLUUID &uuid, const U32 local_id);
     LLViewerObject *createObject(const LLPCode pcode, LLViewerRegion *regionp,
@@ -82,7 +89,9 @@ public:
     void killObjects(LLViewerRegion *regionp); // Kill all objects owned by a particular region.
     void killAllObjects();
 
-    void cleanDeadObjects(const BOOL use_timer = TRUE); // Clean up the dead object list.
+    // Clean up the dead object list for up to max_time seconds, at least one
+    // object per call; a negative max_time cleans up all of it.
+    void cleanDeadObjects(F32 max_time = -1.f);
 
     // Simulator and viewer side object updates...
     void processUpdateCore(LLViewerObject* objectp, void** data, U32 block, const EObjectUpdateType update_type,
@@ -210,9 +219,13 @@ protected:
 
 
     using uuid_hash_set_t = boost::unordered_multiset<LLUUID>;
-    uuid_hash_set_t   mDeadObjects;
+    // killed but not yet deleted; by object, since a UUID can be killed again
+    // before the budgeted cleanup deletes the first object with it
+    boost::unordered_flat_set<const LLViewerObject*> mDeadObjects;
 
     boost::unordered_flat_map<LLUUID, LLPointer<LLViewerObject> > mUUIDObjectMap;
+    // same objects as mUUIDObjectMap, by handle; not owning
+    LLHandleTable<LLViewerObject> mObjectHandles;
 
     //set of objects that need to update their cost
     uuid_hash_set_t   mStaleObjectCost;
@@ -279,6 +292,16 @@ inline LLViewerObject *LLViewerObjectList::findObject(const LLUUID &id)
     }
 }
 
+inline LLViewerObject *LLViewerObjectList::findObject(LLViewerObject::handle_t handle) const
+{
+    return mObjectHandles.get(handle);
+}
+
+inline LLViewerObject *LLViewerObjectList::findObject(LLViewerObject::handle_t handle, const LLUUID &id)
+{
+    return handle.isNull() ? findObject(id) : mObjectHandles.get(handle);
+}
+
 inline LLViewerObject *LLViewerObjectList::getObject(const S32 index)
 {
     LLViewerObject *objectp;
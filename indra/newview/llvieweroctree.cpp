@@ -460,7 +460,13 @@ LLViewerOctreeGroup::~LLViewerOctreeGroup()
 LLViewerOctreeGroup::LLViewerOctreeGroup(OctreeNode* node)
 :   mOctreeNode(node),
     mAnyVisible(0),
-    mState(CLEAN)
+    mState(CLEAN),
+    mPrecullStamp(0),
+    mPrecullRes(-1),
+    mPrecullObjectRes(-1),
+    mShadowCullStamp(0),
+    mShadowCullRes(0xffff),
+    mShadowCullObjectRes(0xffff)
 {
     LLVector4a tmp;
     tmp.splat(0.f);
@@ -523,6 +529,8 @@ void LLViewerOctreeGroup::unbound()
     }
 
     setState(DIRTY);
+    mPrecullStamp = 0;
+    mShadowCullStamp = 0;
 
     //all the parent nodes need to rebound this child
     if (mOctreeNode)
@@ -537,6 +545,8 @@ void LLViewerOctreeGroup::unbound()
             }
 
             group->setState(DIRTY);
+            group->mPrecullStamp = 0;
+            group->mShadowCullStamp = 0;
             parent = (OctreeNode*) parent->getParent();
         }
     }
@@ -1345,6 +1355,9 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
 {
     LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
 
+    S32 batch_res = mChildRes;
+    mChildRes = -1;
+
     if (earlyFail(group))
     {
         return;
@@ -1357,9 +1370,22 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
     }
     else
     {
-        mRes = frustumCheck(group);
+        mRes = batch_res >= 0 ? batch_res : frustumCheck(group);
+
+        if (mRes == 1 && n->getChildCount() > 1)
+        { //partially in, check the children together on the way down
+            n->accept(this);
 
-        if (mRes)
+            S32 child_res[8];
+            bool batched = frustumCheckChildren(n, child_res);
+            for (U32 i = 0; i < n->getChildCount(); i++)
+            {
+                mChildRes = batched ? child_res[i] : -1;
+                traverse(n->getChild(i));
+            }
+            mChildRes = -1;
+        }
+        else if (mRes)
         { //at least partially in, run on down
             OctreeTraveler::traverse(n);
         }
@@ -1368,6 +1394,41 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
     }
 }
 
+//------------------------------------------
+//batched group culling, the bounds of all of branch's children at once
+static U32 gather_child_bounds(const OctreeNode* branch, LLVector4a* centers, LLVector4a* radii)
+{
+    U32 count = branch->getChildCount();
+    for (U32 i = 0; i < count; i++)
+    {
+        const LLVector4a* bounds = ((const LLViewerOctreeGroup*) branch->getChild(i)->getListener(0))->getBounds();
+        centers[i] = bounds[0];
+        radii[i] = bounds[1];
+    }
+    return count;
+}
+
+void LLViewerOctreeCull::AABBInFrustumNoFarClipChildBounds(const OctreeNode* branch, S32* results)
+{
+    LLVector4a centers[8], radii[8];
+    U32 count = gather_child_bounds(branch, centers, radii);
+    mCamera->AABBsInFrustumNoFarClip(centers, radii, count, results);
+}
+
+void LLViewerOctreeCull::AABBInFrustumChildBounds(const OctreeNode* branch, S32* results)
+{
+    LLVector4a centers[8], radii[8];
+    U32 count = gather_child_bounds(branch, centers, radii);
+    mCamera->AABBsInFrustum(centers, radii, count, results);
+}
+
+void LLViewerOctreeCull::AABBInRegionFrustumNoFarClipChildBounds(const OctreeNode* branch, S32* results)
+{
+    LLVector4a centers[8], radii[8];
+    U32 count = gather_child_bounds(branch, centers, radii);
+    mCamera->AABBsInRegionFrustumNoFarClip(centers, radii, count, results);
+}
+
 //------------------------------------------
 //agent space group culling
 S32 LLViewerOctreeCull::AABBInFrustumNoFarClipGroupBounds(const LLViewerOctreeGroup* group)
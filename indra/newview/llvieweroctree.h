@@ -267,6 +267,26 @@ protected:
     S32         mAnyVisible; //latest visible to any camera
     S32         mVisible[LLViewerCamera::NUM_CAMERAS];
 
+public:
+    // Frustum results for the next world camera cull, worked out ahead of
+    // time by LLSpatialPartition::precull(). Only valid while mPrecullStamp
+    // matches the precull's stamp; anything that moves the bounds clears it.
+    U32         mPrecullStamp;
+    S8          mPrecullRes;        //group bounds, -1 if not tested
+    S8          mPrecullObjectRes;  //object bounds, -1 if not tested
+
+    // Frustum results for each sun shadow cascade, all worked out in one
+    // walk by LLSpatialPartition::precullShadows(). Two bits per cascade,
+    // SHADOW_RES_UNTESTED where that cascade did not need the test. Only
+    // valid while mShadowCullStamp matches the walk's stamp.
+    U32         mShadowCullStamp;
+    U16         mShadowCullRes;         //group bounds
+    U16         mShadowCullObjectRes;   //object bounds
+
+    static const U16 SHADOW_RES_UNTESTED = 3;
+    static const U32 MAX_SHADOW_CAMERAS = 8;
+
+    S32 getShadowCullRes(U16 packed, U32 camera) const { return (packed >> (camera * 2)) & 3; }
 };//LL_ALIGN_POSTFIX(16);
 
 //octree group which has capability to support occlusion culling
@@ -370,7 +390,7 @@ class LLViewerOctreeCull : public OctreeTraveler
 {
 public:
     LLViewerOctreeCull(LLCamera* camera)
-        : mCamera(camera), mRes(0) { }
+        : mCamera(camera), mRes(0), mChildRes(-1) { }
 
     virtual void traverse(const OctreeNode* n);
 
@@ -397,9 +417,20 @@ protected:
     S32 AABBInRegionFrustumObjectBounds(const LLViewerOctreeGroup* group);
     S32 AABBRegionSphereIntersectObjectExtents(const LLViewerOctreeGroup* group, const LLVector3& shift);
 
+    //batched group culls, one result per child of branch
+    void AABBInFrustumNoFarClipChildBounds(const OctreeNode* branch, S32* results);
+    void AABBInFrustumChildBounds(const OctreeNode* branch, S32* results);
+    void AABBInRegionFrustumNoFarClipChildBounds(const OctreeNode* branch, S32* results);
+
     virtual S32 frustumCheck(const LLViewerOctreeGroup* group) = 0;
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group) = 0;
 
+    // Frustum check every child of a partly visible branch at once, giving
+    // exactly what frustumCheck() would for each. Cullers that override
+    // frustumCheck() must override this to match, or return false to have
+    // their children checked one at a time.
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results) { return false; }
+
     bool checkProjectionArea(const LLVector4a& center, const LLVector4a& size, const LLVector3& shift, F32 pixel_threshold, F32 near_radius);
     virtual bool checkObjects(const OctreeNode* branch, const LLViewerOctreeGroup* group);
     virtual void preprocess(LLViewerOctreeGroup* group);
@@ -409,6 +440,7 @@ protected:
 protected:
     LLCamera *mCamera;
     S32 mRes;
+    S32 mChildRes; //result from frustumCheckChildren() for the next group traversed, or -1
 };
 
 //scan the octree, output the info of each node for debug use.
@@ -47,11 +47,14 @@
 #include "llselectmgr.h"
 #include "llfloatertools.h"
 #include "llglheaders.h"
+#include "llparceloverlayutil.h"
 #include "pipeline.h"
 
 
 static const U8  OVERLAY_IMG_COMPONENTS = 4;
 static const F32 LINE_WIDTH = 0.0625f;
+// Cells colored per updateGL(); a whole 512m region at once, bigger ones over a few frames
+static const S32 OVERLAY_CELLS_PER_UPDATE = 128 * 128;
 
 LLViewerParcelOverlay::update_signal_t* LLViewerParcelOverlay::mUpdateSignal = NULL;
 
@@ -61,7 +64,10 @@ LLViewerParcelOverlay::LLViewerParcelOverlay(LLViewerRegion* region, F32 region_
     mRegionSize(S32(region_width_meters)),
     mDirty( FALSE ),
     mTimeSinceLastUpdate(),
-    mOverlayTextureIdx(-1)
+    mOverlayTextureIdx(-1),
+    mDirtyRowBegin(0),
+    mDirtyRowEnd(0),
+    mMinimapDirty(true)
 {
     // Create a texture to hold color information.
     // 4 components
@@ -90,6 +96,9 @@ LLViewerParcelOverlay::LLViewerParcelOverlay(LLViewerRegion* region, F32 region_
     {
         mOwnership[i] = PARCEL_PUBLIC;
     }
+    mEdgeMasks.resize(mParcelGridsPerEdge * mParcelGridsPerEdge, 0);
+    mEdgeRows.resize(mParcelGridsPerEdge);
+    mChunkReceived.resize(llmax(mRegionSize * mRegionSize / (128 * 128), 1), false);
 
     gPipeline.markGLRebuild(this);
 }
@@ -338,81 +347,26 @@ void LLViewerParcelOverlay::updateOverlayTexture()
     static const LLUIColor for_sale_color = LLUIColorTable::instance().getColor("PropertyColorForSale");
     static const LLUIColor auction_color = LLUIColorTable::instance().getColor("PropertyColorAuction");
 
-
-    const LLColor4U avail = avail_color.get();
-    const LLColor4U owned = owned_color.get();
-    const LLColor4U group = group_color.get();
-    const LLColor4U self  = self_color.get();
-    const LLColor4U for_sale  = for_sale_color.get();
-    const LLColor4U auction  = auction_color.get();
+    // Color stored in low three bits, unused values show as self
+    LLColor4U palette[PARCEL_COLOR_MASK + 1];
+    palette[PARCEL_PUBLIC] = avail_color.get();
+    palette[PARCEL_OWNED] = owned_color.get();
+    palette[PARCEL_GROUP] = group_color.get();
+    palette[PARCEL_SELF] = self_color.get();
+    palette[PARCEL_FOR_SALE] = for_sale_color.get();
+    palette[PARCEL_AUCTION] = auction_color.get();
+    for (S32 c = PARCEL_AUCTION + 1; c <= PARCEL_COLOR_MASK; ++c)
+    {
+        palette[c] = palette[PARCEL_SELF];
+    }
 
     // Create the base texture.
     U8 *raw = mImageRaw->getData();
     const S32 COUNT = mParcelGridsPerEdge * mParcelGridsPerEdge;
-    S32 max = mOverlayTextureIdx + mParcelGridsPerEdge;
-    if (max > COUNT) max = COUNT;
-    S32 pixel_index = mOverlayTextureIdx*OVERLAY_IMG_COMPONENTS;
-    S32 i;
-    for (i = mOverlayTextureIdx; i < max; i++)
-    {
-        U8 ownership = mOwnership[i];
-
-        F32 r,g,b,a;
-
-        // Color stored in low three bits
-        switch( ownership & 0x7 )
-        {
-        case PARCEL_PUBLIC:
-            r = avail.mV[VRED];
-            g = avail.mV[VGREEN];
-            b = avail.mV[VBLUE];
-            a = avail.mV[VALPHA];
-            break;
-        case PARCEL_OWNED:
-            r = owned.mV[VRED];
-            g = owned.mV[VGREEN];
-            b = owned.mV[VBLUE];
-            a = owned.mV[VALPHA];
-            break;
-        case PARCEL_GROUP:
-            r = group.mV[VRED];
-            g = group.mV[VGREEN];
-            b = group.mV[VBLUE];
-            a = group.mV[VALPHA];
-            break;
-        case PARCEL_SELF:
-            r = self.mV[VRED];
-            g = self.mV[VGREEN];
-            b = self.mV[VBLUE];
-            a = self.mV[VALPHA];
-            break;
-        case PARCEL_FOR_SALE:
-            r = for_sale.mV[VRED];
-            g = for_sale.mV[VGREEN];
-            b = for_sale.mV[VBLUE];
-            a = for_sale.mV[VALPHA];
-            break;
-        case PARCEL_AUCTION:
-            r = auction.mV[VRED];
-            g = auction.mV[VGREEN];
-            b = auction.mV[VBLUE];
-            a = auction.mV[VALPHA];
-            break;
-        default:
-            r = self.mV[VRED];
-            g = self.mV[VGREEN];
-            b = self.mV[VBLUE];
-            a = self.mV[VALPHA];
-            break;
-        }
-
-        raw[pixel_index + 0] = (U8)r;
-        raw[pixel_index + 1] = (U8)g;
-        raw[pixel_index + 2] = (U8)b;
-        raw[pixel_index + 3] = (U8)a;
-
-        pixel_index += OVERLAY_IMG_COMPONENTS;
-    }
+    S32 i = mOverlayTextureIdx + llmax(mParcelGridsPerEdge, OVERLAY_CELLS_PER_UPDATE);
+    if (i > COUNT) i = COUNT;
+    LLParcelOverlayUtil::colorCells(mOwnership + mOverlayTextureIdx, i - mOverlayTextureIdx, palette,
+                                    raw + mOverlayTextureIdx * OVERLAY_IMG_COMPONENTS);
 
     // Copy data into GL texture from raw data
     if (i >= COUNT)
@@ -435,13 +389,30 @@ void LLViewerParcelOverlay::uncompressLandOverlay(S32 chunk, U8 *packed_overlay)
 {
     // Unpack the message data into the ownership array
     S32 size    = mParcelGridsPerEdge * mParcelGridsPerEdge;
-    S32 mParcelOverLayChunks = mRegionSize * mRegionSize / (128 * 128);
+    S32 mParcelOverLayChunks = (S32)mChunkReceived.size();
     S32 chunk_size = size / mParcelOverLayChunks;
 
-    memcpy(mOwnership + chunk*chunk_size, packed_overlay, chunk_size);      /*Flawfinder: ignore*/
+    if (chunk < 0 || chunk >= mParcelOverLayChunks)
+    {
+        LL_WARNS() << "Parcel overlay chunk " << chunk << " out of range" << LL_ENDL;
+        return;
+    }
+
+    // The simulator resends every chunk when any parcel changes
+    U8* dest = mOwnership + chunk*chunk_size;
+    if (mChunkReceived[chunk] && !memcmp(dest, packed_overlay, chunk_size))
+    {
+        return;
+    }
+    mChunkReceived[chunk] = true;
+
+    memcpy(dest, packed_overlay, chunk_size);       /*Flawfinder: ignore*/
 
-    // Force property lines and overlay texture to update
-    setDirty();
+    // Force the chunk's property lines and overlay texture to update,
+    // and the row below, whose north edges are this chunk's south lines
+    S32 first_row = chunk * chunk_size / mParcelGridsPerEdge;
+    S32 end_row = ((chunk + 1) * chunk_size + mParcelGridsPerEdge - 1) / mParcelGridsPerEdge;
+    setRowsDirty(first_row - 1, end_row);
 }
 
 void LLViewerParcelOverlay::updatePropertyLines()
@@ -458,30 +429,27 @@ void LLViewerParcelOverlay::updatePropertyLines()
     colors[PARCEL_FOR_SALE] = LLUIColorTable::instance().getColor("PropertyColorForSale").get();
     colors[PARCEL_AUCTION] = LLUIColorTable::instance().getColor("PropertyColorAuction").get();
 
-    mEdges.clear();
-
     const F32 GRID_STEP = PARCEL_GRID_STEP_METERS;
     const S32 GRIDS_PER_EDGE = mParcelGridsPerEdge;
 
-    for (S32 row = 0; row < GRIDS_PER_EDGE; row++)
+    // Only the rows that changed since the last rebuild
+    LLParcelOverlayUtil::edgeMasks(mOwnership, GRIDS_PER_EDGE, mDirtyRowBegin, mDirtyRowEnd, mEdgeMasks.data());
+
+    for (S32 row = mDirtyRowBegin; row < mDirtyRowEnd; row++)
     {
+        EdgeRow& edges = mEdgeRows[row];
+        edges.vertices.clear();
+        edges.edges.clear();
+
         for (S32 col = 0; col < GRIDS_PER_EDGE; col++)
         {
-            U8 overlay = mOwnership[row*GRIDS_PER_EDGE+col];
-            S32 colorIndex = overlay & PARCEL_COLOR_MASK;
-            switch(colorIndex)
+            U8 mask = mEdgeMasks[row*GRIDS_PER_EDGE+col];
+            if (!mask)
             {
-            case PARCEL_SELF:
-            case PARCEL_GROUP:
-            case PARCEL_OWNED:
-            case PARCEL_FOR_SALE:
-            case PARCEL_AUCTION:
-                break;
-            default:
                 continue;
             }
 
-            const LLColor4U& color = colors[colorIndex];
+            const LLColor4U& color = colors[mOwnership[row*GRIDS_PER_EDGE+col] & PARCEL_COLOR_MASK];
 
             F32 left = col*GRID_STEP;
             F32 right = left+GRID_STEP;
@@ -490,43 +458,43 @@ void LLViewerParcelOverlay::updatePropertyLines()
             F32 top = bottom+GRID_STEP;
 
             // West edge
-            if (overlay & PARCEL_WEST_LINE)
+            if (mask & LLParcelOverlayUtil::EDGE_WEST)
             {
-                addPropertyLine(left, bottom, 0, 1, LINE_WIDTH, 0, color);
+                addPropertyLine(edges, left, bottom, 0, 1, LINE_WIDTH, 0, color);
             }
 
             // East edge
-            if (col == GRIDS_PER_EDGE - 1 || mOwnership[row * GRIDS_PER_EDGE + col + 1] & PARCEL_WEST_LINE)
+            if (mask & LLParcelOverlayUtil::EDGE_EAST)
             {
-                addPropertyLine(right, bottom, 0, 1, -LINE_WIDTH, 0, color);
+                addPropertyLine(edges, right, bottom, 0, 1, -LINE_WIDTH, 0, color);
             }
 
             // South edge
-            if (overlay & PARCEL_SOUTH_LINE)
+            if (mask & LLParcelOverlayUtil::EDGE_SOUTH)
             {
-                addPropertyLine(left, bottom, 1, 0, 0, LINE_WIDTH, color);
+                addPropertyLine(edges, left, bottom, 1, 0, 0, LINE_WIDTH, color);
             }
 
             // North edge
-            if (row == GRIDS_PER_EDGE - 1 || mOwnership[(row + 1) * GRIDS_PER_EDGE + col] & PARCEL_SOUTH_LINE)
+            if (mask & LLParcelOverlayUtil::EDGE_NORTH)
             {
-                addPropertyLine(left, top, 1, 0, 0, -LINE_WIDTH, color);
+                addPropertyLine(edges, left, top, 1, 0, 0, -LINE_WIDTH, color);
             }
         }
     }
 
     // Everything's clean now
+    mDirtyRowBegin = mDirtyRowEnd = 0;
     mDirty = FALSE;
 }
 
-void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F32 dy, F32 tick_dx, F32 tick_dy, const LLColor4U& color)
+void LLViewerParcelOverlay::addPropertyLine(EdgeRow& edges, F32 start_x, F32 start_y, F32 dx, F32 dy, F32 tick_dx, F32 tick_dy, const LLColor4U& color)
 {
     LLSurface& land = mRegion->getLand();
     F32 water_z = land.getWaterHeight();
 
-    mEdges.resize(mEdges.size() + 1);
-    Edge& edge = mEdges.back();
-    edge.color = color;
+    std::vector<LLVector3>& vertices = edges.vertices;
+    const U32 first = (U32)vertices.size();
 
     F32 outside_x = start_x;
     F32 outside_y = start_y;
@@ -540,18 +508,18 @@ void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F3
             F32 new_x = start.mV[0] + (x - start.mV[0]) * part;
             F32 new_y = start.mV[1] + (y - start.mV[1]) * part;
             F32 new_z = start.mV[2] + (z - start.mV[2]) * part;
-            edge.vertices.emplace_back(new_x, new_y, new_z);
+            vertices.emplace_back(new_x, new_y, new_z);
         };
 
     auto checkForSplit = [&]()
         {
-            const LLVector3& last_outside = edge.vertices.back();
+            const LLVector3& last_outside = vertices.back();
             F32 z0 = last_outside.mV[2];
             F32 z1 = outside_z;
             if ((z0 >= water_z && z1 >= water_z) || (z0 < water_z && z1 < water_z))
                 return;
             F32 part = (water_z - z0) / (z1 - z0);
-            const LLVector3& last_inside = edge.vertices[edge.vertices.size() - 2];
+            const LLVector3& last_inside = vertices[vertices.size() - 2];
             split(last_inside, inside_x, inside_y, inside_z, part);
             split(last_outside, outside_x, outside_y, outside_z, part);
         };
@@ -559,7 +527,7 @@ void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F3
     // First part, only one vertex
     outside_z = land.resolveHeightRegion( outside_x, outside_y );
 
-    edge.vertices.emplace_back(outside_x, outside_y, outside_z);
+    vertices.emplace_back(outside_x, outside_y, outside_z);
 
     inside_x += dx * LINE_WIDTH;
     inside_y += dy * LINE_WIDTH;
@@ -571,8 +539,8 @@ void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F3
     inside_z = land.resolveHeightRegion( inside_x, inside_y );
     outside_z = land.resolveHeightRegion( outside_x, outside_y );
 
-    edge.vertices.emplace_back(inside_x, inside_y, inside_z);
-    edge.vertices.emplace_back(outside_x, outside_y, outside_z);
+    vertices.emplace_back(inside_x, inside_y, inside_z);
+    vertices.emplace_back(outside_x, outside_y, outside_z);
 
     inside_x += dx * (dx - LINE_WIDTH);
     inside_y += dy * (dy - LINE_WIDTH);
@@ -589,8 +557,8 @@ void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F3
 
         checkForSplit();
 
-        edge.vertices.emplace_back(inside_x, inside_y, inside_z);
-        edge.vertices.emplace_back(outside_x, outside_y, outside_z);
+        vertices.emplace_back(inside_x, inside_y, inside_z);
+        vertices.emplace_back(outside_x, outside_y, outside_z);
 
         inside_x += dx;
         inside_y += dy;
@@ -611,8 +579,8 @@ void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F3
 
     checkForSplit();
 
-    edge.vertices.emplace_back(inside_x, inside_y, inside_z);
-    edge.vertices.emplace_back(outside_x, outside_y, outside_z);
+    vertices.emplace_back(inside_x, inside_y, inside_z);
+    vertices.emplace_back(outside_x, outside_y, outside_z);
 
     outside_x += dx * LINE_WIDTH;
     outside_y += dy * LINE_WIDTH;
@@ -620,11 +588,32 @@ void LLViewerParcelOverlay::addPropertyLine(F32 start_x, F32 start_y, F32 dx, F3
     // Last edge is not drawn to the edge
     outside_z = land.resolveHeightRegion( outside_x, outside_y );
 
-    edge.vertices.emplace_back(outside_x, outside_y, outside_z);
+    vertices.emplace_back(outside_x, outside_y, outside_z);
+
+    Edge edge;
+    edge.first = first;
+    edge.count = (U32)vertices.size() - first;
+    edge.color = color;
+    edges.edges.push_back(edge);
 }
 
 void LLViewerParcelOverlay::setDirty()
 {
+    setRowsDirty(0, mParcelGridsPerEdge);
+}
+
+void LLViewerParcelOverlay::setRowsDirty(S32 first_row, S32 end_row)
+{
+    first_row = llmax(first_row, 0);
+    end_row = llmin(end_row, mParcelGridsPerEdge);
+    if (mDirtyRowBegin < mDirtyRowEnd)
+    {
+        first_row = llmin(first_row, mDirtyRowBegin);
+        end_row = llmax(end_row, mDirtyRowEnd);
+    }
+    mDirtyRowBegin = first_row;
+    mDirtyRowEnd = end_row;
+    mMinimapDirty = true;
     mDirty = TRUE;
 }
 
@@ -713,83 +702,70 @@ void LLViewerParcelOverlay::renderPropertyLines()
 
     const F32 PROPERTY_LINE_CLIP_DIST_SQUARED = 256.f * 256.f;
 
-    for (const Edge& edge : mEdges)
+    for (const EdgeRow& edges : mEdgeRows)
     {
-        LLVector3 center = edge.vertices[edge.vertices.size() >> 1];
-
-        if (dist_vec_squared2D(center, camera_region) > PROPERTY_LINE_CLIP_DIST_SQUARED)
+        for (const Edge& edge : edges.edges)
         {
-            continue;
-        }
+            const LLVector3* vertices = edges.vertices.data() + edge.first;
+            const LLVector3* vertices_end = vertices + edge.count;
 
-        // Destroy vertex, transform to plane-local.
-        center -= cull_plane_point;
+            LLVector3 center = vertices[edge.count >> 1];
 
-        // Negative dot product means it is in back of the plane
-        if (center * CAMERA_AT < 0.f)
-        {
-            continue;
-        }
-
-        gGL.begin(LLRender::TRIANGLE_STRIP);
-
-        gGL.color4ubv(edge.color.mV);
-
-        for (const LLVector3& vertex : edge.vertices)
-        {
-            if (render_hidden || camera_z < water_z || vertex.mV[2] >= water_z)
+            if (dist_vec_squared2D(center, camera_region) > PROPERTY_LINE_CLIP_DIST_SQUARED)
             {
-                gGL.vertex3fv(vertex.mV);
-            }
-            else
-            {
-                LLVector3 visible = vertex;
-                visible.mV[2] = water_z;
-                gGL.vertex3fv(visible.mV);
+                continue;
             }
-        }
 
-        gGL.end();
+            // Destroy vertex, transform to plane-local.
+            center -= cull_plane_point;
 
-        if (render_hidden)
-        {
-            LLGLDepthTest depth(GL_TRUE, GL_FALSE, GL_GREATER);
+            // Negative dot product means it is in back of the plane
+            if (center * CAMERA_AT < 0.f)
+            {
+                continue;
+            }
 
             gGL.begin(LLRender::TRIANGLE_STRIP);
 
-            LLColor4U color = edge.color;
-            color.mV[3] /= 4;
-            gGL.color4ubv(color.mV);
+            gGL.color4ubv(edge.color.mV);
 
-            for (const LLVector3& vertex : edge.vertices)
+            for (const LLVector3* vertex = vertices; vertex != vertices_end; ++vertex)
             {
-                gGL.vertex3fv(vertex.mV);
+                if (render_hidden || camera_z < water_z || vertex->mV[2] >= water_z)
+                {
+                    gGL.vertex3fv(vertex->mV);
+                }
+                else
+                {
+                    LLVector3 visible = *vertex;
+                    visible.mV[2] = water_z;
+                    gGL.vertex3fv(visible.mV);
+                }
             }
 
             gGL.end();
-        }
-    }
 
-    gGL.popMatrix();
-}
+            if (render_hidden)
+            {
+                LLGLDepthTest depth(GL_TRUE, GL_FALSE, GL_GREATER);
 
-// Draw half of a single cell (no fill) in a grid drawn from left to right and from bottom to top
-void grid_2d_part_lines(const F32 left, const F32 top, const F32 right, const F32 bottom, bool has_left, bool has_bottom)
-{
-    gGL.begin(LLRender::LINES);
+                gGL.begin(LLRender::TRIANGLE_STRIP);
 
-    if (has_left)
-    {
-        gGL.vertex2f(left, bottom);
-        gGL.vertex2f(left, top);
-    }
-    if (has_bottom)
-    {
-        gGL.vertex2f(left, bottom);
-        gGL.vertex2f(right, bottom);
+                LLColor4U color = edge.color;
+                color.mV[3] /= 4;
+                gGL.color4ubv(color.mV);
+
+                for (const LLVector3* vertex = vertices; vertex != vertices_end; ++vertex)
+                {
+                    gGL.vertex3fv(vertex->mV);
+                }
+
+                gGL.end();
+            }
+        }
     }
 
-    gGL.end();
+    gGL.popMatrix();
 }
 
 void LLViewerParcelOverlay::renderPropertyLinesOnMinimap(F32 scale_pixels_per_meter, const F32 *parcel_outline_color)
@@ -801,33 +777,28 @@ void LLViewerParcelOverlay::renderPropertyLinesOnMinimap(F32 scale_pixels_per_me
         return;
     }
 
+    // Merged runs of cell edges, rebuilt only when the ownership data changes
+    if (mMinimapDirty)
+    {
+        LLParcelOverlayUtil::minimapLines(mOwnership, mParcelGridsPerEdge, PARCEL_GRID_STEP_METERS, mMinimapLines);
+        mMinimapDirty = false;
+    }
+
     LLVector3 origin_agent     = mRegion->getOriginAgent();
     LLVector3 rel_region_pos   = origin_agent - gAgentCamera.getCameraPositionAgent();
     F32       region_left      = rel_region_pos.mV[0] * scale_pixels_per_meter;
     F32       region_bottom    = rel_region_pos.mV[1] * scale_pixels_per_meter;
-    F32       map_parcel_width = PARCEL_GRID_STEP_METERS * scale_pixels_per_meter;
-    const S32 GRIDS_PER_EDGE   = mParcelGridsPerEdge;
 
     gGL.getTexUnit(0)->unbind(LLTexUnit::TT_TEXTURE);
     glLineWidth(1.0f);
     gGL.color4fv(parcel_outline_color);
-    for (S32 i = 0; i <= GRIDS_PER_EDGE; i++)
+    gGL.begin(LLRender::LINES);
+    for (const LLVector2& point : mMinimapLines)
     {
-        const F32 bottom = region_bottom + (i * map_parcel_width);
-        const F32 top    = bottom + map_parcel_width;
-        for (S32 j = 0; j <= GRIDS_PER_EDGE; j++)
-        {
-            const F32  left               = region_left + (j * map_parcel_width);
-            const F32  right              = left + map_parcel_width;
-            const bool is_region_boundary = i == GRIDS_PER_EDGE || j == GRIDS_PER_EDGE;
-            const U8   overlay            = is_region_boundary ? 0 : mOwnership[(i * GRIDS_PER_EDGE) + j];
-            // The property line vertices are three-dimensional, but here we only care about the x and y coordinates, as we are drawing on a
-            // 2D map
-            const bool has_left   = i != GRIDS_PER_EDGE && (j == GRIDS_PER_EDGE || (overlay & PARCEL_WEST_LINE));
-            const bool has_bottom = j != GRIDS_PER_EDGE && (i == GRIDS_PER_EDGE || (overlay & PARCEL_SOUTH_LINE));
-            grid_2d_part_lines(left, top, right, bottom, has_left, has_bottom);
-        }
+        gGL.vertex2f(region_left + point.mV[VX] * scale_pixels_per_meter,
+                     region_bottom + point.mV[VY] * scale_pixels_per_meter);
     }
+    gGL.end();
 }
 
 boost::signals2::connection LLViewerParcelOverlay::setUpdateCallback(const update_signal_t::slot_type& cb)
@@ -33,6 +33,7 @@
 #include "llbbox.h"
 #include "llframetimer.h"
 #include "lluuid.h"
+#include "v2math.h"
 #include "llviewertexture.h"
 #include "llgl.h"
 
@@ -96,11 +97,15 @@ private:
 
     U8      parcelFlags(S32 row, S32 col, U8 flags) const;
 
-    void    addPropertyLine(F32 start_x, F32 start_y, F32 dx, F32 dy, F32 tick_dx, F32 tick_dy, const LLColor4U& color);
+    struct EdgeRow;
+    void    addPropertyLine(EdgeRow& edges, F32 start_x, F32 start_y, F32 dx, F32 dy, F32 tick_dx, F32 tick_dy, const LLColor4U& color);
 
     void    updateOverlayTexture();
     void    updatePropertyLines();
 
+    // Rows [first_row, end_row) need their property lines rebuilt.
+    void    setRowsDirty(S32 first_row, S32 end_row);
+
 private:
     // Back pointer to the region that owns this structure.
     LLViewerRegion* mRegion;
@@ -121,13 +126,36 @@ private:
     LLFrameTimer    mTimeSinceLastUpdate;
     S32             mOverlayTextureIdx;
 
+    // Property lines dirtied since the last rebuild, by row
+    S32             mDirtyRowBegin;
+    S32             mDirtyRowEnd;
+    // Chunks of ownership data received from the simulator so far
+    std::vector<bool> mChunkReceived;
+
+    // LLParcelOverlayUtil::EDGE_* for each cell
+    std::vector<U8> mEdgeMasks;
+
+    // A triangle strip of vertices in its row
     struct Edge
     {
-        std::vector<LLVector3> vertices;
+        U32 first;
+        U32 count;
         LLColor4U color;
     };
 
-    std::vector<Edge> mEdges;
+    // Property lines are kept per grid row, so that an overlay update only
+    // rebuilds the rows it changed.
+    struct EdgeRow
+    {
+        std::vector<LLVector3> vertices;
+        std::vector<Edge> edges;
+    };
+
+    std::vector<EdgeRow> mEdgeRows;
+
+    // Pairs of points in region meters
+    std::vector<LLVector2> mMinimapLines;
+    bool            mMinimapDirty;
 
     static update_signal_t* mUpdateSignal;
 };
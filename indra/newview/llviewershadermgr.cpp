@@ -158,6 +158,7 @@ LLGLSLShader            gDeferredLightProgram;
 LLGLSLShader            gDeferredMultiLightProgram[16];
 LLGLSLShader            gDeferredSpotLightProgram;
 LLGLSLShader            gDeferredMultiSpotLightProgram;
+LLGLSLShader            gDeferredClusteredLightProgram;
 LLGLSLShader            gDeferredSunProgram;
 LLGLSLShader            gHazeProgram;
 LLGLSLShader            gHazeWaterProgram;
@@ -967,6 +968,7 @@ BOOL LLViewerShaderMgr::loadShadersDeferred()
         }
         gDeferredSpotLightProgram.unload();
         gDeferredMultiSpotLightProgram.unload();
+        gDeferredClusteredLightProgram.unload();
         gDeferredSunProgram.unload();
         gDeferredBlurLightProgram.unload();
         gDeferredSoftenProgram.unload();
@@ -1500,6 +1502,32 @@ BOOL LLViewerShaderMgr::loadShadersDeferred()
         llassert(success);
     }
 
+    if (success)
+    {
+        gDeferredClusteredLightProgram.mName = "Deferred Clustered Light Shader";
+        gDeferredClusteredLightProgram.mFeatures.isDeferred = true;
+        gDeferredClusteredLightProgram.mFeatures.hasShadows = true;
+        gDeferredClusteredLightProgram.mFeatures.hasSrgb = true;
+
+        gDeferredClusteredLightProgram.clearPermutations();
+        gDeferredClusteredLightProgram.addPermutation("MAX_CLUSTERED_LIGHTS", llformat("%d", LLPipeline::MAX_CLUSTERED_LIGHTS));
+        gDeferredClusteredLightProgram.addPermutation("CLUSTER_TILES_X", llformat("%d", LLLightClusters::TILES_X));
+        gDeferredClusteredLightProgram.addPermutation("CLUSTER_TILES_Y", llformat("%d", LLLightClusters::TILES_Y));
+        gDeferredClusteredLightProgram.addPermutation("CLUSTER_SLICES", llformat("%d", LLLightClusters::SLICES));
+        gDeferredClusteredLightProgram.addPermutation("CLUSTER_INDEX_WIDTH", llformat("%d", LLPipeline::CLUSTER_INDEX_WIDTH));
+        gDeferredClusteredLightProgram.mShaderFiles.clear();
+        gDeferredClusteredLightProgram.mShaderFiles.push_back(make_pair("deferred/multiPointLightV.glsl", GL_VERTEX_SHADER));
+        gDeferredClusteredLightProgram.mShaderFiles.push_back(make_pair("deferred/clusteredLightF.glsl", GL_FRAGMENT_SHADER));
+        gDeferredClusteredLightProgram.mShaderLevel = mShaderLevel[SHADER_DEFERRED];
+
+        // optional: without it, local lights use the per light passes
+        if (!gDeferredClusteredLightProgram.createShader(NULL, NULL))
+        {
+            LL_WARNS("ShaderLoading") << "Clustered lighting unavailable" << LL_ENDL;
+            gDeferredClusteredLightProgram.unload();
+        }
+    }
+
     if (success)
     {
         std::string fragment;
@@ -32,11 +32,15 @@
 #include "message.h"
 #include "llfloaterreg.h"
 #include "llmemory.h"
+#include "llmemtag.h"
+#include "llslaballocator.h"
 #include "lltimer.h"
 
 #include "llappviewer.h"
 
 #include "pipeline.h"
+#include "llspatialpartition.h"
+#include "llglslshader.h"
 #include "lltexturefetch.h"
 #include "llviewerobjectlist.h"
 #include "llviewertexturelist.h"
@@ -52,6 +56,7 @@
 #include "lldebugview.h"
 #include "llfasttimerview.h"
 #include "llviewerregion.h"
+#include "llviewerjointmesh.h"
 #include "llvoavatar.h"
 #include "llvoavatarself.h"
 #include "llworld.h"
@@ -147,6 +152,20 @@ LLTrace::CountStatHandle<LLUnit<F64, LLUnits::Kilotriangles> >
 LLTrace::EventStatHandle<LLUnit<F64, LLUnits::Kilotriangles> >
                             TRIANGLES_DRAWN_PER_FRAME("trianglesdrawnperframestat");
 
+LLTrace::EventStatHandle<>  UNIFORM_UPDATES_PER_FRAME("uniformupdatesperframestat", "Number of glUniform calls made in the last frame");
+
+LLTrace::EventStatHandle<>  DRAW_INFO_ALLOCS_PER_FRAME("drawinfoallocsperframe", "Number of draw batches allocated in the last frame"),
+                            DRAW_INFO_REUSED_PER_FRAME("drawinforeusedperframe", "Number of draw batches reinitialized in place in the last frame"),
+                            FACE_ALLOCS_PER_FRAME("faceallocsperframe", "Number of faces allocated in the last frame"),
+                            DRAWABLE_ALLOCS_PER_FRAME("drawableallocsperframe", "Number of drawables allocated in the last frame"),
+                            SPATIAL_GROUP_ALLOCS_PER_FRAME("spatialgroupallocsperframe", "Number of spatial groups allocated in the last frame"),
+                            DEFERRED_LIGHTS_PER_FRAME("deferredlightsperframe", "Number of local lights shaded in the last frame");
+
+LLTrace::SampleStatHandle<F64Megabytes > SLAB_RETAINED_MEM("slabretainedmem", "Memory held in slabs for draw batches, faces, drawables and spatial groups, in use or free");
+
+LLTrace::EventStatHandle<F64Milliseconds >  DEFERRED_LIGHTING_TIME("deferredlightingtime", "GPU time spent shading local lights"),
+                                            AVATAR_BODY_FILL_TIME("avatarbodyfilltime", "Main thread time spent waiting on avatar body vertex copies in the last frame");
+
 LLTrace::CountStatHandle<F64Kilobytes >
                             ACTIVE_MESSAGE_DATA_RECEIVED("activemessagedatareceived", "Message system data received on all active regions"),
                             LAYERS_NETWORK_DATA_RECEIVED("layersdatareceived", "Network data received for layer data (terrain)"),
@@ -188,8 +207,12 @@ LLTrace::SampleStatHandle<> FPS_SAMPLE("fpssample"),
                             NUM_IMAGES("numimagesstat"),
                             NUM_RAW_IMAGES("numrawimagesstat"),
                             NUM_MATERIALS("nummaterials"),
+                            NUM_MATERIAL_OVERRIDES("nummaterialoverrides", "Distinct GLTF material overrides"),
+                            NUM_MATERIAL_OVERRIDE_USES("nummaterialoverrideuses", "Faces sharing GLTF material overrides"),
                             NUM_OBJECTS("numobjectsstat"),
                             NUM_ACTIVE_OBJECTS("numactiveobjectsstat"),
+                            NUM_DEAD_OBJECTS("numdeadobjects", "Killed objects waiting to be deleted"),
+                            NUM_DEAD_VIEWS("numdeadviews", "Closed views waiting to be deleted"),
                             ENABLE_VBO("enablevbo", "Vertex Buffers Enabled"),
                             VISIBLE_AVATARS("visibleavatars", "Visible Avatars"),
                             SHADER_OBJECTS("shaderobjects", "Object Shaders"),
@@ -229,6 +252,8 @@ SimMeasurement<F64Megabytes >   SIM_PHYSICS_MEM("physicsmemoryallocated", "", LL
 LLTrace::SampleStatHandle<F64Milliseconds > FRAMETIME_JITTER("frametimejitter", "Average delta between successive frame times"),
                                             FRAMETIME_SLEW("frametimeslew", "Average delta between frame time and mean"),
                                             FRAMETIME("frametime", "Measured frame time"),
+                                            CULL_TIME("culltime", "Octree culling time per frame, all cameras"),
+                                            SHADOW_CULL_TIME("shadowculltime", "Octree culling time per frame, sun shadow cascades only"),
                                             SIM_PING("simpingstat");
 
 LLTrace::EventStatHandle<LLUnit<F64, LLUnits::Meters> > AGENT_POSITION_SNAP("agentpositionsnap", "agent position corrections");
@@ -254,6 +279,8 @@ LLTrace::EventStatHandle<LLUnit<F32, LLUnits::Percent> > OBJECT_CACHE_HIT_RATE("
 
 LLTrace::EventStatHandle<F64Seconds >   TEXTURE_FETCH_TIME("texture_fetch_time");
 
+LLTrace::EventStatHandle<F64Seconds >   MESH_FIRST_GEOMETRY_TIME("mesh_first_geometry_time", "Seconds from requesting a mesh until some LOD of it can be drawn");
+
 LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> >  SCENERY_FRAME_PCT("scenery_frame_pct");
 LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> >  AVATAR_FRAME_PCT("avatar_frame_pct");
 LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> >  HUDS_FRAME_PCT("huds_frame_pct");
@@ -262,6 +289,47 @@ LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> >  SWAP_FRAME_PCT("swap_
 LLTrace::SampleStatHandle<LLUnit<F32, LLUnits::Percent> >  IDLE_FRAME_PCT("idle_frame_pct");
 }
 
+namespace
+{
+    // Live and allocated bytes for one LLMemTag, as stats named
+    // "memtag_<tag>" and "memtag_<tag>_alloc"
+    struct MemTagStats
+    {
+        MemTagStats(LLMemTag::ETag tag)
+        :   mTag(tag),
+            mLiveBytes(("memtag_" + std::string(LLMemTag::getName(tag))).c_str(), "Live memory owned by this subsystem"),
+            mAllocatedBytes(("memtag_" + std::string(LLMemTag::getName(tag)) + "_alloc").c_str(), "Memory allocated by this subsystem")
+        {}
+
+        const LLMemTag::ETag mTag;
+        LLTrace::SampleStatHandle<F64Megabytes> mLiveBytes;
+        LLTrace::CountStatHandle<F64Megabytes> mAllocatedBytes;
+        U64 mLastAllocatedBytes = 0;
+    };
+
+    std::vector<std::unique_ptr<MemTagStats>> make_mem_tag_stats()
+    {
+        std::vector<std::unique_ptr<MemTagStats>> stats;
+        for (U32 tag = 0; tag < LLMemTag::COUNT; ++tag)
+        {
+            stats.emplace_back(std::make_unique<MemTagStats>((LLMemTag::ETag)tag));
+        }
+        return stats;
+    }
+
+    std::vector<std::unique_ptr<MemTagStats>> sMemTagStats = make_mem_tag_stats();
+
+    // allocations made by a slab allocated class since the last call
+    template<typename T, size_t ALIGNMENT>
+    F64 slab_allocs_since(U64& last_allocations)
+    {
+        U64 allocations = LLSlabAllocator<T, ALIGNMENT>::getStats().mAllocations;
+        F64 delta = (F64)(allocations - last_allocations);
+        last_allocations = allocations;
+        return delta;
+    }
+}
+
 LLViewerStats::LLViewerStats()
 :   mLastTimeDiff(0.0)
 {
@@ -315,6 +383,8 @@ void LLViewerStats::updateFrameStats(const F64Seconds time_diff)
         add(LLStatViewer::FRAMETIME_DOUBLED, time_diff >= 2.0 * mLastTimeDiff ? 1 : 0);
 
         sample(LLStatViewer::FRAMETIME, time_diff);
+        sample(LLStatViewer::CULL_TIME, F64Seconds(gPipeline.resetCullTime()));
+        sample(LLStatViewer::SHADOW_CULL_TIME, F64Seconds(gPipeline.resetShadowCullTime()));
 
         // old stats that were never really used
         F64Seconds jit = (F64Seconds) std::fabs((mLastTimeDiff - time_diff));
@@ -399,6 +469,34 @@ void update_statistics()
 
     record(LLStatViewer::TRIANGLES_DRAWN_PER_FRAME, last_frame_recording.getSum(LLStatViewer::TRIANGLES_DRAWN));
 
+    record(LLStatViewer::UNIFORM_UPDATES_PER_FRAME, (F64)LLGLSLShader::sUniformUpdates);
+    LLGLSLShader::resetUniformUpdates();
+
+    for (auto& mem_stats : sMemTagStats)
+    {
+        LLMemTag::Stats tag_stats = LLMemTag::getStats(mem_stats->mTag);
+        sample(mem_stats->mLiveBytes, F64Bytes((F64)tag_stats.mLiveBytes));
+        add(mem_stats->mAllocatedBytes, F64Bytes((F64)(tag_stats.mAllocatedBytes - mem_stats->mLastAllocatedBytes)));
+        mem_stats->mLastAllocatedBytes = tag_stats.mAllocatedBytes;
+    }
+
+    static U64 last_draw_info_allocs = 0, last_face_allocs = 0, last_drawable_allocs = 0, last_group_allocs = 0;
+    record(LLStatViewer::DRAW_INFO_ALLOCS_PER_FRAME, slab_allocs_since<LLDrawInfo, 16>(last_draw_info_allocs));
+    record(LLStatViewer::DRAW_INFO_REUSED_PER_FRAME, (F64)LLSpatialGroup::sDrawInfoReused);
+    LLSpatialGroup::sDrawInfoReused = 0;
+    record(LLStatViewer::FACE_ALLOCS_PER_FRAME, slab_allocs_since<LLFace, 16>(last_face_allocs));
+    record(LLStatViewer::DRAWABLE_ALLOCS_PER_FRAME, slab_allocs_since<LLDrawable, 16>(last_drawable_allocs));
+    record(LLStatViewer::SPATIAL_GROUP_ALLOCS_PER_FRAME, slab_allocs_since<LLSpatialGroup, 64>(last_group_allocs));
+    sample(LLStatViewer::SLAB_RETAINED_MEM, F64Bytes((F64)(LLSlabAllocator<LLDrawInfo, 16>::getStats().mRetainedBytes
+                                                          + LLSlabAllocator<LLFace, 16>::getStats().mRetainedBytes
+                                                          + LLSlabAllocator<LLDrawable, 16>::getStats().mRetainedBytes
+                                                          + LLSlabAllocator<LLSpatialGroup, 64>::getStats().mRetainedBytes)));
+
+    record(LLStatViewer::DEFERRED_LIGHTS_PER_FRAME, (F64)gPipeline.mDeferredLightCount);
+    record(LLStatViewer::DEFERRED_LIGHTING_TIME, F64Milliseconds(gPipeline.mDeferredLightingTime));
+    record(LLStatViewer::AVATAR_BODY_FILL_TIME, F64Milliseconds(LLViewerJointMesh::getFillTime()));
+    LLViewerJointMesh::resetFillTime();
+
     sample(LLStatViewer::ENABLE_VBO,      (F64)TRUE);
     sample(LLStatViewer::DRAW_DISTANCE,   (F64)LLPipeline::RenderFarClip);
 
@@ -181,7 +181,11 @@ extern LLTrace::SampleStatHandle<>      FPS_SAMPLE,
                                         NUM_RAW_IMAGES,
                                         NUM_OBJECTS,
                                         NUM_MATERIALS,
+                                        NUM_MATERIAL_OVERRIDES,
+                                        NUM_MATERIAL_OVERRIDE_USES,
                                         NUM_ACTIVE_OBJECTS,
+                                        NUM_DEAD_OBJECTS,
+                                        NUM_DEAD_VIEWS,
                                         ENABLE_VBO,
                                         LIGHTING_DETAIL,
                                         VISIBLE_AVATARS,
@@ -217,6 +221,8 @@ extern SimMeasurement<F64Megabytes >    SIM_PHYSICS_MEM;
 
 extern LLTrace::SampleStatHandle<F64Milliseconds >  FRAMETIME_JITTER,
                                                     FRAMETIME_SLEW,
+                                                    CULL_TIME,
+                                                    SHADOW_CULL_TIME,
                                                     SIM_PING;
 
 extern LLTrace::EventStatHandle<LLUnit<F64, LLUnits::Meters> > AGENT_POSITION_SNAP;
@@ -240,6 +246,8 @@ extern LLTrace::EventStatHandle<F64Seconds >    AVATAR_EDIT_TIME,
 
 extern LLTrace::EventStatHandle<LLUnit<F32, LLUnits::Percent> > OBJECT_CACHE_HIT_RATE;
 
+extern LLTrace::EventStatHandle<F64Seconds >    MESH_FIRST_GEOMETRY_TIME;
+
 }
 
 class LLViewerStats final : public LLSingleton<LLViewerStats>
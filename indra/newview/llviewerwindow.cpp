@@ -6718,6 +6718,7 @@ void LLPickInfo::fetchResults()
             // Hit land
             mPickType = PICK_LAND;
             mObjectID.setNull(); // land has no id
+            mObjectHandle = LLHandleTable<LLViewerObject>::Handle();
 
             // put global position into land_pos
             LLVector3d land_pos;
@@ -6746,6 +6747,7 @@ void LLPickInfo::fetchResults()
 
             mObjectOffset = gAgentCamera.calcFocusOffset(objectp, v_intersection, mPickPt.mX, mPickPt.mY);
             mObjectID = objectp->mID;
+            mObjectHandle = objectp->getHandle();
             mObjectFace = (te_offset == NO_FACE) ? -1 : (S32)te_offset;
 
 
@@ -6779,7 +6781,9 @@ void LLPickInfo::fetchResults()
 
 LLPointer<LLViewerObject> LLPickInfo::getObject() const
 {
-    return gObjectList.findObject( mObjectID );
+    // Hover picks ask for this several times a frame. Picks made up
+    // without a handle still go by the UUID.
+    return gObjectList.findObject(mObjectHandle, mObjectID);
 }
 
 void LLPickInfo::updateXYCoords()
@@ -44,6 +44,7 @@
 #include "llmousehandler.h"
 #include "llnotifications.h"
 #include "llhandle.h"
+#include "llhandletable.h"
 #include "llinitparam.h"
 #include "lltrace.h"
 #include "llsnapshotmodel.h"
@@ -118,6 +119,7 @@ public:
     LLVector3d      mPosGlobal;
     LLVector3       mObjectOffset;
     LLUUID          mObjectID;
+    LLHandleTable<LLViewerObject>::Handle mObjectHandle; // resolves mObjectID without a map lookup
     LLUUID          mParticleOwnerID;
     LLUUID          mParticleSourceID;
     S32             mObjectFace;
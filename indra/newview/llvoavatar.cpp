@@ -88,6 +88,7 @@
 #include "llviewercamera.h"
 #include "llviewertexlayer.h"
 #include "llviewertexturelist.h"
+#include "llviewerjointmesh.h"
 #include "llviewermenu.h"
 #include "llviewernetwork.h"
 #include "llviewerobjectlist.h"
@@ -2437,7 +2438,15 @@ void LLVOAvatar::updateMeshData()
             }
 
             stop_glerror();
-            buff->unmapBuffer();
+            if (LLViewerJointMesh::isFillBatchOpen())
+            {
+                // the copies into buff may still be running
+                LLViewerJointMesh::deferUnmap(buff);
+            }
+            else
+            {
+                buff->unmapBuffer();
+            }
 
             if(!f_num)
             {
@@ -11455,9 +11464,10 @@ void LLVOAvatar::calculateUpdateRenderComplexity()
             !isVisuallyMuted())
         {
             LLUUID id = getID(); // <== use id to make sure this avatar didn't get deleted between frames
-            LL::WorkQueue::getInstance("mainloop")->post([this, id]()
+            handle_t handle = getHandle();
+            LL::WorkQueue::getInstance("mainloop")->post([this, handle, id]()
                 {
-                    if (gObjectList.findObject(id) != nullptr)
+                    if (gObjectList.findObject(handle, id) == this)
                     {
                         gPipeline.profileAvatar(this);
                     }
@@ -96,7 +96,7 @@ class LLVOAvatar :
     public LLViewerObject,
     public boost::signals2::trackable
 {
-    LL_ALIGN_NEW;
+    LL_ALIGN_NEW_TAGGED(LLMemTag::AVATAR);
     LOG_CLASS(LLVOAvatar);
 
 public:
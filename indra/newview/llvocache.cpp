@@ -33,6 +33,7 @@
 #include "llviewerregion.h"
 #include "llagentcamera.h"
 #include "llsdserialize.h"
+#include "llgltfmateriallist.h"
 #include "llworld.h" // For LLWorld::getInstance()
 //static variables
 U32 LLVOCacheEntry::sMinFrameRange = 0;
@@ -104,9 +105,9 @@ bool LLGLTFOverrideCacheEntry::fromLLSD(const LLSD& data)
             {
                 S32 side_idx = sides[i].asInteger();
                 mSides[side_idx] = gltf_llsd[i];
-                LLGLTFMaterial* override_mat = new LLGLTFMaterial();
+                LLPointer<LLGLTFMaterial> override_mat = new LLGLTFMaterial();
                 override_mat->applyOverrideLLSD(gltf_llsd[i]);
-                mGLTFMaterial[side_idx] = override_mat;
+                mGLTFMaterial[side_idx] = gGLTFMaterialList.internOverride(override_mat);
             }
         }
         else
@@ -819,6 +820,20 @@ public:
         return res;
     }
 
+    virtual bool frustumCheckChildren(const OctreeNode* branch, S32* results)
+    {
+        AABBInRegionFrustumNoFarClipChildBounds(branch, results);
+        for (U32 i = 0; i < branch->getChildCount(); i++)
+        {
+            if (results[i] != 0)
+            {
+                const LLViewerOctreeGroup* group = (const LLViewerOctreeGroup*) branch->getChild(i)->getListener(0);
+                results[i] = llmin(results[i], AABBRegionSphereIntersectGroupExtents(group, mLocalShift));
+            }
+        }
+        return true;
+    }
+
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group)
     {
 #if 0
@@ -408,6 +408,12 @@ void LLVivoxVoiceClient::init(LLPumpIO *pump)
     // constructor will set up LLVoiceClient::getInstance()
     sPump = pump;
 
+    std::string replay_file = gSavedSettings.getString("VivoxStreamReplayFile");
+    if (!replay_file.empty())
+    {
+        LLVivoxProtocolParser::replay(replay_file);
+    }
+
 //     LLCoros::instance().launch("LLVivoxVoiceClient::voiceControlCoro",
 //         boost::bind(&LLVivoxVoiceClient::voiceControlCoro, LLVivoxVoiceClient::getInstance()));
 
@@ -707,6 +713,8 @@ void LLVivoxVoiceClient::setLoginInfo(
 
 void LLVivoxVoiceClient::idle(void* user_data)
 {
+    LLVivoxVoiceClient* self = static_cast<LLVivoxVoiceClient*>(user_data);
+    self->applyParticipantUpdates();
 }
 
 //=========================================================================
@@ -4324,88 +4332,102 @@ void LLVivoxVoiceClient::participantRemovedEvent(
 }
 
 
-void LLVivoxVoiceClient::participantUpdatedEvent(
-        std::string &sessionHandle,
-        std::string &sessionGroupHandle,
-        std::string &uriString,
-        std::string &alias,
-        bool isModeratorMuted,
-        bool isSpeaking,
-        int volume,
-        F32 energy)
+void LLVivoxVoiceClient::applyParticipantUpdates()
 {
-    sessionStatePtr_t session(findSession(sessionHandle));
-    if(session)
+    if (mParticipantUpdates.empty())
     {
-        participantStatePtr_t participant(session->findParticipant(uriString));
-
-        if(participant)
-        {
-            //LL_INFOS("Voice") << "Participant Update for " << participant->mDisplayName << LL_ENDL;
-
-            participant->mIsSpeaking = isSpeaking;
-            participant->mIsModeratorMuted = isModeratorMuted;
+        return;
+    }
 
-            // SLIM SDK: convert range: ensure that energy is set to zero if is_speaking is false
-            if (isSpeaking)
-            {
-                participant->mSpeakingTimeout.reset();
-                participant->mPower = energy;
-            }
-            else
-            {
-                participant->mPower = 0.0f;
-            }
+    LL_PROFILE_ZONE_SCOPED;
 
-            // Ignore incoming volume level if it has been explicitly set, or there
-            //  is a volume or mute change pending.
-            if ( !participant->mVolumeSet && !participant->mVolumeDirty)
-            {
-                participant->mVolume = (F32)volume * VOLUME_SCALE_VIVOX;
-            }
+    bool updated = false;
+    bool self_updated = false;
 
-            // *HACK: mantipov: added while working on EXT-3544
-            /*
-             Sometimes LLVoiceClient::participantUpdatedEvent callback is called BEFORE
-             LLViewerChatterBoxSessionAgentListUpdates::post() sometimes AFTER.
+    for (const participantUpdate& update : mParticipantUpdates)
+    {
+        // These happen so often that logging them is pretty useless.
+        LL_DEBUGS("LowVoice") << "Updated Params: " << update.mSessionHandle << ", " << update.mURI << ", " << update.mIsModeratorMuted << ", " << update.mIsSpeaking << ", " << update.mVolume << ", " << update.mEnergy << LL_ENDL;
 
-             participantUpdatedEvent updates voice participant state in particular participantState::mIsModeratorMuted
-             Originally we wanted to update session Speaker Manager to fire LLSpeakerVoiceModerationEvent to fix the EXT-3544 bug.
-             Calling of the LLSpeakerMgr::update() method was added into LLIMMgr::processAgentListUpdates.
+        sessionStatePtr_t session(findSession(update.mSessionHandle));
+        if (!session)
+        {
+            LL_DEBUGS("Voice") << "unknown session " << update.mSessionHandle << LL_ENDL;
+            continue;
+        }
 
-             But in case participantUpdatedEvent() is called after LLViewerChatterBoxSessionAgentListUpdates::post()
-             voice participant mIsModeratorMuted is changed after speakers are updated in Speaker Manager
-             and event is not fired.
+        participantStatePtr_t participant(session->findParticipant(update.mURI));
+        if (!participant)
+        {
+            LL_WARNS("Voice") << "unknown participant: " << update.mURI << LL_ENDL;
+            continue;
+        }
 
-             So, we have to call LLSpeakerMgr::update() here.
-             */
-            LLVoiceChannel* voice_cnl = LLVoiceChannel::getCurrentVoiceChannel();
+        //LL_INFOS("Voice") << "Participant Update for " << participant->mDisplayName << LL_ENDL;
 
-            // ignore session ID of local chat
-            if (voice_cnl && voice_cnl->getSessionID().notNull())
-            {
-                LLSpeakerMgr* speaker_manager = LLIMModel::getInstance()->getSpeakerManager(voice_cnl->getSessionID());
-                if (speaker_manager)
-                {
-                    speaker_manager->update(true);
+        participant->mIsSpeaking = update.mIsSpeaking;
+        participant->mIsModeratorMuted = update.mIsModeratorMuted;
 
-                    // also initialize voice moderate_mode depend on Agent's participant. See EXT-6937.
-                    // *TODO: remove once a way to request the current voice channel moderation mode is implemented.
-                    if (gAgent.getID() == participant->mAvatarID)
-                    {
-                        speaker_manager->initVoiceModerateMode();
-                    }
-                }
-            }
+        // SLIM SDK: convert range: ensure that energy is set to zero if is_speaking is false
+        if (update.mIsSpeaking)
+        {
+            participant->mSpeakingTimeout.reset();
+            participant->mPower = update.mEnergy;
         }
         else
         {
-            LL_WARNS("Voice") << "unknown participant: " << uriString << LL_ENDL;
+            participant->mPower = 0.0f;
+        }
+
+        // Ignore incoming volume level if it has been explicitly set, or there
+        //  is a volume or mute change pending.
+        if ( !participant->mVolumeSet && !participant->mVolumeDirty)
+        {
+            participant->mVolume = (F32)update.mVolume * VOLUME_SCALE_VIVOX;
         }
+
+        updated = true;
+        self_updated = self_updated || (gAgent.getID() == participant->mAvatarID);
     }
-    else
+    mParticipantUpdates.clear();
+
+    if (!updated)
     {
-        LL_DEBUGS("Voice") << "unknown session " << sessionHandle << LL_ENDL;
+        return;
+    }
+
+    // *HACK: mantipov: added while working on EXT-3544
+    /*
+     Sometimes LLVoiceClient::participantUpdatedEvent callback is called BEFORE
+     LLViewerChatterBoxSessionAgentListUpdates::post() sometimes AFTER.
+
+     participantUpdatedEvent updates voice participant state in particular participantState::mIsModeratorMuted
+     Originally we wanted to update session Speaker Manager to fire LLSpeakerVoiceModerationEvent to fix the EXT-3544 bug.
+     Calling of the LLSpeakerMgr::update() method was added into LLIMMgr::processAgentListUpdates.
+
+     But in case participantUpdatedEvent() is called after LLViewerChatterBoxSessionAgentListUpdates::post()
+     voice participant mIsModeratorMuted is changed after speakers are updated in Speaker Manager
+     and event is not fired.
+
+     So, we have to call LLSpeakerMgr::update() here. Once per batch is enough.
+     */
+    LLVoiceChannel* voice_cnl = LLVoiceChannel::getCurrentVoiceChannel();
+
+    // ignore session ID of local chat
+    if (voice_cnl && voice_cnl->getSessionID().notNull())
+    {
+        LLSpeakerMgr* speaker_manager = LLIMModel::getInstance()->getSpeakerManager(voice_cnl->getSessionID());
+        if (speaker_manager)
+        {
+            speaker_manager->update(true);
+
+            // also initialize voice moderate_mode depend on Agent's participant. See EXT-6937.
+            // *TODO: remove once a way to request the current voice channel moderation mode is implemented.
+            if (self_updated)
+            {
+                speaker_manager->initVoiceModerateMode();
+            }
+        }
     }
 }
 
@@ -7218,10 +7240,23 @@ void LLVivoxVoiceClient::captureBufferPlayStopSendMessage()
 }
 
 LLVivoxProtocolParser::LLVivoxProtocolParser()
+:   inStreamRoot(false),
+    resyncing(false),
+    newlineRun(0),
+    streamBytes(0),
+    replaying(false),
+    messageCount(0)
 {
     parser = XML_ParserCreate(NULL);
 
-    reset();
+    std::string record_file = gSavedSettings.getString("VivoxStreamRecordFile");
+    if (!record_file.empty())
+    {
+        recordStream.open(record_file.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+        LL_INFOS("Voice") << "Recording the connector stream to " << record_file << LL_ENDL;
+    }
+
+    beginStream();
 }
 
 void LLVivoxProtocolParser::reset()
@@ -7260,6 +7295,64 @@ LLVivoxProtocolParser::~LLVivoxProtocolParser()
         XML_ParserFree(parser);
 }
 
+void LLVivoxProtocolParser::beginStream()
+{
+    static const char STREAM_ROOT[] = "<VivoxStream>";
+
+    XML_ParserReset(parser, NULL);
+    XML_SetElementHandler(parser, ExpatStartTag, ExpatEndTag);
+    XML_SetCharacterDataHandler(parser, ExpatCharHandler);
+    XML_SetUserData(parser, this);
+
+    inStreamRoot = false;
+    XML_Parse(parser, STREAM_ROOT, sizeof(STREAM_ROOT) - 1, false);
+    streamBytes = sizeof(STREAM_ROOT) - 1;
+
+    // Reset internal state of the LLVivoxProtocolParser (no effect on the expat parser)
+    reset();
+}
+
+void LLVivoxProtocolParser::parseInput(const char *data, size_t length)
+{
+    while (length)
+    {
+        if (resyncing)
+        {
+            size_t skip = 0;
+            while (skip < length && newlineRun < 3)
+            {
+                newlineRun = (data[skip++] == '\n') ? newlineRun + 1 : 0;
+            }
+            data += skip;
+            length -= skip;
+            if (newlineRun < 3)
+            {
+                return;
+            }
+            resyncing = false;
+            beginStream();
+            continue;
+        }
+
+        if (XML_Parse(parser, data, static_cast<int>(length), false) != XML_STATUS_ERROR)
+        {
+            streamBytes += length;
+            return;
+        }
+
+        // Only the malformed message is lost: drop everything up to the
+        // delimiter that ends it and start over with a fresh root.
+        LL_WARNS("VivoxProtocolParser") << "parse error: " << XML_ErrorString(XML_GetErrorCode(parser))
+                                        << ", skipping to the next message" << LL_ENDL;
+        S64 error_pos = (S64)XML_GetCurrentByteIndex(parser) - streamBytes;
+        size_t skip = (size_t)llclamp(error_pos, (S64)0, (S64)length);
+        data += skip;
+        length -= skip;
+        resyncing = true;
+        newlineRun = 0;
+    }
+}
+
 static LLTrace::BlockTimerStatHandle FTM_VIVOX_PROCESS("Vivox Process");
 
 // virtual
@@ -7272,39 +7365,26 @@ LLIOPipe::EStatus LLVivoxProtocolParser::process_impl(
 {
     LL_RECORD_BLOCK_TIME(FTM_VIVOX_PROCESS);
     LLBufferStream istr(channels, buffer.get());
-    std::ostringstream ostr;
     while (istr.good())
     {
-        char buf[1024];
+        char buf[4096];
         istr.read(buf, sizeof(buf));
-        mInput.append(buf, istr.gcount());
-    }
-
-    // Look for input delimiter(s) in the input buffer.  If one is found, send the message to the xml parser.
-    size_t start = 0;
-    size_t delim;
-    while((delim = mInput.find("\n\n\n", start)) != std::string::npos)
-    {
-
-        // Reset internal state of the LLVivoxProtocolParser (no effect on the expat parser)
-        reset();
-
-        XML_ParserReset(parser, NULL);
-        XML_SetElementHandler(parser, ExpatStartTag, ExpatEndTag);
-        XML_SetCharacterDataHandler(parser, ExpatCharHandler);
-        XML_SetUserData(parser, this);
-        XML_Parse(parser, mInput.data() + start, static_cast<int>(delim - start), false);
+        size_t count = (size_t)istr.gcount();
+        if (!count)
+        {
+            continue;
+        }
 
+        if (recordStream.is_open())
+        {
+            recordStream.write(buf, count);
+        }
 
-        LL_DEBUGS("VivoxProtocolParser") << "parsing: " << mInput.substr(start, delim - start) << LL_ENDL;
-        start = delim + 3;
+        // Expat keeps any partial message itself, so each piece is parsed
+        // straight from here.
+        parseInput(buf, count);
     }
 
-    if(start != 0)
-        mInput = mInput.substr(start);
-
-    LL_DEBUGS("VivoxProtocolParser") << "at end, mInput is: " << mInput << LL_ENDL;
-
     if(!LLVivoxVoiceClient::sConnected)
     {
         // If voice has been disabled, we just want to close the socket.  This does so.
@@ -7315,11 +7395,60 @@ LLIOPipe::EStatus LLVivoxProtocolParser::process_impl(
     return STATUS_OK;
 }
 
+// static
+void LLVivoxProtocolParser::replay(const std::string& filename)
+{
+    llifstream input(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!input.is_open())
+    {
+        LL_WARNS("Voice") << "Could not open connector stream " << filename << LL_ENDL;
+        return;
+    }
+    std::string stream((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    LLVivoxProtocolParser replay_parser;
+    replay_parser.recordStream.close();
+    replay_parser.replaying = true;
+
+    LLVivoxVoiceClient* voice_client = LLVivoxVoiceClient::getInstance();
+    voice_client->applyParticipantUpdates();
+    size_t updates = 0;
+
+    // feed it in pieces the size the socket hands out, applying the queued
+    // updates every few pieces as idle would between frames
+    const size_t PIECE_SIZE = 4096;
+    const U32 PIECES_PER_FRAME = 4;
+    LLTimer timer;
+    U32 piece = 0;
+    for (size_t pos = 0; pos < stream.size(); pos += PIECE_SIZE)
+    {
+        replay_parser.parseInput(stream.data() + pos, llmin(PIECE_SIZE, stream.size() - pos));
+        if (++piece % PIECES_PER_FRAME == 0 || pos + PIECE_SIZE >= stream.size())
+        {
+            updates += voice_client->mParticipantUpdates.size();
+            voice_client->applyParticipantUpdates();
+        }
+    }
+    F64 elapsed = timer.getElapsedTimeF64();
+
+    U32 messages = replay_parser.messageCount;
+    LL_INFOS("Voice") << "Replayed " << stream.size() << " bytes of connector stream from " << filename
+                      << ": " << messages << " messages, " << updates << " participant updates, "
+                      << elapsed * 1000.0 << " ms on the main thread ("
+                      << (messages ? elapsed * 1000000.0 / messages : 0.0) << " us per message)" << LL_ENDL;
+}
+
 void XMLCALL LLVivoxProtocolParser::ExpatStartTag(void *data, const char *el, const char **attr)
 {
     if (data)
     {
         LLVivoxProtocolParser   *object = (LLVivoxProtocolParser*)data;
+        if (!object->inStreamRoot)
+        {
+            // the synthetic root from beginStream(), its end never arrives
+            object->inStreamRoot = true;
+            return;
+        }
         object->StartTag(el, attr);
     }
 }
@@ -7351,6 +7480,12 @@ void XMLCALL LLVivoxProtocolParser::ExpatCharHandler(void *data, const XML_Char
 
 void LLVivoxProtocolParser::StartTag(const char *tag, const char **attr)
 {
+    if (responseDepth == 0)
+    {
+        // a new message, nothing carries over from the previous one
+        reset();
+    }
+
     // Reset the text accumulator. We shouldn't have strings that are inturrupted by new tags
     textBuffer.clear();
     // only accumulate text if we're not ignoring tags.
@@ -7677,6 +7812,18 @@ void LLVivoxProtocolParser::processResponse(std::string tag)
     if(returnCode == 0)
         statusCode = 0;
 
+    ++messageCount;
+    bool participant_update = isEvent && !stricmp(eventTypeString.c_str(), "ParticipantUpdatedEvent");
+    if (replaying && !participant_update)
+    {
+        return;
+    }
+    if (!participant_update)
+    {
+        // keep queued participant updates in order with everything else
+        LLVivoxVoiceClient::getInstance()->applyParticipantUpdates();
+    }
+
     if (isEvent)
     {
         const char *eventTypeCstr = eventTypeString.c_str();
@@ -7684,9 +7831,14 @@ void LLVivoxProtocolParser::processResponse(std::string tag)
 
         if (!stricmp(eventTypeCstr, "ParticipantUpdatedEvent"))
         {
-            // These happen so often that logging them is pretty useless.
-            LL_DEBUGS("LowVoice") << "Updated Params: " << sessionHandle << ", " << sessionGroupHandle << ", " << uriString << ", " << alias << ", " << isModeratorMuted << ", " << isSpeaking << ", " << volume << ", " << energy << LL_ENDL;
-            LLVivoxVoiceClient::getInstance()->participantUpdatedEvent(sessionHandle, sessionGroupHandle, uriString, alias, isModeratorMuted, isSpeaking, volume, energy);
+            LLVivoxVoiceClient::participantUpdate update;
+            update.mSessionHandle = sessionHandle;
+            update.mURI = uriString;
+            update.mEnergy = energy;
+            update.mVolume = volume;
+            update.mIsModeratorMuted = isModeratorMuted;
+            update.mIsSpeaking = isSpeaking;
+            LLVivoxVoiceClient::getInstance()->queueParticipantUpdate(update);
         }
         else if (!stricmp(eventTypeCstr, "AccountLoginStateChangeEvent"))
         {
@@ -35,6 +35,7 @@ class LLVivoxProtocolParser;
 #include "lliosocket.h"
 #include "v3math.h"
 #include "llframetimer.h"
+#include "llfile.h"
 #include "llviewerregion.h"
 #include "llcallingcard.h"   // for LLFriendObserver
 #include "lleventcoro.h"
@@ -483,7 +484,21 @@ protected:
     void sessionRemovedEvent(std::string &sessionHandle, std::string &sessionGroupHandle);
     void participantAddedEvent(std::string &sessionHandle, std::string &sessionGroupHandle, std::string &uriString, std::string &alias, std::string &nameString, std::string &displayNameString, int participantType);
     void participantRemovedEvent(std::string &sessionHandle, std::string &sessionGroupHandle, std::string &uriString, std::string &alias, std::string &nameString);
-    void participantUpdatedEvent(std::string &sessionHandle, std::string &sessionGroupHandle, std::string &uriString, std::string &alias, bool isModeratorMuted, bool isSpeaking, int volume, F32 energy);
+
+    // A ParticipantUpdatedEvent. Busy channels send a steady stream of
+    // these, so the parser queues them and they are applied together once
+    // per frame, or before any other event so that ordering is kept.
+    struct participantUpdate
+    {
+        std::string mSessionHandle;
+        std::string mURI;
+        F32 mEnergy;
+        S32 mVolume;
+        bool mIsModeratorMuted;
+        bool mIsSpeaking;
+    };
+    void queueParticipantUpdate(const participantUpdate& update) { mParticipantUpdates.push_back(update); }
+    void applyParticipantUpdates();
     void voiceServiceConnectionStateChangedEvent(int statusCode, std::string &statusString, std::string &build_id);
     void auxAudioPropertiesEvent(F32 energy);
     void messageEvent(std::string &sessionHandle, std::string &uriString, std::string &alias, std::string &messageHeader, std::string &messageBody, std::string &applicationString);
@@ -684,6 +699,8 @@ private:
 
     static void idle(void *user_data);
 
+    std::vector<participantUpdate> mParticipantUpdates;
+
     LLHost mDaemonHost;
     LLSocket::ptr_t mSocket;
 
@@ -950,6 +967,10 @@ public:
     LLVivoxProtocolParser();
     virtual ~LLVivoxProtocolParser();
 
+    // Parse a connector stream saved through VivoxStreamRecordFile and log
+    // the time it took. Only participant updates are applied.
+    static void replay(const std::string& filename);
+
 protected:
     /* @name LLIOPipe virtual implementations
      */
@@ -965,10 +986,15 @@ protected:
                                  LLPumpIO* pump);
     //@}
 
-    std::string     mInput;
-
     // Expat control members
     XML_Parser      parser;
+    bool            inStreamRoot;
+    bool            resyncing;      // skipping what is left of a malformed message
+    U32             newlineRun;     // trailing newlines seen while resyncing
+    S64             streamBytes;    // bytes given to the parser since beginStream()
+    bool            replaying;      // parse only, see replay()
+    U32             messageCount;
+    llofstream      recordStream;
     int             responseDepth;
     bool            ignoringTags;
     bool            isEvent;
@@ -1034,6 +1060,13 @@ protected:
 
     void            reset();
 
+    // The connector writes a run of XML documents separated by "\n\n\n".
+    // Expat sees them as the children of one synthetic root element, so
+    // socket data is parsed as it arrives without being split into
+    // messages or resetting the parser in between.
+    void            beginStream();
+    void            parseInput(const char *data, size_t length);
+
     void            processResponse(std::string tag);
 
     static void XMLCALL ExpatStartTag(void *data, const char *el, const char **attr);
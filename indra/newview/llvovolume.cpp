@@ -1219,8 +1219,19 @@ void LLVOVolume::updateVisualComplexity()
 
 void LLVOVolume::notifyMeshLoaded()
 {
-    mSculptChanged = TRUE;
-    gPipeline.markRebuild(mDrawable, LLDrawable::REBUILD_GEOMETRY);
+    if (getVolume()->isMeshAssetLoaded())
+    {
+        // Already drawing another LOD of this mesh, and every LOD shares its
+        // bounds: swap volumes as for an LOD change, without making the
+        // spatial group recompute its bounds as a sculpt change would.
+        mLODChanged = TRUE;
+        gPipeline.markRebuild(mDrawable, LLDrawable::REBUILD_VOLUME);
+    }
+    else
+    {
+        mSculptChanged = TRUE;
+        gPipeline.markRebuild(mDrawable, LLDrawable::REBUILD_GEOMETRY);
+    }
 
     if (!mSkinInfo && !mSkinInfoUnavaliable)
     {
@@ -5464,7 +5475,7 @@ void LLVolumeGeometryManager::registerFace(LLSpatialGroup* group, LLFace* facep,
         U32 end = start + facep->getGeomCount()-1;
         U32 offset = facep->getIndicesStart();
         U32 count = facep->getIndicesCount();
-        LLPointer<LLDrawInfo> draw_info = new LLDrawInfo(start,end,count,offset, tex,
+        LLPointer<LLDrawInfo> draw_info = group->obtainDrawInfo(start,end,count,offset, tex,
             facep->getVertexBuffer(), fullbright, bump);
 
         info = draw_info;
@@ -5619,7 +5630,8 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
     const LLVector4a* bounds = group->getObjectBounds();
     group->mObjectBoxSize = bounds[1].getLength3().getF32();
 
-    group->clearDrawMap();
+    // genDrawInfo reinitializes the old batches instead of allocating new ones
+    group->recycleDrawMap();
 
     U32 fullbright_count[2] = { 0 };
     U32 bump_count[2] = { 0 };
@@ -6065,6 +6077,7 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
     }
 
     group->mGeometryBytes = geometryBytes;
+    group->clearSpareDrawInfo();
 
     {
         //drawables have been rebuilt, clear rebuild status
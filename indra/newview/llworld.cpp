@@ -217,6 +217,8 @@ LLViewerRegion* LLWorld::addRegion(const U64 &region_handle, const LLHost &host)
     mRegionList.push_back(regionp);
     mActiveRegionList.push_back(regionp);
     mCulledRegionList.push_back(regionp);
+    mRegionGrid.add(regionp, region_handle, (U32)regionp->getWidth());
+    mRegionHosts.emplace(host, regionp);
 
 
     // Find all the adjacent regions, and attach them.
@@ -331,6 +333,15 @@ void LLWorld::removeRegion(const LLHost &host)
     mCulledRegionList.remove(regionp);
     mVisibleRegionList.remove(regionp);
 
+    mRegionGrid.remove(regionp, regionp->getHandle(), (U32)regionp->getWidth());
+    mRegionHosts.erase(host);
+    // give anything the removed region overlapped back to the regions underneath
+    for (LLViewerRegion* other : mRegionList)
+    {
+        mRegionGrid.add(other, other->getHandle(), (U32)other->getWidth());
+        mRegionHosts.emplace(other->getHost(), other);
+    }
+
     mRegionRemovedSignal(regionp);
 
     updateWaterObjects();
@@ -345,14 +356,8 @@ void LLWorld::removeRegion(const LLHost &host)
 
 LLViewerRegion* LLWorld::getRegion(const LLHost &host)
 {
-    for (LLViewerRegion* regionp : mRegionList)
-    {
-        if (regionp->getHost() == host)
-        {
-            return regionp;
-        }
-    }
-    return NULL;
+    auto it = mRegionHosts.find(host);
+    return it != mRegionHosts.end() ? it->second : NULL;
 }
 
 LLViewerRegion* LLWorld::getRegionFromPosAgent(const LLVector3 &pos)
@@ -362,12 +367,12 @@ LLViewerRegion* LLWorld::getRegionFromPosAgent(const LLVector3 &pos)
 
 LLViewerRegion* LLWorld::getRegionFromPosGlobal(const LLVector3d &pos)
 {
-    for (LLViewerRegion* regionp : mRegionList)
+    // the grid cell settles which region; the region's own test keeps
+    // points right on an edge going the same way they always have
+    LLViewerRegion* regionp = mRegionGrid.find(pos);
+    if (regionp && regionp->pointInRegionGlobal(pos))
     {
-        if (regionp->pointInRegionGlobal(pos))
-        {
-            return regionp;
-        }
+        return regionp;
     }
     return NULL;
 }
@@ -444,22 +449,7 @@ LLVector3d  LLWorld::clipToVisibleRegions(const LLVector3d &start_pos, const LLV
 
 LLViewerRegion* LLWorld::getRegionFromHandle(const U64 &handle)
 {
-    U32 x, y;
-    from_region_handle(handle, &x, &y);
-
-    for (LLViewerRegion* regionp : mRegionList)
-    {
-        U32 checkRegionX, checkRegionY;
-        F32 checkRegionWidth = regionp->getWidth();
-        from_region_handle(regionp->getHandle(), &checkRegionX, &checkRegionY);
-
-        if (x >= checkRegionX && x < (checkRegionX + checkRegionWidth) &&
-            y >= checkRegionY && y < (checkRegionY + checkRegionWidth))
-        {
-            return regionp;
-        }
-    }
-    return NULL;
+    return mRegionGrid.find(handle);
 }
 
 LLViewerRegion* LLWorld::getRegionFromID(const LLUUID& region_id)
@@ -487,14 +477,7 @@ void LLWorld::updateAgentOffset(const LLVector3d &offset_global)
 
 BOOL LLWorld::positionRegionValidGlobal(const LLVector3d &pos_global)
 {
-    for (LLViewerRegion* regionp : mRegionList)
-    {
-        if (regionp->pointInRegionGlobal(pos_global))
-        {
-            return TRUE;
-        }
-    }
-    return FALSE;
+    return getRegionFromPosGlobal(pos_global) != NULL;
 }
 
 
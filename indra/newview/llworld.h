@@ -34,7 +34,9 @@
 
 #include "llpatchvertexarray.h"
 
+#include "llhost.h"
 #include "llmath.h"
+#include "llregiongrid.h"
 #include "v3math.h"
 #include "llsingleton.h"
 #include "llstring.h"
@@ -224,6 +226,11 @@ private:
     region_list_t   mVisibleRegionList;
     region_list_t   mCulledRegionList;
 
+    // Lookups for mRegionList, kept in step by addRegion and removeRegion.
+    // Global positions don't move when the agent frame shifts.
+    LLRegionGrid    mRegionGrid;
+    boost::unordered_map<LLHost, LLViewerRegion*, LLHostHash> mRegionHosts;
+
     region_remove_signal_t mRegionRemovedSignal;
 
     // Number of points on edge
@@ -77,6 +77,7 @@
 #include "lltool.h"
 #include "lltoolmgr.h"
 #include "llviewercamera.h"
+#include "llviewerjointmesh.h"
 #include "llviewermediafocus.h"
 #include "llviewertexturelist.h"
 #include "llviewerobject.h"
@@ -122,6 +123,10 @@
 
 #include "llenvironment.h"
 #include "llsettingsvo.h"
+#include "workqueue.h"
+
+#include <atomic>
+#include <thread>
 
 #include "SMAA/AreaTex.h"
 #include "SMAA/SearchTex.h"
@@ -370,6 +375,11 @@ LLPipeline::LLPipeline() :
     mOldRenderDebugMask(0),
     mMeshDirtyQueryObject(0),
     mGroupQ1Locked(false),
+    mPrecullCameraValid(false),
+    mPrecullFarClip(false),
+    mPrecullStamp(0),
+    mCullTime(0.0),
+    mShadowCullTime(0.0),
     mResetVertexBuffers(false),
     mLastRebuildPool(NULL),
     mLightMask(0),
@@ -378,6 +388,13 @@ LLPipeline::LLPipeline() :
     mNoiseMap = 0;
     mTrueNoiseMap = 0;
     mLightFunc = 0;
+    mClusteredLightUBO = 0;
+    mClusterGridTex = 0;
+    mClusterIndexTex = 0;
+    mDeferredLightCount = 0;
+    mDeferredLightingTime = 0.f;
+    mDeferredLightingQuery = 0;
+    mDeferredLightingQueryPending = false;
     mAreaMap      = 0;
     mSearchMap    = 0;
     mSampleMap    = 0;
@@ -666,6 +683,7 @@ void LLPipeline::cleanup()
     mWLSkyPool = NULL;
 
     releaseGLBuffers();
+    LLRenderTarget::clearPool();
 
     mFaceSelectImagep = NULL;
 
@@ -697,6 +715,13 @@ void LLPipeline::destroyGL()
     resetDrawOrders();
 
     releaseGLBuffers();
+    LLRenderTarget::clearPool();
+
+    if (LLEnvironment::instanceExists())
+    {
+        LLEnvironment::instance().cleanupGL();
+    }
+    LLGLSLShader::resetUniformBlockBindings();
 
     if (mMeshDirtyQueryObject)
     {
@@ -1187,6 +1212,7 @@ void LLPipeline::releaseGLBuffers()
     mALRenderUtil->releaseGLBuffers();
 
     releaseLUTBuffers();
+    releaseClusteredLightBuffers();
 
     mBake.release();
 
@@ -1220,6 +1246,35 @@ void LLPipeline::releaseLUTBuffers()
 
 }
 
+void LLPipeline::releaseClusteredLightBuffers()
+{
+    if (mClusteredLightUBO)
+    {
+        LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_CLUSTERED_LIGHTS, 0);
+        glDeleteBuffers(1, &mClusteredLightUBO);
+        mClusteredLightUBO = 0;
+    }
+
+    if (mClusterGridTex)
+    {
+        LLImageGL::deleteTextures(1, &mClusterGridTex);
+        mClusterGridTex = 0;
+    }
+
+    if (mClusterIndexTex)
+    {
+        LLImageGL::deleteTextures(1, &mClusterIndexTex);
+        mClusterIndexTex = 0;
+    }
+
+    if (mDeferredLightingQuery)
+    {
+        glDeleteQueries(1, &mDeferredLightingQuery);
+        mDeferredLightingQuery = 0;
+        mDeferredLightingQueryPending = false;
+    }
+}
+
 void LLPipeline::releaseShadowBuffers()
 {
     releaseSunShadowTargets();
@@ -2415,11 +2470,8 @@ bool LLPipeline::isWaterClip()
     return (gPipeline.mHeroProbeManager.isMirrorPass()) ? false : (!sRenderTransparentWater || gCubeSnapshot) && !sRenderingHUDs;
 }
 
-void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
+void LLPipeline::setCullClipPlane(LLCamera& camera)
 {
-    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE; //LL_RECORD_BLOCK_TIME(FTM_CULL);
-    LL_PROFILE_GPU_ZONE("updateCull"); // should always be zero GPU time, but drop a timer to flush stuff out
-
     bool water_clip = isWaterClip();
 
     if (water_clip)
@@ -2449,11 +2501,40 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
     {
         camera.disableUserClipPlane();
     }
+}
+
+void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE; //LL_RECORD_BLOCK_TIME(FTM_CULL);
+    LL_PROFILE_GPU_ZONE("updateCull"); // should always be zero GPU time, but drop a timer to flush stuff out
+    LLTimer cull_timer;
+
+    setCullClipPlane(camera);
 
     grabReferences(result);
 
     sCull->clear();
 
+    // the main world camera cull, the one the precull is for
+    bool world_cull = &camera == LLViewerCamera::getInstance() &&
+                      LLViewerCamera::sCurCameraID == LLViewerCamera::CAMERA_WORLD &&
+                      !gCubeSnapshot && !sShadowRender && !sReflectionRender;
+    if (world_cull && mPrecullStamp &&
+        mPrecullFarClip == sUseFarClip &&
+        camera.sameAgentFrustum(mPrecullCamera))
+    {
+        static LLCachedControl<bool> validate(gSavedSettings, "RenderFrameOverlapValidate", false);
+        LLSpatialPartition::sPrecullStamp = mPrecullStamp;
+        LLSpatialPartition::sPrecullValidate = validate;
+        LLSpatialPartition::sPrecullMismatches = 0;
+    }
+    if (world_cull)
+    {
+        // used or not, the results are only ever for this cull; shadow and
+        // reflection culls in between must leave them alone
+        mPrecullStamp = 0;
+    }
+
     for (LLWorld::region_list_t::const_iterator iter = LLWorld::getInstance()->getRegionList().begin();
             iter != LLWorld::getInstance()->getRegionList().end(); ++iter)
     {
@@ -2479,6 +2560,22 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
         }
     }
 
+    if (LLSpatialPartition::sPrecullStamp)
+    {
+        if (LLSpatialPartition::sPrecullMismatches)
+        {
+            // a stale result means some octree change doesn't clear the
+            // group's stamp; fail loudly so it gets fixed, not just logged
+            LL_ERRS("Pipeline") << LLSpatialPartition::sPrecullMismatches << " precull results differ from the cull" << LL_ENDL;
+        }
+        LLSpatialPartition::sPrecullStamp = 0;
+    }
+    if (world_cull)
+    {
+        mPrecullCamera = camera;
+        mPrecullCameraValid = true;
+    }
+
     if (hasRenderType(LLPipeline::RENDER_TYPE_SKY) &&
         gSky.mVOSkyp.notNull() &&
         gSky.mVOSkyp->mDrawable.notNull())
@@ -2497,6 +2594,171 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result)
         gSky.mVOWLSkyp->mDrawable->setVisible(camera);
         sCull->pushDrawable(gSky.mVOWLSkyp->mDrawable);
     }
+
+    F64 cull_time = cull_timer.getElapsedTimeF64();
+    mCullTime += cull_time;
+    if (LLViewerCamera::sCurCameraID >= LLViewerCamera::CAMERA_SUN_SHADOW0 &&
+        LLViewerCamera::sCurCameraID <= LLViewerCamera::CAMERA_SUN_SHADOW3)
+    {
+        mShadowCullTime += cull_time;
+    }
+}
+
+// Shared with the General pool tasks, which may still hold it after
+// finishPrecull() has given up on them.
+struct LLPrecullBatch
+{
+    LLCamera mCamera;
+    U32 mStamp = 0;
+    std::vector<LLSpatialPartition*> mPartitions;
+    std::atomic<U32> mNext{ 0 };
+    std::atomic<U32> mDone{ 0 };
+
+    void run()
+    {
+        const U32 count = (U32)mPartitions.size();
+        U32 i;
+        while ((i = mNext.fetch_add(1, std::memory_order_relaxed)) < count)
+        {
+            mPartitions[i]->precull(mCamera, mStamp);
+            mDone.fetch_add(1, std::memory_order_release);
+        }
+    }
+};
+
+namespace
+{
+    const U32 PRECULL_MAX_HELPERS = 2;
+    U32 sPrecullCounter = 0;
+    U32 sShadowCullCounter = 0;
+}
+
+void LLPipeline::startPrecull()
+{
+    static LLCachedControl<bool> frame_overlap(gSavedSettings, "RenderFrameOverlap", false);
+    if (!frame_overlap || !mPrecullCameraValid || mPrecullBatch)
+    {
+        return;
+    }
+
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!general_queue)
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    std::shared_ptr<LLPrecullBatch> batch = std::make_shared<LLPrecullBatch>();
+    batch->mCamera = mPrecullCamera;
+    if (++sPrecullCounter == 0)
+    {
+        ++sPrecullCounter;
+    }
+    batch->mStamp = sPrecullCounter;
+
+    for (LLViewerRegion* region : LLWorld::getInstance()->getRegionList())
+    {
+        for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+        {
+            LLSpatialPartition* part = region->getSpatialPartition(i);
+            if (part && hasRenderType(part->mDrawableType))
+            {
+                // rebounding is what the cull would do first anyway, and the
+                // helpers must not
+                ((LLSpatialGroup*)part->mOctree->getListener(0))->rebound();
+                batch->mPartitions.push_back(part);
+            }
+        }
+    }
+    if (batch->mPartitions.empty())
+    {
+        return;
+    }
+
+    U32 helpers = llmin((U32)batch->mPartitions.size(), PRECULL_MAX_HELPERS);
+    for (U32 i = 0; i < helpers; ++i)
+    {
+        if (!general_queue->tryPost([batch]() { batch->run(); }))
+        {
+            break;
+        }
+    }
+    mPrecullFarClip = sUseFarClip;
+    mPrecullBatch = batch;
+}
+
+void LLPipeline::finishPrecull()
+{
+    if (!mPrecullBatch)
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    // take whatever the helpers have not started so they stop, then wait
+    // for the partitions they are still on
+    const U32 count = (U32)mPrecullBatch->mPartitions.size();
+    const U32 started = llmin(mPrecullBatch->mNext.exchange(count, std::memory_order_relaxed), count);
+    while (mPrecullBatch->mDone.load(std::memory_order_acquire) < started)
+    {
+        std::this_thread::yield();
+    }
+
+    // partitions nobody got to keep older stamps, which never match
+    mPrecullStamp = mPrecullBatch->mStamp;
+    mPrecullBatch.reset();
+}
+
+U32 LLPipeline::precullShadows(LLCamera* const* cameras, U32 count)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    LLTimer cull_timer;
+
+    // the same clip plane each camera's own updateCull() will set
+    for (U32 i = 0; i < count; ++i)
+    {
+        if (cameras[i])
+        {
+            setCullClipPlane(*cameras[i]);
+        }
+    }
+
+    if (++sShadowCullCounter == 0)
+    {
+        ++sShadowCullCounter;
+    }
+
+    for (LLViewerRegion* region : LLWorld::getInstance()->getRegionList())
+    {
+        for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+        {
+            LLSpatialPartition* part = region->getSpatialPartition(i);
+            if (part && hasRenderType(part->mDrawableType))
+            {
+                ((LLSpatialGroup*)part->mOctree->getListener(0))->rebound();
+                part->precullShadows(cameras, count, sShadowCullCounter);
+            }
+        }
+    }
+
+    F64 cull_time = cull_timer.getElapsedTimeF64();
+    mCullTime += cull_time;
+    mShadowCullTime += cull_time;
+    return sShadowCullCounter;
+}
+
+F64 LLPipeline::resetCullTime()
+{
+    F64 cull_time = mCullTime;
+    mCullTime = 0.0;
+    return cull_time;
+}
+
+F64 LLPipeline::resetShadowCullTime()
+{
+    F64 cull_time = mShadowCullTime;
+    mShadowCullTime = 0.0;
+    return cull_time;
 }
 
 void LLPipeline::markNotCulled(LLSpatialGroup* group, LLCamera& camera)
@@ -2737,6 +2999,8 @@ void LLPipeline::clearRebuildDrawables()
     mShiftList.clear();
 }
 
+static LLTrace::BlockTimerStatHandle FTM_NOTIFY_LOADED_MESHES("Notify Loaded Meshes");
+
 void LLPipeline::rebuildPriorityGroups()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
@@ -2745,7 +3009,14 @@ void LLPipeline::rebuildPriorityGroups()
     LLTimer update_timer;
     assertInitialized();
 
-    gMeshRepo.notifyLoadedMeshes();
+    {
+        // not limited, but its time counts against everyone else's budget
+        static const LLFrameScheduler::task_id_t mesh_task =
+            gFrameScheduler.addTask("Notify Loaded Meshes", 0, 0.0, 0.0, &FTM_NOTIFY_LOADED_MESHES);
+        LL_RECORD_BLOCK_TIME(FTM_NOTIFY_LOADED_MESHES);
+        LLFrameScheduler::Scope budget(gFrameScheduler, mesh_task);
+        gMeshRepo.notifyLoadedMeshes();
+    }
 
     mGroupQ1Locked = true;
     // Iterate through all drawables on the priority build queue,
@@ -3041,6 +3312,10 @@ void LLPipeline::stateSort(LLCamera& camera, LLCullResult &result)
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
     LL_PROFILE_GPU_ZONE("stateSort");
 
+    // avatars whose LOD changes while being sorted refill their body
+    // meshes; copy those on the thread pool and unmap before postSort
+    LLViewerJointMesh::beginFillBatch();
+
     if (hasAnyRenderType(LLPipeline::RENDER_TYPE_AVATAR,
                       LLPipeline::RENDER_TYPE_CONTROL_AV,
                       LLPipeline::RENDER_TYPE_TERRAIN,
@@ -3156,6 +3431,8 @@ void LLPipeline::stateSort(LLCamera& camera, LLCullResult &result)
         }
     }
 
+    LLViewerJointMesh::flushFillBatch();
+
     postSort(camera);
 }
 
@@ -7979,6 +8256,8 @@ void LLPipeline::renderDeferredLighting()
 
     llassert(!sRenderingHUDs);
 
+    const S32 visible_lights = sVisibleLightCount;
+
     F32 light_scale = 1.f;
 
     if (gCubeSnapshot)
@@ -8152,8 +8431,49 @@ void LLPipeline::renderDeferredLighting()
 
         static LLCachedControl<S32> local_light_count(gSavedSettings, "RenderLocalLightCount", 256);
 
+        static LLCachedControl<bool> clustered_lighting(gSavedSettings, "RenderClusteredLighting", false);
+        const bool clustered = clustered_lighting && gDeferredClusteredLightProgram.isComplete();
+
         if (local_light_count > 0)
         {
+            // time the local light passes for the statistics floater, reading
+            // back an earlier frame's result only once it is ready so we never stall
+            bool time_lights = !gCubeSnapshot && !LLGLSLShader::sProfileEnabled;
+            if (time_lights)
+            {
+                if (mDeferredLightingQueryPending)
+                {
+                    GLuint available = 0;
+                    glGetQueryObjectuiv(mDeferredLightingQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+                    if (available)
+                    {
+                        GLuint64 time_elapsed = 0;
+                        glGetQueryObjectui64v(mDeferredLightingQuery, GL_QUERY_RESULT, &time_elapsed);
+                        mDeferredLightingTime = time_elapsed / 1000000.f;
+                        mDeferredLightingQueryPending = false;
+                    }
+                }
+
+                if (mDeferredLightingQueryPending)
+                {
+                    time_lights = false;
+                }
+                else
+                {
+                    if (mDeferredLightingQuery == 0)
+                    {
+                        glGenQueries(1, &mDeferredLightingQuery);
+                    }
+                    glBeginQuery(GL_TIME_ELAPSED, mDeferredLightingQuery);
+                }
+            }
+
+            if (clustered)
+            {
+                F32 tan_y = tanf(camera->getView() * 0.5f);
+                mLightClusters.setup(tan_y * camera->getAspect(), tan_y, camera->getNear(), camera->getFar());
+            }
+
             gGL.setSceneBlendType(LLRender::BT_ADD);
             std::list<LLVector4>        fullscreen_lights;
             LLDrawable::drawable_list_t spot_lights;
@@ -8237,6 +8557,23 @@ void LLPipeline::renderDeferredLighting()
 
                     sVisibleLightCount++;
 
+                    if (clustered && !volume->isLightSpotlight())
+                    { // point lights go to the clusters until they are full, spot lights need their projectors
+                        U32 idx = mLightClusters.getLightCount();
+                        if (idx < MAX_CLUSTERED_LIGHTS)
+                        {
+                            LLVector4a view_center;
+                            mat.affineTransform(center, view_center);
+                            const F32* v = view_center.getF32ptr();
+                            if (mLightClusters.addLight(LLVector3(v), s, (U16)idx))
+                            {
+                                mClusteredLightData.mLight[idx].set(v[0], v[1], v[2], s);
+                                mClusteredLightData.mLightColor[idx].set(col.mV[0], col.mV[1], col.mV[2], volume->getLightFalloff(DEFERRED_LIGHT_FALLOFF));
+                            }
+                            continue;
+                        }
+                    }
+
                     const auto& cam_origin = camera->getOrigin();
                     if (cam_origin.mV[0] > c[0] + s + 0.2f || cam_origin.mV[0] < c[0] - s - 0.2f ||
                         cam_origin.mV[1] > c[1] + s + 0.2f || cam_origin.mV[1] < c[1] - s - 0.2f ||
@@ -8394,6 +8731,21 @@ void LLPipeline::renderDeferredLighting()
                 gDeferredMultiSpotLightProgram.disableTexture(LLShaderMgr::DEFERRED_PROJECTION);
                 unbindDeferredShader(gDeferredMultiSpotLightProgram);
             }
+
+            if (clustered && mLightClusters.getLightCount() > 0)
+            {
+                renderClusteredLights();
+            }
+
+            if (time_lights)
+            {
+                glEndQuery(GL_TIME_ELAPSED);
+                mDeferredLightingQueryPending = true;
+            }
+        }
+        else if (!gCubeSnapshot)
+        {
+            mDeferredLightingTime = 0.f;
         }
 
         gGL.setColorMask(true, true);
@@ -8441,6 +8793,8 @@ void LLPipeline::renderDeferredLighting()
 
     if (!gCubeSnapshot)
     {
+        mDeferredLightCount = sVisibleLightCount - visible_lights;
+
         // this is the end of the 3D scene render, grab a copy of the modelview and projection
         // matrix for use in off-by-one-frame effects in the next frame
         {
@@ -8451,6 +8805,121 @@ void LLPipeline::renderDeferredLighting()
     gGL.setColorMask(true, true);
 }
 
+void LLPipeline::renderClusteredLights()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
+    LL_PROFILE_GPU_ZONE("clustered lights");
+
+    mLightClusters.build();
+
+    const U32 light_count = mLightClusters.getLightCount();
+    const std::vector<U32>& grid = mLightClusters.getGrid();
+    const std::vector<U16>& indices = mLightClusters.getIndices();
+
+    if (!mClusteredLightUBO)
+    {
+        glGenBuffers(1, &mClusteredLightUBO);
+    }
+
+    // orphan the previous frame's lights, then upload only the ones in use
+    glBindBuffer(GL_UNIFORM_BUFFER, mClusteredLightUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(ClusteredLightData), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, light_count * sizeof(LLVector4), mClusteredLightData.mLight);
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(mClusteredLightData.mLight), light_count * sizeof(LLVector4), mClusteredLightData.mLightColor);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    LLGLSLShader::bindUniformBlock(LLGLSLShader::UB_CLUSTERED_LIGHTS, mClusteredLightUBO);
+
+    LLTexUnit* unit = gGL.getTexUnit(0);
+
+    if (!mClusterGridTex)
+    {
+        LLImageGL::generateTextures(1, &mClusterGridTex);
+        unit->bindManual(LLTexUnit::TT_TEXTURE, mClusterGridTex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    else
+    {
+        unit->bindManual(LLTexUnit::TT_TEXTURE, mClusterGridTex);
+    }
+
+    // one texel per cluster, one row per slice
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32UI, LLLightClusters::TILES_X * LLLightClusters::TILES_Y, LLLightClusters::SLICES, 0,
+                 GL_RG_INTEGER, GL_UNSIGNED_INT, grid.data());
+
+    if (!mClusterIndexTex)
+    {
+        LLImageGL::generateTextures(1, &mClusterIndexTex);
+        unit->bindManual(LLTexUnit::TT_TEXTURE, mClusterIndexTex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    else
+    {
+        unit->bindManual(LLTexUnit::TT_TEXTURE, mClusterIndexTex);
+    }
+
+    // the index list wraps every CLUSTER_INDEX_WIDTH entries, the last row is partial
+    const U32 index_count = (U32)indices.size();
+    const U32 full_rows = index_count / CLUSTER_INDEX_WIDTH;
+    const U32 remainder = index_count % CLUSTER_INDEX_WIDTH;
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16UI, CLUSTER_INDEX_WIDTH, llmax(full_rows + (remainder ? 1 : 0), 1U), 0,
+                 GL_RED_INTEGER, GL_UNSIGNED_SHORT, nullptr);
+    if (full_rows > 0)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, CLUSTER_INDEX_WIDTH, full_rows, GL_RED_INTEGER, GL_UNSIGNED_SHORT, indices.data());
+    }
+    if (remainder > 0)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, full_rows, remainder, 1, GL_RED_INTEGER, GL_UNSIGNED_SHORT,
+                        indices.data() + full_rows * CLUSTER_INDEX_WIDTH);
+    }
+
+    unit->unbind(LLTexUnit::TT_TEXTURE);
+
+    LLGLSLShader& shader = gDeferredClusteredLightProgram;
+    bindDeferredShader(shader);
+
+    S32 channel = shader.enableTexture(LLShaderMgr::CLUSTER_GRID);
+    if (channel > -1)
+    {
+        gGL.getTexUnit(channel)->bindManual(LLTexUnit::TT_TEXTURE, mClusterGridTex);
+    }
+
+    channel = shader.enableTexture(LLShaderMgr::CLUSTER_INDICES);
+    if (channel > -1)
+    {
+        gGL.getTexUnit(channel)->bindManual(LLTexUnit::TT_TEXTURE, mClusterIndexTex);
+    }
+
+    static LLStaticHashedString cluster_tan("cluster_tan");
+    static LLStaticHashedString cluster_near("cluster_near");
+    static LLStaticHashedString cluster_slice_scale("cluster_slice_scale");
+
+    shader.uniform2f(cluster_tan, mLightClusters.getTanX(), mLightClusters.getTanY());
+    shader.uniform1f(cluster_near, mLightClusters.getNear());
+    shader.uniform1f(cluster_slice_scale, mLightClusters.getSliceScale());
+
+    // as for the fullscreen lights, skip pixels beyond the farthest light
+    F32 far_z = 0.f;
+    for (U32 i = 0; i < light_count; ++i)
+    {
+        const LLVector4& light = mClusteredLightData.mLight[i];
+        far_z = llmin(light.mV[2] - light.mV[3], far_z);
+    }
+    shader.uniform1f(LLShaderMgr::MULTI_LIGHT_FAR_Z, far_z);
+
+    {
+        LLGLDepthTest depth(GL_FALSE);
+        mScreenTriangleVB->setBuffer();
+        mScreenTriangleVB->drawArrays(LLRender::TRIANGLES, 0, 3);
+    }
+
+    shader.disableTexture(LLShaderMgr::CLUSTER_GRID);
+    shader.disableTexture(LLShaderMgr::CLUSTER_INDICES);
+    unbindDeferredShader(shader);
+}
+
 void LLPipeline::doAtmospherics()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_PIPELINE;
@@ -9645,7 +10114,11 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
     }
     else
     {
-        for (S32 j = 0; j < (gCubeSnapshot ? 2 : 4); j++)
+        const S32 cascades = gCubeSnapshot ? 2 : 4;
+        LLCamera shadow_cams[4];
+        LLCamera* shadow_cull[4] = { NULL, NULL, NULL, NULL };
+
+        for (S32 j = 0; j < cascades; j++)
         {
             if (!hasRenderDebugMask(RENDER_DEBUG_SHADOW_FRUSTA) && !gCubeSnapshot)
             {
@@ -9980,6 +10453,24 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             //shadow_cam.ignoreAgentFrustumPlane(LLCamera::AGENT_PLANE_NEAR);
             shadow_cam.getAgentPlane(LLCamera::AGENT_PLANE_NEAR).set(shadow_near_clip);
 
+            shadow_cams[j] = shadow_cam;
+            shadow_cull[j] = &shadow_cams[j];
+        }
+
+        // one walk of the octrees for all the cascades' frustum tests
+        static LLCachedControl<bool> multi_cull(gSavedSettings, "RenderShadowMultiCull", true);
+        U32 shadow_stamp = multi_cull ? precullShadows(shadow_cull, cascades) : 0;
+
+        for (S32 j = 0; j < cascades; j++)
+        {
+            if (!shadow_cull[j])
+            {
+                continue;
+            }
+
+            LLViewerCamera::sCurCameraID = (LLViewerCamera::eCameraID)(LLViewerCamera::CAMERA_SUN_SHADOW0+j);
+            LLCamera& shadow_cam = shadow_cams[j];
+
             //translate and scale to from [-1, 1] to [0, 1]
             glh::matrix4f trans(0.5f, 0.f, 0.f, 0.5f,
                             0.f, 0.5f, 0.f, 0.5f,
@@ -10004,7 +10495,10 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
 
             {
                 static LLCullResult result[4];
+                LLSpatialPartition::sShadowCullStamp = shadow_stamp;
+                LLSpatialPartition::sShadowCullCamera = j;
                 renderShadow(view[j], proj[j], shadow_cam, result[j], true);
+                LLSpatialPartition::sShadowCullStamp = 0;
             }
 
             mRT->shadow[j].flush();
@@ -40,6 +40,7 @@
 #include "llrendertarget.h"
 #include "llreflectionmapmanager.h"
 #include "llheroprobemanager.h"
+#include "lllightclusters.h"
 
 #include "alrenderutils.h"
 
@@ -57,6 +58,7 @@ class LLVOPartGroup;
 class LLGLSLShader;
 class LLDrawPoolAlpha;
 class LLSettingsSky;
+struct LLPrecullBatch;
 
 typedef enum e_avatar_skinning_method
 {
@@ -240,6 +242,25 @@ public:
 
     // Populate given LLCullResult with results of a frustum cull of the entire scene against the given LLCamera
     void updateCull(LLCamera& camera, LLCullResult& result);
+
+    // Frame overlap (RenderFrameOverlap): while the main thread waits in swap,
+    // General pool threads run the next world camera cull's frustum tests,
+    // assuming the camera stays where it is. The next updateCull() uses the
+    // results if the camera did stay put. finishPrecull() must be called
+    // before anything touches the octrees again.
+    void startPrecull();
+    void finishPrecull();
+
+    // Frustum test the scene against all of the given shadow cameras in a
+    // single walk (RenderShadowMultiCull). Returns the stamp for
+    // LLSpatialPartition::sShadowCullStamp that lets each camera's shadow
+    // cull use the results. NULL cameras are skipped.
+    U32 precullShadows(LLCamera* const* cameras, U32 count);
+
+    // octree culling time since the last call, all cameras, in seconds
+    F64 resetCullTime();
+    // the part of it spent on the sun shadow cascades, in seconds
+    F64 resetShadowCullTime();
     void createObjects(F32 max_dtime);
     void createObject(LLViewerObject* vobj);
     void processPartitionQ();
@@ -303,6 +324,10 @@ public:
 
     void renderDeferredLighting();
 
+    // shade every light binned into mLightClusters in one fullscreen pass
+    void renderClusteredLights();
+    void releaseClusteredLightBuffers();
+
     // apply atmospheric haze based on contents of color and depth buffer
     // should be called just before rendering water when camera is under water
     // and just before rendering alpha when camera is above water
@@ -369,6 +394,8 @@ public:
     bool hasAnyRenderType(const U32 type, ...) const;
 
     static bool isWaterClip();
+    // set or clear the water clip plane a cull with camera uses
+    void setCullClipPlane(LLCamera& camera);
 
     void setRenderTypeMask(U32 type, ...);
     // This is equivalent to 'setRenderTypeMask'
@@ -762,6 +789,29 @@ public:
     U32                 mSampleMap;
     U32                 mStencilMap;
 
+    // clustered deferred lighting, see renderClusteredLights
+    // NOTE: Keep in sync with clusteredLightF.glsl
+    static const U32 MAX_CLUSTERED_LIGHTS = 512;
+    static const U32 CLUSTER_INDEX_WIDTH = 1024;
+
+    struct ClusteredLightData
+    {
+        LLVector4 mLight[MAX_CLUSTERED_LIGHTS];     // view space center, .w = size
+        LLVector4 mLightColor[MAX_CLUSTERED_LIGHTS]; // linear color, .w = falloff
+    };
+
+    LLLightClusters     mLightClusters;
+    ClusteredLightData  mClusteredLightData;
+    U32                 mClusteredLightUBO;
+    U32                 mClusterGridTex;
+    U32                 mClusterIndexTex;
+
+    // lights shaded and GPU time spent by the last main view lighting pass
+    S32                 mDeferredLightCount;
+    F32                 mDeferredLightingTime; // milliseconds
+    U32                 mDeferredLightingQuery;
+    bool                mDeferredLightingQueryPending;
+
     LLColor4            mSunDiffuse;
     LLColor4            mMoonDiffuse;
     LLVector4           mSunDir;
@@ -839,6 +889,17 @@ protected:
 
     bool mGroupQ1Locked;
 
+    // last world camera cull, which the precull assumes the next one repeats
+    LLCamera                        mPrecullCamera;
+    bool                            mPrecullCameraValid;
+    bool                            mPrecullFarClip;
+    // stamp of finished precull results for the next world cull, 0 for none
+    U32                             mPrecullStamp;
+    std::shared_ptr<LLPrecullBatch> mPrecullBatch;
+
+    F64                             mCullTime;
+    F64                             mShadowCullTime;
+
     bool mResetVertexBuffers; //if true, clear vertex buffers on next update
 
     LLViewerObject::vobj_list_t     mCreateQ;
@@ -0,0 +1,290 @@
+/**
+ * @file   llavatarbodyfill_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llavatarbodyfill, including 100 avatars' bodies filled
+ *         in one batch.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../llavatarbodyfill.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace tut
+{
+    struct alignas(16) Vec4
+    {
+        F32 mV[4];
+    };
+
+    // vertices and triangles of the highest LOD of each system body mesh
+    // (character/avatar_*.llm), the eye twice
+    struct BodyMesh
+    {
+        U32 mVerts;
+        U32 mTriangles;
+    };
+    const BodyMesh BODY[] =
+    {
+        { 1132, 1844 },     // head
+        { 2211, 3688 },     // upper body
+        { 977, 1654 },      // lower body
+        { 182, 294 },       // skirt
+        { 627, 1020 },      // hair
+        { 145, 272 },       // eye
+        { 145, 272 },       // eye
+        { 48, 46 },         // eyelashes
+    };
+    const U32 BODY_MESHES = sizeof(BODY) / sizeof(BODY[0]);
+
+    // a poly mesh's arrays, laid out as LLPolyMesh keeps them
+    struct Source
+    {
+        Source(const BodyMesh& mesh, U32 seed) :
+            mCoords(mesh.mVerts),
+            mNormals(mesh.mVerts),
+            mTexCoords((mesh.mVerts + 1) / 2),
+            mWeights((mesh.mVerts + 3) / 4),
+            mClothingWeights(mesh.mVerts),
+            mIndices(mesh.mTriangles * 3)
+        {
+            for (U32 i = 0; i < mesh.mVerts; ++i)
+            {
+                F32 value = (F32)(seed + i);
+                mCoords[i] = { { value, value + 0.25f, value + 0.5f, 1.f } };
+                mNormals[i] = { { 0.f, 0.f, 1.f, value } };
+                mClothingWeights[i] = { { value, 0.f, 0.f, 0.f } };
+                ((F32*)mTexCoords.data())[i * 2] = value;
+                ((F32*)mTexCoords.data())[i * 2 + 1] = -value;
+                ((F32*)mWeights.data())[i] = value * 0.5f;
+            }
+            for (U32 i = 0; i < mIndices.size(); ++i)
+            {
+                mIndices[i] = (S32)((seed + i) % mesh.mVerts);
+            }
+        }
+
+        std::vector<Vec4> mCoords;
+        std::vector<Vec4> mNormals;
+        std::vector<Vec4> mTexCoords;
+        std::vector<Vec4> mWeights;
+        std::vector<Vec4> mClothingWeights;
+        std::vector<S32> mIndices;
+    };
+
+    // one avatar's face buffer, every body mesh at its own offset
+    struct Target
+    {
+        Target()
+        {
+            U32 verts = 0;
+            U32 indices = 0;
+            for (U32 m = 0; m < BODY_MESHES; ++m)
+            {
+                mVertexOffset[m] = verts;
+                mIndexOffset[m] = indices;
+                // keeps every array of the next mesh 16 byte aligned
+                verts += (BODY[m].mVerts + 3) & ~3;
+                indices += BODY[m].mTriangles * 3;
+            }
+            mCoords.resize(verts);
+            mNormals.resize(verts);
+            mTexCoords.resize(verts / 2);
+            mWeights.resize(verts / 4);
+            mClothingWeights.resize(verts);
+            mIndices.resize(indices);
+        }
+
+        U32 mVertexOffset[BODY_MESHES];
+        U32 mIndexOffset[BODY_MESHES];
+        std::vector<Vec4> mCoords;
+        std::vector<Vec4> mNormals;
+        std::vector<Vec4> mTexCoords;
+        std::vector<Vec4> mWeights;
+        std::vector<Vec4> mClothingWeights;
+        std::vector<U16> mIndices;
+    };
+
+    // what LLViewerJointMesh::updateFaceData() makes of a mapped face
+    LLAvatarBodyFill::Fill make_fill(Target& target, U32 m, const Source& source, bool terse)
+    {
+        const U32 offset = target.mVertexOffset[m];
+        LLAvatarBodyFill::Fill fill;
+        fill.mVertices = target.mCoords[offset].mV;
+        fill.mNormals = target.mNormals[offset].mV;
+        fill.mTexCoords = (F32*)target.mTexCoords.data() + offset * 2;
+        fill.mWeights = (F32*)target.mWeights.data() + offset;
+        fill.mClothingWeights = target.mClothingWeights[offset].mV;
+        fill.mIndices = target.mIndices.data() + target.mIndexOffset[m];
+        fill.mSrcCoords = source.mCoords[0].mV;
+        fill.mSrcNormals = source.mNormals[0].mV;
+        fill.mSrcTexCoords = (const F32*)source.mTexCoords.data();
+        fill.mSrcWeights = (const F32*)source.mWeights.data();
+        fill.mSrcClothingWeights = source.mClothingWeights[0].mV;
+        fill.mSrcIndices = source.mIndices.data();
+        fill.mNumVerts = BODY[m].mVerts;
+        fill.mNumIndices = BODY[m].mTriangles * 3;
+        fill.mIndexOffset = (S32)offset;
+        fill.mTerse = terse;
+        return fill;
+    }
+
+    bool filled(const Target& target, U32 m, const Source& source, bool terse)
+    {
+        const U32 offset = target.mVertexOffset[m];
+        const U32 verts = BODY[m].mVerts;
+        for (U32 i = 0; i < verts; ++i)
+        {
+            for (U32 c = 0; c < 4; ++c)
+            {
+                if (target.mCoords[offset + i].mV[c] != source.mCoords[i].mV[c]
+                    || target.mNormals[offset + i].mV[c] != source.mNormals[i].mV[c])
+                {
+                    return false;
+                }
+            }
+            if (terse)
+            {
+                continue;
+            }
+            const F32* tc = (const F32*)target.mTexCoords.data() + (offset + i) * 2;
+            const F32* src_tc = (const F32*)source.mTexCoords.data() + i * 2;
+            if (tc[0] != src_tc[0] || tc[1] != src_tc[1]
+                || ((const F32*)target.mWeights.data())[offset + i] != ((const F32*)source.mWeights.data())[i]
+                || target.mClothingWeights[offset + i].mV[0] != source.mClothingWeights[i].mV[0])
+            {
+                return false;
+            }
+        }
+        for (U32 i = 0; i < BODY[m].mTriangles * 3; ++i)
+        {
+            if (target.mIndices[target.mIndexOffset[m] + i] != (U16)(source.mIndices[i] + offset))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+namespace tut
+{
+    struct llavatarbodyfill_data
+    {
+        llavatarbodyfill_data()
+        {
+            for (U32 m = 0; m < BODY_MESHES; ++m)
+            {
+                mSources.emplace_back(new Source(BODY[m], m * 1000));
+            }
+        }
+
+        ~llavatarbodyfill_data()
+        {
+            for (std::thread& helper : mHelpers)
+            {
+                helper.join();
+            }
+        }
+
+        // posts to a thread of its own, as the "General" pool would
+        LLAvatarBodyFill::post_func_t poster()
+        {
+            return [this](const std::function<void()>& work)
+            {
+                mHelpers.emplace_back(work);
+                return true;
+            };
+        }
+
+        std::vector<std::unique_ptr<Source>> mSources;
+        std::vector<std::thread> mHelpers;
+    };
+    typedef test_group<llavatarbodyfill_data> llavatarbodyfill_group;
+    typedef llavatarbodyfill_group::object object;
+    llavatarbodyfill_group llavatarbodyfillgrp("llavatarbodyfill");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("one avatar stays on the calling thread");
+        Target target;
+        LLAvatarBodyFill batch;
+        for (U32 m = 0; m < BODY_MESHES; ++m)
+        {
+            batch.add(make_fill(target, m, *mSources[m], false));
+        }
+        ensure("one body is below the parallel size", batch.getVertexCount() < LLAvatarBodyFill::MIN_PARALLEL_VERTS);
+
+        ensure_equals("no helpers", batch.flush(poster()), (U32)0);
+        ensure("nothing left", batch.empty());
+        ensure_equals("nothing posted", mHelpers.size(), (size_t)0);
+        for (U32 m = 0; m < BODY_MESHES; ++m)
+        {
+            ensure("mesh filled", filled(target, m, *mSources[m], false));
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("terse fills leave texture coordinates alone");
+        Target target;
+        LLAvatarBodyFill::run(make_fill(target, 1, *mSources[1], true));
+        ensure("positions and normals filled", filled(target, 1, *mSources[1], true));
+        ensure_equals("texture coordinates untouched",
+                      ((const F32*)target.mTexCoords.data())[target.mVertexOffset[1] * 2 + 2], 0.f);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("100 avatars arriving at once");
+        const U32 AVATARS = 100;
+        std::vector<std::unique_ptr<Target>> targets;
+        LLAvatarBodyFill batch;
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            targets.emplace_back(new Target);
+            for (U32 m = 0; m < BODY_MESHES; ++m)
+            {
+                batch.add(make_fill(*targets.back(), m, *mSources[m], false));
+            }
+        }
+
+        ensure_equals("every helper posted", batch.flush(poster()), (U32)LLAvatarBodyFill::MAX_HELPERS);
+        ensure("nothing left", batch.empty());
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            for (U32 m = 0; m < BODY_MESHES; ++m)
+            {
+                ensure("mesh filled", filled(*targets[a], m, *mSources[m], false));
+            }
+        }
+
+        // a pool that turns work away leaves it all to the calling thread
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            targets[a].reset(new Target);
+            for (U32 m = 0; m < BODY_MESHES; ++m)
+            {
+                batch.add(make_fill(*targets[a], m, *mSources[m], true));
+            }
+        }
+        ensure_equals("no helpers taken",
+                      batch.flush([](const std::function<void()>&) { return false; }), (U32)0);
+        for (U32 a = 0; a < AVATARS; ++a)
+        {
+            ensure("last body filled", filled(*targets[a], BODY_MESHES - 1, *mSources[BODY_MESHES - 1], true));
+        }
+    }
+} // namespace tut
@@ -0,0 +1,229 @@
+/**
+ * @file   llgroupmembertable_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llgroupmembertable.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../llgroupmembertable.h"
+
+#include "llsd.h"
+
+namespace
+{
+    // shaped like a GroupMemberData capability reply
+    LLSD make_reply(const LLUUID& group_id, U32 count, U32 changed_every)
+    {
+        LLSD reply;
+        reply["group_id"] = group_id;
+        reply["member_count"] = (LLSD::Integer)count;
+        reply["defaults"]["default_powers"] = "10";
+        reply["titles"].append("Member");
+        reply["titles"].append("Officer");
+        reply["titles"].append("Owner");
+
+        LLSD& members = reply["members"];
+        for (U32 i = 0; i < count; ++i)
+        {
+            LLUUID id;
+            id.generate(llformat("member %u", i));
+            LLSD member;
+            if (i % 3)
+            {
+                member["last_login"] = llformat("%u/%u/20%02u", i % 12 + 1, i % 28 + 1, i % 20);
+            }
+            else
+            {
+                member["last_login"] = "Online";
+            }
+            if (i % 10 == 0)
+            {
+                member["title"] = 1;
+                member["powers"] = "ff";
+            }
+            if (changed_every && i % changed_every == 0)
+            {
+                member["donated_square_meters"] = 512;
+            }
+            members[id.asString()] = member;
+        }
+        return reply;
+    }
+}
+
+namespace tut
+{
+    struct llgroupmembertable_data
+    {
+        llgroupmembertable_data()
+        {
+            mGroupID.generate();
+        }
+
+        LLUUID mGroupID;
+    };
+    typedef test_group<llgroupmembertable_data> llgroupmembertable_group;
+    typedef llgroupmembertable_group::object object;
+    llgroupmembertable_group llgroupmembertablegrp("llgroupmembertable");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("last login");
+        ensure_equals("online", LLGroupMemberTable::parseLastLogin("Online"), LLGroupMemberTable::LAST_LOGIN_ONLINE);
+        ensure_equals("date", LLGroupMemberTable::parseLastLogin("12/25/2008"), (U32)20081225);
+        ensure_equals("short date", LLGroupMemberTable::parseLastLogin("1/2/2010"), (U32)20100102);
+        ensure_equals("garbage", LLGroupMemberTable::parseLastLogin("yesterday"), LLGroupMemberTable::LAST_LOGIN_UNKNOWN);
+        ensure_equals("trailing text", LLGroupMemberTable::parseLastLogin("1/2/2010 now"), LLGroupMemberTable::LAST_LOGIN_UNKNOWN);
+        ensure_equals("empty", LLGroupMemberTable::parseLastLogin(""), LLGroupMemberTable::LAST_LOGIN_UNKNOWN);
+
+        ensure_equals("formatted", LLGroupMemberTable::formatLastLogin(20081225), std::string("2008/12/25"));
+        ensure_equals("padded", LLGroupMemberTable::formatLastLogin(20100102), std::string("2010/01/02"));
+        ensure("no date", LLGroupMemberTable::formatLastLogin(LLGroupMemberTable::LAST_LOGIN_ONLINE).empty());
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("parse reply");
+        LLUUID owner_id, officer_id, plain_id;
+        owner_id.generate();
+        officer_id.generate();
+        plain_id.generate();
+
+        LLSD reply;
+        reply["group_id"] = mGroupID;
+        reply["member_count"] = 3;
+        reply["defaults"]["default_powers"] = "1f";
+        reply["titles"].append("Everyone");
+        reply["titles"].append("Officer");
+        reply["members"][owner_id.asString()]["owner"] = "Y";
+        reply["members"][owner_id.asString()]["last_login"] = "Online";
+        reply["members"][owner_id.asString()]["powers"] = "ffff";
+        reply["members"][officer_id.asString()]["title"] = 1;
+        reply["members"][officer_id.asString()]["last_login"] = "3/4/2021";
+        reply["members"][officer_id.asString()]["donated_square_meters"] = 1024;
+        reply["members"][plain_id.asString()]["title"] = 7;
+
+        LLGroupMemberTable table;
+        ensure("parsed", table.fromLLSD(reply));
+        ensure_equals("group", table.getGroupID(), mGroupID);
+        ensure_equals("rows", table.size(), (U32)3);
+
+        S32 owner = table.findRow(owner_id);
+        S32 officer = table.findRow(officer_id);
+        S32 plain = table.findRow(plain_id);
+        ensure("all found", owner >= 0 && officer >= 0 && plain >= 0);
+        LLUUID stranger;
+        stranger.generate();
+        ensure_equals("stranger", table.findRow(stranger), -1);
+
+        ensure("owner", table.isOwner(owner) && !table.isOwner(officer));
+        ensure_equals("owner powers", table.getPowers(owner), (U64)0xffff);
+        ensure_equals("default powers", table.getPowers(officer), (U64)0x1f);
+        ensure_equals("owner online", table.getLastLogin(owner), LLGroupMemberTable::LAST_LOGIN_ONLINE);
+        ensure_equals("officer login", table.getLastLogin(officer), (U32)20210304);
+        ensure_equals("no login", table.getLastLogin(plain), LLGroupMemberTable::LAST_LOGIN_UNKNOWN);
+        ensure_equals("contribution", table.getContribution(officer), 1024);
+
+        ensure_equals("default title", *table.getTitle(owner), std::string("Everyone"));
+        ensure_equals("officer title", *table.getTitle(officer), std::string("Officer"));
+        ensure("bad title index", table.getTitle(plain)->empty());
+
+        LLSD empty;
+        empty["group_id"] = mGroupID;
+        empty["member_count"] = 0;
+        ensure("no members", !table.fromLLSD(empty));
+        ensure_equals("cleared", table.size(), (U32)0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("titles are shared");
+        LLSD reply = make_reply(mGroupID, 100, 0);
+        LLGroupMemberTable table;
+        table.fromLLSD(reply);
+
+        const LLGroupMemberTable::title_t* member = NULL;
+        for (U32 row = 0; row < table.size(); ++row)
+        {
+            if (*table.getTitle(row) == "Member")
+            {
+                if (member)
+                {
+                    ensure("same string", member->get() == table.getTitle(row).get());
+                }
+                member = &table.getTitle(row);
+            }
+        }
+        ensure("found members", member != NULL);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("diff");
+        LLUUID a, b, c, d;
+        a.generate();
+        b.generate();
+        c.generate();
+        d.generate();
+
+        LLGroupMemberTable older;
+        older.addMember(a, 0, 1, "Member", 20200101, false);
+        older.addMember(b, 0, 1, "Member", 20200101, false);
+        older.addMember(c, 0, 1, "Member", 20200101, false);
+
+        LLGroupMemberTable newer;
+        newer.addMember(a, 0, 1, "Member", 20200101, false);
+        newer.addMember(b, 0, 1, "Member", LLGroupMemberTable::LAST_LOGIN_ONLINE, false);
+        newer.addMember(d, 0, 1, "Member", 20200101, false);
+
+        std::vector<U32> changed;
+        uuid_vec_t removed;
+        newer.diff(&older, changed, removed);
+        ensure_equals("changed and added", changed.size(), (size_t)2);
+        ensure_equals("changed", newer.getID(changed[0]), b);
+        ensure_equals("added", newer.getID(changed[1]), d);
+        ensure_equals("removed", removed.size(), (size_t)1);
+        ensure_equals("removed member", removed[0], c);
+
+        newer.diff(NULL, changed, removed);
+        ensure_equals("everything is new", changed.size(), (size_t)3);
+        ensure("nothing removed", removed.empty());
+
+        newer.diff(&newer, changed, removed);
+        ensure("nothing changed", changed.empty() && removed.empty());
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("50k members");
+        const U32 COUNT = 50000;
+        LLSD first = make_reply(mGroupID, COUNT, 0);
+        // one member in a hundred changes between replies
+        LLSD second = make_reply(mGroupID, COUNT, 100);
+
+        std::shared_ptr<LLGroupMemberTable> older = std::make_shared<LLGroupMemberTable>();
+        older->fromLLSD(first);
+
+        LLGroupMemberTable newer;
+        newer.fromLLSD(second);
+        std::vector<U32> changed;
+        uuid_vec_t removed;
+        newer.diff(older.get(), changed, removed);
+
+        ensure_equals("all rows", older->size(), COUNT);
+        ensure_equals("changed rows", changed.size(), (size_t)(COUNT / 100));
+        ensure("none removed", removed.empty());
+    }
+} // namespace tut
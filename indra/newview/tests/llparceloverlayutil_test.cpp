@@ -0,0 +1,357 @@
+/**
+ * @file   llparceloverlayutil_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llparceloverlayutil.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../llparceloverlayutil.h"
+
+#include "llparcel.h"
+
+#include <random>
+#include <set>
+#include <tuple>
+
+namespace
+{
+    // a region cut into rectangular parcels, with the lines the simulator
+    // would send around each of them
+    std::vector<U8> make_overlay(S32 grids_per_edge, U32 seed)
+    {
+        std::mt19937 rand(seed);
+        std::vector<S32> parcel(grids_per_edge * grids_per_edge, 0);
+        S32 next_parcel = 1;
+        for (S32 i = 0; i < 40; ++i)
+        {
+            S32 x = rand() % grids_per_edge;
+            S32 y = rand() % grids_per_edge;
+            S32 w = 1 + rand() % 16;
+            S32 h = 1 + rand() % 16;
+            for (S32 row = y; row < llmin(y + h, grids_per_edge); ++row)
+            {
+                for (S32 col = x; col < llmin(x + w, grids_per_edge); ++col)
+                {
+                    parcel[row * grids_per_edge + col] = next_parcel;
+                }
+            }
+            ++next_parcel;
+        }
+
+        std::vector<U8> overlay(grids_per_edge * grids_per_edge);
+        for (S32 row = 0; row < grids_per_edge; ++row)
+        {
+            for (S32 col = 0; col < grids_per_edge; ++col)
+            {
+                S32 id = parcel[row * grids_per_edge + col];
+                U8 cell = id ? (U8)(1 + id % PARCEL_AUCTION) : PARCEL_PUBLIC;
+                if (col == 0 || parcel[row * grids_per_edge + col - 1] != id)
+                {
+                    cell |= PARCEL_WEST_LINE;
+                }
+                if (row == 0 || parcel[(row - 1) * grids_per_edge + col] != id)
+                {
+                    cell |= PARCEL_SOUTH_LINE;
+                }
+                overlay[row * grids_per_edge + col] = cell;
+            }
+        }
+        return overlay;
+    }
+
+    // what LLViewerParcelOverlay::updatePropertyLines used to test per cell
+    U8 cell_edges(const U8* ownership, S32 n, S32 row, S32 col)
+    {
+        U8 overlay = ownership[row * n + col];
+        switch (overlay & PARCEL_COLOR_MASK)
+        {
+        case PARCEL_SELF:
+        case PARCEL_GROUP:
+        case PARCEL_OWNED:
+        case PARCEL_FOR_SALE:
+        case PARCEL_AUCTION:
+            break;
+        default:
+            return 0;
+        }
+        U8 mask = 0;
+        if (overlay & PARCEL_WEST_LINE)
+            mask |= LLParcelOverlayUtil::EDGE_WEST;
+        if (col == n - 1 || ownership[row * n + col + 1] & PARCEL_WEST_LINE)
+            mask |= LLParcelOverlayUtil::EDGE_EAST;
+        if (overlay & PARCEL_SOUTH_LINE)
+            mask |= LLParcelOverlayUtil::EDGE_SOUTH;
+        if (row == n - 1 || ownership[(row + 1) * n + col] & PARCEL_SOUTH_LINE)
+            mask |= LLParcelOverlayUtil::EDGE_NORTH;
+        return mask;
+    }
+
+    // what LLViewerParcelOverlay::renderPropertyLinesOnMinimap used to
+    // draw, one segment per cell edge, at one pixel per meter from the
+    // region's corner
+    void legacy_minimap_lines(const U8* ownership, S32 n, F32 step, std::vector<LLVector2>& lines)
+    {
+        lines.clear();
+        for (S32 i = 0; i <= n; i++)
+        {
+            const F32 bottom = i * step;
+            const F32 top    = bottom + step;
+            for (S32 j = 0; j <= n; j++)
+            {
+                const F32  left               = j * step;
+                const F32  right              = left + step;
+                const bool is_region_boundary = i == n || j == n;
+                const U8   overlay            = is_region_boundary ? 0 : ownership[(i * n) + j];
+                const bool has_left   = i != n && (j == n || (overlay & PARCEL_WEST_LINE));
+                const bool has_bottom = j != n && (i == n || (overlay & PARCEL_SOUTH_LINE));
+                if (has_left)
+                {
+                    lines.emplace_back(left, bottom);
+                    lines.emplace_back(left, top);
+                }
+                if (has_bottom)
+                {
+                    lines.emplace_back(left, bottom);
+                    lines.emplace_back(right, bottom);
+                }
+            }
+        }
+    }
+
+    // the cell edges a list of segments covers, as (x, y, vertical) in
+    // grid units; false if any edge is covered twice
+    typedef std::set<std::tuple<S32, S32, bool>> edge_set_t;
+    bool covered_edges(const std::vector<LLVector2>& lines, F32 step, edge_set_t& edges)
+    {
+        edges.clear();
+        size_t pieces = 0;
+        for (size_t i = 0; i + 1 < lines.size(); i += 2)
+        {
+            S32 x0 = ll_round(lines[i].mV[VX] / step), y0 = ll_round(lines[i].mV[VY] / step);
+            S32 x1 = ll_round(lines[i + 1].mV[VX] / step), y1 = ll_round(lines[i + 1].mV[VY] / step);
+            if (x0 == x1)
+            {
+                for (S32 y = llmin(y0, y1); y < llmax(y0, y1); ++y, ++pieces)
+                {
+                    edges.insert(std::make_tuple(x0, y, true));
+                }
+            }
+            else if (y0 == y1)
+            {
+                for (S32 x = llmin(x0, x1); x < llmax(x0, x1); ++x, ++pieces)
+                {
+                    edges.insert(std::make_tuple(x, y0, false));
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return pieces == edges.size();
+    }
+
+    void make_palette(LLColor4U* palette)
+    {
+        for (S32 c = 0; c <= PARCEL_COLOR_MASK; ++c)
+        {
+            palette[c] = LLColor4U(c * 30, 255 - c * 30, c * 7, 128 + c);
+        }
+    }
+}
+
+namespace tut
+{
+    struct llparceloverlayutil_data
+    {
+    };
+    typedef test_group<llparceloverlayutil_data> llparceloverlayutil_group;
+    typedef llparceloverlayutil_group::object object;
+    llparceloverlayutil_group llparceloverlayutilgrp("llparceloverlayutil");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("colors");
+        LLColor4U palette[PARCEL_COLOR_MASK + 1];
+        make_palette(palette);
+
+        // every byte value, and an odd count for the tail
+        std::vector<U8> ownership(256 + 7);
+        for (U32 i = 0; i < ownership.size(); ++i)
+        {
+            ownership[i] = (U8)i;
+        }
+        std::vector<U8> rgba(ownership.size() * 4);
+        LLParcelOverlayUtil::colorCells(ownership.data(), (S32)ownership.size(), palette, rgba.data());
+        for (U32 i = 0; i < ownership.size(); ++i)
+        {
+            const LLColor4U& color = palette[ownership[i] & PARCEL_COLOR_MASK];
+            ensure("pixel matches palette",
+                   rgba[i * 4] == color.mV[VRED] && rgba[i * 4 + 1] == color.mV[VGREEN] &&
+                   rgba[i * 4 + 2] == color.mV[VBLUE] && rgba[i * 4 + 3] == color.mV[VALPHA]);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("edge masks");
+        // 64 for a normal region, 48 for a size not done 16 at a time
+        const S32 sizes[] = { 64, 48, 128 };
+        for (S32 n : sizes)
+        {
+            std::mt19937 rand(n);
+            std::vector<U8> ownership(n * n);
+            for (U8& cell : ownership)
+            {
+                cell = (U8)rand();
+            }
+            std::vector<U8> masks(n * n, 0xff);
+            LLParcelOverlayUtil::edgeMasks(ownership.data(), n, 0, n, masks.data());
+            for (S32 row = 0; row < n; ++row)
+            {
+                for (S32 col = 0; col < n; ++col)
+                {
+                    ensure_equals("same as per cell", masks[row * n + col], cell_edges(ownership.data(), n, row, col));
+                }
+            }
+
+            // a band of rows leaves the others alone
+            std::vector<U8> band(n * n, 0xff);
+            LLParcelOverlayUtil::edgeMasks(ownership.data(), n, 8, 16, band.data());
+            ensure_equals("below the band", band[7 * n], (U8)0xff);
+            ensure_equals("in the band", band[8 * n + 3], masks[8 * n + 3]);
+            ensure_equals("above the band", band[16 * n], (U8)0xff);
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("minimap lines");
+        const S32 N = 64;
+        const F32 STEP = PARCEL_GRID_STEP_METERS;
+        std::vector<U8> ownership(N * N, PARCEL_PUBLIC);
+        std::vector<LLVector2> lines;
+        LLParcelOverlayUtil::minimapLines(ownership.data(), N, STEP, lines);
+        ensure_equals("just the east and north edges", lines.size(), (size_t)4);
+
+        // one parcel, rows 2-5 and columns 3-9
+        for (S32 row = 2; row < 6; ++row)
+        {
+            ownership[row * N + 3] |= PARCEL_WEST_LINE;
+            ownership[row * N + 10] |= PARCEL_WEST_LINE;
+        }
+        for (S32 col = 3; col < 10; ++col)
+        {
+            ownership[2 * N + col] |= PARCEL_SOUTH_LINE;
+            ownership[6 * N + col] |= PARCEL_SOUTH_LINE;
+        }
+        LLParcelOverlayUtil::minimapLines(ownership.data(), N, STEP, lines);
+        ensure_equals("four sides and the region edges", lines.size(), (size_t)12);
+        ensure_equals("west side x", lines[0].mV[VX], 3 * STEP);
+        ensure_equals("west side from", lines[0].mV[VY], 2 * STEP);
+        ensure_equals("west side to", lines[1].mV[VY], 6 * STEP);
+        ensure_equals("south side from", lines[4].mV[VX], 3 * STEP);
+        ensure_equals("south side to", lines[5].mV[VX], 10 * STEP);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("minimap lines cover what the per cell drawing did");
+        const F32 STEP = PARCEL_GRID_STEP_METERS;
+        // 64 for a normal region, 48 for a size not done 16 at a time
+        const S32 sizes[] = { 64, 48, 128 };
+        std::vector<LLVector2> lines, legacy;
+        edge_set_t edges, legacy_edges;
+        for (S32 n : sizes)
+        {
+            std::vector<std::vector<U8>> grids;
+            grids.push_back(make_overlay(n, n));
+            grids.push_back(std::vector<U8>(n * n, PARCEL_PUBLIC));
+            std::mt19937 rand(n);
+            std::vector<U8> noise(n * n);
+            for (U8& cell : noise)
+            {
+                cell = (U8)rand();
+            }
+            grids.push_back(noise);
+
+            for (const std::vector<U8>& ownership : grids)
+            {
+                LLParcelOverlayUtil::minimapLines(ownership.data(), n, STEP, lines);
+                legacy_minimap_lines(ownership.data(), n, STEP, legacy);
+                ensure("merged lines don't overlap", covered_edges(lines, STEP, edges));
+                ensure("per cell lines don't overlap", covered_edges(legacy, STEP, legacy_edges));
+                ensure("same cell edges", edges == legacy_edges);
+                ensure("no more segments than per cell", lines.size() <= legacy.size());
+            }
+        }
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("16 regions");
+        const S32 REGIONS = 16;
+        const S32 N = 64;
+        LLColor4U palette[PARCEL_COLOR_MASK + 1];
+        make_palette(palette);
+
+        std::vector<std::vector<U8>> overlays;
+        for (S32 r = 0; r < REGIONS; ++r)
+        {
+            overlays.push_back(make_overlay(N, r + 1));
+        }
+        std::vector<U8> legacy_rgba(N * N * 4);
+        std::vector<U8> rgba(N * N * 4);
+        std::vector<U8> masks(N * N);
+        std::vector<LLVector2> lines;
+
+        for (const std::vector<U8>& overlay : overlays)
+        {
+            // per cell: a color switch, four neighbour tests, and a minimap
+            // line per cell edge
+            U32 legacy_edges = 0;
+            U32 legacy_segments = 0;
+            for (S32 i = 0; i < N * N; ++i)
+            {
+                const LLColor4U& color = palette[overlay[i] & PARCEL_COLOR_MASK];
+                memcpy(&legacy_rgba[i * 4], color.mV, 4);
+            }
+            for (S32 row = 0; row < N; ++row)
+            {
+                for (S32 col = 0; col < N; ++col)
+                {
+                    U8 mask = cell_edges(overlay.data(), N, row, col);
+                    legacy_edges += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+                    legacy_segments += ((overlay[row * N + col] & PARCEL_WEST_LINE) != 0) +
+                                       ((overlay[row * N + col] & PARCEL_SOUTH_LINE) != 0);
+                }
+            }
+
+            U32 edges = 0;
+            LLParcelOverlayUtil::colorCells(overlay.data(), N * N, palette, rgba.data());
+            LLParcelOverlayUtil::edgeMasks(overlay.data(), N, 0, N, masks.data());
+            for (U8 mask : masks)
+            {
+                edges += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+            }
+            LLParcelOverlayUtil::minimapLines(overlay.data(), N, PARCEL_GRID_STEP_METERS, lines);
+            U32 segments = (U32)lines.size() / 2;
+
+            ensure("same colors", rgba == legacy_rgba);
+            ensure_equals("same property line edges", edges, legacy_edges);
+            ensure("fewer minimap segments", segments < legacy_segments);
+        }
+    }
+} // namespace tut
@@ -0,0 +1,157 @@
+/**
+ * @file   llregiongrid_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for llregiongrid.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../llregiongrid.h"
+
+#include "llregionhandle.h"
+
+#include <list>
+#include <random>
+
+namespace
+{
+    // stands in for LLViewerRegion, which the grid only stores
+    struct FakeRegion
+    {
+        U64 mHandle;
+        U32 mWidth;
+    };
+
+    LLViewerRegion* as_region(FakeRegion* region)
+    {
+        return reinterpret_cast<LLViewerRegion*>(region);
+    }
+
+    // what LLWorld::getRegionFromPosGlobal did
+    FakeRegion* walk(const std::list<FakeRegion*>& regions, const LLVector3d& pos)
+    {
+        for (FakeRegion* region : regions)
+        {
+            LLVector3d origin = from_region_handle(region->mHandle);
+            F64 x = pos.mdV[VX] - origin.mdV[VX];
+            F64 y = pos.mdV[VY] - origin.mdV[VY];
+            if (x >= 0.0 && x < region->mWidth && y >= 0.0 && y < region->mWidth)
+            {
+                return region;
+            }
+        }
+        return NULL;
+    }
+
+    // edge x edge regions of 256m around grid position 1000, 1000
+    std::vector<FakeRegion> make_regions(U32 edge)
+    {
+        std::vector<FakeRegion> regions;
+        for (U32 y = 0; y < edge; ++y)
+        {
+            for (U32 x = 0; x < edge; ++x)
+            {
+                FakeRegion region;
+                region.mHandle = grid_to_region_handle(1000 + x, 1000 + y);
+                region.mWidth = 256;
+                regions.push_back(region);
+            }
+        }
+        return regions;
+    }
+}
+
+namespace tut
+{
+    struct llregiongrid_data
+    {
+    };
+    typedef test_group<llregiongrid_data> llregiongrid_group;
+    typedef llregiongrid_group::object object;
+    llregiongrid_group llregiongridgrp("llregiongrid");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("handles and positions");
+        FakeRegion normal = { to_region_handle(256000, 256000), 256 };
+        FakeRegion var = { to_region_handle(256256, 256000), 512 };
+        LLRegionGrid grid;
+        grid.add(as_region(&normal), normal.mHandle, normal.mWidth);
+        grid.add(as_region(&var), var.mHandle, var.mWidth);
+        ensure_equals("cells", grid.getCellCount(), (size_t)5);
+
+        ensure("normal by handle", grid.find(normal.mHandle) == as_region(&normal));
+        ensure("var by its handle", grid.find(var.mHandle) == as_region(&var));
+        ensure("var by a handle inside it", grid.find(to_region_handle(256700, 256300)) == as_region(&var));
+        ensure("past the var region", grid.find(to_region_handle(256768, 256000)) == NULL);
+
+        ensure("normal by position", grid.find(LLVector3d(256010.0, 256255.5, 20.0)) == as_region(&normal));
+        ensure("var by position", grid.find(LLVector3d(256767.9, 256511.9, 4000.0)) == as_region(&var));
+        ensure("west of everything", grid.find(LLVector3d(255999.9, 256010.0, 0.0)) == NULL);
+        ensure("negative", grid.find(LLVector3d(-1.0, 256010.0, 0.0)) == NULL);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("overlaps and removal");
+        FakeRegion first = { to_region_handle(256000, 256000), 512 };
+        FakeRegion second = { to_region_handle(256256, 256256), 256 };
+        LLRegionGrid grid;
+        grid.add(as_region(&first), first.mHandle, first.mWidth);
+        grid.add(as_region(&second), second.mHandle, second.mWidth);
+        ensure("first added keeps the cell", grid.find(second.mHandle) == as_region(&first));
+
+        // what LLWorld::removeRegion does
+        grid.remove(as_region(&first), first.mHandle, first.mWidth);
+        grid.add(as_region(&second), second.mHandle, second.mWidth);
+        ensure("uncovered", grid.find(second.mHandle) == as_region(&second));
+        ensure("rest of first gone", grid.find(first.mHandle) == NULL);
+
+        // removing a region that lost its cells leaves the owner alone
+        grid.add(as_region(&first), first.mHandle, first.mWidth);
+        grid.remove(as_region(&first), first.mHandle, first.mWidth);
+        ensure("second stays", grid.find(second.mHandle) == as_region(&second));
+        ensure_equals("one cell left", grid.getCellCount(), (size_t)1);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("1, 9 and 49 regions");
+        const U32 LOOKUPS = 20000;
+        const U32 edges[] = { 1, 3, 7 };
+        for (U32 edge : edges)
+        {
+            std::vector<FakeRegion> regions = make_regions(edge);
+            std::list<FakeRegion*> region_list;
+            LLRegionGrid grid;
+            for (FakeRegion& region : regions)
+            {
+                region_list.push_back(&region);
+                grid.add(as_region(&region), region.mHandle, region.mWidth);
+            }
+
+            // spread over the regions and a region's width around them
+            std::mt19937 rand(edge);
+            std::uniform_real_distribution<F64> coord((1000.0 - 1.0) * 256.0, (1000.0 + edge + 1.0) * 256.0);
+            U32 hits = 0;
+            for (U32 i = 0; i < LOOKUPS; ++i)
+            {
+                LLVector3d point(coord(rand), coord(rand), 30.0);
+                FakeRegion* walked = walk(region_list, point);
+                ensure("same region as the list walk", as_region(walked) == grid.find(point));
+                hits += walked != NULL;
+            }
+            ensure("some points inside", hits > 0);
+            ensure("some points outside", hits < LOOKUPS);
+        }
+    }
+} // namespace tut
@@ -0,0 +1,300 @@
+/**
+ * @file   lltexturefetchupdates_test.cpp
+ * @date   2026-10-18
+ * @brief  Test for lltexturefetchupdates, plus a stress run of 20k requests
+ *         updated every frame from several threads while a fetch thread
+ *         drains them.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "../lltexturefetchupdates.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    typedef LLTextureFetchUpdates::Update Update;
+
+    // stands in for LLTextureFetchWorker
+    struct FakeWorker
+    {
+        LLTextureFetchUpdates::Pending& getPendingUpdates() { return mPending; }
+
+        LLTextureFetchUpdates::Pending mPending;
+        F32 mPriority = 0.f;
+        S32 mDesiredDiscard = -1;
+        U32 mApplied = 0;
+    };
+
+    // stands in for LLTextureFetch's request map and its lock
+    struct FakeFetch
+    {
+        FakeFetch(U32 capacity) :
+            mUpdates(capacity)
+        {}
+
+        FakeWorker* add(const LLUUID& id)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::unique_ptr<FakeWorker>& worker = mWorkers[id];
+            worker.reset(new FakeWorker);
+            return worker.get();
+        }
+
+        void remove(const LLUUID& id)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mWorkers.erase(id);
+        }
+
+        // what LLTextureFetch::applyRequestUpdates() does
+        U32 drain()
+        {
+            return mUpdates.drain<FakeWorker>(
+                [this](const Update* updates, U32 count, FakeWorker** workers)
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    ++mLookups;
+                    for (U32 i = 0; i < count; ++i)
+                    {
+                        auto iter = mWorkers.find(updates[i].mID);
+                        workers[i] = (iter != mWorkers.end()) ? iter->second.get() : NULL;
+                    }
+                },
+                [](FakeWorker* worker, const Update& update)
+                {
+                    worker->mPriority = update.mPriority;
+                    if (!update.mPriorityOnly)
+                    {
+                        worker->mDesiredDiscard = update.mDesiredDiscard;
+                    }
+                    ++worker->mApplied;
+                });
+        }
+
+        LLTextureFetchUpdates mUpdates;
+        std::mutex mMutex;
+        std::map<LLUUID, std::unique_ptr<FakeWorker>> mWorkers;
+        U32 mLookups = 0;
+    };
+
+    Update priority_update(const LLUUID& id, F32 priority)
+    {
+        Update update;
+        update.mID = id;
+        update.mPriority = priority;
+        return update;
+    }
+
+    Update discard_update(const LLUUID& id, F32 priority, S32 discard)
+    {
+        Update update = priority_update(id, priority);
+        update.mDesiredDiscard = discard;
+        update.mPriorityOnly = false;
+        return update;
+    }
+}
+
+namespace tut
+{
+    struct lltexturefetchupdates_data
+    {
+    };
+    typedef test_group<lltexturefetchupdates_data> lltexturefetchupdates_group;
+    typedef lltexturefetchupdates_group::object object;
+    lltexturefetchupdates_group lltexturefetchupdatesgrp("lltexturefetchupdates");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("applied in order, one lookup per batch");
+        FakeFetch fetch(1024);
+        LLUUID first, second, gone;
+        first.generate();
+        second.generate();
+        gone.generate();
+        FakeWorker* first_worker = fetch.add(first);
+        FakeWorker* second_worker = fetch.add(second);
+
+        for (U32 i = 0; i < 200; ++i)
+        {
+            ensure("pushed", fetch.mUpdates.push(priority_update(first, (F32)i)));
+            ensure("pushed", fetch.mUpdates.push(priority_update(second, (F32)(1000 + i))));
+            ensure("pushed", fetch.mUpdates.push(priority_update(gone, 1.f)));
+        }
+
+        ensure_equals("requests that are gone are skipped", fetch.drain(), (U32)400);
+        ensure_equals("one lookup per batch", fetch.mLookups, (U32)3);
+        ensure_equals("first got all", first_worker->mApplied, (U32)200);
+        ensure_equals("second got all", second_worker->mApplied, (U32)200);
+        ensure_equals("first ends on the last sent", first_worker->mPriority, 199.f);
+        ensure_equals("second ends on the last sent", second_worker->mPriority, 1199.f);
+        ensure_equals("priority only", first_worker->mDesiredDiscard, -1);
+        ensure_equals("nothing left", fetch.drain(), (U32)0);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("pending until applied");
+        FakeFetch fetch(2);
+        LLUUID id;
+        id.generate();
+        FakeWorker* worker = fetch.add(id);
+        LLTextureFetchUpdates::Pending& pending = worker->getPendingUpdates();
+
+        ensure("nothing pending", !pending.any());
+        ensure("pushed", fetch.mUpdates.push(discard_update(id, 1.f, 3), &pending));
+        ensure("pending once pushed", pending.any());
+        ensure("pushed", fetch.mUpdates.push(discard_update(id, 2.f, 1), &pending));
+        ensure("full", !fetch.mUpdates.push(discard_update(id, 3.f, 0), &pending));
+        ensure_equals("not applied yet", worker->mDesiredDiscard, -1);
+
+        ensure_equals("applied", fetch.drain(), (U32)2);
+        ensure("settled once applied", !pending.any());
+        ensure_equals("last one queued wins", worker->mDesiredDiscard, 1);
+        ensure_equals("one that didn't fit isn't counted", worker->mApplied, (U32)2);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("a new request for the same texture skips the old one's updates");
+        FakeFetch fetch(16);
+        LLUUID id;
+        id.generate();
+        FakeWorker* old_worker = fetch.add(id);
+        ensure("pushed", fetch.mUpdates.push(discard_update(id, 1.f, 2), &old_worker->getPendingUpdates()));
+
+        fetch.remove(id);
+        FakeWorker* new_worker = fetch.add(id);
+        ensure("pushed", fetch.mUpdates.push(priority_update(id, 5.f)));
+
+        ensure_equals("only the priority applied", fetch.drain(), (U32)1);
+        ensure_equals("old discard not applied", new_worker->mDesiredDiscard, -1);
+        ensure_equals("priority still applies by id", new_worker->mPriority, 5.f);
+        ensure("new request has nothing pending", !new_worker->getPendingUpdates().any());
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("20k requests a frame from four threads");
+        const U32 THREADS = 4;
+        const U32 PER_THREAD = 5000;
+        const U32 FRAMES = 30;
+        const U32 DISCARD_EVERY = 100;      // one in this many also changes discard each frame
+
+        // the size LLTextureFetch uses
+        FakeFetch fetch(32768);
+        std::vector<std::vector<LLUUID>> ids(THREADS);
+        for (U32 t = 0; t < THREADS; ++t)
+        {
+            ids[t].resize(PER_THREAD);
+            for (LLUUID& id : ids[t])
+            {
+                id.generate();
+                fetch.add(id);
+            }
+        }
+        std::vector<FakeWorker*> workers;
+        for (U32 t = 0; t < THREADS; ++t)
+        {
+            for (const LLUUID& id : ids[t])
+            {
+                workers.push_back(fetch.mWorkers[id].get());
+            }
+        }
+
+        std::atomic<bool> stop(false);
+        std::atomic<U32> dropped(0);
+        std::atomic<U32> wrong(0);
+        U32 drained = 0;
+        std::thread fetch_thread([&]()
+            {
+                while (!stop)
+                {
+                    drained += fetch.drain();
+                    std::this_thread::yield();
+                }
+            });
+
+        std::vector<std::thread> senders;
+        for (U32 t = 0; t < THREADS; ++t)
+        {
+            senders.emplace_back([&, t]()
+                {
+                    for (U32 frame = 0; frame < FRAMES; ++frame)
+                    {
+                        for (U32 i = 0; i < PER_THREAD; ++i)
+                        {
+                            const LLUUID& id = ids[t][i];
+                            F32 priority = (F32)(frame * PER_THREAD + i);
+                            if (i % DISCARD_EVERY == 0)
+                            {
+                                FakeWorker* worker = workers[t * PER_THREAD + i];
+                                while (!fetch.mUpdates.push(discard_update(id, priority, frame % 6), &worker->getPendingUpdates()))
+                                {
+                                    std::this_thread::yield();
+                                }
+                            }
+                            else if (!fetch.mUpdates.push(priority_update(id, priority)))
+                            {
+                                // LLTextureFetch would post it instead
+                                ++dropped;
+                            }
+                        }
+
+                        // as getRequestFinished() would: once nothing is
+                        // pending, the worker has the last discard asked for
+                        for (U32 i = 0; i < PER_THREAD; i += DISCARD_EVERY)
+                        {
+                            FakeWorker* worker = workers[t * PER_THREAD + i];
+                            while (worker->getPendingUpdates().any())
+                            {
+                                std::this_thread::yield();
+                            }
+                            if (worker->mDesiredDiscard != (S32)(frame % 6))
+                            {
+                                ++wrong;
+                            }
+                        }
+                    }
+                });
+        }
+        for (std::thread& sender : senders)
+        {
+            sender.join();
+        }
+        stop = true;
+        fetch_thread.join();
+        drained += fetch.drain();
+
+        ensure_equals("settled workers have the discard asked for", wrong.load(), (U32)0);
+        ensure_equals("everything pushed was applied", drained, THREADS * PER_THREAD * FRAMES - dropped.load());
+        if (dropped == 0)
+        {
+            for (U32 t = 0; t < THREADS; ++t)
+            {
+                for (U32 i = 0; i < PER_THREAD; ++i)
+                {
+                    FakeWorker* worker = workers[t * PER_THREAD + i];
+                    ensure_equals("last priority sent wins", worker->mPriority, (F32)((FRAMES - 1) * PER_THREAD + i));
+                    ensure("nothing pending", !worker->getPendingUpdates().any());
+                }
+            }
+        }
+    }
+} // namespace tut
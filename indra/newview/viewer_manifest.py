@@ -462,6 +462,12 @@ class WindowsManifest(ViewerManifest):
             ):
                 self.path(libfile)
 
+            # Built from source in indra/deps; the redirect dll makes
+            # mimalloc replace the CRT allocator for the whole process
+            if self.args['mimalloc'] == 'ON' or self.args['mimalloc'] == 'TRUE':
+                self.path("mimalloc.dll")
+                self.path("mimalloc-redirect.dll")
+
             # For image support
             self.path("openjp2.dll")
 
@@ -772,6 +778,11 @@ class DarwinManifest(ViewerManifest):
                 with self.prefix(src=os.path.join(self.args['build'], os.pardir, 'llwebrtc', self.args['configuration'])):
                     self.path('libllwebrtc.dylib')
 
+                if self.args['mimalloc'] == 'ON' or self.args['mimalloc'] == 'TRUE':
+                    with self.prefix(src=os.path.join(self.args['build'], os.pardir, 'sharedlibs',
+                                                      self.args['configuration'], 'Resources')):
+                        self.path('libmimalloc*.dylib')
+
                 with self.prefix(src=libdir):
                     self.path('libndofdev.dylib')
 
@@ -1250,6 +1261,10 @@ class LinuxManifest(ViewerManifest):
         with self.prefix(src=os.path.join(self.args['build'], os.pardir, "llwebrtc"), dst="lib"):
             self.path("libllwebrtc.so")
 
+        if self.args['mimalloc'] == 'ON' or self.args['mimalloc'] == 'TRUE':
+            with self.prefix(src=os.path.join(self.args['build'], os.pardir, "sharedlibs", "lib"), dst="lib"):
+                self.path("libmimalloc.so*")
+
         self.path("featuretable_linux.txt")
 
         with self.prefix(src=pkgdir, dst="app_settings"):
@@ -1388,6 +1403,7 @@ if __name__ == "__main__":
         dict(name='fmodstudio', description="""Indication if fmod studio libraries are needed""", default='OFF'),
         dict(name='openal', description="""Indication if openal libraries are needed""", default='OFF'),
         dict(name='kdu', description="""Indication if kdu libraries are needed""", default='OFF'),
+        dict(name='mimalloc', description="""Indication if the mimalloc library is needed""", default='OFF'),
         ]
     try:
         main(extra=extra_arguments)